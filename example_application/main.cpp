@@ -11,14 +11,20 @@ int main(int /*argc*/, const char* /*argv*/[])
 {
     const auto instance = Instance();
     const auto referenceDevice = instance.addDevice("daqref://device0");
+
+    // The filter and the renderer only need a fraction of the reference signal's sample rate
+    const auto decimator = instance.addFunctionBlock("ExampleDecimator");
+    decimator.setPropertyValue("DecimationFactor", 10);
+    decimator.getInputPorts()[0].connect(referenceDevice.getSignalsRecursive()[0]);
+
     const auto iirFilter = instance.addFunctionBlock("ExampleIIRFilter");
     std::cout << "ExampleIIRFilter successfully added!";
 
-    iirFilter.getInputPorts()[0].connect(referenceDevice.getSignalsRecursive()[0]);
+    iirFilter.getInputPorts()[0].connect(decimator.getSignals()[0]);
 
     const auto renderer = instance.addFunctionBlock("RefFBModuleRenderer");
     renderer.getInputPorts()[0].connect(iirFilter.getSignals()[0]);
-    renderer.getInputPorts()[1].connect(referenceDevice.getSignalsRecursive()[0]);
+    renderer.getInputPorts()[1].connect(decimator.getSignals()[0]);
 
     std::cout << "ExampleIIRFilter is running.\n";
     std::cout << "Press ENTER to exit the application..." << std::endl;
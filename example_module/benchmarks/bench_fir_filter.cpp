@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+#include <example_module/fir_filter.h>
+#include <example_module/polyphase_decimator.h>
+#include <random>
+#include <vector>
+
+using namespace daq;
+using namespace daq::modules::example_module;
+
+// Filters one block per iteration with the given method; state.range(0) holds the tap count. Comparing
+// the two methods over the tap count gives the crossover used for FirFilter::DirectMaxTaps.
+static void BM_FirFilter(benchmark::State& state, FirMethod method)
+{
+    const auto tapCount = static_cast<SizeT>(state.range(0));
+    const SizeT blockSize = 16384;
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> taps(tapCount);
+    for (auto& tap : taps)
+        tap = dist(gen);
+    std::vector<double> data(blockSize);
+    for (auto& value : data)
+        value = dist(gen);
+
+    FirFilter filter;
+    filter.setTaps(taps, method);
+
+    for (auto _ : state)
+    {
+        filter.process(data.data(), data.data(), blockSize);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * blockSize));
+}
+
+BENCHMARK_CAPTURE(BM_FirFilter, Direct, FirMethod::Direct)->RangeMultiplier(2)->Range(4, 1024);
+BENCHMARK_CAPTURE(BM_FirFilter, Fft, FirMethod::Fft)->RangeMultiplier(2)->Range(4, 65536);
+
+// Decimates one block per iteration by state.range(0) with 16 taps per phase; items are input samples
+static void BM_PolyphaseDecimator(benchmark::State& state)
+{
+    const auto factor = static_cast<SizeT>(state.range(0));
+    const SizeT blockSize = 16384;
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> input(blockSize);
+    for (auto& value : input)
+        value = dist(gen);
+    std::vector<double> output(blockSize);
+
+    PolyphaseDecimator decimator;
+    decimator.setFilter(designDecimationFilter(factor, 16, 1000.0), factor);
+
+    for (auto _ : state)
+    {
+        decimator.process(input.data(), blockSize, output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * blockSize));
+}
+
+// Baseline for BM_PolyphaseDecimator: the same filter at the full rate, keeping every factor-th output
+static void BM_FilterThenDrop(benchmark::State& state)
+{
+    const auto factor = static_cast<SizeT>(state.range(0));
+    const SizeT blockSize = 16384;
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> input(blockSize);
+    for (auto& value : input)
+        value = dist(gen);
+    std::vector<double> filtered(blockSize);
+    std::vector<double> output(blockSize);
+
+    FirFilter filter;
+    filter.setTaps(designDecimationFilter(factor, 16, 1000.0));
+
+    for (auto _ : state)
+    {
+        filter.process(input.data(), filtered.data(), blockSize);
+        for (SizeT n = 0, m = 0; n < blockSize; n += factor, ++m)
+            output[m] = filtered[n];
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * blockSize));
+}
+
+BENCHMARK(BM_PolyphaseDecimator)->RangeMultiplier(4)->Range(2, 128);
+BENCHMARK(BM_FilterThenDrop)->RangeMultiplier(4)->Range(2, 128);
@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+#include <example_module/waveform_table.h>
+#include <cmath>
+#include <vector>
+
+using namespace daq;
+using namespace daq::modules::example_module;
+
+// Generates one packet per iteration; state.range(0) holds the packet size. The table fill is what the
+// generator function block does per channel and packet, the computed sine is the cost it avoids.
+static void BM_WaveformTableFill(benchmark::State& state, Waveform waveform, SampleType sampleType)
+{
+    const auto packetSize = static_cast<SizeT>(state.range(0));
+
+    WaveformSpec spec;
+    spec.waveform = waveform;
+    spec.sampleRate = 10000000.0;
+    spec.frequency = 1000.0;
+    spec.endFrequency = 100000.0;
+    spec.duration = 0.1;
+
+    WaveformTable table;
+    table.build(spec, sampleType);
+    std::vector<uint8_t> output(packetSize * table.getSampleSize());
+    SizeT phase = 0;
+
+    for (auto _ : state)
+    {
+        phase = table.fill(output.data(), packetSize, phase);
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * packetSize));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * output.size()));
+}
+
+static void BM_SineCompute(benchmark::State& state)
+{
+    const auto packetSize = static_cast<SizeT>(state.range(0));
+    const double step = 2.0 * 3.14159265358979323846 * 1000.0 / 10000000.0;
+    std::vector<double> output(packetSize);
+    SizeT position = 0;
+
+    for (auto _ : state)
+    {
+        for (SizeT i = 0; i < packetSize; ++i)
+            output[i] = std::sin(step * static_cast<double>(position + i));
+        position += packetSize;
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * packetSize));
+}
+
+BENCHMARK_CAPTURE(BM_WaveformTableFill, Sine_Float64, Waveform::Sine, SampleType::Float64)->RangeMultiplier(16)->Range(64, 1 << 20);
+BENCHMARK_CAPTURE(BM_WaveformTableFill, Sine_Int16, Waveform::Sine, SampleType::Int16)->RangeMultiplier(16)->Range(64, 1 << 20);
+BENCHMARK_CAPTURE(BM_WaveformTableFill, Chirp_Float64, Waveform::Chirp, SampleType::Float64)->RangeMultiplier(16)->Range(64, 1 << 20);
+BENCHMARK_CAPTURE(BM_WaveformTableFill, Constant_Float64, Waveform::Constant, SampleType::Float64)->RangeMultiplier(16)->Range(64, 1 << 20);
+BENCHMARK(BM_SineCompute)->RangeMultiplier(16)->Range(64, 1 << 20);
@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+#include <example_module/operator_chain.h>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace daq;
+using namespace daq::modules::example_module;
+
+namespace
+{
+    std::vector<int16_t> createInput(SizeT count)
+    {
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<int> dist(-1000, 1000);
+
+        std::vector<int16_t> input(count);
+        for (auto& value : input)
+            value = static_cast<int16_t>(dist(gen));
+        return input;
+    }
+
+    std::vector<ChainOperator> parseOperators(const std::vector<std::string>& texts)
+    {
+        std::vector<ChainOperator> operators;
+        for (const auto& text : texts)
+            operators.push_back(parseChainOperator(text));
+        return operators;
+    }
+
+    const std::vector<std::string> CommonChain = {"Gain 0.5", "Offset 10", "Clamp -200 200"};
+    const std::vector<std::string> FiveStageChain = {"Offset -10", "Gain 0.5", "DeadBand 5", "Abs", "Clamp 0 200"};
+}
+
+// Int16 input of state.range(0) samples through an operator chain, with the specialized kernel if the chain
+// has one or with the tiled interpreter
+static void BM_OperatorChain(benchmark::State& state, const std::vector<std::string>& texts, bool interpreted)
+{
+    const auto count = static_cast<SizeT>(state.range(0));
+    const auto input = createInput(count);
+    std::vector<double> output(count);
+
+    OperatorChain chain;
+    chain.setOperators(parseOperators(texts), SampleType::Int16);
+
+    for (auto _ : state)
+    {
+        if (interpreted)
+            chain.interpret(input.data(), output.data(), count);
+        else
+            chain.process(input.data(), output.data(), count);
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+    state.counters["specialized"] = chain.isSpecialized() && !interpreted ? 1 : 0;
+}
+
+// The five stages as five separate passes over the whole block, as five chained function blocks would
+// apply them (without their packet and scheduling overhead)
+static void BM_OperatorChainSeparatePasses(benchmark::State& state)
+{
+    const auto count = static_cast<SizeT>(state.range(0));
+    const auto input = createInput(count);
+    std::vector<double> output(count);
+
+    const auto operators = parseOperators(FiveStageChain);
+    std::vector<OperatorChain> stages(operators.size());
+    for (SizeT i = 0; i < operators.size(); ++i)
+        stages[i].setOperators({operators[i]}, i == 0 ? SampleType::Int16 : SampleType::Float64);
+
+    for (auto _ : state)
+    {
+        stages[0].process(input.data(), output.data(), count);
+        for (SizeT i = 1; i < stages.size(); ++i)
+            stages[i].process(output.data(), output.data(), count);
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+
+BENCHMARK_CAPTURE(BM_OperatorChain, CommonSpecialized, CommonChain, false)->RangeMultiplier(16)->Range(4096, 1 << 22);
+BENCHMARK_CAPTURE(BM_OperatorChain, CommonInterpreted, CommonChain, true)->RangeMultiplier(16)->Range(4096, 1 << 22);
+BENCHMARK_CAPTURE(BM_OperatorChain, FiveStageInterpreted, FiveStageChain, true)->RangeMultiplier(16)->Range(4096, 1 << 22);
+BENCHMARK(BM_OperatorChainSeparatePasses)->RangeMultiplier(16)->Range(4096, 1 << 22);
@@ -0,0 +1,330 @@
+#include <benchmark/benchmark.h>
+#include <opendaq/opendaq.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <thread>
+#include <vector>
+
+using namespace daq;
+
+namespace
+{
+    struct Pipeline
+    {
+        InstancePtr instance;
+        FunctionBlockPtr fb;
+        SignalConfigPtr signal;
+        SignalConfigPtr domainSignal;
+        DataDescriptorPtr dataDescriptor;
+        DataDescriptorPtr domainDescriptor;
+        StreamReaderPtr outputReader;
+        std::vector<double> outputData;
+        SizeT domainOffset = 0;
+    };
+
+    Pipeline createPipeline(const std::string& fbId, bool packetMode, SizeT blockSize)
+    {
+        Pipeline pipeline;
+        pipeline.instance = Instance();
+
+        auto config = pipeline.instance.getAvailableFunctionBlockTypes().get(fbId).createDefaultConfig();
+        config.setPropertyValue("PacketMode", packetMode);
+        pipeline.fb = pipeline.instance.addFunctionBlock(fbId, config);
+
+        pipeline.dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).setValueRange(Range(-10, 10)).build();
+        pipeline.domainDescriptor = DataDescriptorBuilder()
+                                        .setSampleType(SampleType::Int64)
+                                        .setUnit(Unit("s", -1, "seconds", "time"))
+                                        .setTickResolution(Ratio(1, 1000000))
+                                        .setRule(LinearDataRule(1, 0))
+                                        .setOrigin("1970-01-01T00:00:00+00:00")
+                                        .build();
+
+        const auto context = pipeline.instance.getContext();
+        pipeline.signal = SignalWithDescriptor(context, pipeline.dataDescriptor, nullptr, "Data");
+        pipeline.domainSignal = SignalWithDescriptor(context, pipeline.domainDescriptor, nullptr, "Domain");
+        pipeline.signal.setDomainSignal(pipeline.domainSignal);
+
+        pipeline.fb.getInputPorts()[0].connect(pipeline.signal);
+        pipeline.outputReader = StreamReader(pipeline.fb.getSignals()[0], SampleType::Float64, SampleType::Int64);
+        pipeline.outputData.resize(blockSize);
+
+        return pipeline;
+    }
+
+    void sendBlock(Pipeline& pipeline, SizeT blockSize)
+    {
+        const auto domainPacket = DataPacket(pipeline.domainDescriptor, blockSize, pipeline.domainOffset);
+        const auto packet = DataPacketWithDomain(domainPacket, pipeline.dataDescriptor, blockSize);
+        auto data = static_cast<double*>(packet.getRawData());
+        for (SizeT i = 0; i < blockSize; ++i)
+            data[i] = static_cast<double>(i % 100) * 0.1;
+
+        pipeline.signal.sendPacket(packet);
+        pipeline.domainSignal.sendPacket(domainPacket);
+        pipeline.domainOffset += blockSize;
+    }
+
+    // Waits until the function block has produced the whole block and consumes it
+    void receiveBlock(Pipeline& pipeline, SizeT blockSize)
+    {
+        SizeT received = 0;
+        while (received < blockSize)
+        {
+            SizeT count = blockSize - received;
+            pipeline.outputReader.read(pipeline.outputData.data(), &count);
+            received += count;
+            if (count == 0)
+                std::this_thread::yield();
+        }
+    }
+
+    // Reports the p50, p99, p99.9 and maximum of latencies in microseconds
+    void setLatencyCounters(benchmark::State& state, std::vector<double>& latencies)
+    {
+        if (latencies.empty())
+            return;
+
+        std::sort(latencies.begin(), latencies.end());
+        const auto percentile = [&latencies](double p) { return latencies[static_cast<SizeT>(p * static_cast<double>(latencies.size() - 1))]; };
+        state.counters["p50_us"] = percentile(0.5);
+        state.counters["p99_us"] = percentile(0.99);
+        state.counters["p999_us"] = percentile(0.999);
+        state.counters["max_us"] = latencies.back();
+    }
+}
+
+// Sends one block per iteration through the function block and waits for its output
+static void BM_Pipeline(benchmark::State& state, const std::string& fbId, bool packetMode)
+{
+    const auto blockSize = static_cast<SizeT>(state.range(0));
+    auto pipeline = createPipeline(fbId, packetMode, blockSize);
+
+    // Warm-up block, also consumes the descriptor changed events
+    sendBlock(pipeline, blockSize);
+    receiveBlock(pipeline, blockSize);
+
+    for (auto _ : state)
+    {
+        sendBlock(pipeline, blockSize);
+        receiveBlock(pipeline, blockSize);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * blockSize));
+}
+
+BENCHMARK_CAPTURE(BM_Pipeline, ScalingReader, std::string("ExampleScalingModule"), false)
+    ->RangeMultiplier(8)
+    ->Range(64, 1 << 16)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_Pipeline, ScalingPacketMode, std::string("ExampleScalingModule"), true)
+    ->RangeMultiplier(8)
+    ->Range(64, 1 << 16)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_Pipeline, IIRReader, std::string("ExampleIIRFilter"), false)
+    ->RangeMultiplier(8)
+    ->Range(64, 1 << 16)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_Pipeline, IIRPacketMode, std::string("ExampleIIRFilter"), true)
+    ->RangeMultiplier(8)
+    ->Range(64, 1 << 16)
+    ->UseRealTime();
+
+// Scales and filters state.range(0) samples per block, either with the fused function block or with the
+// scaling function block connected to the IIR filter, which adds an intermediate packet and a second read
+static void BM_ScaleAndFilter(benchmark::State& state, bool fused)
+{
+    const auto blockSize = static_cast<SizeT>(state.range(0));
+    auto pipeline = createPipeline(fused ? "ExampleScaledIIRFilter" : "ExampleScalingModule", false, blockSize);
+    pipeline.fb.setPropertyValue("Scale", 2.0);
+    pipeline.fb.setPropertyValue("Offset", 1.0);
+
+    FunctionBlockPtr filter = pipeline.fb;
+    if (!fused)
+    {
+        filter = pipeline.instance.addFunctionBlock("ExampleIIRFilter");
+        filter.getInputPorts()[0].connect(pipeline.fb.getSignals()[0]);
+        pipeline.outputReader = StreamReader(filter.getSignals()[0], SampleType::Float64, SampleType::Int64);
+    }
+    filter.setPropertyValue("Order", 4);
+    filter.setPropertyValue("CutoffFrequency", 1000);
+
+    sendBlock(pipeline, blockSize);
+    receiveBlock(pipeline, blockSize);
+
+    for (auto _ : state)
+    {
+        sendBlock(pipeline, blockSize);
+        receiveBlock(pipeline, blockSize);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * blockSize));
+}
+
+BENCHMARK_CAPTURE(BM_ScaleAndFilter, Chain, false)->RangeMultiplier(8)->Range(64, 1 << 16)->UseRealTime();
+BENCHMARK_CAPTURE(BM_ScaleAndFilter, Fused, true)->RangeMultiplier(8)->Range(64, 1 << 16)->UseRealTime();
+
+// Streams 1 ms blocks of a 1 MS/s signal through the scaling function block while another thread writes
+// the Scale and Offset properties as fast as it can (state.range(0) = 1), or not at all (0). Reports the
+// block latency percentiles in microseconds; property writes must not show up in the tail.
+static void BM_PropertyWritesDuringStreaming(benchmark::State& state)
+{
+    const SizeT blockSize = 1000;
+    const bool writeProperties = state.range(0) != 0;
+    auto pipeline = createPipeline("ExampleScalingModule", false, blockSize);
+
+    sendBlock(pipeline, blockSize);
+    receiveBlock(pipeline, blockSize);
+
+    std::atomic<bool> running{true};
+    std::atomic<SizeT> writeCount{0};
+    std::thread writer;
+    if (writeProperties)
+    {
+        writer = std::thread(
+            [&]
+            {
+                for (SizeT i = 0; running; ++i)
+                {
+                    pipeline.fb.setPropertyValue("Scale", 1.0 + static_cast<double>(i % 8));
+                    pipeline.fb.setPropertyValue("Offset", static_cast<double>(i % 3));
+                    writeCount += 2;
+                    std::this_thread::yield();
+                }
+            });
+    }
+
+    std::vector<double> latencies;
+    latencies.reserve(1 << 20);
+    for (auto _ : state)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        sendBlock(pipeline, blockSize);
+        receiveBlock(pipeline, blockSize);
+        latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    running = false;
+    if (writer.joinable())
+        writer.join();
+
+    setLatencyCounters(state, latencies);
+    state.counters["writes"] = static_cast<double>(writeCount.load());
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * blockSize));
+}
+
+BENCHMARK(BM_PropertyWritesDuringStreaming)->ArgName("writes")->Arg(0)->Arg(1)->UseRealTime();
+
+// Provisions state.range(0) connected FIR filters per iteration, writing five design properties on each,
+// one write at a time or in a single batch update per function block
+static void BM_Provisioning(benchmark::State& state, bool batched)
+{
+    const auto blockCount = static_cast<SizeT>(state.range(0));
+    const auto instance = Instance();
+
+    const auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).build();
+    const auto domainDescriptor = DataDescriptorBuilder()
+                                      .setSampleType(SampleType::Int64)
+                                      .setTickResolution(Ratio(1, 10000))
+                                      .setRule(LinearDataRule(1, 0))
+                                      .build();
+    const auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Data");
+    const auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "Domain");
+    signal.setDomainSignal(domainSignal);
+
+    std::vector<FunctionBlockPtr> fbs;
+    for (SizeT i = 0; i < blockCount; ++i)
+    {
+        fbs.push_back(instance.addFunctionBlock("ExampleFIRFilter"));
+        fbs.back().getInputPorts()[0].connect(signal);
+    }
+
+    Int iteration = 0;
+    for (auto _ : state)
+    {
+        // Alternating settings, so that every write changes the design
+        const Int variant = iteration++ % 2;
+        for (const auto& fb : fbs)
+        {
+            if (batched)
+                fb.beginUpdate();
+
+            fb.setPropertyValue("ResponseType", 2);
+            fb.setPropertyValue("TapCount", 255 + 2 * variant);
+            fb.setPropertyValue("Window", 1 + variant);
+            fb.setPropertyValue("CutoffFrequency", 100 + variant);
+            fb.setPropertyValue("UpperCutoffFrequency", 1000 + variant);
+
+            if (batched)
+                fb.endUpdate();
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * blockCount));
+}
+
+BENCHMARK_CAPTURE(BM_Provisioning, Individual, false)->Arg(100)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_Provisioning, Batched, true)->Arg(100)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Streams 16-sample packets through the scaling function block as fast as they can be sent, with
+// MinBlockSamples = state.range(0) and MaxHoldTime = state.range(1) microseconds. Reports the throughput
+// and the latency percentiles from sending a packet to reading its last scaled sample: larger minimum
+// blocks save per-block overhead, at the cost of holding samples back.
+static void BM_BlockPolicy(benchmark::State& state)
+{
+    const SizeT packetSize = 16;
+    auto pipeline = createPipeline("ExampleScalingModule", false, 1 << 16);
+    pipeline.fb.setPropertyValue("MinBlockSamples", state.range(0));
+    pipeline.fb.setPropertyValue("MaxHoldTime", static_cast<double>(state.range(1)) / 1000.0);
+
+    sendBlock(pipeline, packetSize);
+    receiveBlock(pipeline, packetSize);
+
+    std::deque<std::chrono::steady_clock::time_point> sendTimes;
+    std::vector<double> latencies;
+    latencies.reserve(1 << 20);
+    SizeT receivedSamples = 0;
+    SizeT completedPackets = 0;
+
+    const auto receiveAvailable = [&]
+    {
+        SizeT count = pipeline.outputData.size();
+        pipeline.outputReader.read(pipeline.outputData.data(), &count);
+        receivedSamples += count;
+
+        const auto now = std::chrono::steady_clock::now();
+        for (; completedPackets < receivedSamples / packetSize; ++completedPackets)
+        {
+            latencies.push_back(std::chrono::duration<double, std::micro>(now - sendTimes.front()).count());
+            sendTimes.pop_front();
+        }
+    };
+
+    for (auto _ : state)
+    {
+        sendTimes.push_back(std::chrono::steady_clock::now());
+        sendBlock(pipeline, packetSize);
+        receiveAvailable();
+    }
+
+    // Held samples are flushed by the hold time
+    while (!sendTimes.empty())
+    {
+        std::this_thread::yield();
+        receiveAvailable();
+    }
+
+    setLatencyCounters(state, latencies);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * packetSize));
+}
+
+BENCHMARK(BM_BlockPolicy)
+    ->ArgNames({"min", "hold_us"})
+    ->Args({1, 0})
+    ->Args({256, 100})
+    ->Args({256, 1000})
+    ->Args({4096, 100})
+    ->Args({4096, 1000})
+    ->UseRealTime();
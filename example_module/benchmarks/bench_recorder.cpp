@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+#include <example_module/recording_writer.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+using namespace daq;
+using namespace daq::modules::example_module;
+
+// Sustained recording: writes 256 MiB of Float64 blocks with a linear domain, paced to a target rate,
+// the way an acquisition thread delivers them. state.range(0) holds the block size in samples,
+// state.range(1) the segment size in MiB and state.range(2) the target rate in MB/s.
+//
+// "dropped" is the fraction of samples dropped because the flush thread fell behind; the highest rate
+// without drops is the rate the disk sustains. "writeUs" and "maxWriteUs" are the mean and worst time
+// of a write call, i.e. how long the acquisition thread is held up per block.
+static void BM_RecordingWriter(benchmark::State& state)
+{
+    using Clock = std::chrono::steady_clock;
+
+    const auto blockSize = static_cast<SizeT>(state.range(0));
+    const auto segmentSize = static_cast<SizeT>(state.range(1)) << 20;
+    const auto bytesPerSecond = static_cast<double>(state.range(2)) * 1e6;
+    const SizeT totalSize = SizeT(256) << 20;
+    const SizeT blockCount = totalSize / (blockSize * sizeof(double));
+
+    std::vector<double> values(blockSize);
+    std::iota(values.begin(), values.end(), 0.0);
+    const auto path = (std::filesystem::temp_directory_path() / "bench_recording_writer.daqrec").string();
+
+    SizeT samples = 0;
+    SizeT written = 0;
+    Clock::duration writeTime{};
+    Clock::duration maxWriteTime{};
+
+    for (auto _ : state)
+    {
+        RecordingWriter writer;
+        writer.open(path, {}, segmentSize, totalSize + segmentSize);
+
+        const auto start = Clock::now();
+        for (SizeT block = 0; block < blockCount; ++block)
+        {
+            const auto due = start + std::chrono::duration_cast<Clock::duration>(
+                                         std::chrono::duration<double>(static_cast<double>(block * blockSize * sizeof(double)) / bytesPerSecond));
+            std::this_thread::sleep_until(due);
+
+            const auto writeStart = Clock::now();
+            written += writer.writeData(values.data(), sizeof(double), nullptr, 0, blockSize, static_cast<Int>(block * blockSize), 1);
+            const auto duration = Clock::now() - writeStart;
+
+            writeTime += duration;
+            maxWriteTime = std::max(maxWriteTime, duration);
+            samples += blockSize;
+        }
+
+        writer.close();
+    }
+
+    std::filesystem::remove(path);
+
+    const auto blocks = static_cast<double>(state.iterations() * blockCount);
+    state.SetBytesProcessed(static_cast<int64_t>(written * sizeof(double)));
+    state.counters["dropped"] = 1.0 - static_cast<double>(written) / static_cast<double>(samples);
+    state.counters["writeUs"] = std::chrono::duration<double, std::micro>(writeTime).count() / blocks;
+    state.counters["maxWriteUs"] = std::chrono::duration<double, std::micro>(maxWriteTime).count();
+}
+
+BENCHMARK(BM_RecordingWriter)
+    ->ArgNames({"block", "segmentMiB", "MBps"})
+    ->ArgsProduct({{1024, 65536}, {4, 64}, {100, 400, 1600}})
+    ->Iterations(1)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
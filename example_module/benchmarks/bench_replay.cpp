@@ -0,0 +1,134 @@
+#include <benchmark/benchmark.h>
+#include <example_module/recording_reader.h>
+#include <example_module/recording_writer.h>
+#include <opendaq/opendaq.h>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+using namespace daq;
+using namespace daq::modules::example_module;
+
+namespace
+{
+    constexpr SizeT RecordedSamples = 1 << 24;
+
+    std::string getRecordingPath()
+    {
+        return (std::filesystem::temp_directory_path() / "bench_replay.daqrec").string();
+    }
+
+    std::string serialize(const DataDescriptorPtr& descriptor)
+    {
+        const auto serializer = JsonSerializer();
+        descriptor.asPtr<ISerializable>().serialize(serializer);
+        return serializer.getOutput().toStdString();
+    }
+
+    // 16M Float64 samples at 1 MHz in records of blockSize samples
+    void writeRecording(SizeT blockSize)
+    {
+        const auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).setValueRange(Range(0, 100)).build();
+        const auto domainDescriptor = DataDescriptorBuilder()
+                                          .setSampleType(SampleType::Int64)
+                                          .setUnit(Unit("s", -1, "seconds", "time"))
+                                          .setTickResolution(Ratio(1, 1000000))
+                                          .setRule(LinearDataRule(1, 0))
+                                          .setOrigin("1970-01-01T00:00:00+00:00")
+                                          .build();
+
+        std::vector<double> values(blockSize);
+        for (SizeT i = 0; i < blockSize; ++i)
+            values[i] = static_cast<double>(i % 100);
+
+        RecordingWriter writer;
+        writer.open(getRecordingPath(), {serialize(dataDescriptor), serialize(domainDescriptor)}, 64 << 20, RecordedSamples * 2 * sizeof(double));
+        for (SizeT offset = 0; offset < RecordedSamples; offset += blockSize)
+        {
+            // Retries the samples dropped while the flush thread maps the next segment
+            SizeT written = 0;
+            while (written < blockSize)
+            {
+                written += writer.writeData(
+                    values.data() + written, sizeof(double), nullptr, 0, blockSize - written, static_cast<Int>(offset + written), 1);
+                if (written < blockSize)
+                    std::this_thread::yield();
+            }
+        }
+    }
+}
+
+// Reads every record of the recording in place; state.range(0) holds the samples per record
+static void BM_RecordingReader(benchmark::State& state)
+{
+    const auto blockSize = static_cast<SizeT>(state.range(0));
+    writeRecording(blockSize);
+
+    RecordingReader reader;
+    reader.open(getRecordingPath());
+
+    for (auto _ : state)
+    {
+        reader.rewind();
+        double sum = 0.0;
+        RecordView record;
+        while (reader.next(record))
+        {
+            const auto* values = reinterpret_cast<const double*>(record.values);
+            for (SizeT i = 0; i < record.sampleCount; ++i)
+                sum += values[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    reader.close();
+    std::filesystem::remove(getRecordingPath());
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * RecordedSamples));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * RecordedSamples * sizeof(double)));
+}
+
+// Backfill: the whole recording, replayed as fast as possible through the IIR filter function block
+static void BM_ReplayIIRFilter(benchmark::State& state)
+{
+    const auto blockSize = static_cast<SizeT>(state.range(0));
+    writeRecording(blockSize);
+
+    const auto instance = Instance();
+    const auto replay = instance.addFunctionBlock("ExampleReplay");
+    replay.setPropertyValue("ReplaySpeed", 0.0);
+    replay.setPropertyValue("FilePath", getRecordingPath());
+
+    const auto filter = instance.addFunctionBlock("ExampleIIRFilter");
+    filter.getInputPorts()[0].connect(replay.getSignals()[0]);
+    auto outputReader = StreamReader(filter.getSignals()[0], SampleType::Float64, SampleType::Int64);
+
+    std::vector<double> output(blockSize);
+    const ProcedurePtr rewind = replay.getPropertyValue("Rewind");
+
+    for (auto _ : state)
+    {
+        rewind();
+        replay.setPropertyValue("Playing", True);
+
+        SizeT received = 0;
+        while (received < RecordedSamples)
+        {
+            SizeT count = blockSize;
+            outputReader.read(output.data(), &count);
+            received += count;
+            if (count == 0)
+                std::this_thread::yield();
+        }
+
+        replay.setPropertyValue("Playing", False);
+    }
+
+    outputReader.release();
+    replay.setPropertyValue("FilePath", "");
+    std::error_code error;
+    std::filesystem::remove(getRecordingPath(), error);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * RecordedSamples));
+}
+
+BENCHMARK(BM_RecordingReader)->Arg(1024)->Arg(65536);
+BENCHMARK(BM_ReplayIIRFilter)->Arg(1024)->Arg(65536)->Iterations(3)->UseRealTime()->Unit(benchmark::kMillisecond);
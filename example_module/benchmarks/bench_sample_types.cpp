@@ -0,0 +1,245 @@
+#include <benchmark/benchmark.h>
+#include <example_module/filter_design.h>
+#include <example_module/scaling_kernels.h>
+#include <example_module/sos_filter.h>
+#include <opendaq/opendaq.h>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace daq;
+using namespace daq::modules::example_module;
+
+// Coverage matrix of both function blocks over every input sample type accepted by configure(), block
+// sizes from 1 to 64k samples and channel counts: state.range(0) holds the block size, state.range(1)
+// the number of channels. The kernel benchmarks time the per-block work of the function blocks alone,
+// the pipeline benchmarks send every block through function blocks in a local instance and wait for
+// their output.
+
+namespace
+{
+    constexpr double SampleRate = 1000000.0;
+
+    template <typename T>
+    std::vector<T> createInput(SizeT count)
+    {
+        std::vector<T> input(count);
+        for (SizeT i = 0; i < count; ++i)
+            input[i] = static_cast<T>(i % 100);
+        return input;
+    }
+
+    // The default design of the IIR filter function block at the benchmark sample rate
+    FilterSpec createFilterSpec()
+    {
+        FilterSpec spec;
+        spec.sampleRate = SampleRate;
+        spec.cutoffFrequency = 5.0;
+        return spec;
+    }
+
+    struct PipelineChannel
+    {
+        FunctionBlockPtr fb;
+        SignalConfigPtr signal;
+        SignalConfigPtr domainSignal;
+        StreamReaderPtr outputReader;
+    };
+
+    // One function block per channel, each fed by its own signal
+    struct Pipeline
+    {
+        InstancePtr instance;
+        DataDescriptorPtr dataDescriptor;
+        DataDescriptorPtr domainDescriptor;
+        std::vector<PipelineChannel> channels;
+        std::vector<double> outputData;
+        SizeT domainOffset = 0;
+    };
+
+    Pipeline createPipeline(const std::string& fbId, SampleType sampleType, SizeT channelCount, SizeT blockSize)
+    {
+        Pipeline pipeline;
+        pipeline.instance = Instance();
+        pipeline.dataDescriptor = DataDescriptorBuilder().setSampleType(sampleType).setValueRange(Range(0, 100)).build();
+        pipeline.domainDescriptor = DataDescriptorBuilder()
+                                        .setSampleType(SampleType::Int64)
+                                        .setUnit(Unit("s", -1, "seconds", "time"))
+                                        .setTickResolution(Ratio(1, static_cast<Int>(SampleRate)))
+                                        .setRule(LinearDataRule(1, 0))
+                                        .setOrigin("1970-01-01T00:00:00+00:00")
+                                        .build();
+
+        const auto context = pipeline.instance.getContext();
+        for (SizeT i = 0; i < channelCount; ++i)
+        {
+            PipelineChannel channel;
+            channel.fb = pipeline.instance.addFunctionBlock(fbId);
+            channel.signal = SignalWithDescriptor(context, pipeline.dataDescriptor, nullptr, "Data" + std::to_string(i));
+            channel.domainSignal = SignalWithDescriptor(context, pipeline.domainDescriptor, nullptr, "Domain" + std::to_string(i));
+            channel.signal.setDomainSignal(channel.domainSignal);
+            channel.fb.getInputPorts()[0].connect(channel.signal);
+            channel.outputReader = StreamReader(channel.fb.getSignals()[0], SampleType::Float64, SampleType::Int64);
+            pipeline.channels.push_back(std::move(channel));
+        }
+
+        pipeline.outputData.resize(blockSize);
+        return pipeline;
+    }
+
+    template <typename T>
+    void sendBlock(Pipeline& pipeline, const std::vector<T>& input)
+    {
+        const SizeT blockSize = input.size();
+        for (const auto& channel : pipeline.channels)
+        {
+            const auto domainPacket = DataPacket(pipeline.domainDescriptor, blockSize, pipeline.domainOffset);
+            const auto packet = DataPacketWithDomain(domainPacket, pipeline.dataDescriptor, blockSize);
+            std::memcpy(packet.getRawData(), input.data(), blockSize * sizeof(T));
+
+            channel.signal.sendPacket(packet);
+            channel.domainSignal.sendPacket(domainPacket);
+        }
+        pipeline.domainOffset += blockSize;
+    }
+
+    // Waits until every function block has produced the whole block and consumes it
+    void receiveBlock(Pipeline& pipeline, SizeT blockSize)
+    {
+        for (auto& channel : pipeline.channels)
+        {
+            SizeT received = 0;
+            while (received < blockSize)
+            {
+                SizeT count = blockSize - received;
+                channel.outputReader.read(pipeline.outputData.data(), &count);
+                received += count;
+                if (count == 0)
+                    std::this_thread::yield();
+            }
+        }
+    }
+
+    template <SampleType InputType>
+    void runPipeline(benchmark::State& state, const std::string& fbId)
+    {
+        using InputT = typename SampleTypeToType<InputType>::Type;
+
+        const auto blockSize = static_cast<SizeT>(state.range(0));
+        const auto channelCount = static_cast<SizeT>(state.range(1));
+        const auto input = createInput<InputT>(blockSize);
+        auto pipeline = createPipeline(fbId, InputType, channelCount, blockSize);
+
+        // Warm-up block, also consumes the descriptor changed events
+        sendBlock(pipeline, input);
+        receiveBlock(pipeline, blockSize);
+
+        for (auto _ : state)
+        {
+            sendBlock(pipeline, input);
+            receiveBlock(pipeline, blockSize);
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * blockSize * channelCount));
+    }
+}
+
+// Scaling function block: the scaling kernel of the input sample type
+template <SampleType InputType>
+static void BM_ScalingKernel(benchmark::State& state)
+{
+    using InputT = typename SampleTypeToType<InputType>::Type;
+
+    const auto blockSize = static_cast<SizeT>(state.range(0));
+    const auto channelCount = static_cast<SizeT>(state.range(1));
+    const auto input = createInput<InputT>(blockSize * channelCount);
+    std::vector<Float> output(blockSize * channelCount);
+    const auto kernel = getScalingKernel(InputType);
+
+    for (auto _ : state)
+    {
+        for (SizeT channel = 0; channel < channelCount; ++channel)
+            kernel(input.data() + channel * blockSize, output.data() + channel * blockSize, blockSize, 2.0, 1.0);
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * blockSize * channelCount));
+}
+
+// IIR filter function block: the reader's conversion to Float64 followed by the default filter design
+template <SampleType InputType>
+static void BM_IIRKernel(benchmark::State& state)
+{
+    using InputT = typename SampleTypeToType<InputType>::Type;
+
+    const auto blockSize = static_cast<SizeT>(state.range(0));
+    const auto channelCount = static_cast<SizeT>(state.range(1));
+    const auto input = createInput<InputT>(blockSize * channelCount);
+    std::vector<double> converted(blockSize);
+    std::vector<double> output(blockSize * channelCount);
+    std::vector<SosFilter> filters(channelCount, SosFilter(designSosFilter(createFilterSpec())));
+
+    for (auto _ : state)
+    {
+        for (SizeT channel = 0; channel < channelCount; ++channel)
+        {
+            const InputT* in = input.data() + channel * blockSize;
+            for (SizeT i = 0; i < blockSize; ++i)
+                converted[i] = static_cast<double>(in[i]);
+            filters[channel].process(converted.data(), output.data() + channel * blockSize, blockSize);
+        }
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * blockSize * channelCount));
+}
+
+template <SampleType InputType>
+static void BM_ScalingPipeline(benchmark::State& state)
+{
+    runPipeline<InputType>(state, "ExampleScalingModule");
+}
+
+template <SampleType InputType>
+static void BM_IIRPipeline(benchmark::State& state)
+{
+    runPipeline<InputType>(state, "ExampleIIRFilter");
+}
+
+static void kernelArguments(benchmark::internal::Benchmark* bench)
+{
+    bench->ArgNames({"block", "channels"});
+    for (const int64_t channels : {1, 8, 64})
+        for (int64_t blockSize = 1; blockSize <= (1 << 16); blockSize *= 4)
+            bench->Args({blockSize, channels});
+}
+
+// Every block is a round trip through the scheduler, so the pipelines use fewer points
+static void pipelineArguments(benchmark::internal::Benchmark* bench)
+{
+    bench->ArgNames({"block", "channels"});
+    for (const int64_t channels : {1, 8})
+        for (const int64_t blockSize : {1, 64, 4096, 1 << 16})
+            bench->Args({blockSize, channels});
+    bench->UseRealTime();
+}
+
+#define SAMPLE_TYPE_BENCHMARKS(InputType)                                                \
+    BENCHMARK_TEMPLATE(BM_ScalingKernel, InputType)->Apply(kernelArguments);            \
+    BENCHMARK_TEMPLATE(BM_IIRKernel, InputType)->Apply(kernelArguments);                \
+    BENCHMARK_TEMPLATE(BM_ScalingPipeline, InputType)->Apply(pipelineArguments);        \
+    BENCHMARK_TEMPLATE(BM_IIRPipeline, InputType)->Apply(pipelineArguments)
+
+SAMPLE_TYPE_BENCHMARKS(SampleType::Float64);
+SAMPLE_TYPE_BENCHMARKS(SampleType::Float32);
+SAMPLE_TYPE_BENCHMARKS(SampleType::Int8);
+SAMPLE_TYPE_BENCHMARKS(SampleType::Int16);
+SAMPLE_TYPE_BENCHMARKS(SampleType::Int32);
+SAMPLE_TYPE_BENCHMARKS(SampleType::Int64);
+SAMPLE_TYPE_BENCHMARKS(SampleType::UInt8);
+SAMPLE_TYPE_BENCHMARKS(SampleType::UInt16);
+SAMPLE_TYPE_BENCHMARKS(SampleType::UInt32);
+SAMPLE_TYPE_BENCHMARKS(SampleType::UInt64);
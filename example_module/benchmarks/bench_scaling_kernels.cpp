@@ -0,0 +1,157 @@
+#include <benchmark/benchmark.h>
+#include <example_module/processing_statistics.h>
+#include <example_module/scaling_kernels.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace daq;
+using namespace daq::modules::example_module;
+
+namespace
+{
+    template <typename T>
+    std::vector<T> createInput(SizeT count)
+    {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<double> dist(-1000.0, 1000.0);
+
+        std::vector<T> input(count);
+        for (auto& value : input)
+            value = static_cast<T>(dist(gen));
+        return input;
+    }
+}
+
+// Previous path: the reader converts the input to Float32, the scaling loop widens it again to Float64
+template <SampleType InputType>
+static void BM_ScaleViaFloat32(benchmark::State& state)
+{
+    using InputT = typename SampleTypeToType<InputType>::Type;
+
+    const auto count = static_cast<SizeT>(state.range(0));
+    const auto input = createInput<InputT>(count);
+    std::vector<float> converted(count);
+    std::vector<Float> output(count);
+
+    for (auto _ : state)
+    {
+        for (SizeT i = 0; i < count; ++i)
+            converted[i] = static_cast<float>(input[i]);
+        scaleSamples<SampleType::Float32>(converted.data(), output.data(), count, 2.0, 1.0);
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * count * sizeof(InputT)));
+}
+
+// Native path: a single pass reads the input sample type and writes Float64
+template <SampleType InputType>
+static void BM_ScaleNative(benchmark::State& state)
+{
+    using InputT = typename SampleTypeToType<InputType>::Type;
+
+    const auto count = static_cast<SizeT>(state.range(0));
+    const auto input = createInput<InputT>(count);
+    std::vector<Float> output(count);
+    const auto kernel = getScalingKernel(InputType);
+
+    for (auto _ : state)
+    {
+        kernel(input.data(), output.data(), count, 2.0, 1.0);
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * count * sizeof(InputT)));
+}
+
+BENCHMARK_TEMPLATE(BM_ScaleViaFloat32, SampleType::Int16)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_ScaleNative, SampleType::Int16)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_ScaleViaFloat32, SampleType::Float64)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_ScaleNative, SampleType::Float64)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+
+// Explicit SIMD level, state.range(1) holds the SimdLevel
+template <SampleType InputType>
+static void BM_ScaleSimdLevel(benchmark::State& state)
+{
+    using InputT = typename SampleTypeToType<InputType>::Type;
+
+    const auto count = static_cast<SizeT>(state.range(0));
+    const auto level = static_cast<SimdLevel>(state.range(1));
+    if (level > getSimdLevel())
+    {
+        state.SkipWithError("SIMD level not supported by this CPU");
+        return;
+    }
+
+    const auto input = createInput<InputT>(count);
+    std::vector<Float> output(count);
+    const auto kernel = getScalingKernel(InputType, level);
+    state.SetLabel(simdLevelName(level));
+
+    for (auto _ : state)
+    {
+        kernel(input.data(), output.data(), count, 2.0, 1.0);
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+
+static void simdLevelArguments(benchmark::internal::Benchmark* bench)
+{
+    for (const auto level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512})
+        bench->Args({4096, static_cast<int64_t>(level)});
+}
+
+BENCHMARK_TEMPLATE(BM_ScaleSimdLevel, SampleType::Int16)->Apply(simdLevelArguments);
+BENCHMARK_TEMPLATE(BM_ScaleSimdLevel, SampleType::Int32)->Apply(simdLevelArguments);
+BENCHMARK_TEMPLATE(BM_ScaleSimdLevel, SampleType::Int64)->Apply(simdLevelArguments);
+BENCHMARK_TEMPLATE(BM_ScaleSimdLevel, SampleType::Float32)->Apply(simdLevelArguments);
+BENCHMARK_TEMPLATE(BM_ScaleSimdLevel, SampleType::Float64)->Apply(simdLevelArguments);
+
+// Cost of the always-on statistics: the same Float64 stream scaled in blocks of state.range(0) samples,
+// with (state.range(1) = 1) or without the per-block timestamps and counter updates the function
+// blocks do. The difference between the two must stay below 1% down to small blocks.
+static void BM_ScaleBlocksStatistics(benchmark::State& state)
+{
+    constexpr SizeT StreamLength = 1 << 20;
+
+    const auto blockSize = static_cast<SizeT>(state.range(0));
+    const bool withStatistics = state.range(1) != 0;
+    const auto input = createInput<Float>(StreamLength);
+    std::vector<Float> output(StreamLength);
+    const auto kernel = getScalingKernel(SampleType::Float64);
+    ProcessingStatistics statistics;
+    state.SetLabel(withStatistics ? "statistics" : "plain");
+
+    for (auto _ : state)
+    {
+        for (SizeT offset = 0; offset < StreamLength; offset += blockSize)
+        {
+            const SizeT count = std::min(blockSize, StreamLength - offset);
+            if (withStatistics)
+            {
+                const auto start = ProcessingStatistics::Clock::now();
+                statistics.recordBacklog(StreamLength - offset);
+                kernel(input.data() + offset, output.data() + offset, count, 2.0, 1.0);
+                statistics.recordBlock(count, count, 0, 1, ProcessingStatistics::Clock::now() - start);
+            }
+            else
+            {
+                kernel(input.data() + offset, output.data() + offset, count, 2.0, 1.0);
+            }
+        }
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * StreamLength));
+}
+
+BENCHMARK(BM_ScaleBlocksStatistics)->ArgNames({"block", "statistics"})->ArgsProduct({{256, 1024, 4096, 65536}, {0, 1}});
@@ -0,0 +1,154 @@
+#include <benchmark/benchmark.h>
+#include <example_module/filter_design.h>
+#include <example_module/parallel_sos_filter.h>
+#include <example_module/sos_filter.h>
+#include <example_module/sos_filter_bank.h>
+#include <random>
+#include <vector>
+
+using namespace daq;
+using namespace daq::modules::example_module;
+
+// Filters one block per iteration; state.range(0) holds the block size, state.range(1) the filter order.
+// The "section" counter reports the time per sample and section.
+static void BM_SosFilter(benchmark::State& state, FilterFamily family, FilterResponse response)
+{
+    const auto blockSize = static_cast<SizeT>(state.range(0));
+
+    FilterSpec spec;
+    spec.family = family;
+    spec.response = response;
+    spec.order = static_cast<SizeT>(state.range(1));
+    spec.sampleRate = 100000.0;
+    spec.cutoffFrequency = 1000.0;
+    spec.upperCutoffFrequency = 5000.0;
+
+    SosFilter filter(designSosFilter(spec));
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> input(blockSize);
+    for (auto& value : input)
+        value = dist(gen);
+    std::vector<double> output(blockSize);
+
+    for (auto _ : state)
+    {
+        filter.process(input.data(), output.data(), blockSize);
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    const auto sections = filter.getSectionCount();
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * blockSize));
+    state.counters["sections"] = static_cast<double>(sections);
+    state.counters["section"] = benchmark::Counter(static_cast<double>(blockSize * sections),
+                                                   benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+static void sosArguments(benchmark::internal::Benchmark* bench)
+{
+    for (const int64_t blockSize : {1024, 1 << 16})
+        for (const int64_t order : {1, 2, 4, 8, 16})
+            bench->Args({blockSize, order});
+}
+
+BENCHMARK_CAPTURE(BM_SosFilter, ButterworthLowPass, FilterFamily::Butterworth, FilterResponse::LowPass)->Apply(sosArguments);
+BENCHMARK_CAPTURE(BM_SosFilter, ChebyshevIIHighPass, FilterFamily::ChebyshevII, FilterResponse::HighPass)->Apply(sosArguments);
+BENCHMARK_CAPTURE(BM_SosFilter, BesselBandPass, FilterFamily::Bessel, FilterResponse::BandPass)->Apply(sosArguments);
+
+namespace
+{
+    std::vector<BiquadCoefficients> designBankFilter()
+    {
+        FilterSpec spec;
+        spec.order = 4;
+        spec.sampleRate = 100000.0;
+        spec.cutoffFrequency = 1000.0;
+        return designSosFilter(spec);
+    }
+}
+
+// One SosFilter per channel, state.range(0) holds the channel count
+static void BM_SeparateChannelFilters(benchmark::State& state)
+{
+    const auto channelCount = static_cast<SizeT>(state.range(0));
+    const SizeT blockSize = 1024;
+
+    std::vector<SosFilter> filters(channelCount, SosFilter(designBankFilter()));
+    std::vector<std::vector<double>> data(channelCount, std::vector<double>(blockSize, 0.5));
+
+    for (auto _ : state)
+    {
+        for (SizeT channel = 0; channel < channelCount; ++channel)
+            filters[channel].process(data[channel].data(), data[channel].data(), blockSize);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * blockSize * channelCount));
+}
+
+// All channels in one SosFilterBank, filtered across channels with the given SIMD level (state.range(1))
+static void BM_FilterBank(benchmark::State& state)
+{
+    const auto channelCount = static_cast<SizeT>(state.range(0));
+    const auto level = static_cast<SimdLevel>(state.range(1));
+    const SizeT blockSize = 1024;
+    if (level > getSimdLevel())
+    {
+        state.SkipWithError("SIMD level not supported by this CPU");
+        return;
+    }
+
+    SosFilterBank bank;
+    bank.setSimdLevel(level);
+    bank.setChannels(std::vector<std::vector<BiquadCoefficients>>(channelCount, designBankFilter()));
+    std::vector<double> data(blockSize * bank.getStride(), 0.5);
+    state.SetLabel(simdLevelName(level));
+
+    for (auto _ : state)
+    {
+        bank.process(data.data(), blockSize);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * blockSize * channelCount));
+}
+
+BENCHMARK(BM_SeparateChannelFilters)->Arg(8)->Arg(64)->Arg(256);
+BENCHMARK(BM_FilterBank)->ArgsProduct({{8, 64, 256}, {0, 1, 2, 3}});
+
+// One high-rate channel filtered in blocks of 8 segments, state.range(0) holds the thread count
+// (1 filters serially) and state.range(1) the filter order. Uses real time, the work runs on the pool.
+static void BM_ParallelSosFilter(benchmark::State& state)
+{
+    const auto threadCount = static_cast<SizeT>(state.range(0));
+
+    FilterSpec spec;
+    spec.order = static_cast<SizeT>(state.range(1));
+    spec.sampleRate = 10e6;
+    spec.cutoffFrequency = 100e3;
+
+    ParallelSosFilter filter;
+    filter.setSections(designSosFilter(spec));
+    filter.setWorkerPool(std::make_shared<WorkerPool>(threadCount));
+    const SizeT blockSize = 8 * filter.getSegmentSize();
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> input(blockSize);
+    for (auto& value : input)
+        value = dist(gen);
+    std::vector<double> output(blockSize);
+
+    for (auto _ : state)
+    {
+        filter.process(input.data(), output.data(), blockSize);
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * blockSize));
+}
+
+BENCHMARK(BM_ParallelSosFilter)->ArgsProduct({{1, 2, 4, 8}, {2, 8}})->UseRealTime();
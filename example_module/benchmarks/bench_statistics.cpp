@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+#include <example_module/window_statistics.h>
+#include <random>
+#include <vector>
+
+using namespace daq;
+using namespace daq::modules::example_module;
+
+namespace
+{
+    std::vector<double> createInput(SizeT count)
+    {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<double> dist(-10.0, 10.0);
+
+        std::vector<double> input(count);
+        for (auto& value : input)
+            value = dist(gen);
+        return input;
+    }
+}
+
+// Moments of one tile, state.range(1) holds the SimdLevel
+static void BM_Moments(benchmark::State& state)
+{
+    const auto count = static_cast<SizeT>(state.range(0));
+    const auto level = static_cast<SimdLevel>(state.range(1));
+    if (level > getSimdLevel())
+    {
+        state.SkipWithError("SIMD level not supported by this CPU");
+        return;
+    }
+
+    const auto input = createInput(count);
+    const MomentsKernel kernel(level);
+    state.SetLabel(simdLevelName(level));
+
+    for (auto _ : state)
+    {
+        auto moments = kernel(input.data(), count);
+        benchmark::DoNotOptimize(moments);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+
+// One pass over the samples of a window per hop, as a block without the segment ring would compute
+// overlapping windows; state.range(0) is the window and state.range(1) the hop
+static void BM_WindowStatisticsRecompute(benchmark::State& state)
+{
+    const SizeT count = 1 << 20;
+    const auto window = static_cast<SizeT>(state.range(0));
+    const auto hop = static_cast<SizeT>(state.range(1));
+    const auto input = createInput(count);
+    const MomentsKernel kernel;
+
+    for (auto _ : state)
+    {
+        for (SizeT start = 0; start + window <= count; start += hop)
+        {
+            Moments moments;
+            for (SizeT i = 0; i < window; i += WindowStatistics::TileSize)
+                mergeMoments(moments, kernel(input.data() + start + i, std::min(WindowStatistics::TileSize, window - i)));
+            benchmark::DoNotOptimize(moments);
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+
+static void BM_WindowStatistics(benchmark::State& state)
+{
+    const SizeT count = 1 << 20;
+    const auto input = createInput(count);
+
+    WindowStatistics statistics;
+    statistics.configure(static_cast<SizeT>(state.range(0)), static_cast<SizeT>(state.range(1)));
+
+    for (auto _ : state)
+    {
+        statistics.reset();
+        statistics.process(input.data(), count, [](const WindowResult& result) { benchmark::DoNotOptimize(result); });
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+
+static void simdLevelArguments(benchmark::internal::Benchmark* bench)
+{
+    for (const auto level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512})
+        bench->Args({static_cast<int64_t>(WindowStatistics::TileSize), static_cast<int64_t>(level)});
+}
+
+BENCHMARK(BM_Moments)->Apply(simdLevelArguments);
+BENCHMARK(BM_WindowStatisticsRecompute)->Args({1000, 1000})->Args({10000, 100});
+BENCHMARK(BM_WindowStatistics)->Args({1000, 1000})->Args({10000, 100});
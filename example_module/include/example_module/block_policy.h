@@ -0,0 +1,89 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+#include <example_module/common.h>
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Decides how many of the samples waiting in a reader a function block processes now. Blocks of fewer
+// than the minimum are held to save the per-block overhead of tiny upstream packets, until more samples
+// arrive or the oldest held block has waited for the maximum hold time; blocks never exceed the maximum.
+// A minimum of 1 processes every sample as soon as it arrives.
+class BlockPolicy
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    void setLimits(SizeT minSamples, SizeT maxSamples, Clock::duration maxHoldTime)
+    {
+        maxBlock = std::max<SizeT>(maxSamples, 1);
+        minBlock = std::clamp<SizeT>(minSamples, 1, maxBlock);
+        holdTime = maxHoldTime;
+    }
+
+    SizeT getMinSamples() const
+    {
+        return minBlock;
+    }
+
+    SizeT getMaxSamples() const
+    {
+        return maxBlock;
+    }
+
+    // Number of samples to read out of available; 0 holds them. The hold time is counted from the
+    // first call that held the pending samples.
+    SizeT getReadAmount(SizeT available, Clock::time_point now)
+    {
+        if (available >= minBlock || available == 0)
+        {
+            holding = false;
+            return std::min(available, maxBlock);
+        }
+
+        if (!holding)
+        {
+            holding = true;
+            holdStart = now;
+        }
+
+        if (now - holdStart < holdTime)
+            return 0;
+
+        holding = false;
+        return available;
+    }
+
+    // Time at which held samples are due; only meaningful after getReadAmount held samples
+    Clock::time_point getDeadline() const
+    {
+        return holdStart + holdTime;
+    }
+
+private:
+    SizeT minBlock = 1;
+    SizeT maxBlock = std::numeric_limits<SizeT>::max();
+    Clock::duration holdTime = Clock::duration::zero();
+    Clock::time_point holdStart;
+    bool holding = false;
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+#include <example_module/block_policy.h>
+#include <example_module/common.h>
+#include <example_module/processing_statistics.h>
+#include <opendaq/opendaq.h>
+#include <cstdint>
+#include <functional>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+static constexpr Int DefaultMaxBlockSamples = 65536;
+static constexpr Int MaxBlockSamplesLimit = 1 << 24;
+static constexpr double DefaultMaxHoldTime = 10.0;
+
+// Where a function block processes its input: as a task of the instance's scheduler, inline on the thread
+// that sends the input packets, or on a dedicated thread of its own
+enum class ExecutionMode
+{
+    Scheduler = 0,
+    SameThread,
+    WorkerThread
+};
+
+struct BlockLimits
+{
+    SizeT minSamples = 1;
+    SizeT maxSamples = DefaultMaxBlockSamples;
+    BlockPolicy::Clock::duration maxHoldTime{};
+};
+
+// Adds the block policy properties (MinBlockSamples, MaxBlockSamples and MaxHoldTime in milliseconds) and
+// the read-only MemoryUsage property; onChanged is invoked whenever one of the policy properties is written,
+// or once at the end of a batch update
+void addBlockPolicyProperties(PropertyObjectPtr& objPtr, const std::function<void()>& onChanged);
+
+BlockLimits readBlockPolicyProperties(const PropertyObjectPtr& objPtr);
+
+// Adds the ExecutionMode selection and the CpuAffinity mask of the worker thread; onChanged is invoked
+// whenever one of them is written, or once at the end of a batch update
+void addExecutionProperties(PropertyObjectPtr& objPtr, const std::function<void()>& onChanged);
+
+ExecutionMode readExecutionMode(const PropertyObjectPtr& objPtr);
+uint64_t readCpuAffinity(const PropertyObjectPtr& objPtr);
+
+// Input port notification that matches the execution mode; a worker thread is notified from the sending thread
+PacketReadyNotification getNotificationMethod(ExecutionMode mode);
+
+// Adds the read-only Statistics object with the counters of statistics (SamplesIn, SamplesOut, PacketsIn,
+// PacketsOut, Events, Blocks, BusyTimeNs, MaxBacklog, Reconfigurations and the ProcessingTimeHistogram
+// list) and its Reset procedure. The counters are read when the properties are read.
+void addStatisticsProperty(PropertyObjectPtr& objPtr, ProcessingStatistics& statistics);
+
+// Adds the Tracing switch and the DumpTrace function, which returns the spans of all traced function blocks
+// in the Chrome trace event format; onChanged is invoked whenever Tracing is written
+void addTracingProperties(PropertyObjectPtr& objPtr, const std::function<void()>& onChanged);
+
+bool readTracingEnabled(const PropertyObjectPtr& objPtr);
+
+// Publishes the bytes of state and scratch memory a function block needs in its MemoryUsage property
+void setMemoryUsage(const PropertyObjectPtr& objPtr, SizeT bytes);
+
+END_NAMESPACE_EXAMPLE_MODULE
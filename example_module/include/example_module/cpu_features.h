@@ -0,0 +1,127 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <example_module/common.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define EXAMPLE_MODULE_SIMD_X86 1
+#else
+    #define EXAMPLE_MODULE_SIMD_X86 0
+#endif
+
+#if EXAMPLE_MODULE_SIMD_X86
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+    #endif
+    #include <immintrin.h>
+#endif
+
+// MSVC allows intrinsics of any instruction set without compiler flags, GCC and Clang
+// need the instruction set enabled per function.
+#if EXAMPLE_MODULE_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+    #define EXAMPLE_MODULE_TARGET_SSE2 __attribute__((target("sse2")))
+    #define EXAMPLE_MODULE_TARGET_AVX2 __attribute__((target("avx2")))
+    #define EXAMPLE_MODULE_TARGET_AVX512 __attribute__((target("avx512f,avx512dq,avx512vl,avx2")))
+#else
+    #define EXAMPLE_MODULE_TARGET_SSE2
+    #define EXAMPLE_MODULE_TARGET_AVX2
+    #define EXAMPLE_MODULE_TARGET_AVX512
+#endif
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+enum class SimdLevel
+{
+    Scalar = 0,
+    SSE2,
+    AVX2,
+    AVX512
+};
+
+inline const char* simdLevelName(SimdLevel level)
+{
+    switch (level)
+    {
+        case SimdLevel::SSE2:
+            return "SSE2";
+        case SimdLevel::AVX2:
+            return "AVX2";
+        case SimdLevel::AVX512:
+            return "AVX512";
+        default:
+            return "Scalar";
+    }
+}
+
+// Queries CPUID (and the OS support for the extended register state) for the highest usable level
+inline SimdLevel detectSimdLevel()
+{
+#if EXAMPLE_MODULE_SIMD_X86
+    #if defined(_MSC_VER) && !defined(__clang__)
+    int regs[4];
+    __cpuid(regs, 0);
+    const int maxLeaf = regs[0];
+
+    __cpuid(regs, 1);
+    const bool sse2 = (regs[3] & (1 << 26)) != 0;
+    const bool osxsave = (regs[2] & (1 << 27)) != 0;
+    const bool avx = (regs[2] & (1 << 28)) != 0;
+    if (!sse2)
+        return SimdLevel::Scalar;
+    if (!osxsave || !avx || maxLeaf < 7)
+        return SimdLevel::SSE2;
+
+    const auto xcr0 = _xgetbv(0);
+    const bool ymmState = (xcr0 & 0x6) == 0x6;
+    const bool zmmState = (xcr0 & 0xe6) == 0xe6;
+
+    __cpuidex(regs, 7, 0);
+    const bool avx2 = (regs[1] & (1 << 5)) != 0;
+    const bool avx512f = (regs[1] & (1 << 16)) != 0;
+    const bool avx512dq = (regs[1] & (1 << 17)) != 0;
+    const bool avx512vl = (regs[1] & (1 << 31)) != 0;
+
+    if (zmmState && avx512f && avx512dq && avx512vl && avx2)
+        return SimdLevel::AVX512;
+    if (ymmState && avx2)
+        return SimdLevel::AVX2;
+    return SimdLevel::SSE2;
+    #else
+    // libgcc / compiler-rt also verify that the OS saves the extended register state
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl") &&
+        __builtin_cpu_supports("avx2"))
+        return SimdLevel::AVX512;
+    if (__builtin_cpu_supports("avx2"))
+        return SimdLevel::AVX2;
+    if (__builtin_cpu_supports("sse2"))
+        return SimdLevel::SSE2;
+    return SimdLevel::Scalar;
+    #endif
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+// Detected once per process
+inline SimdLevel getSimdLevel()
+{
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,174 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+#include <example_module/common.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Calls a function at a deadline, e.g. to flush a block held by a BlockPolicy when no more samples
+// arrive. All timers share one thread, which runs while any timer exists; the callbacks must be short
+// or hand their work off.
+class DeadlineTimer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit DeadlineTimer(std::function<void()> callback)
+        : target(std::make_shared<Target>())
+    {
+        target->callback = std::move(callback);
+    }
+
+    DeadlineTimer(const DeadlineTimer&) = delete;
+    DeadlineTimer& operator=(const DeadlineTimer&) = delete;
+
+    // Waits for a running callback, so the callback may use its owner until the timer is destroyed
+    ~DeadlineTimer()
+    {
+        std::scoped_lock lock(target->mutex);
+        target->callback = nullptr;
+    }
+
+    // Calls the callback at deadline, unless a call is already pending
+    void schedule(Clock::time_point deadline)
+    {
+        if (target->scheduled.exchange(true))
+            return;
+
+        if (!service)
+            service = Service::get();
+        service->add(deadline, target);
+    }
+
+private:
+    struct Target
+    {
+        std::mutex mutex;
+        std::function<void()> callback;
+        std::atomic<bool> scheduled{false};
+    };
+
+    class Service
+    {
+    public:
+        Service()
+            : thread([this] { run(); })
+        {
+        }
+
+        ~Service()
+        {
+            {
+                std::scoped_lock lock(mutex);
+                stopping = true;
+            }
+            wakeUp.notify_one();
+            thread.join();
+        }
+
+        static std::shared_ptr<Service> get()
+        {
+            static std::mutex instanceMutex;
+            static std::weak_ptr<Service> instance;
+
+            std::scoped_lock lock(instanceMutex);
+            auto service = instance.lock();
+            if (!service)
+            {
+                service = std::make_shared<Service>();
+                instance = service;
+            }
+            return service;
+        }
+
+        void add(Clock::time_point deadline, const std::weak_ptr<Target>& target)
+        {
+            {
+                std::scoped_lock lock(mutex);
+                entries.push({deadline, target});
+            }
+            wakeUp.notify_one();
+        }
+
+    private:
+        struct Entry
+        {
+            Clock::time_point deadline;
+            std::weak_ptr<Target> target;
+
+            bool operator>(const Entry& other) const
+            {
+                return deadline > other.deadline;
+            }
+        };
+
+        void run()
+        {
+            std::unique_lock lock(mutex);
+            while (!stopping)
+            {
+                if (entries.empty())
+                {
+                    wakeUp.wait(lock);
+                    continue;
+                }
+
+                const auto deadline = entries.top().deadline;
+                if (Clock::now() < deadline)
+                {
+                    wakeUp.wait_until(lock, deadline);
+                    continue;
+                }
+
+                const auto target = entries.top().target.lock();
+                entries.pop();
+                if (!target)
+                    continue;
+
+                lock.unlock();
+                {
+                    std::scoped_lock targetLock(target->mutex);
+                    target->scheduled = false;
+                    if (target->callback)
+                        target->callback();
+                }
+                lock.lock();
+            }
+        }
+
+        std::mutex mutex;
+        std::condition_variable wakeUp;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> entries;
+        bool stopping = false;
+        std::thread thread;
+    };
+
+    std::shared_ptr<Target> target;
+    std::shared_ptr<Service> service;
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
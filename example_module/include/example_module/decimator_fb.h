@@ -0,0 +1,61 @@
+#pragma once
+#include <example_module/common.h>
+#include <example_module/output_packet_pool.h>
+#include <example_module/polyphase_decimator.h>
+#include <example_module/stream_input.h>
+#include <opendaq/function_block_impl.h>
+#include <opendaq/opendaq.h>
+#include <opendaq/stream_reader_ptr.h>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Low-pass filters and downsamples by an integer factor with a polyphase FIR filter. The output domain
+// keeps the input's linear rule with the delta scaled by the factor; output m is aligned with input
+// sample m * factor.
+class DecimatorFBImpl final : public FunctionBlock
+{
+public:
+    explicit DecimatorFBImpl(const ContextPtr& ctx,
+                             const ComponentPtr& parent,
+                             const StringPtr& localId,
+                             const PropertyObjectPtr& config = nullptr);
+    static FunctionBlockTypePtr CreateType();
+
+private:
+    static constexpr SizeT ReadBlockSize = 8192;
+    static constexpr Int MaxDecimationFactor = 1024;
+    static constexpr Int MaxTapsPerPhase = 64;
+
+    InputPortPtr inputPort;
+    SignalConfigPtr outputSignal;
+    SignalConfigPtr outputDomainSignal;
+    OutputPacketPool outputPacketPool;
+    StreamReaderPtr reader;
+
+    std::vector<double> inputData;
+    DomainOffsetTracker domainOffsets;
+
+    PolyphaseDecimator decimator;
+    SizeT decimationFactor = 1;
+    SizeT tapsPerPhase = 1;
+
+    bool configValid = false;
+
+    DataDescriptorPtr inputDataDescriptor;
+    DataDescriptorPtr inputDomainDataDescriptor;
+    DataDescriptorPtr outputDataDescriptor;
+    DataDescriptorPtr outputDomainDataDescriptor;
+
+    void createInputPorts();
+    void createSignals();
+    void initProperties();
+    void readProperties();
+    void propertyChanged();
+    void configure();
+
+    void calculate();
+    void processData(SizeT readAmount, SizeT packetOffset);
+    void processEventPacket(const EventPacketPtr& packet);
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -16,6 +16,13 @@
 
 #pragma once
 #include <example_module/common.h>
+#include <example_module/input_processing.h>
+#include <example_module/output_packet_pool.h>
+#include <example_module/processing_statistics.h>
+#include <example_module/scaling_kernels.h>
+#include <example_module/scaling_properties.h>
+#include <example_module/scratch_arena.h>
+#include <example_module/trace_recorder.h>
 #include <opendaq/function_block_impl.h>
 #include <opendaq/opendaq.h>
 #include <opendaq/stream_reader_ptr.h>
@@ -25,13 +32,16 @@ BEGIN_NAMESPACE_EXAMPLE_MODULE
 class ExampleFBImpl final : public FunctionBlock
 {
 public:
-    explicit ExampleFBImpl(const ContextPtr& ctx, const ComponentPtr& parent, const StringPtr& localId);
+    explicit ExampleFBImpl(const ContextPtr& ctx,
+                           const ComponentPtr& parent,
+                           const StringPtr& localId,
+                           const PropertyObjectPtr& config = nullptr);
     ~ExampleFBImpl() override = default;
 
     static FunctionBlockTypePtr CreateType();
 
 private:
-    InputPortPtr inputPort;
+    InputPortConfigPtr inputPort;
 
     DataDescriptorPtr inputDataDescriptor;
     DataDescriptorPtr inputDomainDataDescriptor;
@@ -40,38 +50,44 @@ private:
     DataDescriptorPtr outputDomainDataDescriptor;
 
     SampleType inputSampleType;
+    ScalingKernel scalingKernel = nullptr;
 
     SignalConfigPtr outputSignal;
     SignalConfigPtr outputDomainSignal;
+    OutputPacketPool outputPacketPool;
 
     StreamReaderPtr reader;
-    SizeT sampleRate;
-    std::vector<float> inputData;
-    std::vector<uint64_t> inputDomainData;
+    bool packetMode = false;
     
     bool configValid = false;
-    Float scale;
-    Float offset;
-    Float outputHighValue;
-    Float outputLowValue;
-    Bool useCustomOutputRange;
-    std::string outputUnit;
-    std::string outputName;
+
+    ScalingState scaling;
+
+    ProcessingStatistics statistics;
+    TraceSource trace;
+    InputReader inputReader{statistics, trace, dispatcher};
+
+    // Declared last, so that the worker thread and a running flush finish before the other members are destroyed
+    ProcessingDispatcher dispatcher{context, [this] { packetMode ? processQueuedPackets() : calculate(); }};
 
     void createInputPorts();
     void createSignals();
 
     void calculate();
-    void processData(SizeT readAmount, SizeT packetOffset) const;
+    void processData(const void* inputData, SizeT readAmount, SizeT packetOffset, uint64_t inputPosition);
+    void onPacketReceived(const InputPortPtr& port) override;
+    void processQueuedPackets();
+    void processDataPacket(const DataPacketPtr& packet, uint64_t inputPosition);
     void processEventPacket(const EventPacketPtr& packet);
 
     void processSignalDescriptorChanged(const DataDescriptorPtr& dataDescriptor,
                                         const DataDescriptorPtr& domainDescriptor);
     void configure();
+    void updateOutputDescriptor(const ScalingParameters& params);
 
     void initProperties();
-    void propertyChanged(bool configure);
-    void readProperties();
+    void blockPolicyChanged();
+    void updateMemoryUsage();
 };
 
 END_NAMESPACE_EXAMPLE_MODULE
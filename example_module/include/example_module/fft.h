@@ -0,0 +1,254 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <example_module/common.h>
+#include <example_module/cpu_features.h>
+#include <example_module/fft_x86.h>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// One radix-2 butterfly stage over count complex values: each group of 2 * span values combines its
+// halves a and b into a + w b and a - w b, with the stage's span twiddles w
+using FftStageKernel = void (*)(double* re, double* im, const double* twiddleRe, const double* twiddleIm, SizeT count, SizeT span);
+
+inline void fftStageScalar(double* re, double* im, const double* twiddleRe, const double* twiddleIm, SizeT count, SizeT span)
+{
+    for (SizeT start = 0; start < count; start += 2 * span)
+    {
+        double* aRe = re + start;
+        double* aIm = im + start;
+        double* bRe = aRe + span;
+        double* bIm = aIm + span;
+        for (SizeT j = 0; j < span; ++j)
+        {
+            const double tRe = bRe[j] * twiddleRe[j] - bIm[j] * twiddleIm[j];
+            const double tIm = bRe[j] * twiddleIm[j] + bIm[j] * twiddleRe[j];
+            bRe[j] = aRe[j] - tRe;
+            bIm[j] = aIm[j] - tIm;
+            aRe[j] += tRe;
+            aIm[j] += tIm;
+        }
+    }
+}
+
+// Picks the widest stage kernel whose register width divides the span
+inline FftStageKernel getFftStageKernel(SimdLevel level, SizeT span)
+{
+#if EXAMPLE_MODULE_SIMD_X86
+    if (level >= SimdLevel::AVX512 && span % 8 == 0)
+        return &x86::fftStageAvx512;
+    if (level >= SimdLevel::AVX2 && span % 4 == 0)
+        return &x86::fftStageAvx2;
+    if (level >= SimdLevel::SSE2 && span % 2 == 0)
+        return &x86::fftStageSse2;
+#endif
+    return &fftStageScalar;
+}
+
+// Precomputed tables for real transforms of one power-of-two size. A real transform of size N is
+// computed as a complex transform of size N / 2 on the even/odd sample pairs, followed by a split step.
+// Complex values are kept in split form (separate real and imaginary arrays), so the butterfly loops
+// over contiguous twiddles vectorize. Plans are immutable and shared, see FftPlan::get.
+class FftPlan
+{
+public:
+    explicit FftPlan(SizeT size, SimdLevel level = getSimdLevel())
+        : size(size)
+        , half(size / 2)
+        , simdLevel(level)
+    {
+        if (size < 4 || (size & (size - 1)) != 0)
+            throw std::invalid_argument("FFT size must be a power of two of at least 4");
+
+        bitReversal.resize(half);
+        SizeT bits = 0;
+        while ((SizeT(1) << bits) < half)
+            ++bits;
+        for (SizeT i = 0; i < half; ++i)
+        {
+            SizeT reversed = 0;
+            for (SizeT bit = 0; bit < bits; ++bit)
+                reversed |= ((i >> bit) & 1) << (bits - 1 - bit);
+            bitReversal[i] = reversed;
+        }
+
+        // Twiddles of all butterfly stages, one contiguous run of length / 2 values per stage
+        for (SizeT length = 2; length <= half; length *= 2)
+        {
+            for (SizeT j = 0; j < length / 2; ++j)
+            {
+                const double angle = -2.0 * M_PI * static_cast<double>(j) / static_cast<double>(length);
+                stageTwiddleRe.push_back(std::cos(angle));
+                stageTwiddleIm.push_back(std::sin(angle));
+            }
+        }
+
+        splitTwiddleRe.resize(half + 1);
+        splitTwiddleIm.resize(half + 1);
+        for (SizeT k = 0; k <= half; ++k)
+        {
+            const double angle = -2.0 * M_PI * static_cast<double>(k) / static_cast<double>(size);
+            splitTwiddleRe[k] = std::cos(angle);
+            splitTwiddleIm[k] = std::sin(angle);
+        }
+    }
+
+    // Returns the shared plan of the given size, creating it on first use
+    static std::shared_ptr<const FftPlan> get(SizeT size)
+    {
+        static std::mutex mutex;
+        static std::map<SizeT, std::weak_ptr<const FftPlan>> plans;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& entry = plans[size];
+        auto plan = entry.lock();
+        if (!plan)
+        {
+            plan = std::make_shared<const FftPlan>(size);
+            entry = plan;
+        }
+        return plan;
+    }
+
+    SizeT getSize() const
+    {
+        return size;
+    }
+
+    // Number of bins of a real transform (size / 2 + 1)
+    SizeT getBinCount() const
+    {
+        return half + 1;
+    }
+
+    // Transforms size real samples into getBinCount() bins. re and im need getBinCount() values.
+    void forward(const double* input, double* re, double* im) const
+    {
+        for (SizeT i = 0; i < half; ++i)
+        {
+            const SizeT j = bitReversal[i];
+            re[i] = input[2 * j];
+            im[i] = input[2 * j + 1];
+        }
+        transform(re, im);
+
+        // X[k] = E[k] + W^k O[k], with E and O the transforms of the even and odd samples
+        re[half] = re[0];
+        im[half] = im[0];
+        for (SizeT k = 0; k <= half / 2; ++k)
+        {
+            const SizeT m = half - k;
+            const double evenRe = 0.5 * (re[k] + re[m]);
+            const double evenIm = 0.5 * (im[k] - im[m]);
+            const double oddRe = 0.5 * (im[k] + im[m]);
+            const double oddIm = -0.5 * (re[k] - re[m]);
+
+            const double wkRe = splitTwiddleRe[k];
+            const double wkIm = splitTwiddleIm[k];
+            const double wmRe = splitTwiddleRe[m];
+            const double wmIm = splitTwiddleIm[m];
+
+            // E[m] = conj(E[k]), O[m] = conj(O[k])
+            re[k] = evenRe + (wkRe * oddRe - wkIm * oddIm);
+            im[k] = evenIm + (wkRe * oddIm + wkIm * oddRe);
+            const double mRe = evenRe + (wmRe * oddRe + wmIm * oddIm);
+            const double mIm = -evenIm + (wmIm * oddRe - wmRe * oddIm);
+            re[m] = mRe;
+            im[m] = mIm;
+        }
+    }
+
+    // Inverse of forward, scaled so that inverse(forward(x)) == x. re and im are used as scratch.
+    void inverse(double* re, double* im, double* output) const
+    {
+        // Recovers E[k] + i O[k] from X[k] and conj(X[half - k])
+        for (SizeT k = 0; k <= half / 2; ++k)
+        {
+            const SizeT m = half - k;
+            const double sumRe = re[k] + re[m];
+            const double sumIm = im[k] - im[m];
+            const double diffRe = re[k] - re[m];
+            const double diffIm = im[k] + im[m];
+
+            // O[k] = (X[k] - conj(X[m])) conj(W^k) / 2, O[m] = conj(O[k])
+            const double wkRe = splitTwiddleRe[k];
+            const double wkIm = splitTwiddleIm[k];
+            const double oddRe = 0.5 * (diffRe * wkRe + diffIm * wkIm);
+            const double oddIm = 0.5 * (diffIm * wkRe - diffRe * wkIm);
+            const double evenRe = 0.5 * sumRe;
+            const double evenIm = 0.5 * sumIm;
+
+            re[k] = evenRe - oddIm;
+            im[k] = evenIm + oddRe;
+            re[m] = evenRe + oddIm;
+            im[m] = -evenIm + oddRe;
+        }
+
+        // The inverse transform is the forward transform of the conjugate
+        for (SizeT i = 0; i < half; ++i)
+            im[i] = -im[i];
+        for (SizeT i = 0; i < half; ++i)
+        {
+            const SizeT j = bitReversal[i];
+            if (j > i)
+            {
+                std::swap(re[i], re[j]);
+                std::swap(im[i], im[j]);
+            }
+        }
+        transform(re, im);
+
+        const double scale = 1.0 / static_cast<double>(half);
+        for (SizeT i = 0; i < half; ++i)
+        {
+            output[2 * i] = re[i] * scale;
+            output[2 * i + 1] = -im[i] * scale;
+        }
+    }
+
+private:
+    // In-place radix-2 decimation in time on bit-reversed input
+    void transform(double* re, double* im) const
+    {
+        const double* twiddleRe = stageTwiddleRe.data();
+        const double* twiddleIm = stageTwiddleIm.data();
+
+        for (SizeT span = 1; span < half; span *= 2)
+        {
+            getFftStageKernel(simdLevel, span)(re, im, twiddleRe, twiddleIm, half, span);
+            twiddleRe += span;
+            twiddleIm += span;
+        }
+    }
+
+    SizeT size;
+    SizeT half;
+    SimdLevel simdLevel;
+    std::vector<SizeT> bitReversal;
+    std::vector<double> stageTwiddleRe;
+    std::vector<double> stageTwiddleIm;
+    std::vector<double> splitTwiddleRe;
+    std::vector<double> splitTwiddleIm;
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,111 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <example_module/common.h>
+#include <example_module/cpu_features.h>
+
+#if EXAMPLE_MODULE_SIMD_X86
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Vectorized variants of fftStageScalar for spans that are a multiple of the register width. The
+// butterflies are rounded like the scalar stage (no FMA).
+namespace x86
+{
+    EXAMPLE_MODULE_TARGET_SSE2 inline void fftStageSse2(double* re, double* im, const double* twiddleRe, const double* twiddleIm, SizeT count, SizeT span)
+    {
+        for (SizeT start = 0; start < count; start += 2 * span)
+        {
+            double* aRe = re + start;
+            double* aIm = im + start;
+            double* bRe = aRe + span;
+            double* bIm = aIm + span;
+            for (SizeT j = 0; j < span; j += 2)
+            {
+                const __m128d wRe = _mm_loadu_pd(twiddleRe + j);
+                const __m128d wIm = _mm_loadu_pd(twiddleIm + j);
+                const __m128d xRe = _mm_loadu_pd(bRe + j);
+                const __m128d xIm = _mm_loadu_pd(bIm + j);
+                const __m128d tRe = _mm_sub_pd(_mm_mul_pd(xRe, wRe), _mm_mul_pd(xIm, wIm));
+                const __m128d tIm = _mm_add_pd(_mm_mul_pd(xRe, wIm), _mm_mul_pd(xIm, wRe));
+                const __m128d yRe = _mm_loadu_pd(aRe + j);
+                const __m128d yIm = _mm_loadu_pd(aIm + j);
+                _mm_storeu_pd(bRe + j, _mm_sub_pd(yRe, tRe));
+                _mm_storeu_pd(bIm + j, _mm_sub_pd(yIm, tIm));
+                _mm_storeu_pd(aRe + j, _mm_add_pd(yRe, tRe));
+                _mm_storeu_pd(aIm + j, _mm_add_pd(yIm, tIm));
+            }
+        }
+    }
+
+    EXAMPLE_MODULE_TARGET_AVX2 inline void fftStageAvx2(double* re, double* im, const double* twiddleRe, const double* twiddleIm, SizeT count, SizeT span)
+    {
+        for (SizeT start = 0; start < count; start += 2 * span)
+        {
+            double* aRe = re + start;
+            double* aIm = im + start;
+            double* bRe = aRe + span;
+            double* bIm = aIm + span;
+            for (SizeT j = 0; j < span; j += 4)
+            {
+                const __m256d wRe = _mm256_loadu_pd(twiddleRe + j);
+                const __m256d wIm = _mm256_loadu_pd(twiddleIm + j);
+                const __m256d xRe = _mm256_loadu_pd(bRe + j);
+                const __m256d xIm = _mm256_loadu_pd(bIm + j);
+                const __m256d tRe = _mm256_sub_pd(_mm256_mul_pd(xRe, wRe), _mm256_mul_pd(xIm, wIm));
+                const __m256d tIm = _mm256_add_pd(_mm256_mul_pd(xRe, wIm), _mm256_mul_pd(xIm, wRe));
+                const __m256d yRe = _mm256_loadu_pd(aRe + j);
+                const __m256d yIm = _mm256_loadu_pd(aIm + j);
+                _mm256_storeu_pd(bRe + j, _mm256_sub_pd(yRe, tRe));
+                _mm256_storeu_pd(bIm + j, _mm256_sub_pd(yIm, tIm));
+                _mm256_storeu_pd(aRe + j, _mm256_add_pd(yRe, tRe));
+                _mm256_storeu_pd(aIm + j, _mm256_add_pd(yIm, tIm));
+            }
+        }
+    }
+
+    EXAMPLE_MODULE_TARGET_AVX512 inline void fftStageAvx512(
+        double* re, double* im, const double* twiddleRe, const double* twiddleIm, SizeT count, SizeT span)
+    {
+        for (SizeT start = 0; start < count; start += 2 * span)
+        {
+            double* aRe = re + start;
+            double* aIm = im + start;
+            double* bRe = aRe + span;
+            double* bIm = aIm + span;
+            for (SizeT j = 0; j < span; j += 8)
+            {
+                const __m512d wRe = _mm512_loadu_pd(twiddleRe + j);
+                const __m512d wIm = _mm512_loadu_pd(twiddleIm + j);
+                const __m512d xRe = _mm512_loadu_pd(bRe + j);
+                const __m512d xIm = _mm512_loadu_pd(bIm + j);
+                const __m512d tRe = _mm512_sub_pd(_mm512_mul_pd(xRe, wRe), _mm512_mul_pd(xIm, wIm));
+                const __m512d tIm = _mm512_add_pd(_mm512_mul_pd(xRe, wIm), _mm512_mul_pd(xIm, wRe));
+                const __m512d yRe = _mm512_loadu_pd(aRe + j);
+                const __m512d yIm = _mm512_loadu_pd(aIm + j);
+                _mm512_storeu_pd(bRe + j, _mm512_sub_pd(yRe, tRe));
+                _mm512_storeu_pd(bIm + j, _mm512_sub_pd(yIm, tIm));
+                _mm512_storeu_pd(aRe + j, _mm512_add_pd(yRe, tRe));
+                _mm512_storeu_pd(aIm + j, _mm512_add_pd(yIm, tIm));
+            }
+        }
+    }
+}
+
+END_NAMESPACE_EXAMPLE_MODULE
+
+#endif
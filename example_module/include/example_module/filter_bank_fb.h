@@ -0,0 +1,83 @@
+#pragma once
+#include <example_module/common.h>
+#include <example_module/filter_design.h>
+#include <example_module/output_packet_pool.h>
+#include <example_module/sos_filter_bank.h>
+#include <example_module/stream_input.h>
+#include <opendaq/function_block_impl.h>
+#include <opendaq/opendaq.h>
+#include <opendaq/stream_reader_ptr.h>
+#include <memory>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Filters many channels with the same filter design. A free input port is always available; connecting
+// it adds the next one. Channels are read in lockstep and filtered together in structure-of-arrays
+// layout, with one output signal per channel. Lockstep reading requires the channels to share one
+// sample rate and to deliver their samples together; a channel that falls behind holds back the others.
+class FilterBankFBImpl final : public FunctionBlock
+{
+public:
+    explicit FilterBankFBImpl(const ContextPtr& ctx,
+                              const ComponentPtr& parent,
+                              const StringPtr& localId,
+                              const PropertyObjectPtr& config = nullptr);
+    ~FilterBankFBImpl() override = default;
+
+    static FunctionBlockTypePtr CreateType();
+
+private:
+    static constexpr SizeT ReadBlockSize = 1024;
+
+    struct Channel
+    {
+        InputPortConfigPtr inputPort;
+        StreamReaderPtr reader;
+        SignalConfigPtr outputSignal;
+        SignalConfigPtr outputDomainSignal;
+        OutputPacketPool outputPacketPool;
+
+        DataDescriptorPtr inputDataDescriptor;
+        DataDescriptorPtr inputDomainDataDescriptor;
+        DataDescriptorPtr outputDataDescriptor;
+
+        // Known once the input descriptors are valid, even if the design is not
+        double sampleRate = 0.0;
+        DomainOffsetTracker domainOffsets;
+        bool configValid = false;
+
+        // Set for a valid channel left out of the bank because its sample rate differs
+        bool rateMismatch = false;
+        std::string error;
+    };
+
+    std::vector<std::unique_ptr<Channel>> channels;
+    std::vector<Channel*> activeChannels;
+    SizeT nextChannelId = 0;
+
+    FilterSpec filterSpec;
+    SosFilterBank filterBank;
+
+    std::vector<double> channelData;
+    std::vector<double> discardData;
+    std::vector<double> interleavedData;
+    std::vector<SizeT> domainOffsets;
+
+    void addChannel();
+    void onConnected(const InputPortPtr& port) override;
+    void onDisconnected(const InputPortPtr& port) override;
+
+    void initProperties();
+    void propertyChanged();
+    void configure(bool resetStates);
+    void configureChannel(Channel& channel);
+    void updateComponentStatus();
+
+    void calculate();
+    bool drainChannel(Channel& channel);
+    void processPendingEvents(Channel& channel);
+    void processEventPacket(Channel& channel, const EventPacketPtr& packet);
+    void processData(SizeT readAmount);
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
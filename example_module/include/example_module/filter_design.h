@@ -0,0 +1,538 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <example_module/common.h>
+#include <example_module/sos_filter.h>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Values match the indices of the "FilterType" and "ResponseType" selection properties
+enum class FilterFamily : Int
+{
+    Butterworth = 0,
+    ChebyshevI,
+    ChebyshevII,
+    Bessel
+};
+
+enum class FilterResponse : Int
+{
+    LowPass = 0,
+    HighPass,
+    BandPass,
+    BandStop
+};
+
+static constexpr SizeT MaxFilterOrder = 16;
+
+// Digital IIR filter specification. The order is the order of the low-pass prototype, so band-pass and
+// band-stop filters have twice as many poles. For Chebyshev II the cutoff is the stopband edge, for all
+// other families it is the -3 dB point (Chebyshev I: the passband ripple edge).
+struct FilterSpec
+{
+    FilterFamily family = FilterFamily::Butterworth;
+    FilterResponse response = FilterResponse::LowPass;
+    SizeT order = 1;
+    double sampleRate = 0.0;
+    double cutoffFrequency = 0.0;
+    double upperCutoffFrequency = 0.0;
+    double passbandRipple = 1.0;
+    double stopbandAttenuation = 40.0;
+};
+
+namespace filter_design
+{
+    using Complex = std::complex<double>;
+
+    // Zeros, poles and gain of a transfer function
+    struct Zpk
+    {
+        std::vector<Complex> zeros;
+        std::vector<Complex> poles;
+        double gain = 1.0;
+    };
+
+    inline constexpr double Pi = 3.14159265358979323846;
+
+    inline Complex product(const std::vector<Complex>& values, Complex (*term)(const Complex&))
+    {
+        Complex result = 1.0;
+        for (const auto& value : values)
+            result *= term(value);
+        return result;
+    }
+
+    inline Complex negate(const Complex& value)
+    {
+        return -value;
+    }
+
+    inline Zpk butterworthPrototype(SizeT order)
+    {
+        const auto n = static_cast<int>(order);
+
+        Zpk zpk;
+        for (int m = -n + 1; m < n; m += 2)
+            zpk.poles.push_back(-std::exp(Complex(0.0, Pi * m / (2.0 * n))));
+        return zpk;
+    }
+
+    inline Zpk chebyshev1Prototype(SizeT order, double rippleDb)
+    {
+        const auto n = static_cast<int>(order);
+        const double eps = std::sqrt(std::pow(10.0, 0.1 * rippleDb) - 1.0);
+        const double mu = std::asinh(1.0 / eps) / n;
+
+        Zpk zpk;
+        for (int m = -n + 1; m < n; m += 2)
+            zpk.poles.push_back(-std::sinh(Complex(mu, Pi * m / (2.0 * n))));
+
+        zpk.gain = product(zpk.poles, negate).real();
+        if (n % 2 == 0)
+            zpk.gain /= std::sqrt(1.0 + eps * eps);
+        return zpk;
+    }
+
+    inline Zpk chebyshev2Prototype(SizeT order, double attenuationDb)
+    {
+        const auto n = static_cast<int>(order);
+        const double de = 1.0 / std::sqrt(std::pow(10.0, 0.1 * attenuationDb) - 1.0);
+        const double mu = std::asinh(1.0 / de) / n;
+
+        Zpk zpk;
+        // Odd orders have one zero at infinity (m = 0), which is left out
+        for (int m = -n + 1; m < n; m += 2)
+        {
+            if (m != 0)
+                zpk.zeros.emplace_back(0.0, 1.0 / std::sin(m * Pi / (2.0 * n)));
+        }
+
+        for (int m = -n + 1; m < n; m += 2)
+        {
+            const Complex p = -std::exp(Complex(0.0, Pi * m / (2.0 * n)));
+            zpk.poles.push_back(1.0 / Complex(std::sinh(mu) * p.real(), std::cosh(mu) * p.imag()));
+        }
+
+        zpk.gain = (product(zpk.poles, negate) / product(zpk.zeros, negate)).real();
+        return zpk;
+    }
+
+    // Evaluates a polynomial given by ascending coefficients and its derivative
+    inline void evaluatePolynomial(const std::vector<double>& coefficients, const Complex& x, Complex& value, Complex& derivative)
+    {
+        value = 0.0;
+        derivative = 0.0;
+        for (auto it = coefficients.rbegin(); it != coefficients.rend(); ++it)
+        {
+            derivative = derivative * x + value;
+            value = value * x + *it;
+        }
+    }
+
+    // Aberth-Ehrlich iteration for all roots of a monic polynomial whose roots lie near the unit circle
+    inline std::vector<Complex> polynomialRoots(const std::vector<double>& coefficients)
+    {
+        const SizeT degree = coefficients.size() - 1;
+        std::vector<Complex> roots(degree);
+        for (SizeT i = 0; i < degree; ++i)
+            roots[i] = std::polar(1.0, 2.0 * Pi * (static_cast<double>(i) + 0.25) / static_cast<double>(degree));
+
+        for (int iteration = 0; iteration < 500; ++iteration)
+        {
+            double maxCorrection = 0.0;
+            for (SizeT i = 0; i < degree; ++i)
+            {
+                Complex value;
+                Complex derivative;
+                evaluatePolynomial(coefficients, roots[i], value, derivative);
+                if (value == 0.0)
+                    continue;
+
+                const Complex ratio = value / derivative;
+                Complex repulsion = 0.0;
+                for (SizeT j = 0; j < degree; ++j)
+                {
+                    if (j != i)
+                        repulsion += 1.0 / (roots[i] - roots[j]);
+                }
+
+                const Complex correction = ratio / (1.0 - ratio * repulsion);
+                roots[i] -= correction;
+                maxCorrection = std::max(maxCorrection, std::abs(correction));
+            }
+
+            if (maxCorrection < 1e-15)
+                break;
+        }
+
+        return roots;
+    }
+
+    // Bessel prototype normalized so that the magnitude response is -3 dB at 1 rad/s
+    inline Zpk besselPrototype(SizeT order)
+    {
+        const auto n = static_cast<int>(order);
+
+        // Reverse Bessel polynomial: a_k = (2n - k)! / (2^(n - k) k! (n - k)!)
+        std::vector<double> a(n + 1);
+        for (int k = 0; k <= n; ++k)
+            a[k] = std::exp(std::lgamma(2.0 * n - k + 1) - std::lgamma(k + 1.0) - std::lgamma(n - k + 1.0) - (n - k) * std::log(2.0));
+
+        // Substituting s = g * u with g = a0^(1/n) gives a monic polynomial with roots near the unit circle
+        const double g = std::pow(a[0], 1.0 / n);
+        std::vector<double> scaled(n + 1);
+        for (int k = 0; k <= n; ++k)
+            scaled[k] = a[k] * std::pow(g, k) / a[0];
+        scaled[n] = 1.0;
+
+        Zpk zpk;
+        for (const auto& root : polynomialRoots(scaled))
+            zpk.poles.push_back(std::abs(root.imag()) < 1e-12 ? Complex(root.real() * g, 0.0) : root * g);
+
+        // |H(jw)|^2 = |prod(-p)|^2 / |prod(jw - p)|^2 decreases monotonically; bisect for 1/2 on a log scale
+        const auto magnitudeSquared = [&zpk](double w)
+        {
+            double result = 1.0;
+            for (const auto& p : zpk.poles)
+                result *= std::norm(p) / std::norm(Complex(0.0, w) - p);
+            return result;
+        };
+
+        double low = 1e-6;
+        double high = 1e6;
+        for (int i = 0; i < 200; ++i)
+        {
+            const double mid = std::sqrt(low * high);
+            if (magnitudeSquared(mid) > 0.5)
+                low = mid;
+            else
+                high = mid;
+        }
+
+        const double cutoff = std::sqrt(low * high);
+        for (auto& p : zpk.poles)
+            p /= cutoff;
+
+        zpk.gain = product(zpk.poles, negate).real();
+        return zpk;
+    }
+
+    inline SizeT relativeDegree(const Zpk& zpk)
+    {
+        return zpk.poles.size() - zpk.zeros.size();
+    }
+
+    inline Zpk lowPassToLowPass(const Zpk& prototype, double wo)
+    {
+        Zpk zpk;
+        for (const auto& z : prototype.zeros)
+            zpk.zeros.push_back(z * wo);
+        for (const auto& p : prototype.poles)
+            zpk.poles.push_back(p * wo);
+        zpk.gain = prototype.gain * std::pow(wo, static_cast<double>(relativeDegree(prototype)));
+        return zpk;
+    }
+
+    inline Zpk lowPassToHighPass(const Zpk& prototype, double wo)
+    {
+        Zpk zpk;
+        for (const auto& z : prototype.zeros)
+            zpk.zeros.push_back(wo / z);
+        for (const auto& p : prototype.poles)
+            zpk.poles.push_back(wo / p);
+        zpk.zeros.insert(zpk.zeros.end(), relativeDegree(prototype), Complex(0.0));
+        zpk.gain = prototype.gain * (product(prototype.zeros, negate) / product(prototype.poles, negate)).real();
+        return zpk;
+    }
+
+    // Maps every root r to the pair r * bw / 2 +- sqrt((r * bw / 2)^2 - wo^2)
+    inline void splitBandRoots(const std::vector<Complex>& roots, double wo, std::vector<Complex>& result)
+    {
+        for (const auto& r : roots)
+        {
+            const Complex root = std::sqrt(r * r - wo * wo);
+            result.push_back(r + root);
+            result.push_back(r - root);
+        }
+    }
+
+    inline Zpk lowPassToBandPass(const Zpk& prototype, double wo, double bw)
+    {
+        std::vector<Complex> zeros;
+        std::vector<Complex> poles;
+        for (const auto& z : prototype.zeros)
+            zeros.push_back(z * bw / 2.0);
+        for (const auto& p : prototype.poles)
+            poles.push_back(p * bw / 2.0);
+
+        Zpk zpk;
+        splitBandRoots(zeros, wo, zpk.zeros);
+        splitBandRoots(poles, wo, zpk.poles);
+        zpk.zeros.insert(zpk.zeros.end(), relativeDegree(prototype), Complex(0.0));
+        zpk.gain = prototype.gain * std::pow(bw, static_cast<double>(relativeDegree(prototype)));
+        return zpk;
+    }
+
+    inline Zpk lowPassToBandStop(const Zpk& prototype, double wo, double bw)
+    {
+        std::vector<Complex> zeros;
+        std::vector<Complex> poles;
+        for (const auto& z : prototype.zeros)
+            zeros.push_back(bw / 2.0 / z);
+        for (const auto& p : prototype.poles)
+            poles.push_back(bw / 2.0 / p);
+
+        Zpk zpk;
+        splitBandRoots(zeros, wo, zpk.zeros);
+        splitBandRoots(poles, wo, zpk.poles);
+        for (SizeT i = 0; i < relativeDegree(prototype); ++i)
+        {
+            zpk.zeros.emplace_back(0.0, wo);
+            zpk.zeros.emplace_back(0.0, -wo);
+        }
+        zpk.gain = prototype.gain * (product(prototype.zeros, negate) / product(prototype.poles, negate)).real();
+        return zpk;
+    }
+
+    // Bilinear transform; zeros at infinity map to z = -1
+    inline Zpk bilinear(const Zpk& analog, double sampleRate)
+    {
+        const double fs2 = 2.0 * sampleRate;
+
+        Zpk zpk;
+        Complex numerator = 1.0;
+        Complex denominator = 1.0;
+        for (const auto& z : analog.zeros)
+        {
+            zpk.zeros.push_back((fs2 + z) / (fs2 - z));
+            numerator *= fs2 - z;
+        }
+        for (const auto& p : analog.poles)
+        {
+            zpk.poles.push_back((fs2 + p) / (fs2 - p));
+            denominator *= fs2 - p;
+        }
+        zpk.zeros.insert(zpk.zeros.end(), relativeDegree(analog), Complex(-1.0));
+        zpk.gain = analog.gain * (numerator / denominator).real();
+        return zpk;
+    }
+
+    // Roots of a real polynomial split into one representative per conjugate pair and real roots
+    struct RootSet
+    {
+        std::vector<Complex> pairs;
+        std::vector<double> reals;
+
+        SizeT size() const
+        {
+            return 2 * pairs.size() + reals.size();
+        }
+    };
+
+    inline RootSet splitConjugates(const std::vector<Complex>& roots)
+    {
+        constexpr double tolerance = 1e-10;
+
+        RootSet set;
+        for (const auto& r : roots)
+        {
+            if (std::abs(r.imag()) <= tolerance * std::max(1.0, std::abs(r)))
+                set.reals.push_back(r.real());
+            else if (r.imag() > 0.0)
+                set.pairs.push_back(r);
+        }
+
+        if (set.size() != roots.size())
+            throw std::runtime_error("Filter roots are not in conjugate pairs");
+        return set;
+    }
+
+    template <typename T>
+    T takeNearest(std::vector<T>& candidates, const Complex& target)
+    {
+        const auto nearest = std::min_element(candidates.begin(),
+                                              candidates.end(),
+                                              [&target](const T& a, const T& b) { return std::abs(Complex(a) - target) < std::abs(Complex(b) - target); });
+        const T value = *nearest;
+        candidates.erase(nearest);
+        return value;
+    }
+
+    // Coefficients of prod(1 - r z^-1) over up to two roots: (1, c1, c2)
+    inline void rootsToCoefficients(const std::vector<Complex>& roots, double& c1, double& c2)
+    {
+        c1 = 0.0;
+        c2 = 0.0;
+        if (roots.size() == 1)
+        {
+            c1 = -roots[0].real();
+        }
+        else if (roots.size() == 2)
+        {
+            c1 = -(roots[0] + roots[1]).real();
+            c2 = (roots[0] * roots[1]).real();
+        }
+    }
+
+    // Groups poles and zeros into sections. Poles closest to the unit circle are matched with their
+    // nearest zeros first and end up in the last sections, which keeps the intermediate gain low.
+    inline std::vector<BiquadCoefficients> zpkToSos(const Zpk& zpk)
+    {
+        auto poles = splitConjugates(zpk.poles);
+        auto zeros = splitConjugates(zpk.zeros);
+        if (zeros.size() > poles.size())
+            throw std::runtime_error("Filter has more zeros than poles");
+
+        // Each pole group is a conjugate pair, two real poles, or a single real pole for odd orders
+        std::vector<std::vector<Complex>> poleGroups;
+        for (const auto& p : poles.pairs)
+            poleGroups.push_back({p, std::conj(p)});
+
+        std::sort(poles.reals.begin(), poles.reals.end(), [](double a, double b) { return std::abs(a) > std::abs(b); });
+        for (SizeT i = 0; i + 1 < poles.reals.size(); i += 2)
+            poleGroups.push_back({poles.reals[i], poles.reals[i + 1]});
+
+        const auto radius = [](const std::vector<Complex>& group) { return std::abs(group[0]); };
+        std::sort(poleGroups.begin(), poleGroups.end(), [&radius](const auto& a, const auto& b) { return radius(a) > radius(b); });
+
+        // The lone real pole is matched last, so it receives the remaining real zero
+        if (poles.reals.size() % 2 == 1)
+            poleGroups.push_back({poles.reals.back()});
+
+        std::vector<BiquadCoefficients> sections;
+        for (const auto& group : poleGroups)
+        {
+            std::vector<Complex> sectionZeros;
+            const bool complexPoles = group[0].imag() != 0.0;
+
+            if (group.size() == 2 && complexPoles && !zeros.pairs.empty())
+            {
+                const Complex z = takeNearest(zeros.pairs, group[0]);
+                sectionZeros = {z, std::conj(z)};
+            }
+            else
+            {
+                while (sectionZeros.size() < group.size() && !zeros.reals.empty())
+                    sectionZeros.emplace_back(takeNearest(zeros.reals, group[sectionZeros.size()]));
+
+                if (sectionZeros.empty() && group.size() == 2 && !zeros.pairs.empty())
+                {
+                    const Complex z = takeNearest(zeros.pairs, group[0]);
+                    sectionZeros = {z, std::conj(z)};
+                }
+            }
+
+            BiquadCoefficients section;
+            rootsToCoefficients(sectionZeros, section.b1, section.b2);
+            rootsToCoefficients(group, section.a1, section.a2);
+            sections.push_back(section);
+        }
+
+        if (zeros.size() != 0)
+            throw std::runtime_error("Failed to pair filter zeros with poles");
+
+        std::reverse(sections.begin(), sections.end());
+
+        sections[0].b0 *= zpk.gain;
+        sections[0].b1 *= zpk.gain;
+        sections[0].b2 *= zpk.gain;
+        return sections;
+    }
+
+    inline Zpk analogPrototype(const FilterSpec& spec)
+    {
+        switch (spec.family)
+        {
+            case FilterFamily::Butterworth:
+                return butterworthPrototype(spec.order);
+            case FilterFamily::ChebyshevI:
+                return chebyshev1Prototype(spec.order, spec.passbandRipple);
+            case FilterFamily::ChebyshevII:
+                return chebyshev2Prototype(spec.order, spec.stopbandAttenuation);
+            case FilterFamily::Bessel:
+                return besselPrototype(spec.order);
+        }
+        throw std::invalid_argument("Unknown filter type");
+    }
+
+    inline bool isBandResponse(FilterResponse response)
+    {
+        return response == FilterResponse::BandPass || response == FilterResponse::BandStop;
+    }
+
+    inline void validate(const FilterSpec& spec)
+    {
+        const double nyquist = spec.sampleRate / 2.0;
+
+        if (!(spec.sampleRate > 0.0))
+            throw std::invalid_argument("Invalid sample rate: " + std::to_string(spec.sampleRate));
+        if (spec.order < 1 || spec.order > MaxFilterOrder)
+            throw std::invalid_argument("Filter order " + std::to_string(spec.order) + " is in invalid range (1 - " + std::to_string(MaxFilterOrder) + ")");
+        if (!(spec.cutoffFrequency > 0.0 && spec.cutoffFrequency < nyquist))
+            throw std::invalid_argument("Cutoff frequency must be between 0 and the Nyquist frequency");
+        if (isBandResponse(spec.response) && !(spec.upperCutoffFrequency > spec.cutoffFrequency && spec.upperCutoffFrequency < nyquist))
+            throw std::invalid_argument("Upper cutoff frequency must be between the cutoff frequency and the Nyquist frequency");
+        if (spec.family == FilterFamily::ChebyshevI && !(spec.passbandRipple > 0.0))
+            throw std::invalid_argument("Passband ripple must be positive");
+        if (spec.family == FilterFamily::ChebyshevII && !(spec.stopbandAttenuation > 0.0))
+            throw std::invalid_argument("Stopband attenuation must be positive");
+    }
+}
+
+// Designs the filter as a cascade of second-order sections: analog prototype, frequency transformation
+// at the prewarped band edges, bilinear transform, and pairing of poles with zeros.
+// Throws std::invalid_argument for invalid specifications.
+inline std::vector<BiquadCoefficients> designSosFilter(const FilterSpec& spec)
+{
+    using namespace filter_design;
+
+    validate(spec);
+
+    const auto prewarp = [&spec](double frequency) { return 2.0 * spec.sampleRate * std::tan(Pi * frequency / spec.sampleRate); };
+    const Zpk prototype = analogPrototype(spec);
+    const double low = prewarp(spec.cutoffFrequency);
+
+    Zpk analog;
+    switch (spec.response)
+    {
+        case FilterResponse::LowPass:
+            analog = lowPassToLowPass(prototype, low);
+            break;
+        case FilterResponse::HighPass:
+            analog = lowPassToHighPass(prototype, low);
+            break;
+        case FilterResponse::BandPass:
+        case FilterResponse::BandStop:
+        {
+            const double high = prewarp(spec.upperCutoffFrequency);
+            const double wo = std::sqrt(low * high);
+            analog = spec.response == FilterResponse::BandPass ? lowPassToBandPass(prototype, wo, high - low)
+                                                               : lowPassToBandStop(prototype, wo, high - low);
+            break;
+        }
+    }
+
+    return zpkToSos(bilinear(analog, spec.sampleRate));
+}
+
+END_NAMESPACE_EXAMPLE_MODULE
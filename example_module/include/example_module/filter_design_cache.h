@@ -0,0 +1,108 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <example_module/common.h>
+#include <example_module/filter_design.h>
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+using SharedSosDesign = std::shared_ptr<const std::vector<BiquadCoefficients>>;
+
+// Least recently used cache of filter designs, so that toggling between a few settings does not
+// redesign the filter every time. Lookups are linear; the cache is meant to hold a handful of designs.
+class FilterDesignCache
+{
+public:
+    static constexpr SizeT DefaultCapacity = 16;
+
+    explicit FilterDesignCache(SizeT capacity = DefaultCapacity)
+        : capacity(std::max<SizeT>(capacity, 1))
+    {
+    }
+
+    // Returns the cached design of spec, or designs and caches it. Throws like designSosFilter.
+    SharedSosDesign get(const FilterSpec& spec)
+    {
+        {
+            std::scoped_lock lock(mutex);
+            for (auto it = entries.begin(); it != entries.end(); ++it)
+            {
+                if (sameDesign(it->first, spec))
+                {
+                    entries.splice(entries.begin(), entries, it);
+                    ++hitCount;
+                    return entries.front().second;
+                }
+            }
+        }
+
+        // Designed without the lock; two threads missing on the same spec both design it
+        auto design = std::make_shared<const std::vector<BiquadCoefficients>>(designSosFilter(spec));
+
+        std::scoped_lock lock(mutex);
+        ++missCount;
+        entries.emplace_front(spec, design);
+        if (entries.size() > capacity)
+            entries.pop_back();
+        return design;
+    }
+
+    void clear()
+    {
+        std::scoped_lock lock(mutex);
+        entries.clear();
+    }
+
+    SizeT getSize() const
+    {
+        std::scoped_lock lock(mutex);
+        return entries.size();
+    }
+
+    SizeT getHitCount() const
+    {
+        std::scoped_lock lock(mutex);
+        return hitCount;
+    }
+
+    SizeT getMissCount() const
+    {
+        std::scoped_lock lock(mutex);
+        return missCount;
+    }
+
+    static bool sameDesign(const FilterSpec& a, const FilterSpec& b)
+    {
+        return std::tie(a.family, a.response, a.order, a.sampleRate, a.cutoffFrequency, a.upperCutoffFrequency, a.passbandRipple, a.stopbandAttenuation) ==
+               std::tie(b.family, b.response, b.order, b.sampleRate, b.cutoffFrequency, b.upperCutoffFrequency, b.passbandRipple, b.stopbandAttenuation);
+    }
+
+private:
+    SizeT capacity;
+    std::list<std::pair<FilterSpec, SharedSosDesign>> entries;
+    SizeT hitCount = 0;
+    SizeT missCount = 0;
+    mutable std::mutex mutex;
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,110 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <example_module/common.h>
+#include <example_module/filter_design_cache.h>
+#include <example_module/filter_properties.h>
+#include <example_module/parallel_sos_filter.h>
+#include <example_module/sos_crossfade.h>
+#include <atomic>
+#include <memory>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Design changes of a running IIR filter. A property write validates and designs the new spec on its own
+// thread, so that designing does not stall the acquisition, and stages the design; the acquisition thread
+// swaps it in between two blocks and keeps the filter state. A design staged for another sample rate than
+// that of the running filter is dropped.
+class FilterDesignStage
+{
+public:
+    struct Design
+    {
+        SharedSosDesign sections;
+        double sampleRate = 0.0;
+        SizeT crossfadeLength = 0;
+    };
+
+    using DesignPtr = std::shared_ptr<const Design>;
+
+    // Designs spec for the running filter, without the acquisition lock; null while no filter runs. Throws
+    // std::invalid_argument for an invalid design.
+    DesignPtr prepare(FilterSpec spec, SizeT crossfadeLength)
+    {
+        const double rate = sampleRate;
+        if (rate <= 0.0)
+            return nullptr;
+
+        validateFilterFrequencies(spec, rate);
+        spec.sampleRate = rate;
+        return std::make_shared<const Design>(Design{designCache.get(spec), rate, crossfadeLength});
+    }
+
+    // Under the acquisition lock, while the filter runs. A design prepared before the filter was
+    // reconfigured for another input is prepared again.
+    void stage(const FilterSpec& spec, DesignPtr design, SizeT crossfadeLength)
+    {
+        if (!design || design->sampleRate != sampleRate)
+            design = prepare(spec, crossfadeLength);
+
+        std::atomic_store(&staged, std::move(design));
+    }
+
+    // Under the acquisition lock: designs the filter from scratch. Throws std::invalid_argument for an
+    // invalid design, leaving the stage stopped.
+    void start(ParallelSosFilter& filter, FilterSpec spec, double rate)
+    {
+        validateFilterFrequencies(spec, rate);
+        spec.sampleRate = rate;
+        filter.setSections(*designCache.get(spec));
+        sampleRate = rate;
+    }
+
+    // Under the acquisition lock, when the filter is reconfigured: a staged design belongs to the previous input
+    void stop()
+    {
+        sampleRate = 0.0;
+        std::atomic_store(&staged, DesignPtr());
+    }
+
+    // Called by the acquisition thread before it filters a block
+    void apply(ParallelSosFilter& filter, SosCrossfade& crossfade)
+    {
+        if (!std::atomic_load(&staged))
+            return;
+
+        const auto design = std::atomic_exchange(&staged, DesignPtr());
+        if (!design || design->sampleRate != sampleRate)
+            return;
+
+        if (design->crossfadeLength > 0)
+            crossfade.start(filter.getSections(), filter.getStates(), design->crossfadeLength);
+        else
+            crossfade.stop();
+
+        filter.updateSections(*design->sections);
+    }
+
+private:
+    FilterDesignCache designCache;
+
+    // Of the running filter, zero while none runs; read by property writes without the lock
+    std::atomic<double> sampleRate{0.0};
+    DesignPtr staged;
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <example_module/common.h>
+#include <example_module/filter_design.h>
+#include <opendaq/opendaq.h>
+#include <functional>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+static constexpr Int MaxCrossfadeLength = 65536;
+
+// Adds the filter design properties (FilterType, ResponseType, Order, CutoffFrequency, UpperCutoffFrequency,
+// PassbandRipple and StopbandAttenuation); onChanged is invoked whenever one of them is written, or once
+// at the end of a batch update
+void addFilterDesignProperties(PropertyObjectPtr& objPtr, const std::function<void()>& onChanged);
+
+// The returned spec has no sample rate, it is set per input signal
+FilterSpec readFilterDesignProperties(const PropertyObjectPtr& objPtr);
+
+// Adds CrossfadeLength, the number of samples over which the output blends from the old to the new design
+// (0 switches at once). It is read when a design change is staged, so it has no handler of its own.
+void addCrossfadeProperty(PropertyObjectPtr& objPtr);
+
+SizeT readCrossfadeLength(const PropertyObjectPtr& objPtr);
+
+// Cutoff frequencies must lie within 1 Hz and the Nyquist frequency - 1 Hz; throws std::invalid_argument otherwise
+void validateFilterFrequencies(const FilterSpec& spec, double sampleRate);
+void validateFilterFrequencies(FilterResponse response, double cutoffFrequency, double upperCutoffFrequency, double sampleRate);
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,166 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <example_module/common.h>
+#include <example_module/filter_design.h>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Values match the indices of the "Window" selection property
+enum class FirWindow : Int
+{
+    Rectangular = 0,
+    Hann,
+    Hamming,
+    Blackman
+};
+
+static constexpr SizeT MaxFirTapCount = 65536;
+
+// Linear-phase FIR filter specification, designed with the window method
+struct FirSpec
+{
+    FilterResponse response = FilterResponse::LowPass;
+    FirWindow window = FirWindow::Hamming;
+    SizeT tapCount = 101;
+    double sampleRate = 0.0;
+    double cutoffFrequency = 0.0;
+    double upperCutoffFrequency = 0.0;
+};
+
+namespace fir_design
+{
+    inline double windowValue(FirWindow window, SizeT n, SizeT tapCount)
+    {
+        if (tapCount == 1)
+            return 1.0;
+
+        const double phase = 2.0 * filter_design::Pi * static_cast<double>(n) / static_cast<double>(tapCount - 1);
+        switch (window)
+        {
+            case FirWindow::Rectangular:
+                return 1.0;
+            case FirWindow::Hann:
+                return 0.5 - 0.5 * std::cos(phase);
+            case FirWindow::Hamming:
+                return 0.54 - 0.46 * std::cos(phase);
+            case FirWindow::Blackman:
+                return 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+        }
+        return 1.0;
+    }
+
+    // Ideal low-pass impulse response with the cutoff given as a fraction of the sample rate
+    inline double lowPassTap(double cutoff, double t)
+    {
+        if (t == 0.0)
+            return 2.0 * cutoff;
+        return std::sin(2.0 * filter_design::Pi * cutoff * t) / (filter_design::Pi * t);
+    }
+
+    inline double gainAt(const std::vector<double>& taps, double frequency)
+    {
+        double re = 0.0;
+        double im = 0.0;
+        for (SizeT n = 0; n < taps.size(); ++n)
+        {
+            re += taps[n] * std::cos(2.0 * filter_design::Pi * frequency * static_cast<double>(n));
+            im -= taps[n] * std::sin(2.0 * filter_design::Pi * frequency * static_cast<double>(n));
+        }
+        return std::sqrt(re * re + im * im);
+    }
+
+    inline void validate(const FirSpec& spec)
+    {
+        const double nyquist = spec.sampleRate / 2.0;
+
+        if (!(spec.sampleRate > 0.0))
+            throw std::invalid_argument("Invalid sample rate: " + std::to_string(spec.sampleRate));
+        if (spec.tapCount < 1 || spec.tapCount > MaxFirTapCount)
+            throw std::invalid_argument("Tap count " + std::to_string(spec.tapCount) + " is in invalid range (1 - " + std::to_string(MaxFirTapCount) + ")");
+        if ((spec.response == FilterResponse::HighPass || spec.response == FilterResponse::BandStop) && spec.tapCount % 2 == 0)
+            throw std::invalid_argument("High-pass and band-stop FIR filters need an odd tap count");
+        if (!(spec.cutoffFrequency > 0.0 && spec.cutoffFrequency < nyquist))
+            throw std::invalid_argument("Cutoff frequency must be between 0 and the Nyquist frequency");
+        if (filter_design::isBandResponse(spec.response) && !(spec.upperCutoffFrequency > spec.cutoffFrequency && spec.upperCutoffFrequency < nyquist))
+            throw std::invalid_argument("Upper cutoff frequency must be between the cutoff frequency and the Nyquist frequency");
+    }
+}
+
+// Designs a symmetric (linear-phase) FIR filter by windowing the ideal impulse response. The low-pass is
+// normalized to unity gain at DC and the band-pass at the band center; high-pass and band-stop filters
+// are their spectral inversions, which needs an odd tap count (a tap at the center of the filter).
+// Throws std::invalid_argument for invalid specifications.
+inline std::vector<double> designFirFilter(const FirSpec& spec)
+{
+    using namespace fir_design;
+
+    validate(spec);
+
+    const SizeT tapCount = spec.tapCount;
+    const double center = static_cast<double>(tapCount - 1) / 2.0;
+    const double low = spec.cutoffFrequency / spec.sampleRate;
+    const double high = spec.upperCutoffFrequency / spec.sampleRate;
+
+    // The second half mirrors the first, so the taps are exactly symmetric
+    std::vector<double> taps(tapCount);
+    for (SizeT n = 0; n < (tapCount + 1) / 2; ++n)
+    {
+        const double t = static_cast<double>(n) - center;
+        double value = 0.0;
+        switch (spec.response)
+        {
+            case FilterResponse::LowPass:
+            case FilterResponse::HighPass:
+                value = lowPassTap(low, t);
+                break;
+            case FilterResponse::BandPass:
+            case FilterResponse::BandStop:
+                value = lowPassTap(high, t) - lowPassTap(low, t);
+                break;
+        }
+        taps[n] = value * windowValue(spec.window, n, tapCount);
+        taps[tapCount - 1 - n] = taps[n];
+    }
+
+    // Normalize the pass band of the windowed prototype, then invert the spectrum for the stop responses
+    double normalizeAt = 0.0;
+    if (spec.response == FilterResponse::BandPass || spec.response == FilterResponse::BandStop)
+        normalizeAt = (low + high) / 2.0;
+
+    const double gain = gainAt(taps, normalizeAt);
+    if (gain > 0.0)
+    {
+        for (auto& tap : taps)
+            tap /= gain;
+    }
+
+    if (spec.response == FilterResponse::HighPass || spec.response == FilterResponse::BandStop)
+    {
+        for (auto& tap : taps)
+            tap = -tap;
+        taps[tapCount / 2] += 1.0;
+    }
+
+    return taps;
+}
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,382 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <example_module/common.h>
+#include <example_module/cpu_features.h>
+#include <example_module/fft.h>
+#include <example_module/fir_filter_x86.h>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Computes output[n] = sum of taps[k] * input[n - k]. The input must be preceded by tapCount - 1
+// samples of history.
+using FirKernel = void (*)(const double* taps, SizeT tapCount, const double* input, double* output, SizeT count);
+
+inline void firDirectScalar(const double* taps, SizeT tapCount, const double* input, double* output, SizeT count)
+{
+    for (SizeT n = 0; n < count; ++n)
+    {
+        double acc = 0.0;
+        for (SizeT k = 0; k < tapCount; ++k)
+            acc += taps[k] * input[n - k];
+        output[n] = acc;
+    }
+}
+
+// Runs a vectorized kernel that returns the number of outputs it computed, and the scalar kernel on the rest
+template <SizeT (*Vectorized)(const double*, SizeT, const double*, double*, SizeT)>
+void firDirectWithTail(const double* taps, SizeT tapCount, const double* input, double* output, SizeT count)
+{
+    const SizeT done = Vectorized(taps, tapCount, input, output, count);
+    firDirectScalar(taps, tapCount, input + done, output + done, count - done);
+}
+
+inline FirKernel getFirKernel(SimdLevel level)
+{
+#if EXAMPLE_MODULE_SIMD_X86
+    if (level >= SimdLevel::AVX512)
+        return &firDirectWithTail<&x86::firDirectAvx512>;
+    if (level >= SimdLevel::AVX2)
+        return &firDirectWithTail<&x86::firDirectAvx2>;
+    if (level >= SimdLevel::SSE2)
+        return &firDirectWithTail<&x86::firDirectSse2>;
+#endif
+    return &firDirectScalar;
+}
+
+// Direct convolution, vectorized across consecutive output samples
+class DirectFirFilter
+{
+public:
+    static constexpr SizeT ChunkSize = 1024;
+
+    DirectFirFilter()
+        : kernel(getFirKernel(getSimdLevel()))
+    {
+    }
+
+    // Replaces the taps and clears the history
+    void setTaps(std::vector<double> filterTaps)
+    {
+        taps = std::move(filterTaps);
+        buffer.assign(historySize() + ChunkSize, 0.0);
+    }
+
+    void setSimdLevel(SimdLevel level)
+    {
+        kernel = getFirKernel(level);
+    }
+
+    void reset()
+    {
+        std::fill(buffer.begin(), buffer.end(), 0.0);
+    }
+
+    // Input and output may be the same buffer
+    void process(const double* input, double* output, SizeT count)
+    {
+        if (taps.empty())
+            return;
+
+        const SizeT history = historySize();
+        for (SizeT start = 0; start < count; start += ChunkSize)
+        {
+            const SizeT chunk = std::min(ChunkSize, count - start);
+            std::copy(input + start, input + start + chunk, buffer.begin() + history);
+            kernel(taps.data(), taps.size(), buffer.data() + history, output + start, chunk);
+            std::memmove(buffer.data(), buffer.data() + chunk, history * sizeof(double));
+        }
+    }
+
+private:
+    SizeT historySize() const
+    {
+        return taps.empty() ? 0 : taps.size() - 1;
+    }
+
+    std::vector<double> taps;
+    std::vector<double> buffer;
+    FirKernel kernel;
+};
+
+// Uniformly partitioned overlap-save convolution. The taps are split into partitions of B samples, each
+// transformed with size 2B. Every transform covers a frame of the previous and the current input block;
+// the outputs that would wrap around are discarded. The current block is multiplied with the first
+// partition, and the spectra of the previous blocks, kept in a frequency-domain delay line, with the
+// later partitions. Their sum is computed once per block, so a call that adds only a few samples costs
+// one forward and one inverse transform of size 2B. The transform plan is shared between filters of the
+// same size and all buffers are allocated in setTaps.
+class FftFirFilter
+{
+public:
+    // Short kernels use at least MinPartitionSize, which amortizes the per-transform overhead
+    static constexpr SizeT MinPartitionSize = 256;
+    static constexpr SizeT MaxPartitionSize = 4096;
+
+    // Replaces the taps and clears the history
+    void setTaps(const std::vector<double>& taps)
+    {
+        if (taps.empty())
+        {
+            *this = FftFirFilter();
+            return;
+        }
+
+        partitionSize = choosePartitionSize(taps.size());
+        partitionCount = (taps.size() + partitionSize - 1) / partitionSize;
+        plan = FftPlan::get(2 * partitionSize);
+        binCount = plan->getBinCount();
+
+        frame.assign(2 * partitionSize, 0.0);
+        timeBuffer.assign(2 * partitionSize, 0.0);
+        spectrumRe.assign(binCount, 0.0);
+        spectrumIm.assign(binCount, 0.0);
+        productRe.assign(binCount, 0.0);
+        productIm.assign(binCount, 0.0);
+        tailRe.assign(binCount, 0.0);
+        tailIm.assign(binCount, 0.0);
+        delayLineRe.assign((partitionCount - 1) * binCount, 0.0);
+        delayLineIm.assign((partitionCount - 1) * binCount, 0.0);
+        delayLineHead = 0;
+        blockFill = 0;
+
+        tapsRe.assign(partitionCount * binCount, 0.0);
+        tapsIm.assign(partitionCount * binCount, 0.0);
+        for (SizeT partition = 0; partition < partitionCount; ++partition)
+        {
+            std::fill(timeBuffer.begin(), timeBuffer.end(), 0.0);
+            const auto first = taps.begin() + partition * partitionSize;
+            const auto last = taps.begin() + std::min(taps.size(), (partition + 1) * partitionSize);
+            std::copy(first, last, timeBuffer.begin());
+            plan->forward(timeBuffer.data(), tapsRe.data() + partition * binCount, tapsIm.data() + partition * binCount);
+        }
+    }
+
+    void reset()
+    {
+        std::fill(frame.begin(), frame.end(), 0.0);
+        std::fill(tailRe.begin(), tailRe.end(), 0.0);
+        std::fill(tailIm.begin(), tailIm.end(), 0.0);
+        std::fill(delayLineRe.begin(), delayLineRe.end(), 0.0);
+        std::fill(delayLineIm.begin(), delayLineIm.end(), 0.0);
+        blockFill = 0;
+    }
+
+    SizeT getFftSize() const
+    {
+        return plan ? plan->getSize() : 0;
+    }
+
+    // Number of new samples per input block
+    SizeT getBlockSize() const
+    {
+        return partitionSize;
+    }
+
+    // Input and output may be the same buffer
+    void process(const double* input, double* output, SizeT count)
+    {
+        if (!plan)
+            return;
+
+        const SizeT blockSize = partitionSize;
+        SizeT position = 0;
+        while (position < count)
+        {
+            const SizeT samples = std::min(blockSize - blockFill, count - position);
+            double* current = frame.data() + blockSize + blockFill;
+            std::copy(input + position, input + position + samples, current);
+            std::fill(current + samples, frame.data() + 2 * blockSize, 0.0);
+
+            plan->forward(frame.data(), spectrumRe.data(), spectrumIm.data());
+            multiplyAdd(spectrumRe.data(), spectrumIm.data(), tapsRe.data(), tapsIm.data(), tailRe.data(), tailIm.data(), productRe.data(), productIm.data());
+            plan->inverse(productRe.data(), productIm.data(), timeBuffer.data());
+            std::copy(timeBuffer.begin() + blockSize + blockFill, timeBuffer.begin() + blockSize + blockFill + samples, output + position);
+
+            position += samples;
+            blockFill += samples;
+            if (blockFill == blockSize)
+                completeBlock();
+        }
+    }
+
+    // Partition size (half of the transform size) for a tap count
+    static SizeT choosePartitionSize(SizeT tapCount)
+    {
+        SizeT size = MinPartitionSize;
+        while (size < tapCount && size < MaxPartitionSize)
+            size *= 2;
+        return size;
+    }
+
+private:
+    // out = add + x * h
+    void multiplyAdd(
+        const double* xRe, const double* xIm, const double* hRe, const double* hIm, const double* addRe, const double* addIm, double* outRe, double* outIm) const
+    {
+        for (SizeT k = 0; k < binCount; ++k)
+        {
+            outRe[k] = addRe[k] + (xRe[k] * hRe[k] - xIm[k] * hIm[k]);
+            outIm[k] = addIm[k] + (xRe[k] * hIm[k] + xIm[k] * hRe[k]);
+        }
+    }
+
+    // Stores the spectrum of the completed frame and sums the contributions of the previous blocks to the next one
+    void completeBlock()
+    {
+        const SizeT blockSize = partitionSize;
+        std::copy(frame.begin() + blockSize, frame.end(), frame.begin());
+        blockFill = 0;
+
+        std::fill(tailRe.begin(), tailRe.end(), 0.0);
+        std::fill(tailIm.begin(), tailIm.end(), 0.0);
+        if (partitionCount == 1)
+            return;
+
+        // The delay line holds the spectra of the last partitionCount - 1 frames, newest at the head
+        delayLineHead = (delayLineHead + partitionCount - 2) % (partitionCount - 1);
+        std::copy(spectrumRe.begin(), spectrumRe.end(), delayLineRe.begin() + delayLineHead * binCount);
+        std::copy(spectrumIm.begin(), spectrumIm.end(), delayLineIm.begin() + delayLineHead * binCount);
+
+        for (SizeT partition = 1; partition < partitionCount; ++partition)
+        {
+            const SizeT slot = (delayLineHead + partition - 1) % (partitionCount - 1);
+            multiplyAdd(delayLineRe.data() + slot * binCount,
+                        delayLineIm.data() + slot * binCount,
+                        tapsRe.data() + partition * binCount,
+                        tapsIm.data() + partition * binCount,
+                        tailRe.data(),
+                        tailIm.data(),
+                        tailRe.data(),
+                        tailIm.data());
+        }
+    }
+
+    SizeT partitionSize = 0;
+    SizeT partitionCount = 0;
+    SizeT binCount = 0;
+    std::shared_ptr<const FftPlan> plan;
+
+    // Previous and current input block; blockFill samples of the current block are filled
+    std::vector<double> frame;
+    SizeT blockFill = 0;
+
+    std::vector<double> timeBuffer;
+    std::vector<double> spectrumRe;
+    std::vector<double> spectrumIm;
+    std::vector<double> productRe;
+    std::vector<double> productIm;
+
+    // Spectra of the tap partitions ([partition][bin]) and of the previous frames
+    std::vector<double> tapsRe;
+    std::vector<double> tapsIm;
+    std::vector<double> delayLineRe;
+    std::vector<double> delayLineIm;
+    SizeT delayLineHead = 0;
+
+    // Contribution of the previous blocks to the current one
+    std::vector<double> tailRe;
+    std::vector<double> tailIm;
+};
+
+enum class FirMethod
+{
+    Direct,
+    Fft
+};
+
+// FIR filter that uses direct convolution for short kernels and overlap-save for long ones
+class FirFilter
+{
+public:
+    // Kernels up to this length are convolved directly (see BM_FirFilter for the crossover)
+    static constexpr SizeT DirectMaxTaps = 128;
+
+    // Replaces the taps and clears the history, choosing the method from the tap count
+    void setTaps(std::vector<double> taps)
+    {
+        const auto method = taps.size() <= DirectMaxTaps ? FirMethod::Direct : FirMethod::Fft;
+        setTaps(std::move(taps), method);
+    }
+
+    void setTaps(std::vector<double> taps, FirMethod filterMethod)
+    {
+        method = filterMethod;
+        tapCount = taps.size();
+        if (method == FirMethod::Direct)
+        {
+            fftFilter.setTaps({});
+            directFilter.setTaps(std::move(taps));
+        }
+        else
+        {
+            directFilter.setTaps({});
+            fftFilter.setTaps(taps);
+        }
+    }
+
+    FirMethod getMethod() const
+    {
+        return method;
+    }
+
+    SizeT getTapCount() const
+    {
+        return tapCount;
+    }
+
+    // Block size that the filter processes most efficiently
+    SizeT getBlockSize() const
+    {
+        return method == FirMethod::Direct ? DirectFirFilter::ChunkSize : fftFilter.getBlockSize();
+    }
+
+    void reset()
+    {
+        directFilter.reset();
+        fftFilter.reset();
+    }
+
+    // Input and output may be the same buffer
+    void process(const double* input, double* output, SizeT count)
+    {
+        if (tapCount == 0)
+        {
+            if (input != output)
+                std::copy(input, input + count, output);
+            return;
+        }
+
+        if (method == FirMethod::Direct)
+            directFilter.process(input, output, count);
+        else
+            fftFilter.process(input, output, count);
+    }
+
+private:
+    FirMethod method = FirMethod::Direct;
+    SizeT tapCount = 0;
+    DirectFirFilter directFilter;
+    FftFirFilter fftFilter;
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
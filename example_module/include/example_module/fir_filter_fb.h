@@ -0,0 +1,57 @@
+#pragma once
+#include <example_module/common.h>
+#include <example_module/fir_design.h>
+#include <example_module/fir_filter.h>
+#include <example_module/output_packet_pool.h>
+#include <example_module/stream_input.h>
+#include <opendaq/function_block_impl.h>
+#include <opendaq/opendaq.h>
+#include <opendaq/stream_reader_ptr.h>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Linear-phase FIR filter designed with the window method. Kernels up to FirFilter::DirectMaxTaps taps are
+// convolved directly, longer ones with partitioned overlap-save.
+class FIRFilterFBImpl final : public FunctionBlock
+{
+public:
+    explicit FIRFilterFBImpl(const ContextPtr& ctx,
+                             const ComponentPtr& parent,
+                             const StringPtr& localId,
+                             const PropertyObjectPtr& config = nullptr);
+    static FunctionBlockTypePtr CreateType();
+
+private:
+    static constexpr SizeT ReadBlockSize = FftFirFilter::MaxPartitionSize;
+
+    InputPortPtr inputPort;
+    SignalConfigPtr outputSignal;
+    SignalConfigPtr outputDomainSignal;
+    OutputPacketPool outputPacketPool;
+    StreamReaderPtr reader;
+
+    std::vector<double> inputData;
+    DomainOffsetTracker domainOffsets;
+
+    FirFilter filter;
+    FirSpec firSpec;
+
+    bool configValid = false;
+
+    DataDescriptorPtr inputDataDescriptor;
+    DataDescriptorPtr inputDomainDataDescriptor;
+    DataDescriptorPtr outputDataDescriptor;
+
+    void createInputPorts();
+    void createSignals();
+    void initProperties();
+    void readProperties();
+    void propertyChanged();
+    void configure();
+
+    void calculate();
+    void processData(SizeT readAmount, SizeT packetOffset);
+    void processEventPacket(const EventPacketPtr& packet);
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
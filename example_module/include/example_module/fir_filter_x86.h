@@ -0,0 +1,120 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <example_module/common.h>
+#include <example_module/cpu_features.h>
+
+#if EXAMPLE_MODULE_SIMD_X86
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Vectorized variants of firDirectScalar. Each lane computes one output sample and the taps are
+// accumulated in the same order as the scalar kernel (no FMA), so the results are identical.
+namespace x86
+{
+    // Computes Vectors registers of consecutive outputs starting at output sample n
+    template <SizeT Vectors>
+    EXAMPLE_MODULE_TARGET_SSE2 void firOutputsSse2(const double* taps, SizeT tapCount, const double* input, double* output, SizeT n)
+    {
+        __m128d acc[Vectors];
+        for (SizeT v = 0; v < Vectors; ++v)
+            acc[v] = _mm_setzero_pd();
+
+        for (SizeT k = 0; k < tapCount; ++k)
+        {
+            const __m128d tap = _mm_set1_pd(taps[k]);
+            const double* x = input + n - k;
+            for (SizeT v = 0; v < Vectors; ++v)
+                acc[v] = _mm_add_pd(acc[v], _mm_mul_pd(tap, _mm_loadu_pd(x + v * 2)));
+        }
+
+        for (SizeT v = 0; v < Vectors; ++v)
+            _mm_storeu_pd(output + n + v * 2, acc[v]);
+    }
+
+    EXAMPLE_MODULE_TARGET_SSE2 inline SizeT firDirectSse2(const double* taps, SizeT tapCount, const double* input, double* output, SizeT count)
+    {
+        SizeT n = 0;
+        for (; n + 8 <= count; n += 8)
+            firOutputsSse2<4>(taps, tapCount, input, output, n);
+        for (; n + 2 <= count; n += 2)
+            firOutputsSse2<1>(taps, tapCount, input, output, n);
+        return n;
+    }
+
+    template <SizeT Vectors>
+    EXAMPLE_MODULE_TARGET_AVX2 void firOutputsAvx2(const double* taps, SizeT tapCount, const double* input, double* output, SizeT n)
+    {
+        __m256d acc[Vectors];
+        for (SizeT v = 0; v < Vectors; ++v)
+            acc[v] = _mm256_setzero_pd();
+
+        for (SizeT k = 0; k < tapCount; ++k)
+        {
+            const __m256d tap = _mm256_set1_pd(taps[k]);
+            const double* x = input + n - k;
+            for (SizeT v = 0; v < Vectors; ++v)
+                acc[v] = _mm256_add_pd(acc[v], _mm256_mul_pd(tap, _mm256_loadu_pd(x + v * 4)));
+        }
+
+        for (SizeT v = 0; v < Vectors; ++v)
+            _mm256_storeu_pd(output + n + v * 4, acc[v]);
+    }
+
+    EXAMPLE_MODULE_TARGET_AVX2 inline SizeT firDirectAvx2(const double* taps, SizeT tapCount, const double* input, double* output, SizeT count)
+    {
+        SizeT n = 0;
+        for (; n + 16 <= count; n += 16)
+            firOutputsAvx2<4>(taps, tapCount, input, output, n);
+        for (; n + 4 <= count; n += 4)
+            firOutputsAvx2<1>(taps, tapCount, input, output, n);
+        return n;
+    }
+
+    template <SizeT Vectors>
+    EXAMPLE_MODULE_TARGET_AVX512 void firOutputsAvx512(const double* taps, SizeT tapCount, const double* input, double* output, SizeT n)
+    {
+        __m512d acc[Vectors];
+        for (SizeT v = 0; v < Vectors; ++v)
+            acc[v] = _mm512_setzero_pd();
+
+        for (SizeT k = 0; k < tapCount; ++k)
+        {
+            const __m512d tap = _mm512_set1_pd(taps[k]);
+            const double* x = input + n - k;
+            for (SizeT v = 0; v < Vectors; ++v)
+                acc[v] = _mm512_add_pd(acc[v], _mm512_mul_pd(tap, _mm512_loadu_pd(x + v * 8)));
+        }
+
+        for (SizeT v = 0; v < Vectors; ++v)
+            _mm512_storeu_pd(output + n + v * 8, acc[v]);
+    }
+
+    EXAMPLE_MODULE_TARGET_AVX512 inline SizeT firDirectAvx512(const double* taps, SizeT tapCount, const double* input, double* output, SizeT count)
+    {
+        SizeT n = 0;
+        for (; n + 32 <= count; n += 32)
+            firOutputsAvx512<4>(taps, tapCount, input, output, n);
+        for (; n + 8 <= count; n += 8)
+            firOutputsAvx512<1>(taps, tapCount, input, output, n);
+        return n;
+    }
+}
+
+END_NAMESPACE_EXAMPLE_MODULE
+
+#endif
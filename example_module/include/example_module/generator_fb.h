@@ -0,0 +1,90 @@
+#pragma once
+#include <example_module/common.h>
+#include <example_module/output_packet_pool.h>
+#include <example_module/waveform_table.h>
+#include <opendaq/function_block_impl.h>
+#include <opendaq/opendaq.h>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Generates synthetic test signals without an input. A generator thread copies packets out of a
+// precomputed waveform table into pooled packets, paced by the wall clock or as fast as the receivers
+// allow. All channels share one table and one linear domain signal; channel c leads channel 0 by
+// c / ChannelCount of a period.
+class GeneratorFBImpl final : public FunctionBlock
+{
+public:
+    explicit GeneratorFBImpl(const ContextPtr& ctx,
+                             const ComponentPtr& parent,
+                             const StringPtr& localId,
+                             const PropertyObjectPtr& config = nullptr);
+    ~GeneratorFBImpl() override;
+
+    static FunctionBlockTypePtr CreateType();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr Int MaxSampleRate = 100000000;
+    static constexpr Int MaxPacketSize = 1 << 20;
+    static constexpr Int MaxChannelCount = 256;
+
+    struct Settings
+    {
+        WaveformSpec waveformSpec;
+        SampleType sampleType = SampleType::Float64;
+        SizeT packetSize = 0;
+        SizeT channelCount = 0;
+        bool freeRunning = false;
+        bool active = false;
+    };
+
+    struct Channel
+    {
+        SignalConfigPtr outputSignal;
+        OutputPacketPool outputPacketPool;
+        SizeT phase = 0;
+    };
+
+    std::vector<std::unique_ptr<Channel>> channels;
+    SignalConfigPtr outputDomainSignal;
+    DataDescriptorPtr outputDomainDataDescriptor;
+
+    WaveformSpec waveformSpec;
+    WaveformTable table;
+    SampleType sampleType = SampleType::Float64;
+    SizeT packetSize = 0;
+    bool freeRunning = false;
+    bool active = false;
+    bool configValid = false;
+    std::string configError;
+
+    // Domain value of the next generated sample, in ticks of 1 / SampleRate since the epoch
+    Int nextDomainValue = 0;
+
+    std::thread generatorThread;
+    std::mutex generatorMutex;
+    std::condition_variable generatorCv;
+    bool stopRequested = false;
+
+    void createSignals();
+    void initProperties();
+    Settings readSettings() const;
+    void applySettings(const Settings& settings);
+    void propertyChanged();
+    void configure();
+    void setChannelCount(SizeT count);
+
+    void start();
+    void stop();
+    void generate();
+    void sendPackets(SizeT count);
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -1,55 +1,86 @@
 #pragma once
+#include <example_module/block_properties.h>
 #include <example_module/common.h>
+#include <example_module/filter_design.h>
+#include <example_module/filter_design_stage.h>
+#include <example_module/input_processing.h>
+#include <example_module/output_packet_pool.h>
+#include <example_module/parallel_sos_filter.h>
+#include <example_module/processing_statistics.h>
+#include <example_module/scaling_kernels.h>
+#include <example_module/scratch_arena.h>
+#include <example_module/sos_crossfade.h>
+#include <example_module/trace_recorder.h>
 #include <opendaq/function_block_impl.h>
 #include <opendaq/opendaq.h>
 #include <opendaq/stream_reader_ptr.h>
+#include <memory>
 
 BEGIN_NAMESPACE_EXAMPLE_MODULE
 
 class IIRFilterFBImpl final : public FunctionBlock
 {
 public:
-    explicit IIRFilterFBImpl(const ContextPtr& ctx, const ComponentPtr& parent, const StringPtr& localId);
+    explicit IIRFilterFBImpl(const ContextPtr& ctx,
+                             const ComponentPtr& parent,
+                             const StringPtr& localId,
+                             const PropertyObjectPtr& config = nullptr);
     static FunctionBlockTypePtr CreateType();
 
 private:
-    InputPortPtr inputPort;
+    static constexpr SizeT SerialReadBlockSize = 1024;
+
+    InputPortConfigPtr inputPort;
     SignalConfigPtr outputSignal;
     SignalConfigPtr outputDomainSignal;
+    OutputPacketPool outputPacketPool;
     StreamReaderPtr reader;
+    bool packetMode = false;
+    ScalingKernel convertKernel = nullptr;
+
+    SizeT readBlockSize = SerialReadBlockSize;
+    BlockLimits blockLimits;
 
-    std::vector<double> inputData;
-    std::vector<double> inputDomainData;
+    ParallelSosFilter filter;
+    std::shared_ptr<WorkerPool> workerPool;
+    FilterDesignStage designStage;
+    SosCrossfade crossfade;
 
-    double prevInput = 0.0;
-    double prevOutput = 0.0;
-    double a0 = 1.0;
-    double a1 = 0.0;
-    double b1 = 0.0;
-    double cutoffFreq;
+    // The last accepted design; written under the acquisition lock
+    FilterSpec filterSpec;
 
     bool configValid = false;
-    SizeT sampleRate = 0;
     SampleType inputSampleType;
 
     DataDescriptorPtr inputDataDescriptor;
     DataDescriptorPtr inputDomainDataDescriptor;
+    DataDescriptorPtr outputDataDescriptor;
+
+    ProcessingStatistics statistics;
+    TraceSource trace;
+    InputReader inputReader{statistics, trace, dispatcher};
+
+    // Declared last, so that the worker thread and a running flush finish before the other members are destroyed
+    ProcessingDispatcher dispatcher{context, [this] { packetMode ? processQueuedPackets() : calculate(); }};
 
     void createInputPorts();
     void createSignals();
     void initProperties();
-    void readProperties();
-    void propertyChanged(bool configure);
+    void propertyChanged();
+    void parallelismChanged();
+    void blockPolicyChanged();
+    void updateReadBlockSize();
+    void updateMemoryUsage();
     void configure();
     void resetFilterState();
 
     void calculate();
-    void processData(SizeT readAmount, SizeT packetOffset);
+    void processData(const double* inputData, SizeT readAmount, SizeT packetOffset, uint64_t inputPosition);
+    void onPacketReceived(const InputPortPtr& port) override;
+    void processQueuedPackets();
+    void processDataPacket(const DataPacketPtr& packet, uint64_t inputPosition);
     void processEventPacket(const EventPacketPtr& packet);
     void processSignalDescriptorChanged(const DataDescriptorPtr& dataDesc, const DataDescriptorPtr& domainDesc);
-
-    void calculateFilterCoefficients(double sampleRate);
-    void validateCutoffFrequency(double cutoffFreq, double sampleRate) const;
 };
 
 END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,208 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <example_module/block_policy.h>
+#include <example_module/common.h>
+#include <example_module/deadline_timer.h>
+#include <example_module/processing_statistics.h>
+#include <example_module/processing_thread.h>
+#include <example_module/stream_input.h>
+#include <example_module/trace_recorder.h>
+#include <opendaq/opendaq.h>
+#include <opendaq/stream_reader_ptr.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Stamp the arrival of input, for the latency reported by traced blocks: the samples pending in a stream
+// reader, or the packets queued on an input port in packet mode
+void markIngress(TraceSource& trace, const StreamReaderPtr& reader);
+void markQueuedIngress(TraceSource& trace, const InputPortConfigPtr& inputPort);
+
+// Runs the processing of a function block's input where its ExecutionMode property says: on the thread
+// that notifies about new input, or on a worker thread of its own. Blocks held by a block policy are
+// flushed at their deadline by the worker thread or by a task of the context scheduler; the thread shared
+// by the deadline timers only hands the flush off.
+class ProcessingDispatcher
+{
+public:
+    // process handles all pending input and takes the acquisition lock itself
+    ProcessingDispatcher(const ContextPtr& context, std::function<void()> process);
+
+    // Joins the worker thread and waits for a running flush; declared as the last member of its function
+    // block, so that the members process uses outlive the dispatcher
+    ~ProcessingDispatcher();
+
+    ProcessingDispatcher(const ProcessingDispatcher&) = delete;
+    ProcessingDispatcher& operator=(const ProcessingDispatcher&) = delete;
+
+    // Processes the input on the calling thread, or hands it to the worker thread
+    void dataAvailable();
+
+    // Processes the input again at deadline
+    void scheduleFlush(DeadlineTimer::Clock::time_point deadline);
+
+    // Applies the ExecutionMode and CpuAffinity properties and the matching notification method of
+    // inputPort. Not called under the acquisition lock: the replaced worker thread finishes its current
+    // block before it is joined, and may be waiting for the lock. Throws std::invalid_argument if the
+    // affinity names no available CPU.
+    void setExecutionMode(const PropertyObjectPtr& objPtr, const InputPortConfigPtr& inputPort);
+
+private:
+    struct FlushTarget
+    {
+        std::mutex mutex;
+        std::function<void()> process;
+    };
+
+    void flush();
+
+    ContextPtr context;
+    std::function<void()> process;
+    std::shared_ptr<FlushTarget> flushTarget;
+    std::shared_ptr<ProcessingThread> processingThread;
+    DeadlineTimer flushTimer{[this] { flush(); }};
+};
+
+// Reads the input of a function block in the blocks its block policy asks for, and records the read span
+// and the statistics of every block. Domain offsets the reader does not report continue from the previous
+// block according to the linear domain rule.
+class InputReader
+{
+public:
+    InputReader(ProcessingStatistics& statistics, TraceSource& trace, ProcessingDispatcher& dispatcher)
+        : statistics(statistics)
+        , trace(trace)
+        , dispatcher(dispatcher)
+    {
+    }
+
+    BlockPolicy& getBlockPolicy()
+    {
+        return blockPolicy;
+    }
+
+    // Delta of the linear domain rule of the input, set when the function block is configured
+    void setDomainDelta(SizeT delta)
+    {
+        domainOffsets.setDelta(delta);
+    }
+
+    // Reads until the reader is empty, an event was handled or the block policy holds the pending samples
+    // until more arrive; called under the acquisition lock. buffer holds as many samples of the reader's
+    // value type as the block policy reads at most. Blocks read while configValid is false are dropped.
+    // processBlock(buffer, samples, domainOffset, inputPosition) handles a block and processEvent(packet)
+    // an event, after which the call ends.
+    template <typename ProcessBlock, typename ProcessEvent>
+    void readBlocks(StreamReaderPtr& reader, void* buffer, const bool& configValid, ProcessBlock&& processBlock, ProcessEvent&& processEvent)
+    {
+        while (!reader.getEmpty())
+        {
+            const auto start = BlockPolicy::Clock::now();
+            const SizeT available = reader.getAvailableCount();
+            statistics.recordBacklog(available);
+
+            SizeT readAmount = blockPolicy.getReadAmount(available, start);
+            if (readAmount == 0 && available > 0)
+            {
+                // Flushed at the deadline unless more samples arrive before the hold time expires
+                dispatcher.scheduleFlush(blockPolicy.getDeadline());
+                return;
+            }
+
+            ReaderStatusPtr status;
+            SizeT domainOffset = 0;
+            uint64_t inputPosition = 0;
+            {
+                TraceScope readSpan(trace, TraceSpan::Read);
+                status = reader.read(buffer, &readAmount);
+                domainOffset = configValid ? domainOffsets.next(status, readAmount) : 0;
+                inputPosition = trace.getInputPosition();
+                trace.consumeInput(readAmount);
+                readSpan.setBlock(static_cast<int64_t>(domainOffset), readAmount);
+            }
+
+            if (configValid)
+                processBlock(static_cast<const void*>(buffer), readAmount, domainOffset, inputPosition);
+
+            if (readAmount > 0)
+            {
+                const SizeT processed = configValid ? readAmount : 0;
+                statistics.recordBlock(readAmount, processed, 0, processed > 0 ? 1 : 0, BlockPolicy::Clock::now() - start);
+            }
+
+            if (status.getReadStatus() == ReadStatus::Event)
+            {
+                const auto eventPacket = status.getEventPacket();
+                if (eventPacket.assigned())
+                    processEvent(eventPacket);
+                return;
+            }
+        }
+    }
+
+    // Packet mode: handles the packets queued on inputPort, under the acquisition lock. Input positions
+    // count packets. Data packets that arrive while configValid is false are dropped.
+    template <typename ProcessPacket, typename ProcessEvent>
+    void readPackets(const InputPortConfigPtr& inputPort, const bool& configValid, ProcessPacket&& processPacket, ProcessEvent&& processEvent)
+    {
+        const auto connection = inputPort.getConnection();
+        if (!connection.assigned())
+            return;
+
+        PacketPtr packet = connection.dequeue();
+        while (packet.assigned())
+        {
+            const uint64_t inputPosition = trace.getInputPosition();
+            trace.consumeInput(1);
+
+            switch (packet.getType())
+            {
+                case PacketType::Event:
+                    processEvent(packet.asPtr<IEventPacket>());
+                    break;
+                case PacketType::Data:
+                    if (configValid)
+                    {
+                        const auto start = ProcessingStatistics::Clock::now();
+                        const auto dataPacket = packet.asPtr<IDataPacket>();
+                        processPacket(dataPacket, inputPosition);
+
+                        const SizeT sampleCount = dataPacket.getSampleCount();
+                        statistics.recordBlock(
+                            sampleCount, sampleCount, 1, sampleCount > 0 ? 1 : 0, ProcessingStatistics::Clock::now() - start);
+                    }
+                    break;
+                default:
+                    break;
+            }
+
+            packet = connection.dequeue();
+        }
+    }
+
+private:
+    ProcessingStatistics& statistics;
+    TraceSource& trace;
+    ProcessingDispatcher& dispatcher;
+    BlockPolicy blockPolicy;
+    DomainOffsetTracker domainOffsets;
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
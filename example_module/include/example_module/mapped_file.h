@@ -0,0 +1,326 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <example_module/common.h>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <cerrno>
+    #include <cstring>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Mapped view of a range of a MappedFile. Views are independent of each other and of the file object:
+// they can be flushed and unmapped from any thread while other views are written.
+class MappedRegion
+{
+public:
+    MappedRegion() = default;
+
+    MappedRegion(const MappedRegion&) = delete;
+    MappedRegion& operator=(const MappedRegion&) = delete;
+
+    MappedRegion(MappedRegion&& other) noexcept
+        : data(other.data)
+        , size(other.size)
+    {
+        other.data = nullptr;
+        other.size = 0;
+    }
+
+    MappedRegion& operator=(MappedRegion&& other) noexcept
+    {
+        if (this != &other)
+        {
+            unmap();
+            data = other.data;
+            size = other.size;
+            other.data = nullptr;
+            other.size = 0;
+        }
+        return *this;
+    }
+
+    ~MappedRegion()
+    {
+        unmap();
+    }
+
+    uint8_t* getData() const
+    {
+        return static_cast<uint8_t*>(data);
+    }
+
+    SizeT getSize() const
+    {
+        return size;
+    }
+
+    bool isMapped() const
+    {
+        return data != nullptr;
+    }
+
+    // Writes the dirty pages of the view to the file and waits for the write to complete
+    void flush()
+    {
+        if (!data)
+            return;
+#ifdef _WIN32
+        FlushViewOfFile(data, size);
+#else
+        msync(data, size, MS_SYNC);
+#endif
+    }
+
+    void unmap()
+    {
+        if (!data)
+            return;
+#ifdef _WIN32
+        UnmapViewOfFile(data);
+#else
+        munmap(data, size);
+#endif
+        data = nullptr;
+        size = 0;
+    }
+
+private:
+    friend class MappedFile;
+
+    MappedRegion(void* data, SizeT size)
+        : data(data)
+        , size(size)
+    {
+    }
+
+    void* data = nullptr;
+    SizeT size = 0;
+};
+
+// File accessed through memory-mapped views. create() opens a new file for writing and allocates it up
+// front, so that writes to the views never extend the file; truncate() shrinks it to the used size once
+// all views are unmapped. open() opens an existing file for reading, its views are read-only.
+class MappedFile
+{
+public:
+    // Offsets of views must be multiples of the alignment (the page size, or the allocation
+    // granularity on Windows)
+    static constexpr SizeT Alignment = 64 * 1024;
+
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile()
+    {
+        close();
+    }
+
+    // Creates or replaces the file at path with size bytes of zeros
+    void create(const std::string& path, SizeT size)
+    {
+        close();
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            throw std::runtime_error("Cannot create " + path + ": error " + std::to_string(GetLastError()));
+
+        LARGE_INTEGER fileSize;
+        fileSize.QuadPart = static_cast<LONGLONG>(size);
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, fileSize.HighPart, fileSize.LowPart, nullptr);
+        if (mapping == nullptr)
+        {
+            const auto error = GetLastError();
+            close();
+            throw std::runtime_error("Cannot allocate " + std::to_string(size) + " bytes for " + path + ": error " + std::to_string(error));
+        }
+#else
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+            throw std::runtime_error("Cannot create " + path + ": " + std::strerror(errno));
+
+    #ifdef __linux__
+        // Allocates the blocks now; a full disk would otherwise fault on a later write to a view
+        const int error = posix_fallocate(fd, 0, static_cast<off_t>(size));
+    #else
+        const int error = ftruncate(fd, static_cast<off_t>(size)) == 0 ? 0 : errno;
+    #endif
+        if (error != 0)
+        {
+            close();
+            throw std::runtime_error("Cannot allocate " + std::to_string(size) + " bytes for " + path + ": " + std::strerror(error));
+        }
+#endif
+        this->size = size;
+        writable = true;
+    }
+
+    void open(const std::string& path)
+    {
+        close();
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            throw std::runtime_error("Cannot open " + path + ": error " + std::to_string(GetLastError()));
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize))
+        {
+            const auto error = GetLastError();
+            close();
+            throw std::runtime_error("Cannot read the size of " + path + ": error " + std::to_string(error));
+        }
+
+        // Empty files cannot be mapped
+        if (fileSize.QuadPart > 0)
+        {
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping == nullptr)
+            {
+                const auto error = GetLastError();
+                close();
+                throw std::runtime_error("Cannot map " + path + ": error " + std::to_string(error));
+            }
+        }
+        size = static_cast<SizeT>(fileSize.QuadPart);
+#else
+        fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("Cannot open " + path + ": " + std::strerror(errno));
+
+        const off_t end = lseek(fd, 0, SEEK_END);
+        if (end < 0)
+        {
+            const int error = errno;
+            close();
+            throw std::runtime_error("Cannot read the size of " + path + ": " + std::strerror(error));
+        }
+        size = static_cast<SizeT>(end);
+#endif
+        writable = false;
+    }
+
+    bool isOpen() const
+    {
+#ifdef _WIN32
+        return file != INVALID_HANDLE_VALUE;
+#else
+        return fd >= 0;
+#endif
+    }
+
+    SizeT getSize() const
+    {
+        return size;
+    }
+
+    // Maps length bytes at offset, for writing if the file was created. With prefault, the pages are
+    // faulted in before the call returns, so that the first access does not wait for the page cache.
+    MappedRegion map(SizeT offset, SizeT length, bool prefault) const
+    {
+        if (offset % Alignment != 0 || offset + length > size || length == 0)
+            throw std::invalid_argument("Mapped range is empty, outside of the file or not aligned");
+
+#ifdef _WIN32
+        LARGE_INTEGER viewOffset;
+        viewOffset.QuadPart = static_cast<LONGLONG>(offset);
+        void* data = MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, viewOffset.HighPart, viewOffset.LowPart, length);
+        if (data == nullptr)
+            throw std::runtime_error("Cannot map the file: error " + std::to_string(GetLastError()));
+        if (prefault)
+        {
+            WIN32_MEMORY_RANGE_ENTRY range{data, length};
+            PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+        }
+#else
+        int flags = MAP_SHARED;
+    #ifdef MAP_POPULATE
+        if (prefault)
+            flags |= MAP_POPULATE;
+    #endif
+        void* data = mmap(nullptr, length, writable ? PROT_READ | PROT_WRITE : PROT_READ, flags, fd, static_cast<off_t>(offset));
+        if (data == MAP_FAILED)
+            throw std::runtime_error(std::string("Cannot map the file: ") + std::strerror(errno));
+    #ifndef MAP_POPULATE
+        if (prefault)
+            madvise(data, length, MADV_WILLNEED);
+    #endif
+#endif
+        return MappedRegion(data, length);
+    }
+
+    // Shrinks or grows the file; all views must be unmapped
+    void truncate(SizeT newSize)
+    {
+#ifdef _WIN32
+        CloseHandle(mapping);
+        mapping = nullptr;
+        LARGE_INTEGER position;
+        position.QuadPart = static_cast<LONGLONG>(newSize);
+        if (!SetFilePointerEx(file, position, nullptr, FILE_BEGIN) || !SetEndOfFile(file))
+            throw std::runtime_error("Cannot resize the file: error " + std::to_string(GetLastError()));
+#else
+        if (ftruncate(fd, static_cast<off_t>(newSize)) != 0)
+            throw std::runtime_error(std::string("Cannot resize the file: ") + std::strerror(errno));
+#endif
+        size = newSize;
+    }
+
+    void close()
+    {
+#ifdef _WIN32
+        if (mapping != nullptr)
+            CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE)
+            CloseHandle(file);
+        mapping = nullptr;
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (fd >= 0)
+            ::close(fd);
+        fd = -1;
+#endif
+        size = 0;
+    }
+
+private:
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+    SizeT size = 0;
+    bool writable = false;
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,340 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+#include <example_module/common.h>
+#include <example_module/dispatch.h>
+#include <opendaq/sample_type_traits.h>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Per-sample operators of an operator chain; a and b are the parameters of the operator
+enum class ChainOperatorType
+{
+    Offset = 0,  // x + a
+    Gain,        // x * a
+    Clamp,       // x limited to [a, b]
+    Abs,         // |x|
+    Square,      // x * x
+    DeadBand,    // 0 if |x| < a, else x
+    Convert      // x * a + b, e.g. a unit conversion
+};
+
+struct ChainOperator
+{
+    ChainOperatorType type = ChainOperatorType::Offset;
+    double a = 0.0;
+    double b = 0.0;
+};
+
+template <ChainOperatorType Type>
+inline double applyChainOperator(double x, const ChainOperator& op)
+{
+    if constexpr (Type == ChainOperatorType::Offset)
+        return x + op.a;
+    else if constexpr (Type == ChainOperatorType::Gain)
+        return x * op.a;
+    else if constexpr (Type == ChainOperatorType::Clamp)
+        return std::min(std::max(x, op.a), op.b);
+    else if constexpr (Type == ChainOperatorType::Abs)
+        return std::abs(x);
+    else if constexpr (Type == ChainOperatorType::Square)
+        return x * x;
+    else if constexpr (Type == ChainOperatorType::DeadBand)
+        return std::abs(x) < op.a ? 0.0 : x;
+    else
+        return x * op.a + op.b;
+}
+
+// Parses one operator written as its name followed by its parameters, e.g. "Gain 2.5", "Clamp -1 1" or
+// "Abs"; throws std::invalid_argument on unknown names, missing or extra parameters and invalid values
+inline ChainOperator parseChainOperator(const std::string& text)
+{
+    static const std::pair<const char*, ChainOperatorType> Names[] = {{"Offset", ChainOperatorType::Offset},
+                                                                        {"Gain", ChainOperatorType::Gain},
+                                                                        {"Clamp", ChainOperatorType::Clamp},
+                                                                        {"Abs", ChainOperatorType::Abs},
+                                                                        {"Square", ChainOperatorType::Square},
+                                                                        {"DeadBand", ChainOperatorType::DeadBand},
+                                                                        {"Convert", ChainOperatorType::Convert}};
+
+    std::istringstream stream(text);
+    std::string name;
+    stream >> name;
+
+    const auto it = std::find_if(std::begin(Names), std::end(Names), [&name](const auto& entry) { return name == entry.first; });
+    if (it == std::end(Names))
+        throw std::invalid_argument("Unknown operator \"" + text + "\"");
+
+    ChainOperator op;
+    op.type = it->second;
+
+    SizeT parameterCount = 0;
+    if (op.type == ChainOperatorType::Clamp || op.type == ChainOperatorType::Convert)
+        parameterCount = 2;
+    else if (op.type != ChainOperatorType::Abs && op.type != ChainOperatorType::Square)
+        parameterCount = 1;
+
+    double* parameters[] = {&op.a, &op.b};
+    for (SizeT i = 0; i < parameterCount; ++i)
+    {
+        if (!(stream >> *parameters[i]) || !std::isfinite(*parameters[i]))
+            throw std::invalid_argument("Operator \"" + text + "\" expects " + std::to_string(parameterCount) + " finite parameter(s)");
+    }
+
+    std::string extra;
+    if (stream >> extra)
+        throw std::invalid_argument("Operator \"" + text + "\" has too many parameters");
+    if (op.type == ChainOperatorType::Clamp && op.a > op.b)
+        throw std::invalid_argument("Operator \"" + text + "\" has a lower limit above its upper limit");
+    if (op.type == ChainOperatorType::DeadBand && op.a < 0.0)
+        throw std::invalid_argument("Operator \"" + text + "\" has a negative width");
+
+    return op;
+}
+
+// Converts the input from its native sample type and applies the operators to each sample
+using OperatorChainKernel = void (*)(const void* input, double* output, SizeT count, const ChainOperator* operators);
+
+template <ChainOperatorType... Types, SizeT... Indices>
+inline double applyChainOperators(double x, const ChainOperator* operators, std::index_sequence<Indices...>)
+{
+    ((x = applyChainOperator<Types>(x, operators[Indices])), ...);
+    return x;
+}
+
+// The whole chain runs per sample with the parameters in registers, so the compiler can vectorize it
+template <SampleType InputType, ChainOperatorType... Types>
+void processOperatorChain(const void* input, double* output, SizeT count, const ChainOperator* operators)
+{
+    using InputT = typename SampleTypeToType<InputType>::Type;
+
+    // Local copies, which the output cannot alias
+    std::array<ChainOperator, sizeof...(Types)> ops{};
+    std::copy_n(operators, sizeof...(Types), ops.begin());
+
+    const auto* in = static_cast<const InputT*>(input);
+    for (SizeT i = 0; i < count; ++i)
+        output[i] = applyChainOperators<Types...>(static_cast<double>(in[i]), ops.data(), std::make_index_sequence<sizeof...(Types)>{});
+}
+
+template <ChainOperatorType... Types>
+struct OperatorSequence
+{
+    static bool matches(const std::vector<ChainOperator>& operators)
+    {
+        static constexpr std::array<ChainOperatorType, sizeof...(Types)> types{Types...};
+        return operators.size() == types.size() &&
+               std::equal(types.begin(), types.end(), operators.begin(), [](ChainOperatorType type, const ChainOperator& op) { return type == op.type; });
+    }
+
+    template <SampleType InputType>
+    static constexpr OperatorChainKernel kernel = &processOperatorChain<InputType, Types...>;
+};
+
+// Operator sequences with a specialized kernel for every sample type; the empty sequence only converts
+using CommonOperatorSequences = std::tuple<OperatorSequence<>,
+                                           OperatorSequence<ChainOperatorType::Offset>,
+                                           OperatorSequence<ChainOperatorType::Gain>,
+                                           OperatorSequence<ChainOperatorType::Convert>,
+                                           OperatorSequence<ChainOperatorType::Gain, ChainOperatorType::Offset>,
+                                           OperatorSequence<ChainOperatorType::Offset, ChainOperatorType::Gain>,
+                                           OperatorSequence<ChainOperatorType::Gain, ChainOperatorType::Offset, ChainOperatorType::Clamp>,
+                                           OperatorSequence<ChainOperatorType::Convert, ChainOperatorType::Clamp>,
+                                           OperatorSequence<ChainOperatorType::Offset, ChainOperatorType::Abs>,
+                                           OperatorSequence<ChainOperatorType::Offset, ChainOperatorType::Square>,
+                                           OperatorSequence<ChainOperatorType::DeadBand>,
+                                           OperatorSequence<ChainOperatorType::Offset, ChainOperatorType::DeadBand>>;
+
+// Assigns the specialized kernel of the first matching sequence, or nullptr if none matches
+template <SampleType InputType>
+void assignOperatorChainKernel(OperatorChainKernel& kernel, const std::vector<ChainOperator>& operators)
+{
+    kernel = nullptr;
+    std::apply(
+        [&](auto... sequences)
+        {
+            ((decltype(sequences)::matches(operators) ? (kernel = decltype(sequences)::template kernel<InputType>, true) : false) || ...);
+        },
+        CommonOperatorSequences{});
+}
+
+inline OperatorChainKernel getOperatorChainKernel(SampleType sampleType, const std::vector<ChainOperator>& operators)
+{
+    OperatorChainKernel kernel = nullptr;
+    SAMPLE_TYPE_DISPATCH(sampleType, assignOperatorChainKernel, kernel, operators)
+    return kernel;
+}
+
+// Ordered list of per-sample operators applied in one pass over a block. Common sequences run a
+// specialized kernel; any other sequence is interpreted tile by tile: a tile is converted into the output
+// and each operator then runs a tight loop over it while it is in L1.
+class OperatorChain
+{
+public:
+    static constexpr SizeT TileSize = 512;
+
+    // Selects the kernel for the operators and the input sample type
+    void setOperators(std::vector<ChainOperator> chainOperators, SampleType inputSampleType)
+    {
+        operators = std::move(chainOperators);
+        specializedKernel = getOperatorChainKernel(inputSampleType, operators);
+        convertKernel = getOperatorChainKernel(inputSampleType, {});
+        inputSampleSize = getSampleSize(inputSampleType);
+    }
+
+    const std::vector<ChainOperator>& getOperators() const
+    {
+        return operators;
+    }
+
+    bool isSpecialized() const
+    {
+        return specializedKernel != nullptr;
+    }
+
+    void process(const void* input, double* output, SizeT count) const
+    {
+        if (specializedKernel)
+            specializedKernel(input, output, count, operators.data());
+        else
+            interpret(input, output, count);
+    }
+
+    // The fallback of process; gives the same result as the specialized kernels
+    void interpret(const void* input, double* output, SizeT count) const
+    {
+        const auto* in = static_cast<const uint8_t*>(input);
+        for (SizeT tileStart = 0; tileStart < count; tileStart += TileSize)
+        {
+            const SizeT tileCount = std::min(TileSize, count - tileStart);
+            double* tile = output + tileStart;
+
+            convertKernel(in + tileStart * inputSampleSize, tile, tileCount, nullptr);
+            for (const auto& op : operators)
+            {
+                switch (op.type)
+                {
+                    case ChainOperatorType::Offset:
+                        applyToTile<ChainOperatorType::Offset>(tile, tileCount, op);
+                        break;
+                    case ChainOperatorType::Gain:
+                        applyToTile<ChainOperatorType::Gain>(tile, tileCount, op);
+                        break;
+                    case ChainOperatorType::Clamp:
+                        applyToTile<ChainOperatorType::Clamp>(tile, tileCount, op);
+                        break;
+                    case ChainOperatorType::Abs:
+                        applyToTile<ChainOperatorType::Abs>(tile, tileCount, op);
+                        break;
+                    case ChainOperatorType::Square:
+                        applyToTile<ChainOperatorType::Square>(tile, tileCount, op);
+                        break;
+                    case ChainOperatorType::DeadBand:
+                        applyToTile<ChainOperatorType::DeadBand>(tile, tileCount, op);
+                        break;
+                    case ChainOperatorType::Convert:
+                        applyToTile<ChainOperatorType::Convert>(tile, tileCount, op);
+                        break;
+                }
+            }
+        }
+    }
+
+    // Range of the output for inputs within [low, high]. Abs and Square decrease below zero and increase
+    // above it; all other operators are monotonic.
+    std::pair<double, double> getOutputRange(double low, double high) const
+    {
+        for (const auto& op : operators)
+        {
+            switch (op.type)
+            {
+                case ChainOperatorType::Offset:
+                case ChainOperatorType::Gain:
+                case ChainOperatorType::Convert:
+                case ChainOperatorType::Clamp:
+                case ChainOperatorType::DeadBand:
+                {
+                    // Monotonic, but decreasing for negative factors
+                    const double first = applyOperator(op, low);
+                    const double second = applyOperator(op, high);
+                    low = std::min(first, second);
+                    high = std::max(first, second);
+                    break;
+                }
+                case ChainOperatorType::Abs:
+                case ChainOperatorType::Square:
+                {
+                    const double first = applyOperator(op, low);
+                    const double second = applyOperator(op, high);
+                    low = low <= 0.0 && high >= 0.0 ? 0.0 : std::min(first, second);
+                    high = std::max(first, second);
+                    break;
+                }
+            }
+        }
+
+        return {low, high};
+    }
+
+private:
+    template <ChainOperatorType Type>
+    static void applyToTile(double* tile, SizeT count, ChainOperator op)
+    {
+        for (SizeT i = 0; i < count; ++i)
+            tile[i] = applyChainOperator<Type>(tile[i], op);
+    }
+
+    static double applyOperator(const ChainOperator& op, double x)
+    {
+        switch (op.type)
+        {
+            case ChainOperatorType::Offset:
+                return applyChainOperator<ChainOperatorType::Offset>(x, op);
+            case ChainOperatorType::Gain:
+                return applyChainOperator<ChainOperatorType::Gain>(x, op);
+            case ChainOperatorType::Clamp:
+                return applyChainOperator<ChainOperatorType::Clamp>(x, op);
+            case ChainOperatorType::Abs:
+                return applyChainOperator<ChainOperatorType::Abs>(x, op);
+            case ChainOperatorType::Square:
+                return applyChainOperator<ChainOperatorType::Square>(x, op);
+            case ChainOperatorType::DeadBand:
+                return applyChainOperator<ChainOperatorType::DeadBand>(x, op);
+            case ChainOperatorType::Convert:
+                return applyChainOperator<ChainOperatorType::Convert>(x, op);
+        }
+        return x;
+    }
+
+    std::vector<ChainOperator> operators;
+    OperatorChainKernel specializedKernel = nullptr;
+    OperatorChainKernel convertKernel = nullptr;
+    SizeT inputSampleSize = 0;
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
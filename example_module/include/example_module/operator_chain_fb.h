@@ -0,0 +1,59 @@
+#pragma once
+#include <example_module/common.h>
+#include <example_module/operator_chain.h>
+#include <example_module/output_packet_pool.h>
+#include <example_module/stream_input.h>
+#include <opendaq/function_block_impl.h>
+#include <opendaq/opendaq.h>
+#include <opendaq/stream_reader_ptr.h>
+#include <vector>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Applies an ordered list of per-sample operators (see operator_chain.h) to its input in one pass. The
+// input is read in its native sample type, and common operator sequences run a specialized kernel.
+class OperatorChainFBImpl final : public FunctionBlock
+{
+public:
+    explicit OperatorChainFBImpl(const ContextPtr& ctx,
+                                 const ComponentPtr& parent,
+                                 const StringPtr& localId,
+                                 const PropertyObjectPtr& config = nullptr);
+    static FunctionBlockTypePtr CreateType();
+
+private:
+    static constexpr SizeT ReadBlockSize = 4096;
+
+    InputPortPtr inputPort;
+    SignalConfigPtr outputSignal;
+    SignalConfigPtr outputDomainSignal;
+    OutputPacketPool outputPacketPool;
+    StreamReaderPtr reader;
+
+    // Native input samples of one read block, of up to 8 bytes each
+    std::vector<uint8_t> inputData;
+    DomainOffsetTracker domainOffsets;
+
+    std::vector<ChainOperator> operators;
+    std::string outputUnit;
+    OperatorChain chain;
+
+    bool configValid = false;
+
+    DataDescriptorPtr inputDataDescriptor;
+    DataDescriptorPtr inputDomainDataDescriptor;
+    DataDescriptorPtr outputDataDescriptor;
+
+    void createInputPorts();
+    void createSignals();
+    void initProperties();
+    std::vector<ChainOperator> readOperators() const;
+    void propertyChanged();
+    void configure();
+
+    void calculate();
+    void processData(SizeT readAmount, SizeT packetOffset);
+    void processEventPacket(const EventPacketPtr& packet);
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
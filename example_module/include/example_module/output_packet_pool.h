@@ -0,0 +1,178 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <example_module/common.h>
+#include <opendaq/data_descriptor_ptr.h>
+#include <opendaq/deleter_factory.h>
+#include <opendaq/packet_factory.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Recycles the data buffers of one output signal's packets. Buffers are handed to the packets as
+// external memory and return to the pool once downstream releases the last reference to the packet,
+// so steady-state streaming with a fixed block size does not allocate sample memory.
+//
+// Buffers are keyed by the output descriptor (a new descriptor starts a new generation, buffers of
+// older generations are freed when returned) and by their byte size, i.e. the sample count.
+class OutputPacketPool
+{
+public:
+    // Upper bound of idle buffers kept per size, so a burst of held packets does not pin memory
+    static constexpr SizeT MaxFreeBuffersPerSize = 64;
+
+    OutputPacketPool()
+        : freeLists(std::make_shared<FreeLists>())
+    {
+        // A single deleter is shared by all packets; the buffer header tells it where the buffer belongs
+        deleter = Deleter([lists = freeLists](void* data) { lists->release(data); });
+    }
+
+    OutputPacketPool(const OutputPacketPool&) = delete;
+    OutputPacketPool& operator=(const OutputPacketPool&) = delete;
+
+    void setDescriptor(const DataDescriptorPtr& dataDescriptor)
+    {
+        if (descriptor == dataDescriptor)
+            return;
+
+        descriptor = dataDescriptor;
+        sampleSize = dataDescriptor.assigned() ? dataDescriptor.getRawSampleSize() : 0;
+        freeLists->startGeneration();
+    }
+
+    DataPacketPtr createPacket(const DataPacketPtr& domainPacket, SizeT sampleCount, const NumberPtr& offset = nullptr)
+    {
+        const SizeT size = sampleCount * sampleSize;
+        void* data = freeLists->acquire(size);
+        return DataPacketWithExternalMemory(domainPacket, descriptor, sampleCount, data, deleter, offset, size);
+    }
+
+    // Number of sample buffers allocated from the heap since the pool was created
+    SizeT getAllocationCount() const
+    {
+        return freeLists->allocationCount.load(std::memory_order_relaxed);
+    }
+
+    SizeT getFreeBufferCount() const
+    {
+        return freeLists->getFreeCount();
+    }
+
+private:
+    // Placed in front of each buffer; its size keeps the samples 64-byte aligned
+    struct alignas(64) BufferHeader
+    {
+        SizeT size;
+        SizeT generation;
+    };
+
+    static constexpr std::align_val_t BufferAlignment{alignof(BufferHeader)};
+
+    // Shared with the deleter, so that packets may outlive the pool (and the function block)
+    struct FreeLists
+    {
+        std::mutex mutex;
+        std::unordered_map<SizeT, std::vector<BufferHeader*>> buffers;
+        SizeT generation = 0;
+        std::atomic<SizeT> allocationCount{0};
+
+        ~FreeLists()
+        {
+            clear();
+        }
+
+        void* acquire(SizeT size)
+        {
+            SizeT currentGeneration;
+            {
+                std::scoped_lock lock(mutex);
+                const auto it = buffers.find(size);
+                if (it != buffers.end() && !it->second.empty())
+                {
+                    BufferHeader* header = it->second.back();
+                    it->second.pop_back();
+                    return header + 1;
+                }
+                currentGeneration = generation;
+            }
+
+            allocationCount.fetch_add(1, std::memory_order_relaxed);
+            auto* header = static_cast<BufferHeader*>(::operator new(sizeof(BufferHeader) + size, BufferAlignment));
+            header->size = size;
+            header->generation = currentGeneration;
+            return header + 1;
+        }
+
+        void release(void* data)
+        {
+            BufferHeader* header = static_cast<BufferHeader*>(data) - 1;
+            {
+                std::scoped_lock lock(mutex);
+                if (header->generation == generation)
+                {
+                    auto& list = buffers[header->size];
+                    if (list.size() < MaxFreeBuffersPerSize)
+                    {
+                        list.push_back(header);
+                        return;
+                    }
+                }
+            }
+
+            ::operator delete(header, BufferAlignment);
+        }
+
+        void startGeneration()
+        {
+            std::scoped_lock lock(mutex);
+            ++generation;
+            clear();
+        }
+
+        SizeT getFreeCount()
+        {
+            std::scoped_lock lock(mutex);
+            SizeT count = 0;
+            for (const auto& [size, list] : buffers)
+                count += list.size();
+            return count;
+        }
+
+        void clear()
+        {
+            for (auto& [size, list] : buffers)
+            {
+                for (BufferHeader* header : list)
+                    ::operator delete(header, BufferAlignment);
+            }
+            buffers.clear();
+        }
+    };
+
+    std::shared_ptr<FreeLists> freeLists;
+    DeleterPtr deleter;
+    DataDescriptorPtr descriptor;
+    SizeT sampleSize = 0;
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
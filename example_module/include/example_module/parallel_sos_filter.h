@@ -0,0 +1,261 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <example_module/common.h>
+#include <example_module/sos_filter.h>
+#include <example_module/worker_pool.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Cascade of second-order sections that filters large blocks on a worker pool. The filter is a linear
+// recurrence over the state vector s (two values per section): s[n+1] = A s[n] + B x[n]. A block is
+// split into segments, and the output of a segment is the sum of two parts:
+//   - the zero-state response, i.e. the segment filtered from a cleared state, computed for all
+//     segments concurrently, which also yields the segment's zero-state end state z;
+//   - the zero-input response to the segment's true initial state s0, which is a linear combination
+//     of the precomputed responses to the unit states.
+// The initial states follow from a short sequential scan, s0[j+1] = A^L s0[j] + z[j], and the zero-input
+// responses are then added concurrently. The first segment is filtered directly from the true state.
+//
+// Tolerance: the result equals the serial filter up to rounding, because the output is summed in a
+// different order. The difference grows with the transient gain of the filter (poles close to the unit
+// circle). For designs up to order 16 with a cutoff down to 1/1000 of the sample rate it stays below
+// 1e-8 of the peak output, about ten times the rounding error of the serial filter itself.
+class ParallelSosFilter
+{
+public:
+    static constexpr SizeT DefaultSegmentSize = 8192;
+
+    ParallelSosFilter() = default;
+
+    // Replaces the cascade and clears the filter state
+    void setSections(std::vector<BiquadCoefficients> sections)
+    {
+        filter.setSections(std::move(sections));
+        basisValid = false;
+    }
+
+    // Replaces the coefficients and keeps the state if the section count is unchanged
+    void updateSections(std::vector<BiquadCoefficients> sections)
+    {
+        filter.updateSections(std::move(sections));
+        basisValid = false;
+    }
+
+    const std::vector<BiquadCoefficients>& getSections() const
+    {
+        return filter.getSections();
+    }
+
+    const std::vector<BiquadState>& getStates() const
+    {
+        return filter.getStates();
+    }
+
+    void reset()
+    {
+        filter.reset();
+    }
+
+    // Blocks are processed serially without a pool, or with a pool of a single thread
+    void setWorkerPool(std::shared_ptr<WorkerPool> workerPool)
+    {
+        pool = std::move(workerPool);
+    }
+
+    void setSegmentSize(SizeT size)
+    {
+        segmentSize = std::max<SizeT>(size, 1);
+        basisValid = false;
+    }
+
+    SizeT getSegmentSize() const
+    {
+        return segmentSize;
+    }
+
+    // Heap memory of the filter, including the basis that is computed with the first block filtered in parallel
+    SizeT getMemoryUsage() const
+    {
+        SizeT bytes = filter.getMemoryUsage();
+        if (pool && pool->getThreadCount() > 1)
+        {
+            const SizeT stateSize = 2 * filter.getSectionCount();
+            bytes += (stateSize * segmentSize + stateSize * stateSize) * sizeof(double);
+        }
+        return bytes;
+    }
+
+    // Input and output may be the same buffer
+    void process(const double* input, double* output, SizeT count)
+    {
+        const SizeT sectionCount = filter.getSectionCount();
+        if (sectionCount == 0 || !pool || pool->getThreadCount() <= 1 || count <= segmentSize)
+        {
+            filter.process(input, output, count);
+            return;
+        }
+
+        if (!basisValid)
+            updateBasis();
+
+        const SizeT stateSize = 2 * sectionCount;
+        const SizeT segmentCount = (count - 1) / segmentSize;
+        const SizeT firstLength = count - segmentCount * segmentSize;
+        const BiquadCoefficients* coefficients = filter.getSections().data();
+
+        segmentStates.assign(segmentCount * sectionCount, BiquadState{});
+        pool->run(segmentCount + 1,
+                  [&](SizeT task)
+                  {
+                      if (task == 0)
+                      {
+                          filter.process(input, output, firstLength);
+                          return;
+                      }
+
+                      const SizeT offset = firstLength + (task - 1) * segmentSize;
+                      SosFilter::processCascade(coefficients,
+                                                segmentStates.data() + (task - 1) * sectionCount,
+                                                sectionCount,
+                                                input + offset,
+                                                output + offset,
+                                                segmentSize);
+                  });
+
+        scanInitialStates(segmentCount);
+
+        pool->run(segmentCount,
+                  [&](SizeT segment)
+                  {
+                      addZeroInputResponse(initialStates.data() + segment * stateSize, output + firstLength + segment * segmentSize);
+                  });
+    }
+
+private:
+    static constexpr SizeT FixUpTileSize = 512;
+
+    // Filters each unit state with zero input for one segment
+    void updateBasis()
+    {
+        const SizeT sectionCount = filter.getSectionCount();
+        const SizeT stateSize = 2 * sectionCount;
+        const std::vector<double> zeros(segmentSize, 0.0);
+
+        basisResponses.resize(stateSize * segmentSize);
+        transition.resize(stateSize * stateSize);
+
+        pool->run(stateSize,
+                  [&](SizeT unit)
+                  {
+                      std::vector<BiquadState> states(sectionCount);
+                      if (unit % 2 == 0)
+                          states[unit / 2].s1 = 1.0;
+                      else
+                          states[unit / 2].s2 = 1.0;
+
+                      SosFilter::processCascade(
+                          filter.getSections().data(), states.data(), sectionCount, zeros.data(), basisResponses.data() + unit * segmentSize, segmentSize);
+
+                      for (SizeT section = 0; section < sectionCount; ++section)
+                      {
+                          transition[(2 * section) * stateSize + unit] = states[section].s1;
+                          transition[(2 * section + 1) * stateSize + unit] = states[section].s2;
+                      }
+                  });
+
+        basisValid = true;
+    }
+
+    // Propagates the state from the end of the first segment through all segments and leaves the
+    // filter in the state at the end of the block
+    void scanInitialStates(SizeT segmentCount)
+    {
+        const SizeT sectionCount = filter.getSectionCount();
+        const SizeT stateSize = 2 * sectionCount;
+
+        std::vector<double> state(stateSize);
+        for (SizeT section = 0; section < sectionCount; ++section)
+        {
+            state[2 * section] = filter.getStates()[section].s1;
+            state[2 * section + 1] = filter.getStates()[section].s2;
+        }
+
+        initialStates.resize(segmentCount * stateSize);
+        std::vector<double> next(stateSize);
+        for (SizeT segment = 0; segment < segmentCount; ++segment)
+        {
+            std::copy(state.begin(), state.end(), initialStates.begin() + segment * stateSize);
+
+            const BiquadState* zeroStateEnd = segmentStates.data() + segment * sectionCount;
+            for (SizeT row = 0; row < stateSize; ++row)
+            {
+                double value = row % 2 == 0 ? zeroStateEnd[row / 2].s1 : zeroStateEnd[row / 2].s2;
+                for (SizeT column = 0; column < stateSize; ++column)
+                    value += transition[row * stateSize + column] * state[column];
+                next[row] = value;
+            }
+            state.swap(next);
+        }
+
+        std::vector<BiquadState> endStates(sectionCount);
+        for (SizeT section = 0; section < sectionCount; ++section)
+        {
+            endStates[section].s1 = state[2 * section];
+            endStates[section].s2 = state[2 * section + 1];
+        }
+        filter.setStates(endStates);
+    }
+
+    void addZeroInputResponse(const double* initialState, double* output) const
+    {
+        const SizeT stateSize = 2 * filter.getSectionCount();
+        for (SizeT tileStart = 0; tileStart < segmentSize; tileStart += FixUpTileSize)
+        {
+            const SizeT tileCount = std::min(FixUpTileSize, segmentSize - tileStart);
+            double* out = output + tileStart;
+            for (SizeT unit = 0; unit < stateSize; ++unit)
+            {
+                const double weight = initialState[unit];
+                if (weight == 0.0)
+                    continue;
+
+                const double* response = basisResponses.data() + unit * segmentSize + tileStart;
+                for (SizeT i = 0; i < tileCount; ++i)
+                    out[i] += weight * response[i];
+            }
+        }
+    }
+
+    SosFilter filter;
+    std::shared_ptr<WorkerPool> pool;
+    SizeT segmentSize = DefaultSegmentSize;
+
+    // Zero-input responses to the unit states ([unit][sample]) and the state transition over one
+    // segment ([row][unit]), valid for the current sections and segment size
+    std::vector<double> basisResponses;
+    std::vector<double> transition;
+    bool basisValid = false;
+
+    std::vector<BiquadState> segmentStates;
+    std::vector<double> initialStates;
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
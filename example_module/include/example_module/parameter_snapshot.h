@@ -0,0 +1,86 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <example_module/common.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Immutable, versioned parameter block published read-copy-update style. Writers build a new snapshot
+// and swap the pointer; readers load the pointer once per block and keep using that snapshot, which stays
+// alive until the last reader releases it. Writers are serialized among themselves but never wait for
+// readers, and readers never wait for a writer building its snapshot.
+//
+// The pointer is swapped with the std::atomic_load/atomic_store overloads for shared_ptr. They are not
+// required to be lock-free; common implementations guard just the pointer copy with a spinlock from a
+// small pool, which is held for a few instructions and never while a snapshot is built or destroyed.
+template <typename T>
+class ParameterSnapshot
+{
+public:
+    struct Snapshot
+    {
+        T parameters;
+        SizeT version;
+    };
+
+    using SnapshotPtr = std::shared_ptr<const Snapshot>;
+
+    explicit ParameterSnapshot(T initial = T{})
+        : current(std::make_shared<const Snapshot>(Snapshot{std::move(initial), 0}))
+    {
+    }
+
+    SnapshotPtr load() const
+    {
+        return std::atomic_load(&current);
+    }
+
+    // Replaces the parameters and returns the new version
+    SizeT publish(T parameters)
+    {
+        std::scoped_lock lock(writeMutex);
+        const SizeT version = std::atomic_load(&current)->version + 1;
+        std::atomic_store(&current, std::make_shared<const Snapshot>(Snapshot{std::move(parameters), version}));
+        return version;
+    }
+
+    // Read-modify-write of the parameters; concurrent updates are applied one after another
+    template <typename F>
+    SizeT update(F&& modify)
+    {
+        std::scoped_lock lock(writeMutex);
+        const auto previous = std::atomic_load(&current);
+        T parameters = previous->parameters;
+        modify(parameters);
+        std::atomic_store(&current, std::make_shared<const Snapshot>(Snapshot{std::move(parameters), previous->version + 1}));
+        return previous->version + 1;
+    }
+
+    SizeT getVersion() const
+    {
+        return load()->version;
+    }
+
+private:
+    SnapshotPtr current;
+    std::mutex writeMutex;
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
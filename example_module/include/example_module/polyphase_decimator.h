@@ -0,0 +1,181 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <example_module/common.h>
+#include <example_module/cpu_features.h>
+#include <example_module/fir_design.h>
+#include <example_module/fir_filter.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Anti-alias filter cutoff as a fraction of the output sample rate; the Hamming window's transition band
+// ends at about the output Nyquist frequency for 16 taps per phase
+static constexpr double DecimationCutoff = 0.4;
+
+// Low-pass FIR filter of tapsPerPhase * factor taps for decimation by factor. A factor of 1 passes the
+// signal through unchanged.
+inline std::vector<double> designDecimationFilter(SizeT factor, SizeT tapsPerPhase, double sampleRate)
+{
+    if (factor == 1)
+        return {1.0};
+
+    FirSpec spec;
+    spec.response = FilterResponse::LowPass;
+    spec.window = FirWindow::Hamming;
+    spec.tapCount = factor * tapsPerPhase;
+    spec.sampleRate = sampleRate;
+    spec.cutoffFrequency = DecimationCutoff * sampleRate / static_cast<double>(factor);
+    return designFirFilter(spec);
+}
+
+// Filters and decimates by an integer factor D, computing only the retained outputs y[m] = sum of
+// h[k] x[mD - k]. The filter is split into D phases h_p[j] = h[jD + p], and the input into D streams
+// x_p[m] = x[mD - p], so that y[m] = sum over p of (h_p * x_p)[m]: D short filters at the output rate,
+// each computed with the direct FIR kernels. Output m is aligned with input sample mD; the first input
+// sample passed to process is sample 0.
+class PolyphaseDecimator
+{
+public:
+    // Outputs per convolution call; bounds the size of the phase buffers
+    static constexpr SizeT ChunkSize = 1024;
+
+    PolyphaseDecimator()
+        : kernel(getFirKernel(getSimdLevel()))
+    {
+        setFilter({1.0}, 1);
+    }
+
+    // Replaces the filter and clears the history
+    void setFilter(const std::vector<double>& taps, SizeT decimationFactor)
+    {
+        if (decimationFactor < 1)
+            throw std::invalid_argument("Decimation factor must be at least 1");
+        if (taps.empty())
+            throw std::invalid_argument("Decimation filter needs at least one tap");
+
+        factor = decimationFactor;
+        phaseLength = (taps.size() + factor - 1) / factor;
+
+        phaseTaps.assign(factor * phaseLength, 0.0);
+        for (SizeT k = 0; k < taps.size(); ++k)
+            phaseTaps[(k % factor) * phaseLength + k / factor] = taps[k];
+
+        phaseInputs.assign(factor * phaseStride(), 0.0);
+        phaseOutput.assign(ChunkSize, 0.0);
+        reset();
+    }
+
+    void setSimdLevel(SimdLevel level)
+    {
+        kernel = getFirKernel(level);
+    }
+
+    void reset()
+    {
+        std::fill(phaseInputs.begin(), phaseInputs.end(), 0.0);
+
+        // Output 0 only uses input sample 0, the other phases of its group lie before the stream
+        receivedPhases = factor - 1;
+    }
+
+    SizeT getFactor() const
+    {
+        return factor;
+    }
+
+    // Number of input samples until (and including) the one that completes the next output
+    SizeT getSamplesUntilNextOutput() const
+    {
+        return factor - receivedPhases;
+    }
+
+    // Number of outputs that process produces for count input samples
+    SizeT getOutputCount(SizeT count) const
+    {
+        const SizeT untilNext = getSamplesUntilNextOutput();
+        return count < untilNext ? 0 : 1 + (count - untilNext) / factor;
+    }
+
+    // Consumes count input samples and writes getOutputCount(count) outputs
+    SizeT process(const double* input, SizeT count, double* output)
+    {
+        const SizeT history = phaseLength - 1;
+        const SizeT stride = phaseStride();
+        SizeT produced = 0;
+
+        while (count > 0)
+        {
+            const SizeT outputs = std::min(getOutputCount(count), ChunkSize);
+            if (outputs == 0)
+            {
+                // Keeps the start of the next group in the slot of the next output
+                for (; count > 0; --count)
+                    phaseInputs[(factor - 1 - receivedPhases++) * stride + history] = *input++;
+                break;
+            }
+
+            count -= getSamplesUntilNextOutput() + (outputs - 1) * factor;
+
+            // Deinterleaves the groups; within a group the phases arrive from D - 1 down to 0
+            for (SizeT m = 0; m < outputs; ++m)
+            {
+                for (SizeT p = factor - receivedPhases; p-- > 0;)
+                    phaseInputs[p * stride + history + m] = *input++;
+                receivedPhases = 0;
+            }
+
+            for (SizeT p = 0; p < factor; ++p)
+            {
+                double* phaseInput = phaseInputs.data() + p * stride;
+                double* target = p == 0 ? output + produced : phaseOutput.data();
+                kernel(phaseTaps.data() + p * phaseLength, phaseLength, phaseInput + history, target, outputs);
+                if (p > 0)
+                {
+                    for (SizeT m = 0; m < outputs; ++m)
+                        output[produced + m] += phaseOutput[m];
+                }
+                std::memmove(phaseInput, phaseInput + outputs, history * sizeof(double));
+            }
+
+            produced += outputs;
+        }
+
+        return produced;
+    }
+
+private:
+    SizeT phaseStride() const
+    {
+        return phaseLength - 1 + ChunkSize;
+    }
+
+    SizeT factor = 1;
+    SizeT phaseLength = 0;
+    SizeT receivedPhases = 0;
+
+    // Phase filters ([phase][tap]) and their inputs ([phase][history + chunk])
+    std::vector<double> phaseTaps;
+    std::vector<double> phaseInputs;
+    std::vector<double> phaseOutput;
+    FirKernel kernel;
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,169 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+#include <example_module/common.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Always-on counters of a function block's processing. They are updated by the thread that processes
+// (under the acquisition lock) with relaxed atomic operations, a few per block, and can be read from any
+// thread; only reconfigurations may be recorded by several threads at once. A reset records the current counts as a baseline instead of writing the counters, so it never
+// races with the processing thread.
+class ProcessingStatistics
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Bucket k of the processing time histogram counts blocks of [2^k, 2^(k+1)) ns, bucket 0 also
+    // those below 1 ns and the last bucket all longer ones (2^31 ns is about 2.1 s)
+    static constexpr SizeT HistogramBucketCount = 32;
+
+    struct Counters
+    {
+        uint64_t samplesIn = 0;
+        uint64_t samplesOut = 0;
+        uint64_t packetsIn = 0;
+        uint64_t packetsOut = 0;
+        uint64_t events = 0;
+        uint64_t blocks = 0;
+        uint64_t busyTimeNs = 0;
+        uint64_t maxBacklog = 0;
+        uint64_t reconfigurations = 0;
+        std::array<uint64_t, HistogramBucketCount> processingTimeHistogram{};
+    };
+
+    // One processed block: samples read (or received in packets), samples sent and the time it took
+    void recordBlock(SizeT samplesIn, SizeT samplesOut, SizeT packetsIn, SizeT packetsOut, Clock::duration processingTime)
+    {
+        const auto ns = static_cast<uint64_t>(std::max<Clock::rep>(std::chrono::duration_cast<std::chrono::nanoseconds>(processingTime).count(), 0));
+
+        add(counters.samplesIn, samplesIn);
+        add(counters.samplesOut, samplesOut);
+        add(counters.packetsIn, packetsIn);
+        add(counters.packetsOut, packetsOut);
+        add(counters.blocks, 1);
+        add(counters.busyTimeNs, ns);
+        add(counters.histogram[getHistogramBucket(ns)], 1);
+    }
+
+    void recordEvent()
+    {
+        add(counters.events, 1);
+    }
+
+    // Configurations also run on the threads that write properties, concurrently with the processing thread
+    void recordReconfiguration()
+    {
+        counters.reconfigurations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Samples waiting in the reader before a block is read; the maximum is kept
+    void recordBacklog(SizeT available)
+    {
+        if (available > counters.maxBacklog.load(std::memory_order_relaxed))
+            counters.maxBacklog.store(available, std::memory_order_relaxed);
+    }
+
+    Counters getCounters() const
+    {
+        Counters result = loadCounters();
+        result.maxBacklog = counters.maxBacklog.load(std::memory_order_relaxed);
+
+        std::scoped_lock lock(baselineMutex);
+        result.samplesIn -= baseline.samplesIn;
+        result.samplesOut -= baseline.samplesOut;
+        result.packetsIn -= baseline.packetsIn;
+        result.packetsOut -= baseline.packetsOut;
+        result.events -= baseline.events;
+        result.blocks -= baseline.blocks;
+        result.busyTimeNs -= baseline.busyTimeNs;
+        result.reconfigurations -= baseline.reconfigurations;
+        for (SizeT i = 0; i < HistogramBucketCount; ++i)
+            result.processingTimeHistogram[i] -= baseline.processingTimeHistogram[i];
+        return result;
+    }
+
+    // The maximum backlog restarts from zero; a block processed at the same time may restore the old maximum
+    void reset()
+    {
+        std::scoped_lock lock(baselineMutex);
+        baseline = loadCounters();
+        counters.maxBacklog.store(0, std::memory_order_relaxed);
+    }
+
+    static SizeT getHistogramBucket(uint64_t ns)
+    {
+        SizeT bucket = 0;
+        while (ns > 1 && bucket + 1 < HistogramBucketCount)
+        {
+            ns >>= 1;
+            ++bucket;
+        }
+        return bucket;
+    }
+
+private:
+    Counters loadCounters() const
+    {
+        Counters result;
+        result.samplesIn = counters.samplesIn.load(std::memory_order_relaxed);
+        result.samplesOut = counters.samplesOut.load(std::memory_order_relaxed);
+        result.packetsIn = counters.packetsIn.load(std::memory_order_relaxed);
+        result.packetsOut = counters.packetsOut.load(std::memory_order_relaxed);
+        result.events = counters.events.load(std::memory_order_relaxed);
+        result.blocks = counters.blocks.load(std::memory_order_relaxed);
+        result.busyTimeNs = counters.busyTimeNs.load(std::memory_order_relaxed);
+        result.reconfigurations = counters.reconfigurations.load(std::memory_order_relaxed);
+        for (SizeT i = 0; i < HistogramBucketCount; ++i)
+            result.processingTimeHistogram[i] = counters.histogram[i].load(std::memory_order_relaxed);
+        return result;
+    }
+
+    // Only the processing thread writes, so a load and a store suffice; a locked increment would cost
+    // more than the rest of the bookkeeping
+    static void add(std::atomic<uint64_t>& counter, uint64_t value)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    struct AtomicCounters
+    {
+        std::atomic<uint64_t> samplesIn{0};
+        std::atomic<uint64_t> samplesOut{0};
+        std::atomic<uint64_t> packetsIn{0};
+        std::atomic<uint64_t> packetsOut{0};
+        std::atomic<uint64_t> events{0};
+        std::atomic<uint64_t> blocks{0};
+        std::atomic<uint64_t> busyTimeNs{0};
+        std::atomic<uint64_t> maxBacklog{0};
+        std::atomic<uint64_t> reconfigurations{0};
+        std::array<std::atomic<uint64_t>, HistogramBucketCount> histogram{};
+    };
+
+    AtomicCounters counters;
+    mutable std::mutex baselineMutex;
+    Counters baseline;
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
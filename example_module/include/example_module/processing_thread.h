@@ -0,0 +1,123 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+#include <example_module/common.h>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Dedicated thread that runs a function block's processing, so that a heavy block does not compete with
+// the other tasks of the scheduler. notify wakes the thread; notifications that arrive while it processes
+// are coalesced into one more call of the processing function.
+class ProcessingThread
+{
+public:
+    explicit ProcessingThread(std::function<void()> process)
+        : process(std::move(process))
+        , thread([this] { run(); })
+    {
+    }
+
+    ~ProcessingThread()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeUp.notify_one();
+        thread.join();
+    }
+
+    ProcessingThread(const ProcessingThread&) = delete;
+    ProcessingThread& operator=(const ProcessingThread&) = delete;
+
+    void notify()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending = true;
+        }
+        wakeUp.notify_one();
+    }
+
+    // Pins the thread to the CPUs whose bits are set in mask (bit n is CPU n); 0 lets it run on any CPU.
+    // Returns false if the mask cannot be applied, e.g. when it names no available CPU. Affinity is only
+    // supported on Linux, elsewhere only a mask of 0 is accepted.
+    bool setAffinity(uint64_t mask)
+    {
+#if defined(__linux__)
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for (int cpu = 0; cpu < 64; ++cpu)
+        {
+            if (mask == 0 || (mask >> cpu) & 1u)
+                CPU_SET(cpu, &cpus);
+        }
+        if (mask == 0)
+        {
+            for (int cpu = 64; cpu < CPU_SETSIZE; ++cpu)
+                CPU_SET(cpu, &cpus);
+        }
+        return pthread_setaffinity_np(thread.native_handle(), sizeof(cpus), &cpus) == 0;
+#else
+        return mask == 0;
+#endif
+    }
+
+private:
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            wakeUp.wait(lock, [this] { return pending || stopping; });
+            if (stopping)
+                return;
+
+            pending = false;
+            lock.unlock();
+            try
+            {
+                process();
+            }
+            catch (...)
+            {
+                // Configuration errors are reported through the component status
+            }
+            lock.lock();
+        }
+    }
+
+    std::function<void()> process;
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    bool pending = false;
+    bool stopping = false;
+    std::thread thread;
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
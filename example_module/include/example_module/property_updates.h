@@ -0,0 +1,31 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <example_module/common.h>
+#include <opendaq/opendaq.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Invokes onChanged when one of the named properties is written. Writes inside a batch update
+// (beginUpdate/endUpdate) are coalesced: onChanged is invoked once at endUpdate if the batch wrote any
+// of the properties, so a batch reconfigures the function block once.
+void observeProperties(PropertyObjectPtr& objPtr, const std::vector<std::string>& names, const std::function<void()>& onChanged);
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,62 @@
+#pragma once
+#include <example_module/common.h>
+#include <example_module/recording_writer.h>
+#include <opendaq/function_block_impl.h>
+#include <opendaq/opendaq.h>
+#include <atomic>
+#include <memory>
+#include <string>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Records the raw samples and domain of its input into a memory-mapped recording file (see
+// recording_format.h). Packets are written on the thread that sends them; the writes are copies into
+// mapped segments that a flush thread writes to disk, and samples are dropped rather than waiting for
+// the disk. Opening and closing the file happens outside of the acquisition lock.
+class RecorderFBImpl final : public FunctionBlock
+{
+public:
+    explicit RecorderFBImpl(const ContextPtr& ctx,
+                            const ComponentPtr& parent,
+                            const StringPtr& localId,
+                            const PropertyObjectPtr& config = nullptr);
+    ~RecorderFBImpl() override;
+
+    static FunctionBlockTypePtr CreateType();
+
+private:
+    static constexpr Int MaxSegmentSize = 1024;
+    static constexpr Int MaxFileSize = 1 << 20;
+
+    InputPortConfigPtr inputPort;
+
+    DataDescriptorPtr inputDataDescriptor;
+    DataDescriptorPtr inputDomainDataDescriptor;
+    SizeT valueSampleSize = 0;
+    SizeT domainSampleSize = 0;
+    Int domainDelta = 0;
+    bool explicitDomain = false;
+    bool configValid = false;
+
+    // Replaced under the acquisition lock, opened and closed outside of it
+    std::unique_ptr<RecordingWriter> writer;
+    bool droppedSamplesReported = false;
+    bool writeErrorReported = false;
+
+    std::atomic<SizeT> recordedSamples{0};
+    std::atomic<SizeT> droppedSamples{0};
+
+    void createInputPorts();
+    void initProperties();
+    void recordingChanged();
+    void startRecording();
+    void stopRecording();
+
+    void onPacketReceived(const InputPortPtr& port) override;
+    void processEventPacket(const EventPacketPtr& packet);
+    void processDataPacket(const DataPacketPtr& packet);
+    void configure();
+    RecordedDescriptors serializeDescriptors() const;
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <example_module/common.h>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Layout of recording files (little-endian, all offsets 8-byte aligned):
+//
+//   [RecordingFileHeader][descriptor payload]   padded to headerSize
+//   [segment 0][segment 1]...                   segmentSize bytes each, the last one may be shorter
+//
+// A segment holds records, each a RecordHeader followed by its payload padded to 8 bytes. Records never
+// cross segments; a zero record type (the initial file content) ends the records of a segment.
+//
+// A data record holds sampleCount raw values followed by sampleCount raw domain values. Domain signals
+// with implicit (linear) rules store no domain values; domainOffset holds the packet offset of the
+// record's first sample instead. A descriptor record replaces the descriptors of the following data
+// records.
+
+static constexpr char RecordingMagic[8] = {'D', 'A', 'Q', 'R', 'E', 'C', '\0', '\0'};
+static constexpr uint32_t RecordingVersion = 1;
+
+struct RecordingFileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t segmentSize;
+
+    // Written when the recording is closed; a crashed recording has complete == 0 and its segments
+    // are read up to the first empty record
+    uint64_t dataSize;
+    uint64_t recordCount;
+    uint64_t droppedSamples;
+    uint32_t complete;
+    uint32_t reserved;
+
+    // Size of the descriptor payload that follows the header
+    uint64_t descriptorSize;
+};
+
+enum class RecordType : uint32_t
+{
+    End = 0,
+    Data = 1,
+    Descriptor = 2
+};
+
+struct RecordHeader
+{
+    RecordType type;
+    uint32_t reserved;
+
+    // Payload bytes, excluding the padding
+    uint64_t size;
+    uint64_t sampleCount;
+
+    // Domain packet offset of the first sample
+    int64_t domainOffset;
+
+    // Bytes of raw values at the start of the payload; the domain values fill the rest
+    uint64_t valueSize;
+};
+
+static constexpr SizeT RecordAlignment = 8;
+
+inline SizeT alignRecordSize(SizeT size)
+{
+    return (size + RecordAlignment - 1) / RecordAlignment * RecordAlignment;
+}
+
+// Value and domain descriptors in their JSON serialization
+struct RecordedDescriptors
+{
+    std::string dataDescriptor;
+    std::string domainDescriptor;
+};
+
+// Payload of the header and of descriptor records: both strings, each preceded by its uint64 length
+inline std::string encodeDescriptors(const RecordedDescriptors& descriptors)
+{
+    std::string payload;
+    for (const auto* text : {&descriptors.dataDescriptor, &descriptors.domainDescriptor})
+    {
+        const uint64_t length = text->size();
+        payload.append(reinterpret_cast<const char*>(&length), sizeof(length));
+        payload.append(*text);
+    }
+    return payload;
+}
+
+inline RecordedDescriptors decodeDescriptors(const uint8_t* payload, SizeT size)
+{
+    RecordedDescriptors descriptors;
+    SizeT position = 0;
+    for (auto* text : {&descriptors.dataDescriptor, &descriptors.domainDescriptor})
+    {
+        uint64_t length;
+        if (size - position < sizeof(length))
+            throw std::runtime_error("Truncated descriptor payload");
+        std::memcpy(&length, payload + position, sizeof(length));
+        position += sizeof(length);
+
+        if (size - position < length)
+            throw std::runtime_error("Truncated descriptor payload");
+        text->assign(reinterpret_cast<const char*>(payload + position), length);
+        position += length;
+    }
+    return descriptors;
+}
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,171 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <example_module/common.h>
+#include <example_module/mapped_file.h>
+#include <example_module/recording_format.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// A record of a recording file. The value and domain pointers point into the mapped file and stay valid
+// while the reader is open.
+struct RecordView
+{
+    RecordType type = RecordType::End;
+    SizeT sampleCount = 0;
+    Int domainOffset = 0;
+
+    const uint8_t* values = nullptr;
+    SizeT valueSize = 0;
+    const uint8_t* domain = nullptr;
+    SizeT domainSize = 0;
+
+    // Set for descriptor records
+    RecordedDescriptors descriptors;
+};
+
+// Reads a recording file (see recording_format.h) through a read-only mapping of the whole file, so
+// the records are read in place. Recordings that were not closed are read up to their first empty
+// record.
+class RecordingReader
+{
+public:
+    void open(const std::string& path)
+    {
+        close();
+        file.open(path);
+        if (file.getSize() < sizeof(RecordingFileHeader))
+            throw std::runtime_error(path + " is not a recording");
+
+        region = file.map(0, file.getSize(), false);
+        std::memcpy(&header, region.getData(), sizeof(header));
+        if (std::memcmp(header.magic, RecordingMagic, sizeof(RecordingMagic)) != 0)
+            throw std::runtime_error(path + " is not a recording");
+        if (header.version != RecordingVersion)
+            throw std::runtime_error(path + " has the unsupported recording version " + std::to_string(header.version));
+        if (header.headerSize < sizeof(header) || header.headerSize > file.getSize() ||
+            header.descriptorSize > header.headerSize - sizeof(header) ||
+            header.segmentSize < sizeof(RecordHeader) || header.segmentSize % RecordAlignment != 0)
+            throw std::runtime_error(path + " has a corrupt header");
+
+        descriptors = decodeDescriptors(region.getData() + sizeof(header), header.descriptorSize);
+
+        const SizeT available = file.getSize() - header.headerSize;
+        dataSize = header.complete ? std::min<SizeT>(header.dataSize, available) : available;
+        rewind();
+    }
+
+    void close()
+    {
+        region.unmap();
+        file.close();
+        header = {};
+        descriptors = {};
+        dataSize = 0;
+        position = 0;
+    }
+
+    bool isOpen() const
+    {
+        return region.isMapped();
+    }
+
+    const RecordingFileHeader& getHeader() const
+    {
+        return header;
+    }
+
+    // Descriptors of the records up to the first descriptor record
+    const RecordedDescriptors& getDescriptors() const
+    {
+        return descriptors;
+    }
+
+    void rewind()
+    {
+        position = 0;
+    }
+
+    // Reads the next record; false at the end of the recording
+    bool next(RecordView& record)
+    {
+        const SizeT segmentSize = header.segmentSize;
+        const uint8_t* data = region.getData() + header.headerSize;
+
+        while (position < dataSize)
+        {
+            const SizeT segmentEnd = std::min(position - position % segmentSize + segmentSize, dataSize);
+            if (segmentEnd - position < sizeof(RecordHeader))
+            {
+                position = segmentEnd;
+                continue;
+            }
+
+            RecordHeader recordHeader;
+            std::memcpy(&recordHeader, data + position, sizeof(recordHeader));
+            if (recordHeader.type == RecordType::End)
+            {
+                // The rest of the segment is empty
+                position = segmentEnd;
+                continue;
+            }
+
+            const SizeT payloadOffset = position + sizeof(RecordHeader);
+            if ((recordHeader.type != RecordType::Data && recordHeader.type != RecordType::Descriptor) ||
+                recordHeader.size > segmentEnd - payloadOffset || recordHeader.valueSize > recordHeader.size)
+                throw std::runtime_error("Corrupt record at byte " + std::to_string(header.headerSize + position));
+
+            record = RecordView();
+            record.type = recordHeader.type;
+            record.sampleCount = recordHeader.sampleCount;
+            record.domainOffset = recordHeader.domainOffset;
+
+            const uint8_t* payload = data + payloadOffset;
+            if (recordHeader.type == RecordType::Descriptor)
+            {
+                record.descriptors = decodeDescriptors(payload, recordHeader.size);
+            }
+            else
+            {
+                record.values = payload;
+                record.valueSize = recordHeader.valueSize;
+                record.domainSize = recordHeader.size - recordHeader.valueSize;
+                record.domain = record.domainSize > 0 ? payload + recordHeader.valueSize : nullptr;
+            }
+
+            position = std::min(payloadOffset + alignRecordSize(recordHeader.size), segmentEnd);
+            return true;
+        }
+        return false;
+    }
+
+private:
+    MappedFile file;
+    MappedRegion region;
+    RecordingFileHeader header{};
+    RecordedDescriptors descriptors;
+
+    // Read position relative to the first segment
+    SizeT dataSize = 0;
+    SizeT position = 0;
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,377 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <example_module/common.h>
+#include <example_module/mapped_file.h>
+#include <example_module/recording_format.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Writes a recording file (see recording_format.h) through two mapped segments. The writing thread fills
+// one segment while a flush thread writes the previous one to disk, unmaps it and maps and prefaults
+// the next one, so writes are copies into memory and never wait for the disk. If the next segment is
+// not mapped in time, or the preallocated file is full, write calls drop their samples and count them.
+//
+// Writes and open/close must come from one thread at a time; the counters can be read from any thread.
+class RecordingWriter
+{
+public:
+    static constexpr SizeT SlotCount = 2;
+    static constexpr SizeT MinSegmentSize = MappedFile::Alignment;
+
+    RecordingWriter() = default;
+    RecordingWriter(const RecordingWriter&) = delete;
+    RecordingWriter& operator=(const RecordingWriter&) = delete;
+
+    ~RecordingWriter()
+    {
+        close();
+    }
+
+    // Creates the file with room for maxDataSize bytes of segments and maps the first segments. The
+    // segment size is rounded up to a multiple of MinSegmentSize.
+    void open(const std::string& path, const RecordedDescriptors& descriptors, SizeT requestedSegmentSize, SizeT maxDataSize)
+    {
+        close();
+
+        segmentSize = std::max(roundUp(requestedSegmentSize, MinSegmentSize), MinSegmentSize);
+        segmentCount = std::max<SizeT>(maxDataSize / segmentSize, 1);
+
+        const auto payload = encodeDescriptors(descriptors);
+        headerSize = roundUp(sizeof(RecordingFileHeader) + payload.size(), MappedFile::Alignment);
+
+        file.create(path, headerSize + segmentCount * segmentSize);
+        headerRegion = file.map(0, headerSize, false);
+
+        RecordingFileHeader header{};
+        std::memcpy(header.magic, RecordingMagic, sizeof(header.magic));
+        header.version = RecordingVersion;
+        header.headerSize = static_cast<uint32_t>(headerSize);
+        header.segmentSize = segmentSize;
+        header.descriptorSize = payload.size();
+        std::memcpy(headerRegion.getData(), &header, sizeof(header));
+        std::memcpy(headerRegion.getData() + sizeof(header), payload.data(), payload.size());
+        headerRegion.flush();
+
+        recordCount = 0;
+        droppedSamples = 0;
+        writtenBytes = 0;
+        dataSize = 0;
+        nextSegment = 0;
+        activeSlot = NoSlot;
+        lastSlot = SlotCount - 1;
+        closing = false;
+        error.clear();
+
+        for (SizeT slot = 0; slot < SlotCount; ++slot)
+            mapSegment(slot);
+
+        flushThread = std::thread([this] { flushSegments(); });
+    }
+
+    bool isOpen() const
+    {
+        return file.isOpen();
+    }
+
+    // Appends sampleCount samples: valueSampleSize bytes of raw values each and, if domain is set,
+    // domainSampleSize bytes of raw domain values each. Samples that do not fit into the current segment
+    // continue in a new record of the next one, with domainOffset advanced by domainDelta per sample.
+    // Returns the number of samples written; the rest is dropped.
+    SizeT writeData(const void* values,
+                    SizeT valueSampleSize,
+                    const void* domain,
+                    SizeT domainSampleSize,
+                    SizeT sampleCount,
+                    Int domainOffset,
+                    Int domainDelta)
+    {
+        if (!domain)
+            domainSampleSize = 0;
+        const SizeT sampleSize = valueSampleSize + domainSampleSize;
+        if (sampleSize == 0 || !file.isOpen())
+            return 0;
+
+        const auto* valueBytes = static_cast<const uint8_t*>(values);
+        const auto* domainBytes = static_cast<const uint8_t*>(domain);
+
+        SizeT written = 0;
+        while (written < sampleCount)
+        {
+            const SizeT count = std::min(sampleCount - written, getFreePayload() / sampleSize);
+            if (count == 0)
+            {
+                // A fresh segment that cannot hold one sample will never do
+                if ((activeSlot != NoSlot && writePosition == 0) || !acquireSegment())
+                    break;
+                continue;
+            }
+
+            RecordHeader header{};
+            header.type = RecordType::Data;
+            header.size = count * sampleSize;
+            header.sampleCount = count;
+            header.domainOffset = domainOffset + static_cast<Int>(written) * domainDelta;
+            header.valueSize = count * valueSampleSize;
+
+            uint8_t* payload = getPayload();
+            std::memcpy(payload, valueBytes + written * valueSampleSize, count * valueSampleSize);
+            if (domainBytes)
+                std::memcpy(payload + count * valueSampleSize, domainBytes + written * domainSampleSize, count * domainSampleSize);
+            commitRecord(header);
+
+            written += count;
+        }
+
+        droppedSamples.fetch_add(sampleCount - written, std::memory_order_relaxed);
+        return written;
+    }
+
+    // Appends a record with new descriptors for the following data records; returns false if it was
+    // dropped
+    bool writeDescriptors(const RecordedDescriptors& descriptors)
+    {
+        if (!file.isOpen())
+            return false;
+
+        const auto payload = encodeDescriptors(descriptors);
+        if (getFreePayload() < payload.size() && (!acquireSegment() || getFreePayload() < payload.size()))
+            return false;
+
+        RecordHeader header{};
+        header.type = RecordType::Descriptor;
+        header.size = payload.size();
+        std::memcpy(getPayload(), payload.data(), payload.size());
+        commitRecord(header);
+        return true;
+    }
+
+    // Flushes the remaining segments, completes the header and shrinks the file to the written data
+    void close()
+    {
+        if (!file.isOpen())
+            return;
+
+        if (activeSlot != NoSlot)
+            releaseSegment();
+
+        {
+            std::scoped_lock lock(mutex);
+            closing = true;
+        }
+        flushCv.notify_all();
+        flushThread.join();
+
+        for (auto& region : regions)
+            region.unmap();
+
+        RecordingFileHeader header;
+        std::memcpy(&header, headerRegion.getData(), sizeof(header));
+        header.dataSize = dataSize;
+        header.recordCount = recordCount.load(std::memory_order_relaxed);
+        header.droppedSamples = droppedSamples.load(std::memory_order_relaxed);
+        header.complete = 1;
+        std::memcpy(headerRegion.getData(), &header, sizeof(header));
+        headerRegion.flush();
+        headerRegion.unmap();
+
+        file.truncate(headerSize + dataSize);
+        file.close();
+    }
+
+    SizeT getSegmentSize() const
+    {
+        return segmentSize;
+    }
+
+    SizeT getRecordCount() const
+    {
+        return recordCount.load(std::memory_order_relaxed);
+    }
+
+    SizeT getDroppedSamples() const
+    {
+        return droppedSamples.load(std::memory_order_relaxed);
+    }
+
+    // Bytes of records written, including record headers and padding
+    SizeT getWrittenBytes() const
+    {
+        return writtenBytes.load(std::memory_order_relaxed);
+    }
+
+    // Error of the flush thread, empty if none occurred
+    std::string getError()
+    {
+        std::scoped_lock lock(mutex);
+        return error;
+    }
+
+private:
+    enum class SlotState
+    {
+        Empty,
+        Ready,
+        Active,
+        Full
+    };
+
+    static constexpr SizeT NoSlot = SlotCount;
+
+    static SizeT roundUp(SizeT value, SizeT alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    SizeT getFreePayload() const
+    {
+        if (activeSlot == NoSlot || segmentSize - writePosition < sizeof(RecordHeader))
+            return 0;
+        return segmentSize - writePosition - sizeof(RecordHeader);
+    }
+
+    uint8_t* getPayload() const
+    {
+        return regions[activeSlot].getData() + writePosition + sizeof(RecordHeader);
+    }
+
+    // The header is written after the payload, so a reader of a crashed recording never sees a record
+    // with a partial payload
+    void commitRecord(const RecordHeader& header)
+    {
+        std::memcpy(regions[activeSlot].getData() + writePosition, &header, sizeof(header));
+        const SizeT recordSize = sizeof(RecordHeader) + alignRecordSize(header.size);
+        writePosition += recordSize;
+        recordCount.fetch_add(1, std::memory_order_relaxed);
+        writtenBytes.fetch_add(recordSize, std::memory_order_relaxed);
+    }
+
+    // Hands the active segment to the flush thread
+    void releaseSegment()
+    {
+        dataSize = segmentIndices[activeSlot] * segmentSize + writePosition;
+        slotStates[activeSlot].store(SlotState::Full, std::memory_order_release);
+        lastSlot = activeSlot;
+        activeSlot = NoSlot;
+
+        {
+            // Only orders the notification with the flush thread's wait, no disk I/O happens under the lock
+            std::scoped_lock lock(mutex);
+        }
+        flushCv.notify_one();
+    }
+
+    // Releases the active segment and continues in the next one; false if it is not mapped yet
+    bool acquireSegment()
+    {
+        if (activeSlot != NoSlot)
+            releaseSegment();
+
+        // Slots are used and refilled in turns, so the segments are written in file order
+        const SizeT slot = (lastSlot + 1) % SlotCount;
+        if (slotStates[slot].load(std::memory_order_acquire) != SlotState::Ready)
+            return false;
+
+        slotStates[slot].store(SlotState::Active, std::memory_order_relaxed);
+        activeSlot = slot;
+        writePosition = 0;
+        return true;
+    }
+
+    void mapSegment(SizeT slot)
+    {
+        if (nextSegment >= segmentCount || closing)
+        {
+            slotStates[slot].store(SlotState::Empty, std::memory_order_release);
+            return;
+        }
+
+        regions[slot] = file.map(headerSize + nextSegment * segmentSize, segmentSize, true);
+        segmentIndices[slot] = nextSegment++;
+        slotStates[slot].store(SlotState::Ready, std::memory_order_release);
+    }
+
+    void flushSegments()
+    {
+        SizeT slot = 0;
+        std::unique_lock lock(mutex);
+        while (true)
+        {
+            flushCv.wait(lock, [this, slot] { return closing || slotStates[slot].load(std::memory_order_acquire) == SlotState::Full; });
+
+            // Segments are released in turns, so no later slot is full if this one is not
+            if (slotStates[slot].load(std::memory_order_acquire) != SlotState::Full)
+                break;
+
+            lock.unlock();
+            std::string mapError;
+            try
+            {
+                regions[slot].flush();
+                regions[slot].unmap();
+                mapSegment(slot);
+            }
+            catch (const std::exception& e)
+            {
+                mapError = e.what();
+                slotStates[slot].store(SlotState::Empty, std::memory_order_release);
+            }
+            lock.lock();
+
+            if (!mapError.empty())
+                error = mapError;
+            slot = (slot + 1) % SlotCount;
+        }
+    }
+
+    MappedFile file;
+    MappedRegion headerRegion;
+    SizeT headerSize = 0;
+    SizeT segmentSize = MinSegmentSize;
+    SizeT segmentCount = 0;
+
+    // Owned by the writing thread
+    SizeT activeSlot = NoSlot;
+    SizeT lastSlot = SlotCount - 1;
+    SizeT writePosition = 0;
+    SizeT dataSize = 0;
+
+    // A slot is owned by the writing thread while Ready or Active, by the flush thread while Full
+    MappedRegion regions[SlotCount];
+    SizeT segmentIndices[SlotCount] = {};
+    std::atomic<SlotState> slotStates[SlotCount] = {};
+    SizeT nextSegment = 0;
+
+    std::atomic<SizeT> recordCount{0};
+    std::atomic<SizeT> droppedSamples{0};
+    std::atomic<SizeT> writtenBytes{0};
+
+    std::thread flushThread;
+    std::mutex mutex;
+    std::condition_variable flushCv;
+    std::atomic<bool> closing{false};
+    std::string error;
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,74 @@
+#pragma once
+#include <example_module/common.h>
+#include <example_module/recording_reader.h>
+#include <opendaq/function_block_impl.h>
+#include <opendaq/opendaq.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Replays a file written by the recorder with the recorded descriptors. The file is mapped read-only and
+// the packets reference the mapped records directly; each packet keeps the mapping alive. A replay
+// thread sends the records paced by their domain values, ReplaySpeed times faster than real time, or
+// as fast as the receivers take them.
+class ReplayFBImpl final : public FunctionBlock
+{
+public:
+    explicit ReplayFBImpl(const ContextPtr& ctx,
+                          const ComponentPtr& parent,
+                          const StringPtr& localId,
+                          const PropertyObjectPtr& config = nullptr);
+    ~ReplayFBImpl() override;
+
+    static FunctionBlockTypePtr CreateType();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    SignalConfigPtr outputSignal;
+    SignalConfigPtr outputDomainSignal;
+
+    // Shared with the deleter of every sent packet
+    std::shared_ptr<RecordingReader> recordingReader;
+    DeleterPtr recordDeleter;
+
+    DataDescriptorPtr dataDescriptor;
+    DataDescriptorPtr domainDescriptor;
+    SizeT valueSampleSize = 0;
+    bool linearDomain = false;
+    Int domainDelta = 0;
+
+    // Seconds per domain tick; zero if the records cannot be paced
+    double tickSeconds = 0.0;
+    bool configValid = false;
+
+    double replaySpeed = 1.0;
+    std::atomic<SizeT> replayedSamples{0};
+
+    std::thread replayThread;
+    std::mutex replayMutex;
+    std::condition_variable replayCv;
+    bool stopRequested = false;
+
+    void createSignals();
+    void initProperties();
+    void filePathChanged();
+    void playbackChanged();
+    void rewind();
+
+    void openFile();
+    void applyDescriptors(const RecordedDescriptors& descriptors);
+
+    void start();
+    void stop();
+    void replay();
+    bool getRecordTimes(const RecordView& record, double& start, double& end) const;
+    void sendRecord(const RecordView& record);
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,96 @@
+#pragma once
+#include <example_module/block_properties.h>
+#include <example_module/common.h>
+#include <example_module/filter_design.h>
+#include <example_module/filter_design_stage.h>
+#include <example_module/input_processing.h>
+#include <example_module/output_packet_pool.h>
+#include <example_module/parallel_sos_filter.h>
+#include <example_module/processing_statistics.h>
+#include <example_module/scaling_kernels.h>
+#include <example_module/scaling_properties.h>
+#include <example_module/scratch_arena.h>
+#include <example_module/sos_crossfade.h>
+#include <example_module/trace_recorder.h>
+#include <opendaq/function_block_impl.h>
+#include <opendaq/opendaq.h>
+#include <opendaq/stream_reader_ptr.h>
+#include <memory>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Scaling followed by an IIR filter in one function block, with the properties of ExampleScalingModule
+// and ExampleIIRFilter. The input is read in its native sample type, and each tile of a block is scaled
+// into the output packet and filtered there while it is in L1, so a sample is read once and written once.
+// The output equals that of the two function blocks connected in a chain.
+class ScaledFilterFBImpl final : public FunctionBlock
+{
+public:
+    explicit ScaledFilterFBImpl(const ContextPtr& ctx,
+                                const ComponentPtr& parent,
+                                const StringPtr& localId,
+                                const PropertyObjectPtr& config = nullptr);
+    static FunctionBlockTypePtr CreateType();
+
+private:
+    static constexpr SizeT SerialReadBlockSize = 1024;
+
+    InputPortConfigPtr inputPort;
+    SignalConfigPtr outputSignal;
+    SignalConfigPtr outputDomainSignal;
+    OutputPacketPool outputPacketPool;
+    StreamReaderPtr reader;
+    bool packetMode = false;
+    ScalingKernel scalingKernel = nullptr;
+
+    SizeT readBlockSize = SerialReadBlockSize;
+    BlockLimits blockLimits;
+
+    ParallelSosFilter filter;
+    std::shared_ptr<WorkerPool> workerPool;
+    FilterDesignStage designStage;
+    SosCrossfade crossfade;
+
+    // Accepted design, guarded by the acquisition lock
+    FilterSpec filterSpec;
+
+    ScalingState scaling;
+
+    bool configValid = false;
+
+    SampleType inputSampleType = SampleType::Float64;
+    SizeT inputSampleSize = sizeof(double);
+
+    DataDescriptorPtr inputDataDescriptor;
+    DataDescriptorPtr inputDomainDataDescriptor;
+    DataDescriptorPtr outputDataDescriptor;
+
+    ProcessingStatistics statistics;
+    TraceSource trace;
+    InputReader inputReader{statistics, trace, dispatcher};
+
+    // Declared last, so that the worker thread and a running flush finish before the other members are destroyed
+    ProcessingDispatcher dispatcher{context, [this] { packetMode ? processQueuedPackets() : calculate(); }};
+
+    void createInputPorts();
+    void createSignals();
+    void initProperties();
+    void filterPropertyChanged();
+    void parallelismChanged();
+    void blockPolicyChanged();
+    void updateReadBlockSize();
+    void updateMemoryUsage();
+    void configure();
+    void updateOutputDescriptor(const ScalingParameters& params);
+
+    void calculate();
+    void scaleAndFilter(const void* inputData, double* outputData, SizeT count, const ScalingParameters& params);
+    void processData(const void* inputData, SizeT readAmount, SizeT packetOffset, uint64_t inputPosition);
+    void onPacketReceived(const InputPortPtr& port) override;
+    void processQueuedPackets();
+    void processDataPacket(const DataPacketPtr& packet, uint64_t inputPosition);
+    void processEventPacket(const EventPacketPtr& packet);
+    void processSignalDescriptorChanged(const DataDescriptorPtr& dataDesc, const DataDescriptorPtr& domainDesc);
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <example_module/common.h>
+#include <example_module/cpu_features.h>
+#include <example_module/dispatch.h>
+#include <example_module/scaling_kernels_x86.h>
+#include <opendaq/sample_type_traits.h>
+#include <cassert>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Computes output[i] = scale * input[i] + offset, reading the input in its native sample type
+using ScalingKernel = void (*)(const void* input, Float* output, SizeT count, Float scale, Float offset);
+
+template <SampleType InputType>
+void scaleSamples(const void* input, Float* output, SizeT count, Float scale, Float offset)
+{
+    using InputT = typename SampleTypeToType<InputType>::Type;
+
+    const auto* in = static_cast<const InputT*>(input);
+    for (SizeT i = 0; i < count; ++i)
+        output[i] = scale * static_cast<Float>(in[i]) + offset;
+}
+
+// Picks the widest variant available up to the requested level, falling back to the scalar
+// kernel for sample types that the level cannot convert natively (e.g. 64-bit integers below AVX-512)
+template <SampleType InputType>
+void assignScalingKernel(ScalingKernel& kernel, SimdLevel level)
+{
+    kernel = &scaleSamples<InputType>;
+
+#if EXAMPLE_MODULE_SIMD_X86
+    if constexpr (x86::Avx512Block<InputType>::Supported)
+    {
+        if (level >= SimdLevel::AVX512)
+        {
+            kernel = &x86::scaleSamplesAvx512<InputType>;
+            return;
+        }
+    }
+
+    if constexpr (x86::Avx2Block<InputType>::Supported)
+    {
+        if (level >= SimdLevel::AVX2)
+        {
+            kernel = &x86::scaleSamplesAvx2<InputType>;
+            return;
+        }
+    }
+
+    if constexpr (x86::Sse2Block<InputType>::Supported)
+    {
+        if (level >= SimdLevel::SSE2)
+            kernel = &x86::scaleSamplesSse2<InputType>;
+    }
+#endif
+}
+
+inline ScalingKernel getScalingKernel(SampleType sampleType, SimdLevel level)
+{
+    ScalingKernel kernel = nullptr;
+    SAMPLE_TYPE_DISPATCH(sampleType, assignScalingKernel, kernel, level)
+    return kernel;
+}
+
+inline ScalingKernel getScalingKernel(SampleType sampleType)
+{
+    return getScalingKernel(sampleType, getSimdLevel());
+}
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,479 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <example_module/common.h>
+#include <example_module/cpu_features.h>
+#include <opendaq/sample_type_traits.h>
+
+#if EXAMPLE_MODULE_SIMD_X86
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Vectorized variants of scaleSamples. Every tier multiplies and adds in two separately
+// rounded steps (no FMA), so the results are bit-identical to the scalar kernel.
+namespace x86
+{
+    // Each block converts Width input samples to doubles and writes scale * x + offset.
+
+    template <SampleType InputType>
+    struct Sse2Block
+    {
+        static constexpr bool Supported = false;
+    };
+
+    template <>
+    struct Sse2Block<SampleType::Float64>
+    {
+        static constexpr bool Supported = true;
+        static constexpr SizeT Width = 2;
+
+        EXAMPLE_MODULE_TARGET_SSE2 static void apply(const double* in, Float* out, __m128d scale, __m128d offset)
+        {
+            _mm_storeu_pd(out, _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(in), scale), offset));
+        }
+    };
+
+    template <>
+    struct Sse2Block<SampleType::Float32>
+    {
+        static constexpr bool Supported = true;
+        static constexpr SizeT Width = 4;
+
+        EXAMPLE_MODULE_TARGET_SSE2 static void apply(const float* in, Float* out, __m128d scale, __m128d offset)
+        {
+            const __m128 x = _mm_loadu_ps(in);
+            _mm_storeu_pd(out, _mm_add_pd(_mm_mul_pd(_mm_cvtps_pd(x), scale), offset));
+            _mm_storeu_pd(out + 2, _mm_add_pd(_mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(x, x)), scale), offset));
+        }
+    };
+
+    EXAMPLE_MODULE_TARGET_SSE2 inline void sse2StoreInt32x4(__m128i x, Float* out, __m128d scale, __m128d offset)
+    {
+        _mm_storeu_pd(out, _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(x), scale), offset));
+        _mm_storeu_pd(out + 2, _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(x, 0xEE)), scale), offset));
+    }
+
+    template <>
+    struct Sse2Block<SampleType::Int32>
+    {
+        static constexpr bool Supported = true;
+        static constexpr SizeT Width = 4;
+
+        EXAMPLE_MODULE_TARGET_SSE2 static void apply(const int32_t* in, Float* out, __m128d scale, __m128d offset)
+        {
+            sse2StoreInt32x4(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)), out, scale, offset);
+        }
+    };
+
+    template <>
+    struct Sse2Block<SampleType::UInt32>
+    {
+        static constexpr bool Supported = true;
+        static constexpr SizeT Width = 4;
+
+        // Flip the sign bit to convert as signed, then add 2^31 back (exact in double precision)
+        EXAMPLE_MODULE_TARGET_SSE2 static void apply(const uint32_t* in, Float* out, __m128d scale, __m128d offset)
+        {
+            const __m128i x = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)), _mm_set1_epi32(INT32_MIN));
+            const __m128d bias = _mm_set1_pd(2147483648.0);
+            const __m128d lo = _mm_add_pd(_mm_cvtepi32_pd(x), bias);
+            const __m128d hi = _mm_add_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(x, 0xEE)), bias);
+            _mm_storeu_pd(out, _mm_add_pd(_mm_mul_pd(lo, scale), offset));
+            _mm_storeu_pd(out + 2, _mm_add_pd(_mm_mul_pd(hi, scale), offset));
+        }
+    };
+
+    template <>
+    struct Sse2Block<SampleType::Int16>
+    {
+        static constexpr bool Supported = true;
+        static constexpr SizeT Width = 8;
+
+        EXAMPLE_MODULE_TARGET_SSE2 static void apply(const int16_t* in, Float* out, __m128d scale, __m128d offset)
+        {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+            sse2StoreInt32x4(_mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16), out, scale, offset);
+            sse2StoreInt32x4(_mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16), out + 4, scale, offset);
+        }
+    };
+
+    template <>
+    struct Sse2Block<SampleType::UInt16>
+    {
+        static constexpr bool Supported = true;
+        static constexpr SizeT Width = 8;
+
+        EXAMPLE_MODULE_TARGET_SSE2 static void apply(const uint16_t* in, Float* out, __m128d scale, __m128d offset)
+        {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+            const __m128i zero = _mm_setzero_si128();
+            sse2StoreInt32x4(_mm_unpacklo_epi16(x, zero), out, scale, offset);
+            sse2StoreInt32x4(_mm_unpackhi_epi16(x, zero), out + 4, scale, offset);
+        }
+    };
+
+    template <>
+    struct Sse2Block<SampleType::Int8>
+    {
+        static constexpr bool Supported = true;
+        static constexpr SizeT Width = 8;
+
+        EXAMPLE_MODULE_TARGET_SSE2 static void apply(const int8_t* in, Float* out, __m128d scale, __m128d offset)
+        {
+            const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in));
+            const __m128i x = _mm_srai_epi16(_mm_unpacklo_epi8(bytes, bytes), 8);
+            sse2StoreInt32x4(_mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16), out, scale, offset);
+            sse2StoreInt32x4(_mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16), out + 4, scale, offset);
+        }
+    };
+
+    template <>
+    struct Sse2Block<SampleType::UInt8>
+    {
+        static constexpr bool Supported = true;
+        static constexpr SizeT Width = 8;
+
+        EXAMPLE_MODULE_TARGET_SSE2 static void apply(const uint8_t* in, Float* out, __m128d scale, __m128d offset)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i x = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in)), zero);
+            sse2StoreInt32x4(_mm_unpacklo_epi16(x, zero), out, scale, offset);
+            sse2StoreInt32x4(_mm_unpackhi_epi16(x, zero), out + 4, scale, offset);
+        }
+    };
+
+    template <SampleType InputType>
+    EXAMPLE_MODULE_TARGET_SSE2 void scaleSamplesSse2(const void* input, Float* output, SizeT count, Float scale, Float offset)
+    {
+        using InputT = typename SampleTypeToType<InputType>::Type;
+        using Block = Sse2Block<InputType>;
+
+        const auto* in = static_cast<const InputT*>(input);
+        const __m128d vScale = _mm_set1_pd(scale);
+        const __m128d vOffset = _mm_set1_pd(offset);
+
+        SizeT i = 0;
+        for (; i + Block::Width <= count; i += Block::Width)
+            Block::apply(in + i, output + i, vScale, vOffset);
+
+        for (; i < count; ++i)
+            output[i] = scale * static_cast<Float>(in[i]) + offset;
+    }
+
+    template <SampleType InputType>
+    struct Avx2Block
+    {
+        static constexpr bool Supported = false;
+    };
+
+    EXAMPLE_MODULE_TARGET_AVX2 inline void avx2Store(__m256d x, Float* out, __m256d scale, __m256d offset)
+    {
+        _mm256_storeu_pd(out, _mm256_add_pd(_mm256_mul_pd(x, scale), offset));
+    }
+
+    template <>
+    struct Avx2Block<SampleType::Float64>
+    {
+        static constexpr bool Supported = true;
+        static constexpr SizeT Width = 8;
+
+        EXAMPLE_MODULE_TARGET_AVX2 static void apply(const double* in, Float* out, __m256d scale, __m256d offset)
+        {
+            avx2Store(_mm256_loadu_pd(in), out, scale, offset);
+            avx2Store(_mm256_loadu_pd(in + 4), out + 4, scale, offset);
+        }
+    };
+
+    template <>
+    struct Avx2Block<SampleType::Float32>
+    {
+        static constexpr bool Supported = true;
+        static constexpr SizeT Width = 8;
+
+        EXAMPLE_MODULE_TARGET_AVX2 static void apply(const float* in, Float* out, __m256d scale, __m256d offset)
+        {
+            avx2Store(_mm256_cvtps_pd(_mm_loadu_ps(in)), out, scale, offset);
+            avx2Store(_mm256_cvtps_pd(_mm_loadu_ps(in + 4)), out + 4, scale, offset);
+        }
+    };
+
+    EXAMPLE_MODULE_TARGET_AVX2 inline void avx2StoreInt32x8(__m256i x, Float* out, __m256d scale, __m256d offset)
+    {
+        avx2Store(_mm256_cvtepi32_pd(_mm256_castsi256_si128(x)), out, scale, offset);
+        avx2Store(_mm256_cvtepi32_pd(_mm256_extracti128_si256(x, 1)), out + 4, scale, offset);
+    }
+
+    template <>
+    struct Avx2Block<SampleType::Int32>
+    {
+        static constexpr bool Supported = true;
+        static constexpr SizeT Width = 8;
+
+        EXAMPLE_MODULE_TARGET_AVX2 static void apply(const int32_t* in, Float* out, __m256d scale, __m256d offset)
+        {
+            avx2StoreInt32x8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in)), out, scale, offset);
+        }
+    };
+
+    template <>
+    struct Avx2Block<SampleType::UInt32>
+    {
+        static constexpr bool Supported = true;
+        static constexpr SizeT Width = 8;
+
+        EXAMPLE_MODULE_TARGET_AVX2 static void apply(const uint32_t* in, Float* out, __m256d scale, __m256d offset)
+        {
+            const __m256i x =
+                _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in)), _mm256_set1_epi32(INT32_MIN));
+            const __m256d bias = _mm256_set1_pd(2147483648.0);
+            avx2Store(_mm256_add_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(x)), bias), out, scale, offset);
+            avx2Store(_mm256_add_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(x, 1)), bias), out + 4, scale, offset);
+        }
+    };
+
+    template <>
+    struct Avx2Block<SampleType::Int16>
+    {
+        static constexpr bool Supported = true;
+        static constexpr SizeT Width = 8;
+
+        EXAMPLE_MODULE_TARGET_AVX2 static void apply(const int16_t* in, Float* out, __m256d scale, __m256d offset)
+        {
+            avx2StoreInt32x8(_mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in))), out, scale, offset);
+        }
+    };
+
+    template <>
+    struct Avx2Block<SampleType::UInt16>
+    {
+        static constexpr bool Supported = true;
+        static constexpr SizeT Width = 8;
+
+        EXAMPLE_MODULE_TARGET_AVX2 static void apply(const uint16_t* in, Float* out, __m256d scale, __m256d offset)
+        {
+            avx2StoreInt32x8(_mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in))), out, scale, offset);
+        }
+    };
+
+    template <>
+    struct Avx2Block<SampleType::Int8>
+    {
+        static constexpr bool Supported = true;
+        static constexpr SizeT Width = 8;
+
+        EXAMPLE_MODULE_TARGET_AVX2 static void apply(const int8_t* in, Float* out, __m256d scale, __m256d offset)
+        {
+            avx2StoreInt32x8(_mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in))), out, scale, offset);
+        }
+    };
+
+    template <>
+    struct Avx2Block<SampleType::UInt8>
+    {
+        static constexpr bool Supported = true;
+        static constexpr SizeT Width = 8;
+
+        EXAMPLE_MODULE_TARGET_AVX2 static void apply(const uint8_t* in, Float* out, __m256d scale, __m256d offset)
+        {
+            avx2StoreInt32x8(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in))), out, scale, offset);
+        }
+    };
+
+    template <SampleType InputType>
+    EXAMPLE_MODULE_TARGET_AVX2 void scaleSamplesAvx2(const void* input, Float* output, SizeT count, Float scale, Float offset)
+    {
+        using InputT = typename SampleTypeToType<InputType>::Type;
+        using Block = Avx2Block<InputType>;
+
+        const auto* in = static_cast<const InputT*>(input);
+        const __m256d vScale = _mm256_set1_pd(scale);
+        const __m256d vOffset = _mm256_set1_pd(offset);
+
+        SizeT i = 0;
+        for (; i + Block::Width <= count; i += Block::Width)
+            Block::apply(in + i, output + i, vScale, vOffset);
+
+        for (; i < count; ++i)
+            output[i] = scale * static_cast<Float>(in[i]) + offset;
+    }
+
+    template <SampleType InputType>
+    struct Avx512Block
+    {
+        static constexpr bool Supported = false;
+    };
+
+    EXAMPLE_MODULE_TARGET_AVX512 inline void avx512Store(__m512d x, Float* out, __m512d scale, __m512d offset)
+    {
+        _mm512_storeu_pd(out, _mm512_add_pd(_mm512_mul_pd(x, scale), offset));
+    }
+
+    template <>
+    struct Avx512Block<SampleType::Float64>
+    {
+        static constexpr bool Supported = true;
+        static constexpr SizeT Width = 16;
+
+        EXAMPLE_MODULE_TARGET_AVX512 static void apply(const double* in, Float* out, __m512d scale, __m512d offset)
+        {
+            avx512Store(_mm512_loadu_pd(in), out, scale, offset);
+            avx512Store(_mm512_loadu_pd(in + 8), out + 8, scale, offset);
+        }
+    };
+
+    template <>
+    struct Avx512Block<SampleType::Float32>
+    {
+        static constexpr bool Supported = true;
+        static constexpr SizeT Width = 16;
+
+        EXAMPLE_MODULE_TARGET_AVX512 static void apply(const float* in, Float* out, __m512d scale, __m512d offset)
+        {
+            avx512Store(_mm512_cvtps_pd(_mm256_loadu_ps(in)), out, scale, offset);
+            avx512Store(_mm512_cvtps_pd(_mm256_loadu_ps(in + 8)), out + 8, scale, offset);
+        }
+    };
+
+    EXAMPLE_MODULE_TARGET_AVX512 inline void avx512StoreInt32x8(__m256i x, Float* out, __m512d scale, __m512d offset)
+    {
+        avx512Store(_mm512_cvtepi32_pd(x), out, scale, offset);
+    }
+
+    template <>
+    struct Avx512Block<SampleType::Int32>
+    {
+        static constexpr bool Supported = true;
+        static constexpr SizeT Width = 16;
+
+        EXAMPLE_MODULE_TARGET_AVX512 static void apply(const int32_t* in, Float* out, __m512d scale, __m512d offset)
+        {
+            avx512StoreInt32x8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in)), out, scale, offset);
+            avx512StoreInt32x8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 8)), out + 8, scale, offset);
+        }
+    };
+
+    template <>
+    struct Avx512Block<SampleType::UInt32>
+    {
+        static constexpr bool Supported = true;
+        static constexpr SizeT Width = 16;
+
+        EXAMPLE_MODULE_TARGET_AVX512 static void apply(const uint32_t* in, Float* out, __m512d scale, __m512d offset)
+        {
+            avx512Store(_mm512_cvtepu32_pd(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in))), out, scale, offset);
+            avx512Store(_mm512_cvtepu32_pd(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 8))), out + 8, scale, offset);
+        }
+    };
+
+    template <>
+    struct Avx512Block<SampleType::Int16>
+    {
+        static constexpr bool Supported = true;
+        static constexpr SizeT Width = 16;
+
+        EXAMPLE_MODULE_TARGET_AVX512 static void apply(const int16_t* in, Float* out, __m512d scale, __m512d offset)
+        {
+            avx512StoreInt32x8(_mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in))), out, scale, offset);
+            avx512StoreInt32x8(_mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 8))), out + 8, scale, offset);
+        }
+    };
+
+    template <>
+    struct Avx512Block<SampleType::UInt16>
+    {
+        static constexpr bool Supported = true;
+        static constexpr SizeT Width = 16;
+
+        EXAMPLE_MODULE_TARGET_AVX512 static void apply(const uint16_t* in, Float* out, __m512d scale, __m512d offset)
+        {
+            avx512StoreInt32x8(_mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in))), out, scale, offset);
+            avx512StoreInt32x8(_mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 8))), out + 8, scale, offset);
+        }
+    };
+
+    template <>
+    struct Avx512Block<SampleType::Int8>
+    {
+        static constexpr bool Supported = true;
+        static constexpr SizeT Width = 16;
+
+        EXAMPLE_MODULE_TARGET_AVX512 static void apply(const int8_t* in, Float* out, __m512d scale, __m512d offset)
+        {
+            avx512StoreInt32x8(_mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in))), out, scale, offset);
+            avx512StoreInt32x8(_mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + 8))), out + 8, scale, offset);
+        }
+    };
+
+    template <>
+    struct Avx512Block<SampleType::UInt8>
+    {
+        static constexpr bool Supported = true;
+        static constexpr SizeT Width = 16;
+
+        EXAMPLE_MODULE_TARGET_AVX512 static void apply(const uint8_t* in, Float* out, __m512d scale, __m512d offset)
+        {
+            avx512StoreInt32x8(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in))), out, scale, offset);
+            avx512StoreInt32x8(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + 8))), out + 8, scale, offset);
+        }
+    };
+
+    template <>
+    struct Avx512Block<SampleType::Int64>
+    {
+        static constexpr bool Supported = true;
+        static constexpr SizeT Width = 8;
+
+        EXAMPLE_MODULE_TARGET_AVX512 static void apply(const int64_t* in, Float* out, __m512d scale, __m512d offset)
+        {
+            avx512Store(_mm512_cvtepi64_pd(_mm512_loadu_si512(in)), out, scale, offset);
+        }
+    };
+
+    template <>
+    struct Avx512Block<SampleType::UInt64>
+    {
+        static constexpr bool Supported = true;
+        static constexpr SizeT Width = 8;
+
+        EXAMPLE_MODULE_TARGET_AVX512 static void apply(const uint64_t* in, Float* out, __m512d scale, __m512d offset)
+        {
+            avx512Store(_mm512_cvtepu64_pd(_mm512_loadu_si512(in)), out, scale, offset);
+        }
+    };
+
+    template <SampleType InputType>
+    EXAMPLE_MODULE_TARGET_AVX512 void scaleSamplesAvx512(const void* input, Float* output, SizeT count, Float scale, Float offset)
+    {
+        using InputT = typename SampleTypeToType<InputType>::Type;
+        using Block = Avx512Block<InputType>;
+
+        const auto* in = static_cast<const InputT*>(input);
+        const __m512d vScale = _mm512_set1_pd(scale);
+        const __m512d vOffset = _mm512_set1_pd(offset);
+
+        SizeT i = 0;
+        for (; i + Block::Width <= count; i += Block::Width)
+            Block::apply(in + i, output + i, vScale, vOffset);
+
+        for (; i < count; ++i)
+            output[i] = scale * static_cast<Float>(in[i]) + offset;
+    }
+}
+
+END_NAMESPACE_EXAMPLE_MODULE
+
+#endif
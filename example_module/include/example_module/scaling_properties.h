@@ -0,0 +1,95 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <example_module/common.h>
+#include <example_module/parameter_snapshot.h>
+#include <opendaq/opendaq.h>
+#include <functional>
+#include <string>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+struct ScalingParameters
+{
+    Float scale = 1.0;
+    Float offset = 0.0;
+    Bool useCustomOutputRange = False;
+    Float outputHighValue = 10.0;
+    Float outputLowValue = -10.0;
+    std::string outputUnit;
+    std::string outputName;
+};
+
+// Adds the scaling properties (Scale, Offset, UseCustomOutputRange, OutputHighValue, OutputLowValue,
+// OutputName and OutputUnit); onChanged is invoked whenever one of them is written, or once at the end of
+// a batch update
+void addScalingProperties(PropertyObjectPtr& objPtr, const std::function<void()>& onChanged);
+
+ScalingParameters readScalingProperties(const PropertyObjectPtr& objPtr);
+
+// Whether a and b give the same output descriptor; without a custom range, the range follows from the
+// scale and offset
+bool sameOutputDescriptor(const ScalingParameters& a, const ScalingParameters& b);
+
+// Float64 descriptor of the scaled input. The range is the scaled input range unless a custom range is
+// used, the unit that of the input unless OutputUnit is set.
+DataDescriptorPtr buildScaledOutputDescriptor(const ScalingParameters& params, const DataDescriptorPtr& inputDataDescriptor);
+
+// OutputName, or the name of the connected input signal followed by suffix
+std::string getScaledOutputName(const ScalingParameters& params, const InputPortPtr& inputPort, const std::string& suffix);
+
+// The scaling parameters of a function block. Property handlers publish new parameters without the
+// acquisition lock; the acquisition thread applies the latest ones once per block and rebuilds the output
+// descriptor only when its range, unit or name changed.
+class ScalingState
+{
+public:
+    void publish(const PropertyObjectPtr& objPtr)
+    {
+        parameters.publish(readScalingProperties(objPtr));
+    }
+
+    // The next apply rebuilds the output descriptor, e.g. for a new input
+    void reset()
+    {
+        applied.reset();
+    }
+
+    // Called by the acquisition thread; the returned parameters stay valid until the next call.
+    // updateOutputDescriptor(const ScalingParameters&) is called when the descriptor must be rebuilt.
+    template <typename UpdateOutputDescriptor>
+    const ScalingParameters& apply(UpdateOutputDescriptor&& updateOutputDescriptor)
+    {
+        const auto snapshot = parameters.load();
+        if (snapshot != applied)
+        {
+            if (!applied || !sameOutputDescriptor(applied->parameters, snapshot->parameters))
+                updateOutputDescriptor(snapshot->parameters);
+            applied = snapshot;
+        }
+
+        return applied->parameters;
+    }
+
+private:
+    using Snapshot = ParameterSnapshot<ScalingParameters>;
+
+    Snapshot parameters;
+    Snapshot::SnapshotPtr applied;
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,194 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+#include <example_module/common.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <vector>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Scratch memory shared by the function blocks that process on the same thread, so that the memory for
+// read buffers scales with the number of processing threads instead of the number of blocks. Buffers are
+// leased for the duration of one processing call and released in reverse order; a block that sends
+// packets to a block processing on the same thread while holding a lease gets a nested lease.
+//
+// Memory is kept in chunks that are never moved, so growing the arena does not invalidate leases.
+class ScratchArena
+{
+public:
+    static constexpr SizeT Alignment = 64;
+    static constexpr SizeT MinChunkSize = 64 * 1024;
+
+    class Lease
+    {
+    public:
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        ~Lease()
+        {
+            arena.release(chunk, previousUsed);
+        }
+
+        template <typename T = void>
+        T* get() const
+        {
+            return static_cast<T*>(data);
+        }
+
+    private:
+        friend class ScratchArena;
+
+        Lease(ScratchArena& arena, SizeT chunk, SizeT previousUsed, void* data)
+            : arena(arena)
+            , chunk(chunk)
+            , previousUsed(previousUsed)
+            , data(data)
+        {
+        }
+
+        ScratchArena& arena;
+        SizeT chunk;
+        SizeT previousUsed;
+        void* data;
+    };
+
+    ScratchArena() = default;
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    ~ScratchArena()
+    {
+        totalReservedBytes().fetch_sub(reservedBytes, std::memory_order_relaxed);
+    }
+
+    // The arena of the calling thread
+    static ScratchArena& local()
+    {
+        static thread_local ScratchArena arena;
+        return arena;
+    }
+
+    // Bytes reserved by the arenas of all threads
+    static SizeT getTotalReservedBytes()
+    {
+        return totalReservedBytes().load(std::memory_order_relaxed);
+    }
+
+    // Leases at least size bytes, aligned to Alignment
+    Lease acquire(SizeT size)
+    {
+        size = std::max<SizeT>((size + Alignment - 1) / Alignment * Alignment, Alignment);
+
+        // Leases are stacked; a lease that does not fit the current chunk moves on to the next one
+        SizeT index = current;
+        while (index < chunks.size() && chunks[index].size - chunks[index].used < size)
+        {
+            if (chunks[index].used == 0)
+            {
+                // Chunks above the top lease are unused and can be replaced by a larger one
+                replaceChunk(index, size);
+                break;
+            }
+            ++index;
+        }
+        if (index == chunks.size())
+            addChunk(size);
+
+        Chunk& chunk = chunks[index];
+        const SizeT previousUsed = chunk.used;
+        void* data = chunk.memory.get() + chunk.used;
+        chunk.used += size;
+        current = index;
+        return Lease(*this, index, previousUsed, data);
+    }
+
+    // Bytes reserved by the arena of this thread
+    SizeT getReservedBytes() const
+    {
+        return reservedBytes;
+    }
+
+    // Frees the memory of all chunks; may only be called without outstanding leases
+    void trim()
+    {
+        totalReservedBytes().fetch_sub(reservedBytes, std::memory_order_relaxed);
+        chunks.clear();
+        current = 0;
+        reservedBytes = 0;
+    }
+
+private:
+    struct AlignedDelete
+    {
+        void operator()(uint8_t* memory) const
+        {
+            ::operator delete(memory, std::align_val_t{Alignment});
+        }
+    };
+
+    struct Chunk
+    {
+        std::unique_ptr<uint8_t, AlignedDelete> memory;
+        SizeT size = 0;
+        SizeT used = 0;
+    };
+
+    static std::atomic<SizeT>& totalReservedBytes()
+    {
+        static std::atomic<SizeT> total{0};
+        return total;
+    }
+
+    void addChunk(SizeT size)
+    {
+        chunks.emplace_back();
+        replaceChunk(chunks.size() - 1, size);
+    }
+
+    void replaceChunk(SizeT index, SizeT size)
+    {
+        Chunk& chunk = chunks[index];
+        size = std::max(size, MinChunkSize);
+
+        chunk.memory.reset();
+        totalReservedBytes().fetch_sub(chunk.size, std::memory_order_relaxed);
+        reservedBytes -= chunk.size;
+
+        chunk.memory.reset(static_cast<uint8_t*>(::operator new(size, std::align_val_t{Alignment})));
+        chunk.size = size;
+        chunk.used = 0;
+        totalReservedBytes().fetch_add(size, std::memory_order_relaxed);
+        reservedBytes += size;
+    }
+
+    void release(SizeT chunk, SizeT previousUsed)
+    {
+        chunks[chunk].used = previousUsed;
+        current = chunk;
+    }
+
+    std::vector<Chunk> chunks;
+    SizeT current = 0;
+    SizeT reservedBytes = 0;
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
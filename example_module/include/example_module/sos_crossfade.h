@@ -0,0 +1,92 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <example_module/common.h>
+#include <example_module/sos_filter.h>
+#include <algorithm>
+#include <vector>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Blends from the output of a replaced filter to the output of its replacement. The outgoing filter keeps
+// running on the input for the length of the crossfade, starting from its state at the swap, and the
+// output ramps linearly from its output to the output of the new filter.
+class SosCrossfade
+{
+public:
+    static constexpr SizeT ChunkSize = 512;
+
+    SosCrossfade()
+        : scratch(ChunkSize)
+    {
+    }
+
+    // Starts a crossfade of length samples away from a filter with the given coefficients and state.
+    // A length of 0 switches immediately.
+    void start(const std::vector<BiquadCoefficients>& sections, const std::vector<BiquadState>& states, SizeT length)
+    {
+        outgoing.setSections(sections);
+        outgoing.setStates(states);
+        fadeLength = length;
+        position = 0;
+    }
+
+    void stop()
+    {
+        position = fadeLength;
+    }
+
+    bool isActive() const
+    {
+        return position < fadeLength;
+    }
+
+    SizeT getMemoryUsage() const
+    {
+        return outgoing.getMemoryUsage() + scratch.capacity() * sizeof(double);
+    }
+
+    // output holds the new filter's response to input; the two may not overlap
+    void apply(const double* input, double* output, SizeT count)
+    {
+        const double step = 1.0 / static_cast<double>(fadeLength + 1);
+
+        SizeT done = 0;
+        while (done < count && isActive())
+        {
+            const SizeT chunk = std::min({ChunkSize, count - done, fadeLength - position});
+            outgoing.process(input + done, scratch.data(), chunk);
+
+            for (SizeT i = 0; i < chunk; ++i)
+            {
+                const double weight = static_cast<double>(position + i + 1) * step;
+                output[done + i] = scratch[i] + weight * (output[done + i] - scratch[i]);
+            }
+
+            done += chunk;
+            position += chunk;
+        }
+    }
+
+private:
+    SosFilter outgoing;
+    std::vector<double> scratch;
+    SizeT fadeLength = 0;
+    SizeT position = 0;
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
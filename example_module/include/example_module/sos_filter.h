@@ -0,0 +1,159 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <example_module/common.h>
+#include <algorithm>
+#include <vector>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Normalized second-order section: H(z) = (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2).
+// First-order sections use b2 = a2 = 0.
+struct BiquadCoefficients
+{
+    double b0 = 1.0;
+    double b1 = 0.0;
+    double b2 = 0.0;
+    double a1 = 0.0;
+    double a2 = 0.0;
+};
+
+// Transposed direct form II state of one section
+struct BiquadState
+{
+    double s1 = 0.0;
+    double s2 = 0.0;
+};
+
+// Cascade of second-order sections. Coefficients and states are kept in contiguous arrays, and a block
+// is filtered section by section in tiles that stay in L1, so each section runs a tight loop with its
+// coefficients and state in registers.
+class SosFilter
+{
+public:
+    static constexpr SizeT TileSize = 512;
+
+    SosFilter() = default;
+
+    explicit SosFilter(std::vector<BiquadCoefficients> sections)
+    {
+        setSections(std::move(sections));
+    }
+
+    // Replaces the cascade and clears the filter state
+    void setSections(std::vector<BiquadCoefficients> sections)
+    {
+        coefficients = std::move(sections);
+        states.assign(coefficients.size(), BiquadState{});
+    }
+
+    // Replaces the coefficients between two blocks. The state is kept if the section count is unchanged,
+    // so the output continues from the current state instead of restarting from zero.
+    void updateSections(std::vector<BiquadCoefficients> sections)
+    {
+        if (sections.size() != coefficients.size())
+            states.assign(sections.size(), BiquadState{});
+        coefficients = std::move(sections);
+    }
+
+    const std::vector<BiquadCoefficients>& getSections() const
+    {
+        return coefficients;
+    }
+
+    SizeT getSectionCount() const
+    {
+        return coefficients.size();
+    }
+
+    const std::vector<BiquadState>& getStates() const
+    {
+        return states;
+    }
+
+    void reset()
+    {
+        std::fill(states.begin(), states.end(), BiquadState{});
+    }
+
+    // Heap memory held by the coefficients and states
+    SizeT getMemoryUsage() const
+    {
+        return coefficients.capacity() * sizeof(BiquadCoefficients) + states.capacity() * sizeof(BiquadState);
+    }
+
+    // Replaces the state of all sections, e.g. with a state computed outside of the filter
+    void setStates(const std::vector<BiquadState>& sectionStates)
+    {
+        if (sectionStates.size() == coefficients.size())
+            states = sectionStates;
+    }
+
+    // Input and output may be the same buffer
+    void process(const double* input, double* output, SizeT count)
+    {
+        if (coefficients.empty())
+        {
+            if (input != output)
+                std::copy(input, input + count, output);
+            return;
+        }
+
+        processCascade(coefficients.data(), states.data(), coefficients.size(), input, output, count);
+    }
+
+    static void processCascade(
+        const BiquadCoefficients* coefficients, BiquadState* states, SizeT sectionCount, const double* input, double* output, SizeT count)
+    {
+        for (SizeT tileStart = 0; tileStart < count; tileStart += TileSize)
+        {
+            const SizeT tileCount = std::min(TileSize, count - tileStart);
+            processSection(coefficients[0], states[0], input + tileStart, output + tileStart, tileCount);
+            for (SizeT section = 1; section < sectionCount; ++section)
+                processSection(coefficients[section], states[section], output + tileStart, output + tileStart, tileCount);
+        }
+    }
+
+    static void processSection(const BiquadCoefficients& c, BiquadState& state, const double* input, double* output, SizeT count)
+    {
+        const double b0 = c.b0;
+        const double b1 = c.b1;
+        const double b2 = c.b2;
+        const double a1 = c.a1;
+        const double a2 = c.a2;
+        double s1 = state.s1;
+        double s2 = state.s2;
+
+        for (SizeT i = 0; i < count; ++i)
+        {
+            const double x = input[i];
+            const double y = b0 * x + s1;
+            s1 = b1 * x - a1 * y + s2;
+            s2 = b2 * x - a2 * y;
+            output[i] = y;
+        }
+
+        state.s1 = s1;
+        state.s2 = s2;
+    }
+
+private:
+    std::vector<BiquadCoefficients> coefficients;
+    std::vector<BiquadState> states;
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,191 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <example_module/common.h>
+#include <example_module/cpu_features.h>
+#include <example_module/sos_filter.h>
+#include <example_module/sos_filter_bank_x86.h>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Filters a tile of interleaved samples (sample i of channel c at data[i * stride + c]) in place.
+// Coefficients are stored per section as five rows (b0, b1, b2, a1, a2) of stride values, states
+// as two rows (s1, s2), so that consecutive channels are adjacent in memory.
+using FilterBankKernel = void (*)(const double* coefficients, double* states, double* data, SizeT sectionCount, SizeT stride, SizeT count);
+
+inline void filterBankScalar(const double* coefficients, double* states, double* data, SizeT sectionCount, SizeT stride, SizeT count)
+{
+    for (SizeT channel = 0; channel < stride; ++channel)
+    {
+        for (SizeT section = 0; section < sectionCount; ++section)
+        {
+            const double* c = coefficients + section * 5 * stride + channel;
+            double* s = states + section * 2 * stride + channel;
+
+            const double b0 = c[0];
+            const double b1 = c[stride];
+            const double b2 = c[2 * stride];
+            const double a1 = c[3 * stride];
+            const double a2 = c[4 * stride];
+            double s1 = s[0];
+            double s2 = s[stride];
+
+            double* row = data + channel;
+            for (SizeT i = 0; i < count; ++i, row += stride)
+            {
+                const double x = *row;
+                const double y = b0 * x + s1;
+                s1 = b1 * x - a1 * y + s2;
+                s2 = b2 * x - a2 * y;
+                *row = y;
+            }
+
+            s[0] = s1;
+            s[stride] = s2;
+        }
+    }
+}
+
+inline FilterBankKernel getFilterBankKernel(SimdLevel level)
+{
+#if EXAMPLE_MODULE_SIMD_X86
+    if (level >= SimdLevel::AVX512)
+        return &x86::filterBankAvx512;
+    if (level >= SimdLevel::AVX2)
+        return &x86::filterBankAvx2;
+    if (level >= SimdLevel::SSE2)
+        return &x86::filterBankSse2;
+#endif
+    return &filterBankScalar;
+}
+
+// Second-order section cascades of many channels in structure-of-arrays layout. Every channel has
+// the same number of sections but its own coefficients (e.g. for different sample rates). A recurrence
+// cannot be vectorized along time, so the kernels vectorize across channels instead.
+class SosFilterBank
+{
+public:
+    // Channels are padded to a multiple of the widest SIMD register; padded channels output zeros
+    static constexpr SizeT ChannelAlignment = 8;
+    static constexpr SizeT TileSize = 256;
+
+    SosFilterBank()
+        : kernel(getFilterBankKernel(getSimdLevel()))
+    {
+    }
+
+    // Replaces all channels and clears the filter state
+    void setChannels(const std::vector<std::vector<BiquadCoefficients>>& channelSections)
+    {
+        channelCount = channelSections.size();
+        sectionCount = channelSections.empty() ? 0 : channelSections[0].size();
+        stride = (channelCount + ChannelAlignment - 1) / ChannelAlignment * ChannelAlignment;
+
+        coefficients.assign(sectionCount * 5 * stride, 0.0);
+        states.assign(sectionCount * 2 * stride, 0.0);
+
+        for (SizeT channel = 0; channel < channelCount; ++channel)
+        {
+            if (channelSections[channel].size() != sectionCount)
+                throw std::invalid_argument("All channels of a filter bank need the same number of sections");
+
+            for (SizeT section = 0; section < sectionCount; ++section)
+            {
+                const auto& c = channelSections[channel][section];
+                double* rows = coefficients.data() + section * 5 * stride + channel;
+                rows[0] = c.b0;
+                rows[stride] = c.b1;
+                rows[2 * stride] = c.b2;
+                rows[3 * stride] = c.a1;
+                rows[4 * stride] = c.a2;
+            }
+        }
+    }
+
+    void setSimdLevel(SimdLevel level)
+    {
+        kernel = getFilterBankKernel(level);
+    }
+
+    void reset()
+    {
+        std::fill(states.begin(), states.end(), 0.0);
+    }
+
+    // Per-channel state access, used to carry a channel's state over when the set of channels changes
+    std::vector<BiquadState> getChannelState(SizeT channel) const
+    {
+        std::vector<BiquadState> state(sectionCount);
+        for (SizeT section = 0; section < sectionCount; ++section)
+        {
+            state[section].s1 = states[section * 2 * stride + channel];
+            state[section].s2 = states[(section * 2 + 1) * stride + channel];
+        }
+        return state;
+    }
+
+    void setChannelState(SizeT channel, const std::vector<BiquadState>& state)
+    {
+        if (state.size() != sectionCount)
+            return;
+
+        for (SizeT section = 0; section < sectionCount; ++section)
+        {
+            states[section * 2 * stride + channel] = state[section].s1;
+            states[(section * 2 + 1) * stride + channel] = state[section].s2;
+        }
+    }
+
+    SizeT getChannelCount() const
+    {
+        return channelCount;
+    }
+
+    // Distance between consecutive samples of a channel in the interleaved buffer
+    SizeT getStride() const
+    {
+        return stride;
+    }
+
+    SizeT getSectionCount() const
+    {
+        return sectionCount;
+    }
+
+    // Filters count interleaved samples per channel in place
+    void process(double* data, SizeT count)
+    {
+        if (sectionCount == 0)
+            return;
+
+        for (SizeT tileStart = 0; tileStart < count; tileStart += TileSize)
+            kernel(coefficients.data(), states.data(), data + tileStart * stride, sectionCount, stride, std::min(TileSize, count - tileStart));
+    }
+
+private:
+    SizeT channelCount = 0;
+    SizeT sectionCount = 0;
+    SizeT stride = 0;
+    std::vector<double> coefficients;
+    std::vector<double> states;
+    FilterBankKernel kernel;
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,190 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <example_module/common.h>
+#include <example_module/cpu_features.h>
+
+#if EXAMPLE_MODULE_SIMD_X86
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Vectorized variants of filterBankScalar. Each lane holds one channel, so a register filters
+// 2/4/8 channels at once; operations are rounded in the same order as the scalar kernel (no FMA).
+namespace x86
+{
+    // Filters Groups adjacent lane groups starting at channel; the groups form independent dependency
+    // chains, which hides the latency of the recurrence
+    template <SizeT Groups>
+    EXAMPLE_MODULE_TARGET_SSE2 void filterBankGroupsSse2(
+        const double* coefficients, double* states, double* data, SizeT sectionCount, SizeT stride, SizeT count, SizeT channel)
+    {
+        for (SizeT section = 0; section < sectionCount; ++section)
+        {
+            const double* c = coefficients + section * 5 * stride + channel;
+            double* s = states + section * 2 * stride + channel;
+
+            __m128d b0[Groups], b1[Groups], b2[Groups], a1[Groups], a2[Groups], s1[Groups], s2[Groups];
+            for (SizeT g = 0; g < Groups; ++g)
+            {
+                b0[g] = _mm_loadu_pd(c + g * 2);
+                b1[g] = _mm_loadu_pd(c + stride + g * 2);
+                b2[g] = _mm_loadu_pd(c + 2 * stride + g * 2);
+                a1[g] = _mm_loadu_pd(c + 3 * stride + g * 2);
+                a2[g] = _mm_loadu_pd(c + 4 * stride + g * 2);
+                s1[g] = _mm_loadu_pd(s + g * 2);
+                s2[g] = _mm_loadu_pd(s + stride + g * 2);
+            }
+
+            double* row = data + channel;
+            for (SizeT i = 0; i < count; ++i, row += stride)
+            {
+                for (SizeT g = 0; g < Groups; ++g)
+                {
+                    const __m128d x = _mm_loadu_pd(row + g * 2);
+                    const __m128d y = _mm_add_pd(_mm_mul_pd(b0[g], x), s1[g]);
+                    s1[g] = _mm_add_pd(_mm_sub_pd(_mm_mul_pd(b1[g], x), _mm_mul_pd(a1[g], y)), s2[g]);
+                    s2[g] = _mm_sub_pd(_mm_mul_pd(b2[g], x), _mm_mul_pd(a2[g], y));
+                    _mm_storeu_pd(row + g * 2, y);
+                }
+            }
+
+            for (SizeT g = 0; g < Groups; ++g)
+            {
+                _mm_storeu_pd(s + g * 2, s1[g]);
+                _mm_storeu_pd(s + stride + g * 2, s2[g]);
+            }
+        }
+    }
+
+    EXAMPLE_MODULE_TARGET_SSE2 inline void filterBankSse2(
+        const double* coefficients, double* states, double* data, SizeT sectionCount, SizeT stride, SizeT count)
+    {
+        SizeT channel = 0;
+        for (; channel + 4 <= stride; channel += 4)
+            filterBankGroupsSse2<2>(coefficients, states, data, sectionCount, stride, count, channel);
+        for (; channel < stride; channel += 2)
+            filterBankGroupsSse2<1>(coefficients, states, data, sectionCount, stride, count, channel);
+    }
+
+    template <SizeT Groups>
+    EXAMPLE_MODULE_TARGET_AVX2 void filterBankGroupsAvx2(
+        const double* coefficients, double* states, double* data, SizeT sectionCount, SizeT stride, SizeT count, SizeT channel)
+    {
+        for (SizeT section = 0; section < sectionCount; ++section)
+        {
+            const double* c = coefficients + section * 5 * stride + channel;
+            double* s = states + section * 2 * stride + channel;
+
+            __m256d b0[Groups], b1[Groups], b2[Groups], a1[Groups], a2[Groups], s1[Groups], s2[Groups];
+            for (SizeT g = 0; g < Groups; ++g)
+            {
+                b0[g] = _mm256_loadu_pd(c + g * 4);
+                b1[g] = _mm256_loadu_pd(c + stride + g * 4);
+                b2[g] = _mm256_loadu_pd(c + 2 * stride + g * 4);
+                a1[g] = _mm256_loadu_pd(c + 3 * stride + g * 4);
+                a2[g] = _mm256_loadu_pd(c + 4 * stride + g * 4);
+                s1[g] = _mm256_loadu_pd(s + g * 4);
+                s2[g] = _mm256_loadu_pd(s + stride + g * 4);
+            }
+
+            double* row = data + channel;
+            for (SizeT i = 0; i < count; ++i, row += stride)
+            {
+                for (SizeT g = 0; g < Groups; ++g)
+                {
+                    const __m256d x = _mm256_loadu_pd(row + g * 4);
+                    const __m256d y = _mm256_add_pd(_mm256_mul_pd(b0[g], x), s1[g]);
+                    s1[g] = _mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(b1[g], x), _mm256_mul_pd(a1[g], y)), s2[g]);
+                    s2[g] = _mm256_sub_pd(_mm256_mul_pd(b2[g], x), _mm256_mul_pd(a2[g], y));
+                    _mm256_storeu_pd(row + g * 4, y);
+                }
+            }
+
+            for (SizeT g = 0; g < Groups; ++g)
+            {
+                _mm256_storeu_pd(s + g * 4, s1[g]);
+                _mm256_storeu_pd(s + stride + g * 4, s2[g]);
+            }
+        }
+    }
+
+    EXAMPLE_MODULE_TARGET_AVX2 inline void filterBankAvx2(
+        const double* coefficients, double* states, double* data, SizeT sectionCount, SizeT stride, SizeT count)
+    {
+        SizeT channel = 0;
+        for (; channel + 8 <= stride; channel += 8)
+            filterBankGroupsAvx2<2>(coefficients, states, data, sectionCount, stride, count, channel);
+        for (; channel < stride; channel += 4)
+            filterBankGroupsAvx2<1>(coefficients, states, data, sectionCount, stride, count, channel);
+    }
+
+    template <SizeT Groups>
+    EXAMPLE_MODULE_TARGET_AVX512 void filterBankGroupsAvx512(
+        const double* coefficients, double* states, double* data, SizeT sectionCount, SizeT stride, SizeT count, SizeT channel)
+    {
+        for (SizeT section = 0; section < sectionCount; ++section)
+        {
+            const double* c = coefficients + section * 5 * stride + channel;
+            double* s = states + section * 2 * stride + channel;
+
+            __m512d b0[Groups], b1[Groups], b2[Groups], a1[Groups], a2[Groups], s1[Groups], s2[Groups];
+            for (SizeT g = 0; g < Groups; ++g)
+            {
+                b0[g] = _mm512_loadu_pd(c + g * 8);
+                b1[g] = _mm512_loadu_pd(c + stride + g * 8);
+                b2[g] = _mm512_loadu_pd(c + 2 * stride + g * 8);
+                a1[g] = _mm512_loadu_pd(c + 3 * stride + g * 8);
+                a2[g] = _mm512_loadu_pd(c + 4 * stride + g * 8);
+                s1[g] = _mm512_loadu_pd(s + g * 8);
+                s2[g] = _mm512_loadu_pd(s + stride + g * 8);
+            }
+
+            double* row = data + channel;
+            for (SizeT i = 0; i < count; ++i, row += stride)
+            {
+                for (SizeT g = 0; g < Groups; ++g)
+                {
+                    const __m512d x = _mm512_loadu_pd(row + g * 8);
+                    const __m512d y = _mm512_add_pd(_mm512_mul_pd(b0[g], x), s1[g]);
+                    s1[g] = _mm512_add_pd(_mm512_sub_pd(_mm512_mul_pd(b1[g], x), _mm512_mul_pd(a1[g], y)), s2[g]);
+                    s2[g] = _mm512_sub_pd(_mm512_mul_pd(b2[g], x), _mm512_mul_pd(a2[g], y));
+                    _mm512_storeu_pd(row + g * 8, y);
+                }
+            }
+
+            for (SizeT g = 0; g < Groups; ++g)
+            {
+                _mm512_storeu_pd(s + g * 8, s1[g]);
+                _mm512_storeu_pd(s + stride + g * 8, s2[g]);
+            }
+        }
+    }
+
+    EXAMPLE_MODULE_TARGET_AVX512 inline void filterBankAvx512(
+        const double* coefficients, double* states, double* data, SizeT sectionCount, SizeT stride, SizeT count)
+    {
+        SizeT channel = 0;
+        for (; channel + 16 <= stride; channel += 16)
+            filterBankGroupsAvx512<2>(coefficients, states, data, sectionCount, stride, count, channel);
+        for (; channel < stride; channel += 8)
+            filterBankGroupsAvx512<1>(coefficients, states, data, sectionCount, stride, count, channel);
+    }
+}
+
+END_NAMESPACE_EXAMPLE_MODULE
+
+#endif
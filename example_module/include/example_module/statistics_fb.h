@@ -0,0 +1,78 @@
+#pragma once
+#include <example_module/common.h>
+#include <example_module/stream_input.h>
+#include <example_module/window_statistics.h>
+#include <opendaq/function_block_impl.h>
+#include <opendaq/opendaq.h>
+#include <opendaq/stream_reader_ptr.h>
+#include <vector>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Minimum, maximum, mean, RMS and standard deviation of the input over sliding windows (see
+// window_statistics.h). Each statistic is a signal with one sample per window; the signals share a
+// linear domain signal whose values are the domain values of the first sample of each window.
+class StatisticsFBImpl final : public FunctionBlock
+{
+public:
+    explicit StatisticsFBImpl(const ContextPtr& ctx,
+                              const ComponentPtr& parent,
+                              const StringPtr& localId,
+                              const PropertyObjectPtr& config = nullptr);
+    static FunctionBlockTypePtr CreateType();
+
+private:
+    static constexpr SizeT ReadBlockSize = 4096;
+
+    InputPortPtr inputPort;
+    SignalConfigPtr minSignal;
+    SignalConfigPtr maxSignal;
+    SignalConfigPtr meanSignal;
+    SignalConfigPtr rmsSignal;
+    SignalConfigPtr stdDevSignal;
+    SignalConfigPtr outputDomainSignal;
+    StreamReaderPtr reader;
+
+    std::vector<double> inputData;
+    DomainOffsetTracker domainOffsets;
+
+    // Domain value of the first sample since the last configuration, from which the windows are counted
+    bool streamStarted = false;
+    SizeT streamStartOffset = 0;
+
+    double windowDuration = 1.0;
+    double hopDuration = 1.0;
+    WindowStatistics statistics;
+
+    // Windows completed by the current read block
+    std::vector<WindowResult> windowResults;
+
+    bool configValid = false;
+
+    DataDescriptorPtr inputDataDescriptor;
+    DataDescriptorPtr inputDomainDataDescriptor;
+    DataDescriptorPtr minDataDescriptor;
+    DataDescriptorPtr maxDataDescriptor;
+    DataDescriptorPtr meanDataDescriptor;
+    DataDescriptorPtr rmsDataDescriptor;
+    DataDescriptorPtr stdDevDataDescriptor;
+    DataDescriptorPtr outputDomainDataDescriptor;
+
+    void createInputPorts();
+    void createSignals();
+    void initProperties();
+    void readProperties();
+    void propertyChanged();
+    void configure();
+    void clearDescriptors();
+
+    void calculate();
+    void processData(SizeT readAmount, SizeT packetOffset);
+    void sendStatistic(const SignalConfigPtr& signal,
+                       const DataDescriptorPtr& descriptor,
+                       const DataPacketPtr& domainPacket,
+                       double WindowResult::*statistic);
+    void processEventPacket(const EventPacketPtr& packet);
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
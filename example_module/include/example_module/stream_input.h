@@ -0,0 +1,90 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+#include <example_module/common.h>
+#include <opendaq/opendaq.h>
+#include <opendaq/stream_reader_ptr.h>
+#include <algorithm>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Checks shared by the function blocks that read a scalar input with a linear domain. They throw
+// std::runtime_error with the message the component status reports.
+
+// The value sample types the input conversion kernels read
+void validateValueSampleType(SampleType sampleType);
+
+// The domain must hold Int64 or UInt64 ticks with a linear rule; returns the delta of the rule
+SizeT validateLinearDomain(const DataDescriptorPtr& domainDescriptor);
+
+// Sample rate of a linear domain, which must be positive
+double getLinearSampleRate(const DataDescriptorPtr& domainDescriptor);
+
+// Domain offsets of consecutive blocks read from a stream reader. The reader reports the offset of the
+// first sample of a block that starts a new packet; within a packet the offset continues from the previous
+// block according to the linear rule.
+class DomainOffsetTracker
+{
+public:
+    void setDelta(SizeT delta)
+    {
+        this->delta = delta;
+    }
+
+    SizeT getDelta() const
+    {
+        return delta;
+    }
+
+    // Offset of the first of readAmount samples read with status
+    SizeT next(const ReaderStatusPtr& status, SizeT readAmount)
+    {
+        const auto offset = status.getOffset();
+        const SizeT domainOffset = offset.assigned() ? static_cast<SizeT>(offset.getIntValue()) : nextOffset;
+        nextOffset = domainOffset + readAmount * delta;
+        return domainOffset;
+    }
+
+private:
+    SizeT delta = 0;
+    SizeT nextOffset = 0;
+};
+
+// Reads blocks of at most maxSamples into buffer until the reader is empty or returns an event, and
+// passes each block to processBlock(status, readAmount) and the event to processEvent(packet). Blocks
+// are passed even when empty or invalid, so that the caller decides what to discard.
+template <typename ProcessBlock, typename ProcessEvent>
+void readUntilEvent(StreamReaderPtr& reader, void* buffer, SizeT maxSamples, ProcessBlock&& processBlock, ProcessEvent&& processEvent)
+{
+    while (!reader.getEmpty())
+    {
+        SizeT readAmount = std::min(reader.getAvailableCount(), maxSamples);
+        const auto status = reader.read(buffer, &readAmount);
+        processBlock(status, readAmount);
+
+        if (status.getReadStatus() == ReadStatus::Event)
+        {
+            const auto eventPacket = status.getEventPacket();
+            if (eventPacket.assigned())
+                processEvent(eventPacket);
+            return;
+        }
+    }
+}
+
+END_NAMESPACE_EXAMPLE_MODULE
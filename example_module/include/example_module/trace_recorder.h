@@ -0,0 +1,487 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+#include <example_module/common.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// What a function block spends a traced span on
+enum class TraceSpan : uint32_t
+{
+    Read = 0,
+    Compute,
+    Send,
+    Event
+};
+
+inline const char* getTraceSpanName(TraceSpan span)
+{
+    switch (span)
+    {
+        case TraceSpan::Read:
+            return "read";
+        case TraceSpan::Compute:
+            return "compute";
+        case TraceSpan::Send:
+            return "send";
+        case TraceSpan::Event:
+            return "event";
+    }
+    return "unknown";
+}
+
+struct TraceEvent
+{
+    uint32_t source = 0;
+    TraceSpan span = TraceSpan::Read;
+    uint32_t thread = 0;
+    int64_t startNs = 0;
+    int64_t durationNs = 0;
+
+    // Domain offset and sample count of the processed block
+    int64_t offset = 0;
+    int64_t samples = 0;
+
+    // Time from the arrival of the block's first sample to the end of the span; -1 if not known
+    int64_t latencyNs = -1;
+};
+
+// Fixed-size ring of the most recent trace events of one thread. Only the owning thread writes, and it
+// never waits: every slot carries a sequence number (a per-slot seqlock), so a concurrent dump skips the
+// slots that are overwritten while it copies them.
+class TraceRing
+{
+public:
+    static constexpr SizeT Capacity = 1 << 14;
+
+    TraceRing() = default;
+    TraceRing(const TraceRing&) = delete;
+    TraceRing& operator=(const TraceRing&) = delete;
+
+    void push(const TraceEvent& event)
+    {
+        const uint64_t index = head.load(std::memory_order_relaxed);
+        Slot& slot = slots[index % Capacity];
+
+        slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.fields[0].store(static_cast<int64_t>(event.source) | static_cast<int64_t>(event.span) << 32, std::memory_order_relaxed);
+        slot.fields[1].store(event.thread, std::memory_order_relaxed);
+        slot.fields[2].store(event.startNs, std::memory_order_relaxed);
+        slot.fields[3].store(event.durationNs, std::memory_order_relaxed);
+        slot.fields[4].store(event.offset, std::memory_order_relaxed);
+        slot.fields[5].store(event.samples, std::memory_order_relaxed);
+        slot.fields[6].store(event.latencyNs, std::memory_order_relaxed);
+
+        slot.sequence.store(2 * index + 2, std::memory_order_release);
+        head.store(index + 1, std::memory_order_release);
+    }
+
+    // Appends the events that are in the ring and were pushed after the last clear
+    void collect(std::vector<TraceEvent>& events) const
+    {
+        const uint64_t end = head.load(std::memory_order_acquire);
+        const uint64_t begin = std::max(end > Capacity ? end - Capacity : 0, clearedBefore.load(std::memory_order_relaxed));
+
+        for (uint64_t index = begin; index < end; ++index)
+        {
+            const Slot& slot = slots[index % Capacity];
+            const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence != 2 * index + 2)
+                continue;
+
+            TraceEvent event;
+            const int64_t sourceAndSpan = slot.fields[0].load(std::memory_order_relaxed);
+            event.source = static_cast<uint32_t>(sourceAndSpan & 0xFFFFFFFF);
+            event.span = static_cast<TraceSpan>(sourceAndSpan >> 32);
+            event.thread = static_cast<uint32_t>(slot.fields[1].load(std::memory_order_relaxed));
+            event.startNs = slot.fields[2].load(std::memory_order_relaxed);
+            event.durationNs = slot.fields[3].load(std::memory_order_relaxed);
+            event.offset = slot.fields[4].load(std::memory_order_relaxed);
+            event.samples = slot.fields[5].load(std::memory_order_relaxed);
+            event.latencyNs = slot.fields[6].load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) == sequence)
+                events.push_back(event);
+        }
+    }
+
+    // Hides the events pushed so far from later collects; safe to call from any thread
+    void clear()
+    {
+        clearedBefore.store(head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+
+private:
+    friend class TraceRegistry;
+
+    struct Slot
+    {
+        std::atomic<uint64_t> sequence{0};
+        std::array<std::atomic<int64_t>, 7> fields{};
+    };
+
+    std::array<Slot, Capacity> slots;
+    std::atomic<uint64_t> head{0};
+    std::atomic<uint64_t> clearedBefore{0};
+
+    // Set while a thread records into the ring; rings of finished threads are reused
+    std::atomic<bool> inUse{false};
+};
+
+// Process-wide trace: the names of the live traced sources and one ring per recording thread. Rings are
+// created when a thread records its first event and handed to a new thread when their thread exits,
+// together with the events still in them.
+class TraceRegistry
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Never destroyed, threads may still record during static destruction
+    static TraceRegistry& instance()
+    {
+        static auto* registry = new TraceRegistry();
+        return *registry;
+    }
+
+    // Ids are not reused, so events left in the rings by a removed source are never attributed to another
+    uint32_t addSource(const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const uint32_t id = nextSource++;
+        sources.emplace(id, name);
+        return id;
+    }
+
+    void removeSource(uint32_t id)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        sources.erase(id);
+    }
+
+    // Records an event on the calling thread's ring; event.thread is filled in
+    void record(TraceEvent event)
+    {
+        static thread_local RingHolder holder;
+        if (!holder.ring)
+            acquireRing(holder);
+
+        event.thread = holder.thread;
+        holder.ring->push(event);
+    }
+
+    std::vector<TraceEvent> collect() const
+    {
+        std::vector<TraceEvent> events;
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& ring : rings)
+            ring->collect(events);
+
+        std::sort(events.begin(), events.end(), [](const TraceEvent& a, const TraceEvent& b) { return a.startNs < b.startNs; });
+        return events;
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& ring : rings)
+            ring->clear();
+    }
+
+    // The collected events in the Chrome trace event format, as loaded by chrome://tracing and Perfetto:
+    // one complete ("X") event per span, named after the span and categorized by its source. Events of
+    // sources that have been removed meanwhile are left out.
+    std::string dumpChromeTrace() const
+    {
+        auto events = collect();
+
+        std::unordered_map<uint32_t, std::string> sourceNames;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            sourceNames = sources;
+        }
+        events.erase(std::remove_if(events.begin(), events.end(), [&](const TraceEvent& event) { return sourceNames.count(event.source) == 0; }),
+                     events.end());
+
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(3);
+        out << R"({"displayTimeUnit":"ns","traceEvents":[)";
+
+        const char* separator = "";
+        std::set<uint32_t> threads;
+        for (const auto& event : events)
+            threads.insert(event.thread);
+        for (const uint32_t thread : threads)
+        {
+            out << separator << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << thread << R"(,"args":{"name":"Processing thread )"
+                << thread << R"("}})";
+            separator = ",";
+        }
+
+        for (const auto& event : events)
+        {
+            const std::string source = escape(sourceNames.at(event.source));
+            out << separator << R"({"name":")" << getTraceSpanName(event.span) << R"(","cat":")" << source << R"(","ph":"X","pid":1,"tid":)"
+                << event.thread << R"(,"ts":)" << static_cast<double>(event.startNs) / 1000.0 << R"(,"dur":)"
+                << static_cast<double>(event.durationNs) / 1000.0 << R"(,"args":{"source":")" << source << R"(","offset":)" << event.offset
+                << R"(,"samples":)" << event.samples;
+            if (event.latencyNs >= 0)
+                out << R"(,"latency_us":)" << static_cast<double>(event.latencyNs) / 1000.0;
+            out << "}}";
+            separator = ",";
+        }
+
+        out << "]}";
+        return out.str();
+    }
+
+    static int64_t toNanoseconds(Clock::time_point time)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    }
+
+private:
+    struct RingHolder
+    {
+        ~RingHolder()
+        {
+            if (ring)
+                ring->inUse.store(false, std::memory_order_release);
+        }
+
+        TraceRing* ring = nullptr;
+        uint32_t thread = 0;
+    };
+
+    TraceRegistry() = default;
+
+    void acquireRing(RingHolder& holder)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        holder.thread = nextThread++;
+
+        for (const auto& ring : rings)
+        {
+            bool free = false;
+            if (ring->inUse.compare_exchange_strong(free, true, std::memory_order_acquire))
+            {
+                holder.ring = ring.get();
+                return;
+            }
+        }
+
+        rings.push_back(std::make_unique<TraceRing>());
+        rings.back()->inUse.store(true, std::memory_order_relaxed);
+        holder.ring = rings.back().get();
+    }
+
+    static std::string escape(const std::string& text)
+    {
+        std::string escaped;
+        for (const char c : text)
+        {
+            if (c == '"' || c == '\\')
+                escaped += '\\';
+            if (static_cast<unsigned char>(c) >= 0x20)
+                escaped += c;
+        }
+        return escaped;
+    }
+
+    mutable std::mutex mutex;
+    std::unordered_map<uint32_t, std::string> sources;
+    uint32_t nextSource = 0;
+    std::vector<std::unique_ptr<TraceRing>> rings;
+    uint32_t nextThread = 0;
+};
+
+// Tracing of one function block. Spans are only recorded while tracing is enabled; disabled, a span costs
+// one relaxed load. Input positions count the samples (or packets) the block has consumed; the arrival of
+// new input is marked with the position up to which input is pending, so that the send span of a block
+// can report the latency from the arrival of its first sample.
+class TraceSource
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Arrival marks kept at most; older ones are dropped when the processing falls behind this far
+    static constexpr SizeT MaxIngressMarks = 4096;
+
+    explicit TraceSource(const std::string& name)
+        : id(TraceRegistry::instance().addSource(name))
+    {
+    }
+
+    ~TraceSource()
+    {
+        TraceRegistry::instance().removeSource(id);
+    }
+
+    TraceSource(const TraceSource&) = delete;
+    TraceSource& operator=(const TraceSource&) = delete;
+
+    void setEnabled(bool enable)
+    {
+        std::lock_guard<std::mutex> lock(ingressMutex);
+        ingress.clear();
+        enabled.store(enable, std::memory_order_relaxed);
+    }
+
+    bool isEnabled() const
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    void record(TraceSpan span, Clock::time_point start, Clock::time_point end, int64_t offset, SizeT samples, int64_t latencyNs = -1) const
+    {
+        TraceEvent event;
+        event.source = id;
+        event.span = span;
+        event.startNs = TraceRegistry::toNanoseconds(start);
+        event.durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        event.offset = offset;
+        event.samples = static_cast<int64_t>(samples);
+        event.latencyNs = latencyNs;
+        TraceRegistry::instance().record(event);
+    }
+
+    // Held while new input is marked, and by the owner while it replaces whatever pending is read from
+    std::unique_lock<std::mutex> lockIngress()
+    {
+        return std::unique_lock<std::mutex>(ingressMutex);
+    }
+
+    // Marks the arrival of input: pending samples (or packets) are waiting to be consumed. Called with
+    // lockIngress() held. A block consumed between reading pending and this call is counted twice, which
+    // stamps a few later samples with an earlier arrival: the latency is overestimated, never hidden.
+    // Samples queued behind an event are not yet pending; the arrival is then attributed to the next one.
+    void markIngress(SizeT pending, Clock::time_point now = Clock::now())
+    {
+        const uint64_t end = position.load(std::memory_order_relaxed) + std::max<SizeT>(pending, 1);
+        if (!ingress.empty() && ingress.back().first >= end)
+            return;
+
+        if (ingress.size() == MaxIngressMarks)
+            ingress.pop_front();
+        ingress.emplace_back(end, now);
+    }
+
+    // Advances the input position by count consumed samples (or packets); only called by the processing thread
+    void consumeInput(SizeT count)
+    {
+        position.store(position.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+    }
+
+    uint64_t getInputPosition() const
+    {
+        return position.load(std::memory_order_relaxed);
+    }
+
+    // Time from the arrival of the input at inputPosition until now, -1 if its arrival was not marked.
+    // Marks of earlier input are dropped, so positions must be queried in increasing order.
+    int64_t takeLatency(uint64_t inputPosition, Clock::time_point now)
+    {
+        std::lock_guard<std::mutex> lock(ingressMutex);
+        while (!ingress.empty() && ingress.front().first <= inputPosition)
+            ingress.pop_front();
+
+        if (ingress.empty())
+            return -1;
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(now - ingress.front().second).count();
+    }
+
+private:
+    uint32_t id;
+    std::atomic<bool> enabled{false};
+    std::atomic<uint64_t> position{0};
+
+    std::mutex ingressMutex;
+    std::deque<std::pair<uint64_t, Clock::time_point>> ingress;
+};
+
+// Records a span of a TraceSource from its construction to its destruction, if tracing was enabled at
+// construction
+class TraceScope
+{
+public:
+    using Clock = TraceSource::Clock;
+
+    explicit TraceScope(TraceSource& source, TraceSpan span, int64_t offset = 0, SizeT samples = 0)
+        : source(source.isEnabled() ? &source : nullptr)
+        , span(span)
+        , offset(offset)
+        , samples(samples)
+    {
+        if (this->source)
+            start = Clock::now();
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+    ~TraceScope()
+    {
+        if (!source)
+            return;
+
+        const auto end = Clock::now();
+        const int64_t latencyNs = hasInputPosition ? source->takeLatency(inputPosition, end) : -1;
+        source->record(span, start, end, offset, samples, latencyNs);
+    }
+
+    // The block is known only once it has been read
+    void setBlock(int64_t blockOffset, SizeT blockSamples)
+    {
+        offset = blockOffset;
+        samples = blockSamples;
+    }
+
+    // Reports the latency from the arrival of the input at position to the end of the span
+    void setInputPosition(uint64_t position)
+    {
+        inputPosition = position;
+        hasInputPosition = true;
+    }
+
+private:
+    TraceSource* source;
+    TraceSpan span;
+    int64_t offset;
+    SizeT samples;
+    Clock::time_point start{};
+    uint64_t inputPosition = 0;
+    bool hasInputPosition = false;
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,282 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+#include <example_module/common.h>
+#include <example_module/dispatch.h>
+#include <opendaq/sample_type_traits.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+enum class Waveform
+{
+    Sine = 0,
+    Step,
+    Chirp,
+    Noise,
+    Constant
+};
+
+struct WaveformSpec
+{
+    Waveform waveform = Waveform::Sine;
+    double sampleRate = 1000.0;
+
+    // Sine and Step: frequency of the signal; Chirp: start frequency of the sweep
+    double frequency = 10.0;
+
+    // Chirp: the sweep runs linearly from frequency to endFrequency within duration seconds, then repeats
+    double endFrequency = 100.0;
+    double duration = 1.0;
+
+    double amplitude = 1.0;
+    double offset = 0.0;
+
+    // Seed of the noise sequence
+    uint32_t seed = 0;
+};
+
+// Whole periods of a waveform, precomputed in the output sample type, so that generating samples is a copy
+// out of the table. A sine or step table holds as many periods as it takes to end on a whole sample: 300 Hz
+// at 1 kS/s is 3 periods in 10 samples. When no such count fits in MaxLength samples, the frequency is
+// rounded to a nearby one that does, which getFrequency reports. Noise repeats every NoiseLength samples.
+class WaveformTable
+{
+public:
+    static constexpr SizeT MaxLength = 1 << 22;
+    static constexpr SizeT NoiseLength = 1 << 20;
+
+    void build(const WaveformSpec& spec, SampleType sampleType)
+    {
+        if (!(spec.sampleRate > 0.0))
+            throw std::invalid_argument("Sample rate must be positive");
+
+        cycles = 1;
+        length = getTableLength(spec, cycles);
+        frequency = spec.waveform == Waveform::Sine || spec.waveform == Waveform::Step
+                        ? spec.sampleRate * static_cast<double>(cycles) / static_cast<double>(length)
+                        : spec.frequency;
+
+        std::vector<double> values(length);
+        switch (spec.waveform)
+        {
+            // The phase of sample i is (i * cycles mod length) / length periods, exact in integers
+            case Waveform::Sine:
+                for (SizeT i = 0; i < length; ++i)
+                    values[i] = spec.offset + spec.amplitude * std::sin(TwoPi * static_cast<double>(i * cycles % length) / static_cast<double>(length));
+                break;
+            case Waveform::Step:
+                for (SizeT i = 0; i < length; ++i)
+                    values[i] = i * cycles % length < length / 2 ? spec.offset : spec.offset + spec.amplitude;
+                break;
+            case Waveform::Chirp:
+            {
+                const double rate = (spec.endFrequency - spec.frequency) / spec.duration;
+                for (SizeT i = 0; i < length; ++i)
+                {
+                    const double t = static_cast<double>(i) / spec.sampleRate;
+                    values[i] = spec.offset + spec.amplitude * std::sin(TwoPi * (spec.frequency * t + 0.5 * rate * t * t));
+                }
+                break;
+            }
+            case Waveform::Noise:
+            {
+                std::mt19937 generator(spec.seed);
+                std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+                for (auto& value : values)
+                    value = spec.offset + spec.amplitude * distribution(generator);
+                break;
+            }
+            case Waveform::Constant:
+                values[0] = spec.offset;
+                break;
+        }
+
+        sampleSize = daq::getSampleSize(sampleType);
+        samples.resize(length * sampleSize);
+        SAMPLE_TYPE_DISPATCH(sampleType, convertValues, values, samples.data());
+    }
+
+    // Number of samples in the table
+    SizeT getLength() const
+    {
+        return length;
+    }
+
+    // Number of sine or step periods in the table; 1 for the other waveforms
+    SizeT getCycles() const
+    {
+        return cycles;
+    }
+
+    // Frequency of the generated signal; differs from the requested one only when its periods do not
+    // end on a whole sample within MaxLength samples
+    double getFrequency() const
+    {
+        return frequency;
+    }
+
+    SizeT getSampleSize() const
+    {
+        return sampleSize;
+    }
+
+    // Writes count samples starting at table position phase; returns the position after the last one
+    SizeT fill(void* output, SizeT count, SizeT phase) const
+    {
+        auto* out = static_cast<uint8_t*>(output);
+        if (length == 1)
+        {
+            // Constant: replicate the single sample by doubling the copied range
+            if (count == 0)
+                return 0;
+            std::memcpy(out, samples.data(), sampleSize);
+            for (SizeT filled = 1; filled < count;)
+            {
+                const SizeT chunk = std::min(filled, count - filled);
+                std::memcpy(out + filled * sampleSize, out, chunk * sampleSize);
+                filled += chunk;
+            }
+            return 0;
+        }
+
+        while (count > 0)
+        {
+            const SizeT chunk = std::min(count, length - phase);
+            std::memcpy(out, samples.data() + phase * sampleSize, chunk * sampleSize);
+            out += chunk * sampleSize;
+            count -= chunk;
+            phase = (phase + chunk) % length;
+        }
+        return phase;
+    }
+
+    SizeT getMemoryUsage() const
+    {
+        return samples.size();
+    }
+
+private:
+    static constexpr double TwoPi = 6.283185307179586;
+
+    static SizeT getTableLength(const WaveformSpec& spec, SizeT& cycles)
+    {
+        switch (spec.waveform)
+        {
+            case Waveform::Sine:
+            case Waveform::Step:
+            {
+                if (!(spec.frequency > 0.0) || spec.frequency > spec.sampleRate / 2.0)
+                    throw std::invalid_argument("Frequency must be positive and at most half the sample rate");
+                if (spec.sampleRate / spec.frequency > static_cast<double>(MaxLength))
+                    throw std::invalid_argument("Frequency is too low for the sample rate; the minimum is sampleRate / " + std::to_string(MaxLength));
+                return getCycleLength(spec.frequency / spec.sampleRate, cycles);
+            }
+            case Waveform::Chirp:
+            {
+                if (spec.frequency < 0.0 || spec.endFrequency < 0.0 || spec.frequency > spec.sampleRate / 2.0 || spec.endFrequency > spec.sampleRate / 2.0)
+                    throw std::invalid_argument("Chirp frequencies must be between 0 and half the sample rate");
+                const double period = std::round(spec.sampleRate * spec.duration);
+                if (period < 1.0 || period > static_cast<double>(MaxLength))
+                    throw std::invalid_argument("Chirp duration must cover 1 to " + std::to_string(MaxLength) + " samples");
+                return static_cast<SizeT>(period);
+            }
+            case Waveform::Noise:
+                return NoiseLength;
+            case Waveform::Constant:
+                return 1;
+        }
+        throw std::invalid_argument("Unknown waveform");
+    }
+
+    // The last convergent cycles / length of the continued fraction of ratio with length at most MaxLength.
+    // Frequencies and sample rates in whole or decimal hertz end on an exact fraction; for whole hertz the
+    // length is sampleRate / gcd(sampleRate, frequency).
+    static SizeT getCycleLength(double ratio, SizeT& cycles)
+    {
+        SizeT previousCycles = 0;
+        SizeT previousLength = 1;
+        SizeT currentCycles = 1;
+        SizeT currentLength = 0;
+
+        double remainder = ratio;
+        while (true)
+        {
+            const double term = std::floor(remainder);
+            if (term > static_cast<double>(MaxLength))
+                break;
+
+            const auto a = static_cast<SizeT>(term);
+            const SizeT nextCycles = a * currentCycles + previousCycles;
+            const SizeT nextLength = a * currentLength + previousLength;
+            if (nextLength > MaxLength)
+                break;
+
+            previousCycles = currentCycles;
+            previousLength = currentLength;
+            currentCycles = nextCycles;
+            currentLength = nextLength;
+
+            const double error = std::abs(static_cast<double>(currentCycles) / static_cast<double>(currentLength) - ratio);
+            const double fraction = remainder - term;
+            if (error <= ratio * 1e-12 || fraction <= 0.0)
+                break;
+            remainder = 1.0 / fraction;
+        }
+
+        cycles = currentCycles;
+        return currentLength;
+    }
+
+    // Rounds and saturates the values to integer sample types
+    template <SampleType Type>
+    static void convertValues(const std::vector<double>& values, uint8_t* output)
+    {
+        using T = typename SampleTypeToType<Type>::Type;
+        auto* out = reinterpret_cast<T*>(output);
+        for (SizeT i = 0; i < values.size(); ++i)
+        {
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                out[i] = static_cast<T>(values[i]);
+            }
+            else
+            {
+                const double low = static_cast<double>(std::numeric_limits<T>::lowest());
+                const double high = static_cast<double>(std::numeric_limits<T>::max());
+                const double value = std::round(values[i]);
+                out[i] = value <= low ? std::numeric_limits<T>::lowest() : value >= high ? std::numeric_limits<T>::max() : static_cast<T>(value);
+            }
+        }
+    }
+
+    std::vector<uint8_t> samples;
+    SizeT length = 0;
+    SizeT cycles = 1;
+    SizeT sampleSize = 0;
+    double frequency = 0.0;
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
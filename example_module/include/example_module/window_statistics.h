@@ -0,0 +1,324 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+#include <example_module/common.h>
+#include <example_module/cpu_features.h>
+#include <example_module/window_statistics_x86.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Count, extremes, mean and sum of squared deviations from the mean of a run of samples
+struct Moments
+{
+    SizeT count = 0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    double mean = 0.0;
+    double m2 = 0.0;
+};
+
+// Combines the moments of two adjacent runs (Chan et al.); the deviations are never summed from zero
+// around a distant mean, so a large offset does not cancel the variance
+inline void mergeMoments(Moments& a, const Moments& b)
+{
+    if (b.count == 0)
+        return;
+    if (a.count == 0)
+    {
+        a = b;
+        return;
+    }
+
+    const double countA = static_cast<double>(a.count);
+    const double countB = static_cast<double>(b.count);
+    const double count = countA + countB;
+    const double delta = b.mean - a.mean;
+
+    a.mean += delta * (countB / count);
+    a.m2 += b.m2 + delta * delta * (countA * countB / count);
+    a.min = std::min(a.min, b.min);
+    a.max = std::max(a.max, b.max);
+    a.count += b.count;
+}
+
+// Lane reductions over a multiple of 4 samples; sample i goes to lane i % 4
+using ReduceLanesFn = void (*)(const double* x, SizeT count, double* sums, double* mins, double* maxs);
+using SquaredDeviationLanesFn = void (*)(const double* x, SizeT count, double mean, double* lanes);
+
+inline void reduceLanesScalar(const double* x, SizeT count, double* sums, double* mins, double* maxs)
+{
+    double s[4] = {};
+    double mn[4] = {mins[0], mins[1], mins[2], mins[3]};
+    double mx[4] = {maxs[0], maxs[1], maxs[2], maxs[3]};
+
+    for (SizeT i = 0; i < count; i += 4)
+    {
+        for (SizeT lane = 0; lane < 4; ++lane)
+        {
+            const double v = x[i + lane];
+            s[lane] += v;
+            mn[lane] = v < mn[lane] ? v : mn[lane];
+            mx[lane] = v > mx[lane] ? v : mx[lane];
+        }
+    }
+
+    std::copy_n(s, 4, sums);
+    std::copy_n(mn, 4, mins);
+    std::copy_n(mx, 4, maxs);
+}
+
+inline void squaredDeviationLanesScalar(const double* x, SizeT count, double mean, double* lanes)
+{
+    double acc[4] = {};
+    for (SizeT i = 0; i < count; i += 4)
+    {
+        for (SizeT lane = 0; lane < 4; ++lane)
+        {
+            const double d = x[i + lane] - mean;
+            acc[lane] += d * d;
+        }
+    }
+    std::copy_n(acc, 4, lanes);
+}
+
+// Computes the moments of up to a few thousand samples in two passes while they are in L1: the sum and
+// extremes, then the squared deviations from the mean. The lanes are combined in a fixed order, so every
+// SIMD level gives the same result.
+class MomentsKernel
+{
+public:
+    explicit MomentsKernel(SimdLevel level = getSimdLevel())
+    {
+#if EXAMPLE_MODULE_SIMD_X86
+        if (level >= SimdLevel::AVX2)
+        {
+            reduceLanes = &x86::reduceLanesAvx2;
+            squaredDeviationLanes = &x86::squaredDeviationLanesAvx2;
+        }
+        else if (level >= SimdLevel::SSE2)
+        {
+            reduceLanes = &x86::reduceLanesSse2;
+            squaredDeviationLanes = &x86::squaredDeviationLanesSse2;
+        }
+#else
+        (void) level;
+#endif
+    }
+
+    Moments operator()(const double* x, SizeT count) const
+    {
+        Moments moments;
+        if (count == 0)
+            return moments;
+
+        const SizeT laneCount = count & ~SizeT(3);
+        double lanes[4] = {};
+        double mins[4] = {moments.min, moments.min, moments.min, moments.min};
+        double maxs[4] = {moments.max, moments.max, moments.max, moments.max};
+        reduceLanes(x, laneCount, lanes, mins, maxs);
+
+        double sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+        moments.min = std::min(std::min(mins[0], mins[1]), std::min(mins[2], mins[3]));
+        moments.max = std::max(std::max(maxs[0], maxs[1]), std::max(maxs[2], maxs[3]));
+        for (SizeT i = laneCount; i < count; ++i)
+        {
+            sum += x[i];
+            moments.min = std::min(moments.min, x[i]);
+            moments.max = std::max(moments.max, x[i]);
+        }
+
+        moments.count = count;
+        moments.mean = sum / static_cast<double>(count);
+
+        squaredDeviationLanes(x, laneCount, moments.mean, lanes);
+        double m2 = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+        for (SizeT i = laneCount; i < count; ++i)
+        {
+            const double d = x[i] - moments.mean;
+            m2 += d * d;
+        }
+        moments.m2 = m2;
+
+        return moments;
+    }
+
+private:
+    ReduceLanesFn reduceLanes = &reduceLanesScalar;
+    SquaredDeviationLanesFn squaredDeviationLanes = &squaredDeviationLanesScalar;
+};
+
+struct WindowResult
+{
+    // Index of the first sample of the window, counted from the last reset
+    SizeT startIndex = 0;
+    double min = 0.0;
+    double max = 0.0;
+    double mean = 0.0;
+    double rms = 0.0;
+    double stdDev = 0.0;
+};
+
+// Statistics over sliding windows of windowSize samples, one window every hopSize samples. The stream is
+// cut into segments of gcd(windowSize, hopSize) samples, whose moments are kept in a ring; a window
+// merges the moments of its segments. A segment is reduced in tiles of TileSize samples counted from its
+// start; a tile split across calls is gathered first, so the results do not depend on the block sizes.
+class WindowStatistics
+{
+public:
+    static constexpr SizeT TileSize = 2048;
+    static constexpr SizeT MaxSegmentsPerWindow = 65536;
+
+    explicit WindowStatistics(SimdLevel level = getSimdLevel())
+        : kernel(level)
+    {
+    }
+
+    // Throws std::invalid_argument unless 0 < hopSize <= windowSize and the window spans at most
+    // MaxSegmentsPerWindow segments
+    void configure(SizeT windowSize, SizeT hopSize)
+    {
+        if (windowSize == 0 || hopSize == 0 || hopSize > windowSize)
+            throw std::invalid_argument("The hop must be at least one sample and at most the window");
+
+        const SizeT segment = std::gcd(windowSize, hopSize);
+        if (windowSize / segment > MaxSegmentsPerWindow)
+            throw std::invalid_argument("The window is too long for its hop; use a hop that divides the window");
+
+        window = windowSize;
+        hop = hopSize;
+        segmentSize = segment;
+        segmentsPerWindow = windowSize / segment;
+        segmentsPerHop = hopSize / segment;
+        segments.assign(segmentsPerWindow, Moments{});
+        pendingTile.reserve(std::min(TileSize, segmentSize));
+        reset();
+    }
+
+    // Starts a new stream; the samples of incomplete windows are discarded
+    void reset()
+    {
+        current = Moments{};
+        pendingTile.clear();
+        segmentFill = 0;
+        nextSegment = 0;
+        completedSegments = 0;
+    }
+
+    SizeT getWindowSize() const
+    {
+        return window;
+    }
+
+    SizeT getHopSize() const
+    {
+        return hop;
+    }
+
+    // Heap memory of the segment ring and the tile buffer
+    SizeT getMemoryUsage() const
+    {
+        return segments.capacity() * sizeof(Moments) + pendingTile.capacity() * sizeof(double);
+    }
+
+    // Adds samples to the stream and calls onWindow(const WindowResult&) for every window they complete
+    template <typename F>
+    void process(const double* input, SizeT count, F&& onWindow)
+    {
+        while (count > 0)
+        {
+            const SizeT tileSize = std::min(TileSize, segmentSize - segmentFill);
+            if (pendingTile.empty() && count >= tileSize)
+            {
+                mergeMoments(current, kernel(input, tileSize));
+                input += tileSize;
+                count -= tileSize;
+            }
+            else
+            {
+                const SizeT n = std::min(tileSize - pendingTile.size(), count);
+                pendingTile.insert(pendingTile.end(), input, input + n);
+                input += n;
+                count -= n;
+                if (pendingTile.size() < tileSize)
+                    return;
+
+                mergeMoments(current, kernel(pendingTile.data(), tileSize));
+                pendingTile.clear();
+            }
+
+            segmentFill += tileSize;
+
+            if (segmentFill == segmentSize)
+                completeSegment(onWindow);
+        }
+    }
+
+private:
+    template <typename F>
+    void completeSegment(F& onWindow)
+    {
+        segments[nextSegment] = current;
+        nextSegment = (nextSegment + 1) % segmentsPerWindow;
+        current = Moments{};
+        segmentFill = 0;
+        ++completedSegments;
+
+        if (completedSegments < segmentsPerWindow || (completedSegments - segmentsPerWindow) % segmentsPerHop != 0)
+            return;
+
+        // nextSegment is now the oldest segment of the window
+        Moments moments;
+        for (SizeT i = 0; i < segmentsPerWindow; ++i)
+            mergeMoments(moments, segments[(nextSegment + i) % segmentsPerWindow]);
+
+        const double variance = std::max(moments.m2 / static_cast<double>(moments.count), 0.0);
+
+        WindowResult result;
+        result.startIndex = (completedSegments - segmentsPerWindow) * segmentSize;
+        result.min = moments.min;
+        result.max = moments.max;
+        result.mean = moments.mean;
+        result.rms = std::sqrt(moments.mean * moments.mean + variance);
+        result.stdDev = std::sqrt(variance);
+        onWindow(static_cast<const WindowResult&>(result));
+    }
+
+    MomentsKernel kernel;
+
+    SizeT window = 0;
+    SizeT hop = 0;
+    SizeT segmentSize = 0;
+    SizeT segmentsPerWindow = 0;
+    SizeT segmentsPerHop = 0;
+
+    // Moments of the last segmentsPerWindow completed segments, and of the segment being filled
+    std::vector<Moments> segments;
+    Moments current;
+    std::vector<double> pendingTile;
+    SizeT segmentFill = 0;
+    SizeT nextSegment = 0;
+    SizeT completedSegments = 0;
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+#include <example_module/common.h>
+#include <example_module/cpu_features.h>
+
+#if EXAMPLE_MODULE_SIMD_X86
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Vectorized lane reductions of window_statistics.h. Sample i is accumulated in lane i % 4, in the same
+// order as the scalar reduction, and squares are multiplied and added in two separately rounded steps, so
+// the lane values are bit-identical to the scalar ones. count must be a multiple of 4.
+namespace x86
+{
+    EXAMPLE_MODULE_TARGET_SSE2 inline void reduceLanesSse2(const double* x, SizeT count, double* sums, double* mins, double* maxs)
+    {
+        __m128d sumLo = _mm_setzero_pd();
+        __m128d sumHi = _mm_setzero_pd();
+        __m128d minLo = _mm_loadu_pd(mins);
+        __m128d minHi = _mm_loadu_pd(mins + 2);
+        __m128d maxLo = _mm_loadu_pd(maxs);
+        __m128d maxHi = _mm_loadu_pd(maxs + 2);
+
+        for (SizeT i = 0; i < count; i += 4)
+        {
+            const __m128d lo = _mm_loadu_pd(x + i);
+            const __m128d hi = _mm_loadu_pd(x + i + 2);
+            sumLo = _mm_add_pd(sumLo, lo);
+            sumHi = _mm_add_pd(sumHi, hi);
+            minLo = _mm_min_pd(lo, minLo);
+            minHi = _mm_min_pd(hi, minHi);
+            maxLo = _mm_max_pd(lo, maxLo);
+            maxHi = _mm_max_pd(hi, maxHi);
+        }
+
+        _mm_storeu_pd(sums, sumLo);
+        _mm_storeu_pd(sums + 2, sumHi);
+        _mm_storeu_pd(mins, minLo);
+        _mm_storeu_pd(mins + 2, minHi);
+        _mm_storeu_pd(maxs, maxLo);
+        _mm_storeu_pd(maxs + 2, maxHi);
+    }
+
+    EXAMPLE_MODULE_TARGET_SSE2 inline void squaredDeviationLanesSse2(const double* x, SizeT count, double mean, double* lanes)
+    {
+        const __m128d m = _mm_set1_pd(mean);
+        __m128d accLo = _mm_setzero_pd();
+        __m128d accHi = _mm_setzero_pd();
+
+        for (SizeT i = 0; i < count; i += 4)
+        {
+            const __m128d lo = _mm_sub_pd(_mm_loadu_pd(x + i), m);
+            const __m128d hi = _mm_sub_pd(_mm_loadu_pd(x + i + 2), m);
+            accLo = _mm_add_pd(accLo, _mm_mul_pd(lo, lo));
+            accHi = _mm_add_pd(accHi, _mm_mul_pd(hi, hi));
+        }
+
+        _mm_storeu_pd(lanes, accLo);
+        _mm_storeu_pd(lanes + 2, accHi);
+    }
+
+    EXAMPLE_MODULE_TARGET_AVX2 inline void reduceLanesAvx2(const double* x, SizeT count, double* sums, double* mins, double* maxs)
+    {
+        __m256d sum = _mm256_setzero_pd();
+        __m256d min = _mm256_loadu_pd(mins);
+        __m256d max = _mm256_loadu_pd(maxs);
+
+        for (SizeT i = 0; i < count; i += 4)
+        {
+            const __m256d v = _mm256_loadu_pd(x + i);
+            sum = _mm256_add_pd(sum, v);
+            min = _mm256_min_pd(v, min);
+            max = _mm256_max_pd(v, max);
+        }
+
+        _mm256_storeu_pd(sums, sum);
+        _mm256_storeu_pd(mins, min);
+        _mm256_storeu_pd(maxs, max);
+    }
+
+    EXAMPLE_MODULE_TARGET_AVX2 inline void squaredDeviationLanesAvx2(const double* x, SizeT count, double mean, double* lanes)
+    {
+        const __m256d m = _mm256_set1_pd(mean);
+        __m256d acc = _mm256_setzero_pd();
+
+        for (SizeT i = 0; i < count; i += 4)
+        {
+            const __m256d d = _mm256_sub_pd(_mm256_loadu_pd(x + i), m);
+            acc = _mm256_add_pd(acc, _mm256_mul_pd(d, d));
+        }
+
+        _mm256_storeu_pd(lanes, acc);
+    }
+}
+
+END_NAMESPACE_EXAMPLE_MODULE
+
+#endif
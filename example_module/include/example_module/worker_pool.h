@@ -0,0 +1,150 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <example_module/common.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+// Fixed set of threads that run the tasks of one job at a time. The calling thread takes part in
+// the job, so a pool of N threads starts N - 1 workers. Tasks must not throw.
+class WorkerPool
+{
+public:
+    explicit WorkerPool(SizeT threadCount)
+        : threadCount(std::max<SizeT>(threadCount, 1))
+    {
+        for (SizeT i = 1; i < this->threadCount; ++i)
+            workers.emplace_back([this] { workerLoop(); });
+    }
+
+    ~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeUp.notify_all();
+
+        for (auto& worker : workers)
+            worker.join();
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    SizeT getThreadCount() const
+    {
+        return threadCount;
+    }
+
+    // Runs task(0) ... task(taskCount - 1) and returns when all of them have finished
+    void run(SizeT taskCount, const std::function<void(SizeT)>& task)
+    {
+        if (workers.empty() || taskCount <= 1)
+        {
+            for (SizeT i = 0; i < taskCount; ++i)
+                task(i);
+            return;
+        }
+
+        {
+            // Workers that woke up late for the previous job may still be checking for tasks
+            std::unique_lock<std::mutex> lock(mutex);
+            jobDone.wait(lock, [this] { return activeWorkers == 0; });
+            jobTask = &task;
+            jobTaskCount = taskCount;
+            nextTask = 0;
+            pendingTasks = taskCount;
+            ++jobGeneration;
+        }
+        wakeUp.notify_all();
+
+        runTasks();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        jobDone.wait(lock, [this] { return pendingTasks == 0 && activeWorkers == 0; });
+    }
+
+private:
+    void workerLoop()
+    {
+        SizeT seenGeneration = 0;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wakeUp.wait(lock, [&] { return stopping || jobGeneration != seenGeneration; });
+                if (stopping)
+                    return;
+                seenGeneration = jobGeneration;
+                ++activeWorkers;
+            }
+
+            runTasks();
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                --activeWorkers;
+            }
+            jobDone.notify_all();
+        }
+    }
+
+    // Claims tasks of the current job until none are left. The job cannot change while a worker is active.
+    void runTasks()
+    {
+        SizeT finished = 0;
+        for (SizeT i = nextTask++; i < jobTaskCount; i = nextTask++)
+        {
+            (*jobTask)(i);
+            ++finished;
+        }
+
+        if (finished == 0)
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pendingTasks -= finished;
+        }
+        jobDone.notify_all();
+    }
+
+    SizeT threadCount;
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::condition_variable jobDone;
+    bool stopping = false;
+    SizeT jobGeneration = 0;
+
+    const std::function<void(SizeT)>* jobTask = nullptr;
+    SizeT jobTaskCount = 0;
+    std::atomic<SizeT> nextTask{0};
+    SizeT pendingTasks = 0;
+    SizeT activeWorkers = 0;
+};
+
+END_NAMESPACE_EXAMPLE_MODULE
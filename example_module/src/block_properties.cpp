@@ -0,0 +1,130 @@
+#include <example_module/block_properties.h>
+#include <example_module/property_updates.h>
+#include <example_module/trace_recorder.h>
+#include <algorithm>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+void addBlockPolicyProperties(PropertyObjectPtr& objPtr, const std::function<void()>& onChanged)
+{
+    // Blocks of fewer samples are held for up to MaxHoldTime to batch small upstream packets
+    const auto minBlockSamplesProp = IntPropertyBuilder("MinBlockSamples", 1).setMinValue(1).setMaxValue(MaxBlockSamplesLimit).build();
+    objPtr.addProperty(minBlockSamplesProp);
+
+    // Largest number of samples processed in one block; bounds the read buffer independently of the sample rate
+    const auto maxBlockSamplesProp =
+        IntPropertyBuilder("MaxBlockSamples", DefaultMaxBlockSamples).setMinValue(1).setMaxValue(MaxBlockSamplesLimit).build();
+    objPtr.addProperty(maxBlockSamplesProp);
+
+    const auto maxHoldTimeProp = FloatPropertyBuilder("MaxHoldTime", DefaultMaxHoldTime).setUnit(Unit("ms", -1, "milliseconds", "time")).build();
+    objPtr.addProperty(maxHoldTimeProp);
+
+    const auto memoryUsageProp = IntPropertyBuilder("MemoryUsage", 0).setReadOnly(true).build();
+    objPtr.addProperty(memoryUsageProp);
+
+    observeProperties(objPtr, {"MinBlockSamples", "MaxBlockSamples", "MaxHoldTime"}, onChanged);
+}
+
+void addExecutionProperties(PropertyObjectPtr& objPtr, const std::function<void()>& onChanged)
+{
+    const auto executionModeProp = SelectionProperty("ExecutionMode", List<IString>("Scheduler", "SameThread", "WorkerThread"), 0);
+    objPtr.addProperty(executionModeProp);
+
+    // Bit n pins the worker thread to CPU n; 0 lets it run on any CPU. Only supported on Linux.
+    const auto cpuAffinityProp = IntProperty("CpuAffinity", 0, EvalValue("$ExecutionMode == 2"));
+    objPtr.addProperty(cpuAffinityProp);
+
+    observeProperties(objPtr, {"ExecutionMode", "CpuAffinity"}, onChanged);
+}
+
+ExecutionMode readExecutionMode(const PropertyObjectPtr& objPtr)
+{
+    return static_cast<ExecutionMode>(static_cast<Int>(objPtr.getPropertyValue("ExecutionMode")));
+}
+
+uint64_t readCpuAffinity(const PropertyObjectPtr& objPtr)
+{
+    return static_cast<uint64_t>(static_cast<Int>(objPtr.getPropertyValue("CpuAffinity")));
+}
+
+PacketReadyNotification getNotificationMethod(ExecutionMode mode)
+{
+    return mode == ExecutionMode::Scheduler ? PacketReadyNotification::Scheduler : PacketReadyNotification::SameThread;
+}
+
+BlockLimits readBlockPolicyProperties(const PropertyObjectPtr& objPtr)
+{
+    BlockLimits limits;
+    limits.minSamples = static_cast<SizeT>(static_cast<Int>(objPtr.getPropertyValue("MinBlockSamples")));
+    limits.maxSamples = static_cast<SizeT>(static_cast<Int>(objPtr.getPropertyValue("MaxBlockSamples")));
+
+    // Negative hold times flush at once
+    const Float maxHoldTime = std::max(static_cast<Float>(objPtr.getPropertyValue("MaxHoldTime")), 0.0);
+    limits.maxHoldTime = std::chrono::duration_cast<BlockPolicy::Clock::duration>(std::chrono::duration<double, std::milli>(maxHoldTime));
+    return limits;
+}
+
+void addStatisticsProperty(PropertyObjectPtr& objPtr, ProcessingStatistics& statistics)
+{
+    using Counters = ProcessingStatistics::Counters;
+
+    auto statisticsObj = PropertyObject();
+    const auto addCounter = [&statisticsObj, &statistics](const std::string& name, uint64_t Counters::*counter)
+    {
+        statisticsObj.addProperty(IntPropertyBuilder(name, 0).setReadOnly(true).build());
+        statisticsObj.getOnPropertyValueRead(name) += [&statistics, counter](PropertyObjectPtr&, PropertyValueEventArgsPtr& args)
+        {
+            args.setValue(static_cast<Int>(statistics.getCounters().*counter));
+        };
+    };
+
+    addCounter("SamplesIn", &Counters::samplesIn);
+    addCounter("SamplesOut", &Counters::samplesOut);
+    addCounter("PacketsIn", &Counters::packetsIn);
+    addCounter("PacketsOut", &Counters::packetsOut);
+    addCounter("Events", &Counters::events);
+    addCounter("Blocks", &Counters::blocks);
+    addCounter("BusyTimeNs", &Counters::busyTimeNs);
+    addCounter("MaxBacklog", &Counters::maxBacklog);
+    addCounter("Reconfigurations", &Counters::reconfigurations);
+
+    // Item k counts the blocks that took [2^k, 2^(k+1)) ns
+    statisticsObj.addProperty(ListPropertyBuilder("ProcessingTimeHistogram", List<IInteger>()).setReadOnly(true).build());
+    statisticsObj.getOnPropertyValueRead("ProcessingTimeHistogram") += [&statistics](PropertyObjectPtr&, PropertyValueEventArgsPtr& args)
+    {
+        auto histogram = List<IInteger>();
+        for (const uint64_t count : statistics.getCounters().processingTimeHistogram)
+            histogram.pushBack(static_cast<Int>(count));
+        args.setValue(histogram);
+    };
+
+    statisticsObj.addProperty(FunctionProperty("Reset", ProcedureInfo()));
+    statisticsObj.setPropertyValue("Reset", Procedure([&statistics] { statistics.reset(); }));
+
+    objPtr.addProperty(ObjectProperty("Statistics", statisticsObj));
+}
+
+void addTracingProperties(PropertyObjectPtr& objPtr, const std::function<void()>& onChanged)
+{
+    // Records read, compute, send and event spans of every block into per-thread rings
+    const auto tracingProp = BoolProperty("Tracing", False);
+    objPtr.addProperty(tracingProp);
+
+    // The trace is process-wide, so that the spans of connected function blocks line up
+    objPtr.addProperty(FunctionProperty("DumpTrace", FunctionInfo(ctString)));
+    objPtr.setPropertyValue("DumpTrace", Function([] { return String(TraceRegistry::instance().dumpChromeTrace()); }));
+
+    observeProperties(objPtr, {"Tracing"}, onChanged);
+}
+
+bool readTracingEnabled(const PropertyObjectPtr& objPtr)
+{
+    return objPtr.getPropertyValue("Tracing");
+}
+
+void setMemoryUsage(const PropertyObjectPtr& objPtr, SizeT bytes)
+{
+    objPtr.asPtr<IPropertyObjectProtected>().setProtectedPropertyValue("MemoryUsage", static_cast<Int>(bytes));
+}
+
+END_NAMESPACE_EXAMPLE_MODULE
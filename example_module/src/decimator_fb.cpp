@@ -0,0 +1,169 @@
+#include <example_module/decimator_fb.h>
+#include <example_module/property_updates.h>
+#include <opendaq/data_descriptor_ptr.h>
+#include <opendaq/event_packet_params.h>
+#include <opendaq/input_port_factory.h>
+#include <opendaq/signal_factory.h>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+DecimatorFBImpl::DecimatorFBImpl(const ContextPtr& context,
+                                 const ComponentPtr& parent,
+                                 const StringPtr& localId,
+                                 const PropertyObjectPtr& /*config*/)
+    : FunctionBlock(CreateType(), context, parent, localId)
+{
+    initComponentStatus();
+    createInputPorts();
+    createSignals();
+    initProperties();
+}
+
+FunctionBlockTypePtr DecimatorFBImpl::CreateType()
+{
+    return FunctionBlockType("ExampleDecimator",
+                             "Decimator",
+                             "Reduces the sample rate by an integer factor with a polyphase anti-alias filter",
+                             PropertyObject());
+}
+
+void DecimatorFBImpl::createInputPorts()
+{
+    inputPort = createAndAddInputPort("Input", PacketReadyNotification::Scheduler);
+    reader = StreamReaderFromPort(inputPort, SampleType::Float64, SampleType::UInt64);
+    reader.setOnDataAvailable([this] { calculate(); });
+
+    // Input that arrives while the descriptors are rejected is still read into this buffer
+    inputData.resize(ReadBlockSize);
+}
+
+void DecimatorFBImpl::createSignals()
+{
+    outputSignal = createAndAddSignal("Decimated");
+    outputDomainSignal = createAndAddSignal("DecimatedTime", nullptr, false);
+    outputSignal.setDomainSignal(outputDomainSignal);
+    outputSignal.setName("Decimated");
+}
+
+void DecimatorFBImpl::initProperties()
+{
+    const auto factorProp = IntPropertyBuilder("DecimationFactor", 10).setMinValue(1).setMaxValue(MaxDecimationFactor).build();
+    objPtr.addProperty(factorProp);
+
+    // Longer phases give a steeper anti-alias filter
+    const auto tapsPerPhaseProp = IntPropertyBuilder("TapsPerPhase", 16).setMinValue(1).setMaxValue(MaxTapsPerPhase).build();
+    objPtr.addProperty(tapsPerPhaseProp);
+
+    observeProperties(objPtr, {"DecimationFactor", "TapsPerPhase"}, [this] { propertyChanged(); });
+
+    readProperties();
+}
+
+void DecimatorFBImpl::readProperties()
+{
+    decimationFactor = static_cast<SizeT>(static_cast<Int>(objPtr.getPropertyValue("DecimationFactor")));
+    tapsPerPhase = static_cast<SizeT>(static_cast<Int>(objPtr.getPropertyValue("TapsPerPhase")));
+}
+
+void DecimatorFBImpl::propertyChanged()
+{
+    auto lock = this->getAcquisitionLock();
+
+    readProperties();
+    if (inputDomainDataDescriptor.assigned())
+        configure();
+}
+
+void DecimatorFBImpl::configure()
+{
+    try
+    {
+        if (!inputDomainDataDescriptor.assigned() || inputDomainDataDescriptor == NullDataDescriptor())
+            throw std::runtime_error("No domain input");
+
+        if (!inputDataDescriptor.assigned() || inputDataDescriptor == NullDataDescriptor())
+            throw std::runtime_error("No value input");
+
+        validateValueSampleType(inputDataDescriptor.getSampleType());
+        const SizeT domainDelta = validateLinearDomain(inputDomainDataDescriptor);
+        const double sampleRate = getLinearSampleRate(inputDomainDataDescriptor);
+
+        decimator.setFilter(designDecimationFilter(decimationFactor, tapsPerPhase, sampleRate), decimationFactor);
+
+        const Int delta = static_cast<Int>(domainDelta);
+        const Int start = inputDomainDataDescriptor.getRule().getParameters().get("start");
+        domainOffsets.setDelta(domainDelta);
+
+        // Same tick resolution and origin, one tick step per retained sample
+        outputDomainDataDescriptor =
+            DataDescriptorBuilderCopy(inputDomainDataDescriptor).setRule(LinearDataRule(delta * static_cast<Int>(decimationFactor), start)).build();
+        outputDataDescriptor = DataDescriptorBuilderCopy(inputDataDescriptor).setSampleType(SampleType::Float64).setPostScaling(nullptr).setRule(ExplicitDataRule()).build();
+
+        outputPacketPool.setDescriptor(outputDataDescriptor);
+        outputSignal.setDescriptor(outputDataDescriptor);
+        outputDomainSignal.setDescriptor(outputDomainDataDescriptor);
+
+        setComponentStatus(ComponentStatus::Ok);
+        configValid = true;
+    }
+    catch (const std::exception& e)
+    {
+        setComponentStatusWithMessage(ComponentStatus::Error, e.what());
+        outputSignal.setDescriptor(nullptr);
+        configValid = false;
+        throw;
+    }
+}
+
+void DecimatorFBImpl::calculate()
+{
+    auto lock = this->getAcquisitionLock();
+
+    readUntilEvent(
+        reader,
+        inputData.data(),
+        ReadBlockSize,
+        [this](const ReaderStatusPtr& status, SizeT readAmount)
+        {
+            if (configValid)
+                processData(readAmount, domainOffsets.next(status, readAmount));
+        },
+        [this](const EventPacketPtr& packet) { processEventPacket(packet); });
+}
+
+void DecimatorFBImpl::processEventPacket(const EventPacketPtr& packet)
+{
+    if (packet.getEventId() == event_packet_id::DATA_DESCRIPTOR_CHANGED)
+    {
+        DataDescriptorPtr dataDesc = packet.getParameters().get(event_packet_param::DATA_DESCRIPTOR);
+        DataDescriptorPtr domainDesc = packet.getParameters().get(event_packet_param::DOMAIN_DATA_DESCRIPTOR);
+        if (dataDesc.assigned())
+            inputDataDescriptor = dataDesc;
+        if (domainDesc.assigned())
+            inputDomainDataDescriptor = domainDesc;
+
+        configure();
+    }
+}
+
+void DecimatorFBImpl::processData(SizeT readAmount, SizeT packetOffset)
+{
+    // Blocks shorter than the factor can complete no output
+    const SizeT outputCount = decimator.getOutputCount(readAmount);
+    if (outputCount == 0)
+    {
+        decimator.process(inputData.data(), readAmount, nullptr);
+        return;
+    }
+
+    const SizeT firstOutputOffset = packetOffset + (decimator.getSamplesUntilNextOutput() - 1) * domainOffsets.getDelta();
+    const auto outputDomainPacket = DataPacket(outputDomainDataDescriptor, outputCount, firstOutputOffset);
+    const auto outputPacket = outputPacketPool.createPacket(outputDomainPacket, outputCount);
+
+    decimator.process(inputData.data(), readAmount, static_cast<double*>(outputPacket.getRawData()));
+
+    outputSignal.sendPacket(outputPacket);
+    outputDomainSignal.sendPacket(outputDomainPacket);
+}
+
+END_NAMESPACE_EXAMPLE_MODULE
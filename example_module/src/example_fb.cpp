@@ -1,11 +1,17 @@
 #include <example_module/example_fb.h>
+#include <example_module/block_properties.h>
 #include <example_module/dispatch.h>
+#include <example_module/property_updates.h>
 #include <opendaq/event_packet_params.h>
 
 BEGIN_NAMESPACE_EXAMPLE_MODULE
-    ExampleFBImpl::ExampleFBImpl(const ContextPtr& ctx, const ComponentPtr& parent, const StringPtr& localId)
+    ExampleFBImpl::ExampleFBImpl(const ContextPtr& ctx, const ComponentPtr& parent, const StringPtr& localId, const PropertyObjectPtr& config)
     : FunctionBlock(CreateType(), ctx, parent, localId)
+    , trace(localId.toStdString())
 {
+    if (config.assigned() && config.hasProperty("PacketMode"))
+        packetMode = config.getPropertyValue("PacketMode");
+
     initComponentStatus();
     createInputPorts();
     createSignals();
@@ -14,65 +20,50 @@ BEGIN_NAMESPACE_EXAMPLE_MODULE
 
 void ExampleFBImpl::initProperties()
 {
-    const auto scaleProp = FloatProperty("Scale", 1.0);
-    objPtr.addProperty(scaleProp);
-    objPtr.getOnPropertyValueWrite("Scale") +=
-        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { propertyChanged(true); };
-
-    const auto offsetProp = FloatProperty("Offset", 0.0);
-    objPtr.addProperty(offsetProp);
-    objPtr.getOnPropertyValueWrite("Offset") +=
-        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { propertyChanged(true); };
-
-    const auto useCustomOutputRangeProp = BoolProperty("UseCustomOutputRange", False);
-    objPtr.addProperty(useCustomOutputRangeProp);
-    objPtr.getOnPropertyValueWrite("UseCustomOutputRange") +=
-        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { propertyChanged(true); };
-
-    const auto customHighValueProp = FloatProperty("OutputHighValue", 10.0, EvalValue("$UseCustomOutputRange"));
-    objPtr.addProperty(customHighValueProp);
-    objPtr.getOnPropertyValueWrite("OutputHighValue") +=
-        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { propertyChanged(true); };
-
-    const auto customLowValueProp = FloatProperty("OutputLowValue", -10.0, EvalValue("$UseCustomOutputRange"));
-    objPtr.addProperty(customLowValueProp);
-    objPtr.getOnPropertyValueWrite("OutputLowValue") +=
-        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { propertyChanged(true); };
-
-    const auto outputNameProp = StringProperty("OutputName", "");
-    objPtr.addProperty(outputNameProp);
-    objPtr.getOnPropertyValueWrite("OutputName") +=
-        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { propertyChanged(true); };
+    // Property writes only publish new scaling parameters and never take the acquisition lock
+    addScalingProperties(objPtr, [this] { scaling.publish(objPtr); });
+    addBlockPolicyProperties(objPtr, [this] { blockPolicyChanged(); });
+    addExecutionProperties(objPtr, [this] { dispatcher.setExecutionMode(objPtr, inputPort); });
+    addStatisticsProperty(objPtr, statistics);
+    addTracingProperties(objPtr, [this] { trace.setEnabled(readTracingEnabled(objPtr)); });
+
+    scaling.publish(objPtr);
+    const auto limits = readBlockPolicyProperties(objPtr);
+    inputReader.getBlockPolicy().setLimits(limits.minSamples, limits.maxSamples, limits.maxHoldTime);
+}
 
-    const auto outputUnitProp = StringProperty("OutputUnit", "");
-    objPtr.addProperty(outputUnitProp);
-    objPtr.getOnPropertyValueWrite("OutputUnit") +=
-        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { propertyChanged(true); };
+void ExampleFBImpl::blockPolicyChanged()
+{
+    auto lock = this->getAcquisitionLock();
 
-    readProperties();
+    const auto limits = readBlockPolicyProperties(objPtr);
+    inputReader.getBlockPolicy().setLimits(limits.minSamples, limits.maxSamples, limits.maxHoldTime);
+    updateMemoryUsage();
 }
 
-void ExampleFBImpl::propertyChanged(bool configure)
+// The read buffer is leased from the scratch arena of the processing thread, which the function blocks
+// processing on that thread share; in packet mode the input packets are scaled directly
+void ExampleFBImpl::updateMemoryUsage()
 {
-    readProperties();
-    if (configure)
-        this->configure();
+    const SizeT maxSamples = inputReader.getBlockPolicy().getMaxSamples();
+    setMemoryUsage(objPtr, packetMode ? 0 : maxSamples * getSampleSize(reader.getValueReadType()));
 }
 
-void ExampleFBImpl::readProperties()
+void ExampleFBImpl::updateOutputDescriptor(const ScalingParameters& params)
 {
-    scale = objPtr.getPropertyValue("Scale");
-    offset = objPtr.getPropertyValue("Offset");
-    useCustomOutputRange = objPtr.getPropertyValue("UseCustomOutputRange");
-    outputHighValue = objPtr.getPropertyValue("OutputHighValue");
-    outputLowValue = objPtr.getPropertyValue("OutputLowValue");
-    outputUnit = static_cast<std::string>(objPtr.getPropertyValue("OutputUnit"));
-    outputName = static_cast<std::string>(objPtr.getPropertyValue("OutputName"));
+    outputDataDescriptor = buildScaledOutputDescriptor(params, inputDataDescriptor);
+    outputPacketPool.setDescriptor(outputDataDescriptor);
+
+    outputSignal.setDescriptor(outputDataDescriptor);
+    outputSignal.setName(getScaledOutputName(params, inputPort, "/Scaled"));
 }
 
 FunctionBlockTypePtr ExampleFBImpl::CreateType()
 {
-    return FunctionBlockType("ExampleScalingModule", "Scaling", "Signal scaling");
+    auto defaultConfig = PropertyObject();
+    defaultConfig.addProperty(BoolProperty("PacketMode", False));
+
+    return FunctionBlockType("ExampleScalingModule", "Scaling", "Signal scaling", defaultConfig);
 }
 
 void ExampleFBImpl::processSignalDescriptorChanged(const DataDescriptorPtr& dataDescriptor,
@@ -88,6 +79,8 @@ void ExampleFBImpl::processSignalDescriptorChanged(const DataDescriptorPtr& data
 
 void ExampleFBImpl::configure()
 {
+    statistics.recordReconfiguration();
+
     try
     {
         if (!inputDomainDataDescriptor.assigned() || inputDomainDataDescriptor == NullDataDescriptor())
@@ -120,6 +113,30 @@ void ExampleFBImpl::configure()
             throw std::runtime_error("Invalid sample type");
         }
 
+        // Read the input in its native sample type, so that the scaling kernel performs the only conversion
+        scalingKernel = getScalingKernel(inputSampleType);
+        if (packetMode)
+        {
+            // Packets are processed in place, the raw data must already hold the values
+            if (inputDataDescriptor.getPostScaling().assigned())
+                throw std::runtime_error("Post scaling is not supported in packet mode");
+            const auto valueRule = inputDataDescriptor.getRule();
+            if (valueRule.assigned() && valueRule.getType() != DataRuleType::Explicit)
+                throw std::runtime_error("Implicit value rules are not supported in packet mode");
+        }
+        else if (reader.getValueReadType() != inputSampleType)
+        {
+            // Arrivals are marked from the sending thread, which reads the pending samples of the reader
+            auto ingressLock = trace.lockIngress();
+            reader = StreamReaderFromExisting(reader, inputSampleType, SampleType::UInt64);
+            reader.setOnDataAvailable(
+                [this]
+                {
+                    markIngress(trace, reader);
+                    dispatcher.dataAvailable();
+                });
+        }
+
         // Accept only synchronous (linear implicit) domain signals
         if (inputDomainDataDescriptor.getSampleType() != SampleType::Int64 && inputDomainDataDescriptor.getSampleType() != SampleType::UInt64)
         {
@@ -138,41 +155,19 @@ void ExampleFBImpl::configure()
             throw std::runtime_error("Domain rule must be linear");
         }
 
-        RangePtr outputRange;
-        if (useCustomOutputRange)
-        {
-            outputRange = Range(outputLowValue, outputHighValue);
-        }
-        else
-        {
-            auto outputHigh = scale * static_cast<Float>(inputDataDescriptor.getValueRange().getLowValue()) + offset;
-            auto outputLow = scale * static_cast<Float>(inputDataDescriptor.getValueRange().getHighValue()) + offset;
-            if (outputLow > outputHigh)
-                std::swap(outputLow, outputHigh);
+        // A new input always gets a new output descriptor
+        scaling.reset();
+        scaling.apply([this](const ScalingParameters& params) { updateOutputDescriptor(params); });
 
-            outputRange = Range(outputLow, outputHigh);
-        }
-
-        auto name = outputName.empty() ? inputPort.getSignal().getName().toStdString() + "/Scaled" : outputName;
-        auto unit = outputUnit.empty() ? inputDataDescriptor.getUnit() : Unit(outputUnit);
-
-        outputDataDescriptor = DataDescriptorBuilder()
-                               .setSampleType(SampleType::Float64)
-                               .setValueRange(outputRange)
-                               .setUnit(unit)
-                               .build();
         outputDomainDataDescriptor = inputDomainDataDescriptor;
-
-        outputSignal.setDescriptor(outputDataDescriptor);
-        outputSignal.setName(name);
         outputDomainSignal.setDescriptor(inputDomainDataDescriptor);
 
-        // Allocate 1s buffer
-        sampleRate = reader::getSampleRate(inputDomainDataDescriptor);
-        inputData.resize(sampleRate);
-        inputDomainData.resize(sampleRate);
+        // Domain values are never read, they follow from the linear rule
+        const Int delta = domainRule.getParameters().get("delta");
+        inputReader.setDomainDelta(static_cast<SizeT>(delta));
 
         setComponentStatus(ComponentStatus::Ok);
+        configValid = true;
     }
     catch (const std::exception& e)
     {
@@ -181,51 +176,93 @@ void ExampleFBImpl::configure()
         configValid = false;
     }
 
-    configValid = true;
+    updateMemoryUsage();
 }
 
 void ExampleFBImpl::calculate()
 {
     auto lock = this->getAcquisitionLock();
 
-    while (!reader.getEmpty())
-    {
-        SizeT readAmount = std::min(reader.getAvailableCount(), sampleRate);
-        const auto status = reader.readWithDomain(inputData.data(), inputDomainData.data(), &readAmount);
+    // Sized for the current read type; a descriptor change that changes it ends the call
+    const SizeT maxSamples = inputReader.getBlockPolicy().getMaxSamples();
+    const auto inputData = ScratchArena::local().acquire(maxSamples * getSampleSize(reader.getValueReadType()));
+    inputReader.readBlocks(
+        reader,
+        inputData.get(),
+        configValid,
+        [this](const void* data, SizeT samples, SizeT domainOffset, uint64_t inputPosition)
+        { processData(data, samples, domainOffset, inputPosition); },
+        [this](const EventPacketPtr& packet) { processEventPacket(packet); });
+}
 
-        if (configValid)
-        {
-            processData(readAmount, status.getOffset());
-        }
+void ExampleFBImpl::processData(const void* inputData, SizeT readAmount, SizeT packetOffset, uint64_t inputPosition)
+{
+    if (readAmount == 0 || !scalingKernel)
+        return;
 
-        if (status.getReadStatus() == ReadStatus::Event)
-        {
-            const auto eventPacket = status.getEventPacket();
-            if (eventPacket.assigned())
-                processEventPacket(eventPacket);
-            return;
-        }
+    // One set of parameters per block
+    const auto& params = scaling.apply([this](const ScalingParameters& p) { updateOutputDescriptor(p); });
+
+    const auto outputDomainPacket = DataPacket(outputDomainDataDescriptor, readAmount, packetOffset);
+    DataPacketPtr outputPacket;
+    {
+        TraceScope computeSpan(trace, TraceSpan::Compute, static_cast<int64_t>(packetOffset), readAmount);
+        outputPacket = outputPacketPool.createPacket(outputDomainPacket, readAmount);
+        scalingKernel(inputData, static_cast<Float*>(outputPacket.getRawData()), readAmount, params.scale, params.offset);
     }
+
+    TraceScope sendSpan(trace, TraceSpan::Send, static_cast<int64_t>(packetOffset), readAmount);
+    sendSpan.setInputPosition(inputPosition);
+    outputSignal.sendPacket(outputPacket);
+    outputDomainSignal.sendPacket(outputDomainPacket);
+}
+
+void ExampleFBImpl::onPacketReceived(const InputPortPtr& /*port*/)
+{
+    markQueuedIngress(trace, inputPort);
+    dispatcher.dataAvailable();
 }
 
-void ExampleFBImpl::processData(SizeT readAmount, SizeT packetOffset) const
+void ExampleFBImpl::processQueuedPackets()
 {
-    if (readAmount == 0)
+    auto lock = this->getAcquisitionLock();
+
+    inputReader.readPackets(
+        inputPort,
+        configValid,
+        [this](const DataPacketPtr& packet, uint64_t inputPosition) { processDataPacket(packet, inputPosition); },
+        [this](const EventPacketPtr& packet) { processEventPacket(packet); });
+}
+
+// Scales the input packet's raw data directly and forwards its domain packet unchanged
+void ExampleFBImpl::processDataPacket(const DataPacketPtr& packet, uint64_t inputPosition)
+{
+    const auto sampleCount = packet.getSampleCount();
+    if (sampleCount == 0 || !scalingKernel)
         return;
 
-    const auto outputDomainPacket = DataPacket(outputDomainDataDescriptor, readAmount, packetOffset);
-    const auto outputPacket = DataPacketWithDomain(outputDomainPacket, outputDataDescriptor, readAmount);
-    auto outputData = static_cast<Float*>(outputPacket.getRawData());
+    const auto& params = scaling.apply([this](const ScalingParameters& p) { updateOutputDescriptor(p); });
 
-    for (size_t i = 0; i < readAmount; i++)
-        *outputData++ = scale * static_cast<Float>(inputData[i]) + offset;
+    const auto domainPacket = packet.getDomainPacket();
+    const auto packetOffset = domainPacket.assigned() && domainPacket.getOffset().assigned() ? domainPacket.getOffset().getIntValue() : 0;
+    DataPacketPtr outputPacket;
+    {
+        TraceScope computeSpan(trace, TraceSpan::Compute, packetOffset, sampleCount);
+        outputPacket = outputPacketPool.createPacket(domainPacket, sampleCount);
+        scalingKernel(packet.getRawData(), static_cast<Float*>(outputPacket.getRawData()), sampleCount, params.scale, params.offset);
+    }
 
+    TraceScope sendSpan(trace, TraceSpan::Send, packetOffset, sampleCount);
+    sendSpan.setInputPosition(inputPosition);
     outputSignal.sendPacket(outputPacket);
-    outputDomainSignal.sendPacket(outputDomainPacket);
+    if (domainPacket.assigned())
+        outputDomainSignal.sendPacket(domainPacket);
 }
 
 void ExampleFBImpl::processEventPacket(const EventPacketPtr& packet)
 {
+    TraceScope eventSpan(trace, TraceSpan::Event);
+    statistics.recordEvent();
     if (packet.getEventId() == event_packet_id::DATA_DESCRIPTOR_CHANGED)
     {
         DataDescriptorPtr dataDesc = packet.getParameters().get(event_packet_param::DATA_DESCRIPTOR);
@@ -237,8 +274,18 @@ void ExampleFBImpl::processEventPacket(const EventPacketPtr& packet)
 void ExampleFBImpl::createInputPorts()
 {
     inputPort = createAndAddInputPort("Input", PacketReadyNotification::Scheduler);
-    reader = StreamReaderFromPort(inputPort, SampleType::Float32, SampleType::UInt64);
-    reader.setOnDataAvailable([this] { calculate();});
+
+    // In packet mode the input port notifies the function block directly (see onPacketReceived)
+    if (packetMode)
+        return;
+
+    reader = StreamReaderFromPort(inputPort, SampleType::Float64, SampleType::UInt64);
+    reader.setOnDataAvailable(
+        [this]
+        {
+            markIngress(trace, reader);
+            dispatcher.dataAvailable();
+        });
 }
 
 void ExampleFBImpl::createSignals()
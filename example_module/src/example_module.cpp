@@ -4,6 +4,15 @@
 #include <example_module/version.h>
 #include <opendaq/custom_log.h>
 #include <example_module/iir_filter_fb.h>
+#include <example_module/filter_bank_fb.h>
+#include <example_module/fir_filter_fb.h>
+#include <example_module/decimator_fb.h>
+#include <example_module/generator_fb.h>
+#include <example_module/recorder_fb.h>
+#include <example_module/replay_fb.h>
+#include <example_module/scaled_filter_fb.h>
+#include <example_module/operator_chain_fb.h>
+#include <example_module/statistics_fb.h>
 
 BEGIN_NAMESPACE_EXAMPLE_MODULE
 
@@ -25,6 +34,33 @@ DictPtr<IString, IFunctionBlockType> ExampleModule::onGetAvailableFunctionBlockT
     const auto typeIIR = IIRFilterFBImpl::CreateType();
     types.set(typeIIR.getId(), typeIIR);
 
+    const auto typeFilterBank = FilterBankFBImpl::CreateType();
+    types.set(typeFilterBank.getId(), typeFilterBank);
+
+    const auto typeFIR = FIRFilterFBImpl::CreateType();
+    types.set(typeFIR.getId(), typeFIR);
+
+    const auto typeDecimator = DecimatorFBImpl::CreateType();
+    types.set(typeDecimator.getId(), typeDecimator);
+
+    const auto typeGenerator = GeneratorFBImpl::CreateType();
+    types.set(typeGenerator.getId(), typeGenerator);
+
+    const auto typeRecorder = RecorderFBImpl::CreateType();
+    types.set(typeRecorder.getId(), typeRecorder);
+
+    const auto typeReplay = ReplayFBImpl::CreateType();
+    types.set(typeReplay.getId(), typeReplay);
+
+    const auto typeScaledFilter = ScaledFilterFBImpl::CreateType();
+    types.set(typeScaledFilter.getId(), typeScaledFilter);
+
+    const auto typeOperatorChain = OperatorChainFBImpl::CreateType();
+    types.set(typeOperatorChain.getId(), typeOperatorChain);
+
+    const auto typeStatistics = StatisticsFBImpl::CreateType();
+    types.set(typeStatistics.getId(), typeStatistics);
+
     return types;
 }
 
@@ -35,13 +71,67 @@ FunctionBlockPtr ExampleModule::onCreateFunctionBlock(const StringPtr& id,
 {
     if (id == ExampleFBImpl::CreateType().getId())
     {
-        FunctionBlockPtr fb = createWithImplementation<IFunctionBlock, ExampleFBImpl>(context, parent, localId);
+        FunctionBlockPtr fb = createWithImplementation<IFunctionBlock, ExampleFBImpl>(context, parent, localId, config);
         return fb;
     }
 
     if (id == IIRFilterFBImpl::CreateType().getId())
     {
-        FunctionBlockPtr fb = createWithImplementation<IFunctionBlock, IIRFilterFBImpl>(context, parent, localId);
+        FunctionBlockPtr fb = createWithImplementation<IFunctionBlock, IIRFilterFBImpl>(context, parent, localId, config);
+        return fb;
+    }
+
+    if (id == FilterBankFBImpl::CreateType().getId())
+    {
+        FunctionBlockPtr fb = createWithImplementation<IFunctionBlock, FilterBankFBImpl>(context, parent, localId, config);
+        return fb;
+    }
+
+    if (id == FIRFilterFBImpl::CreateType().getId())
+    {
+        FunctionBlockPtr fb = createWithImplementation<IFunctionBlock, FIRFilterFBImpl>(context, parent, localId, config);
+        return fb;
+    }
+
+    if (id == DecimatorFBImpl::CreateType().getId())
+    {
+        FunctionBlockPtr fb = createWithImplementation<IFunctionBlock, DecimatorFBImpl>(context, parent, localId, config);
+        return fb;
+    }
+
+    if (id == GeneratorFBImpl::CreateType().getId())
+    {
+        FunctionBlockPtr fb = createWithImplementation<IFunctionBlock, GeneratorFBImpl>(context, parent, localId, config);
+        return fb;
+    }
+
+    if (id == RecorderFBImpl::CreateType().getId())
+    {
+        FunctionBlockPtr fb = createWithImplementation<IFunctionBlock, RecorderFBImpl>(context, parent, localId, config);
+        return fb;
+    }
+
+    if (id == ReplayFBImpl::CreateType().getId())
+    {
+        FunctionBlockPtr fb = createWithImplementation<IFunctionBlock, ReplayFBImpl>(context, parent, localId, config);
+        return fb;
+    }
+
+    if (id == ScaledFilterFBImpl::CreateType().getId())
+    {
+        FunctionBlockPtr fb = createWithImplementation<IFunctionBlock, ScaledFilterFBImpl>(context, parent, localId, config);
+        return fb;
+    }
+
+    if (id == OperatorChainFBImpl::CreateType().getId())
+    {
+        FunctionBlockPtr fb = createWithImplementation<IFunctionBlock, OperatorChainFBImpl>(context, parent, localId, config);
+        return fb;
+    }
+
+    if (id == StatisticsFBImpl::CreateType().getId())
+    {
+        FunctionBlockPtr fb = createWithImplementation<IFunctionBlock, StatisticsFBImpl>(context, parent, localId, config);
         return fb;
     }
 
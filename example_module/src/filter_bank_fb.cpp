@@ -0,0 +1,352 @@
+#include <example_module/filter_bank_fb.h>
+#include <example_module/filter_properties.h>
+#include <opendaq/data_descriptor_ptr.h>
+#include <opendaq/event_packet_params.h>
+#include <opendaq/input_port_factory.h>
+#include <opendaq/signal_factory.h>
+#include <algorithm>
+#include <map>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+FilterBankFBImpl::FilterBankFBImpl(const ContextPtr& context,
+                                   const ComponentPtr& parent,
+                                   const StringPtr& localId,
+                                   const PropertyObjectPtr& /*config*/)
+    : FunctionBlock(CreateType(), context, parent, localId)
+{
+    initComponentStatus();
+    initProperties();
+    addChannel();
+    discardData.resize(ReadBlockSize);
+}
+
+FunctionBlockTypePtr FilterBankFBImpl::CreateType()
+{
+    return FunctionBlockType("ExampleFilterBank",
+                             "Filter Bank",
+                             "Filters any number of channels with the same IIR filter design, vectorized across channels",
+                             PropertyObject());
+}
+
+void FilterBankFBImpl::initProperties()
+{
+    addFilterDesignProperties(objPtr, [this] { propertyChanged(); });
+    filterSpec = readFilterDesignProperties(objPtr);
+}
+
+// The new design is validated for every channel with a known sample rate before it is applied, so an
+// invalid design is rejected like in the single-channel filter and leaves the bank unchanged. Channels
+// rejected for other reasons do not affect the design.
+void FilterBankFBImpl::propertyChanged()
+{
+    auto lock = this->getAcquisitionLock();
+
+    const FilterSpec spec = readFilterDesignProperties(objPtr);
+    for (const auto& channel : channels)
+    {
+        if (channel->sampleRate <= 0.0 || channel->rateMismatch)
+            continue;
+
+        try
+        {
+            validateFilterFrequencies(spec, channel->sampleRate);
+        }
+        catch (const std::exception& e)
+        {
+            throw std::invalid_argument(channel->inputPort.getLocalId().toStdString() + ": " + e.what());
+        }
+    }
+
+    filterSpec = spec;
+    configure(true);
+}
+
+void FilterBankFBImpl::addChannel()
+{
+    auto channel = std::make_unique<Channel>();
+    const auto id = std::to_string(nextChannelId++);
+
+    channel->inputPort = createAndAddInputPort("Input" + id, PacketReadyNotification::Scheduler);
+    channel->reader = StreamReaderFromPort(channel->inputPort, SampleType::Float64, SampleType::UInt64);
+    channel->reader.setOnDataAvailable([this] { calculate(); });
+
+    channel->outputSignal = createAndAddSignal("Filtered" + id);
+    channel->outputDomainSignal = createAndAddSignal("FilteredTime" + id, nullptr, false);
+    channel->outputSignal.setDomainSignal(channel->outputDomainSignal);
+
+    channels.push_back(std::move(channel));
+}
+
+void FilterBankFBImpl::onConnected(const InputPortPtr& port)
+{
+    auto lock = this->getAcquisitionLock();
+
+    // Keep one free input port for the next channel
+    if (channels.back()->inputPort == port)
+        addChannel();
+}
+
+void FilterBankFBImpl::onDisconnected(const InputPortPtr& port)
+{
+    auto lock = this->getAcquisitionLock();
+
+    const auto it = std::find_if(channels.begin(), channels.end(), [&port](const auto& channel) { return channel->inputPort == port; });
+    if (it == channels.end() || it->get() == channels.back().get())
+        return;
+
+    auto channel = std::move(*it);
+    channels.erase(it);
+
+    removeSignal(channel->outputSignal);
+    removeSignal(channel->outputDomainSignal);
+    channel->reader.release();
+    removeInputPort(channel->inputPort);
+
+    configure(false);
+}
+
+void FilterBankFBImpl::configureChannel(Channel& channel)
+{
+    channel.configValid = false;
+    channel.rateMismatch = false;
+    channel.sampleRate = 0.0;
+    channel.error.clear();
+
+    try
+    {
+        if (!channel.inputDomainDataDescriptor.assigned() || channel.inputDomainDataDescriptor == NullDataDescriptor())
+            throw std::runtime_error("No domain input");
+
+        if (!channel.inputDataDescriptor.assigned() || channel.inputDataDescriptor == NullDataDescriptor())
+            throw std::runtime_error("No value input");
+
+        validateValueSampleType(channel.inputDataDescriptor.getSampleType());
+        const SizeT domainDelta = validateLinearDomain(channel.inputDomainDataDescriptor);
+        const double sampleRate = getLinearSampleRate(channel.inputDomainDataDescriptor);
+
+        channel.sampleRate = sampleRate;
+        validateFilterFrequencies(filterSpec, sampleRate);
+
+        channel.domainOffsets.setDelta(domainDelta);
+        channel.outputDataDescriptor =
+            DataDescriptorBuilderCopy(channel.inputDataDescriptor).setSampleType(SampleType::Float64).setPostScaling(nullptr).setRule(ExplicitDataRule()).build();
+
+        channel.outputPacketPool.setDescriptor(channel.outputDataDescriptor);
+        channel.outputSignal.setDescriptor(channel.outputDataDescriptor);
+        channel.outputDomainSignal.setDescriptor(channel.inputDomainDataDescriptor);
+        channel.configValid = true;
+    }
+    catch (const std::exception& e)
+    {
+        channel.error = channel.inputPort.getLocalId().toStdString() + ": " + e.what();
+        channel.outputSignal.setDescriptor(nullptr);
+    }
+}
+
+// Rebuilds the bank from the valid channels. If resetStates is set (the design changed), all channels
+// are reconfigured and start from a cleared state; otherwise the channels keep their filter state.
+// The channels are filtered in lockstep, so they must share the sample rate of the first valid channel;
+// the others are left out until their rate matches.
+void FilterBankFBImpl::configure(bool resetStates)
+{
+    std::map<const Channel*, std::vector<BiquadState>> previousStates;
+    if (!resetStates)
+    {
+        for (SizeT i = 0; i < activeChannels.size(); ++i)
+            previousStates[activeChannels[i]] = filterBank.getChannelState(i);
+    }
+
+    activeChannels.clear();
+    std::vector<std::vector<BiquadCoefficients>> sections;
+    double bankSampleRate = 0.0;
+
+    for (const auto& channel : channels)
+    {
+        if (!channel->inputDataDescriptor.assigned() && !channel->inputDomainDataDescriptor.assigned())
+            continue;
+
+        if (resetStates)
+            configureChannel(*channel);
+
+        if (!channel->configValid)
+            continue;
+
+        if (bankSampleRate == 0.0)
+            bankSampleRate = channel->sampleRate;
+
+        const bool rateMismatch = channel->sampleRate != bankSampleRate;
+        if (rateMismatch != channel->rateMismatch || resetStates)
+            channel->outputSignal.setDescriptor(rateMismatch ? nullptr : channel->outputDataDescriptor);
+        channel->rateMismatch = rateMismatch;
+        if (rateMismatch)
+            continue;
+
+        FilterSpec spec = filterSpec;
+        spec.sampleRate = channel->sampleRate;
+        sections.push_back(designSosFilter(spec));
+        activeChannels.push_back(channel.get());
+    }
+
+    filterBank.setChannels(sections);
+    for (SizeT i = 0; i < activeChannels.size(); ++i)
+    {
+        const auto it = previousStates.find(activeChannels[i]);
+        if (it != previousStates.end())
+            filterBank.setChannelState(i, it->second);
+    }
+
+    channelData.resize(activeChannels.size() * ReadBlockSize);
+    interleavedData.assign(filterBank.getStride() * ReadBlockSize, 0.0);
+    domainOffsets.resize(activeChannels.size());
+
+    updateComponentStatus();
+}
+
+void FilterBankFBImpl::updateComponentStatus()
+{
+    std::string errors;
+    for (const auto& channel : channels)
+    {
+        if (!channel->error.empty())
+            errors += (errors.empty() ? "" : "; ") + channel->error;
+        else if (channel->configValid && channel->rateMismatch)
+            errors += (errors.empty() ? "" : "; ") + channel->inputPort.getLocalId().toStdString() +
+                      ": Sample rate differs from the other channels";
+    }
+
+    if (errors.empty())
+        setComponentStatus(ComponentStatus::Ok);
+    else
+        setComponentStatusWithMessage(ComponentStatus::Error, errors);
+}
+
+void FilterBankFBImpl::calculate()
+{
+    auto lock = this->getAcquisitionLock();
+
+    while (true)
+    {
+        // Descriptor changes come first, they can change the set of filtered channels
+        for (const auto& channel : channels)
+            processPendingEvents(*channel);
+
+        // Channels that are not filtered are drained, so that their queues do not grow
+        bool drained = false;
+        for (const auto& channel : channels)
+        {
+            if (std::find(activeChannels.begin(), activeChannels.end(), channel.get()) == activeChannels.end())
+                drained |= drainChannel(*channel);
+        }
+
+        if (activeChannels.empty())
+        {
+            if (drained)
+                continue;
+            return;
+        }
+
+        // Channels are filtered in lockstep, limited by the channel with the least data
+        SizeT readAmount = ReadBlockSize;
+        for (const auto* channel : activeChannels)
+            readAmount = std::min(readAmount, channel->reader.getAvailableCount());
+
+        if (readAmount == 0)
+        {
+            if (drained)
+                continue;
+            return;
+        }
+
+        for (SizeT i = 0; i < activeChannels.size(); ++i)
+        {
+            auto& channel = *activeChannels[i];
+            SizeT count = readAmount;
+            const auto status = channel.reader.read(channelData.data() + i * ReadBlockSize, &count);
+            domainOffsets[i] = channel.domainOffsets.next(status, count);
+        }
+
+        processData(readAmount);
+    }
+}
+
+// Discards up to one read block of a channel's samples; returns false if it had none
+bool FilterBankFBImpl::drainChannel(Channel& channel)
+{
+    SizeT count = std::min(channel.reader.getAvailableCount(), ReadBlockSize);
+    if (count == 0)
+        return false;
+
+    channel.reader.read(discardData.data(), &count);
+    return true;
+}
+
+// Handles the events queued in front of a channel's samples
+void FilterBankFBImpl::processPendingEvents(Channel& channel)
+{
+    while (channel.reader.getAvailableCount() == 0 && !channel.reader.getEmpty())
+    {
+        double dummy;
+        SizeT count = 0;
+        const auto status = channel.reader.read(&dummy, &count);
+        if (status.getReadStatus() != ReadStatus::Event)
+            return;
+
+        const auto eventPacket = status.getEventPacket();
+        if (eventPacket.assigned())
+            processEventPacket(channel, eventPacket);
+    }
+}
+
+void FilterBankFBImpl::processEventPacket(Channel& channel, const EventPacketPtr& packet)
+{
+    if (packet.getEventId() == event_packet_id::DATA_DESCRIPTOR_CHANGED)
+    {
+        DataDescriptorPtr dataDesc = packet.getParameters().get(event_packet_param::DATA_DESCRIPTOR);
+        DataDescriptorPtr domainDesc = packet.getParameters().get(event_packet_param::DOMAIN_DATA_DESCRIPTOR);
+        if (dataDesc.assigned())
+            channel.inputDataDescriptor = dataDesc;
+        if (domainDesc.assigned())
+            channel.inputDomainDataDescriptor = domainDesc;
+
+        // The channel restarts from a cleared state, the other channels continue
+        const auto active = std::find(activeChannels.begin(), activeChannels.end(), &channel);
+        if (active != activeChannels.end())
+            filterBank.setChannelState(active - activeChannels.begin(), std::vector<BiquadState>(filterBank.getSectionCount()));
+
+        configureChannel(channel);
+        configure(false);
+    }
+}
+
+void FilterBankFBImpl::processData(SizeT readAmount)
+{
+    const SizeT stride = filterBank.getStride();
+    const SizeT channelCount = activeChannels.size();
+
+    for (SizeT i = 0; i < channelCount; ++i)
+    {
+        const double* in = channelData.data() + i * ReadBlockSize;
+        for (SizeT n = 0; n < readAmount; ++n)
+            interleavedData[n * stride + i] = in[n];
+    }
+
+    filterBank.process(interleavedData.data(), readAmount);
+
+    for (SizeT i = 0; i < channelCount; ++i)
+    {
+        auto& channel = *activeChannels[i];
+
+        const auto outputDomainPacket = DataPacket(channel.inputDomainDataDescriptor, readAmount, domainOffsets[i]);
+        const auto outputPacket = channel.outputPacketPool.createPacket(outputDomainPacket, readAmount);
+
+        auto out = static_cast<double*>(outputPacket.getRawData());
+        for (SizeT n = 0; n < readAmount; ++n)
+            out[n] = interleavedData[n * stride + i];
+
+        channel.outputSignal.sendPacket(outputPacket);
+        channel.outputDomainSignal.sendPacket(outputDomainPacket);
+    }
+}
+
+END_NAMESPACE_EXAMPLE_MODULE
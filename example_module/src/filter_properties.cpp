@@ -0,0 +1,86 @@
+#include <example_module/filter_properties.h>
+#include <example_module/property_updates.h>
+#include <sstream>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+void addFilterDesignProperties(PropertyObjectPtr& objPtr, const std::function<void()>& onChanged)
+{
+    const auto filterTypeProp = SelectionProperty("FilterType", List<IString>("Butterworth", "Chebyshev I", "Chebyshev II", "Bessel"), 0);
+    objPtr.addProperty(filterTypeProp);
+
+    const auto responseTypeProp = SelectionProperty("ResponseType", List<IString>("Low-pass", "High-pass", "Band-pass", "Band-stop"), 0);
+    objPtr.addProperty(responseTypeProp);
+
+    const auto orderProp = IntPropertyBuilder("Order", 1).setMinValue(1).setMaxValue(static_cast<Int>(MaxFilterOrder)).build();
+    objPtr.addProperty(orderProp);
+
+    const auto cutoffProp = IntProperty("CutoffFrequency", 5);
+    objPtr.addProperty(cutoffProp);
+
+    // Band-pass and band-stop filters use CutoffFrequency as their lower band edge
+    const auto upperCutoffProp = IntProperty("UpperCutoffFrequency", 50, EvalValue("$ResponseType > 1"));
+    objPtr.addProperty(upperCutoffProp);
+
+    const auto rippleProp = FloatProperty("PassbandRipple", 1.0, EvalValue("$FilterType == 1"));
+    objPtr.addProperty(rippleProp);
+
+    const auto attenuationProp = FloatProperty("StopbandAttenuation", 40.0, EvalValue("$FilterType == 2"));
+    objPtr.addProperty(attenuationProp);
+
+    observeProperties(objPtr,
+                      {"FilterType", "ResponseType", "Order", "CutoffFrequency", "UpperCutoffFrequency", "PassbandRipple", "StopbandAttenuation"},
+                      onChanged);
+}
+
+FilterSpec readFilterDesignProperties(const PropertyObjectPtr& objPtr)
+{
+    FilterSpec spec;
+    spec.family = static_cast<FilterFamily>(static_cast<Int>(objPtr.getPropertyValue("FilterType")));
+    spec.response = static_cast<FilterResponse>(static_cast<Int>(objPtr.getPropertyValue("ResponseType")));
+    spec.order = static_cast<SizeT>(static_cast<Int>(objPtr.getPropertyValue("Order")));
+    spec.cutoffFrequency = static_cast<double>(objPtr.getPropertyValue("CutoffFrequency"));
+    spec.upperCutoffFrequency = static_cast<double>(objPtr.getPropertyValue("UpperCutoffFrequency"));
+    spec.passbandRipple = objPtr.getPropertyValue("PassbandRipple");
+    spec.stopbandAttenuation = objPtr.getPropertyValue("StopbandAttenuation");
+    return spec;
+}
+
+void addCrossfadeProperty(PropertyObjectPtr& objPtr)
+{
+    const auto crossfadeProp = IntPropertyBuilder("CrossfadeLength", 0).setMinValue(0).setMaxValue(MaxCrossfadeLength).build();
+    objPtr.addProperty(crossfadeProp);
+}
+
+SizeT readCrossfadeLength(const PropertyObjectPtr& objPtr)
+{
+    return static_cast<SizeT>(static_cast<Int>(objPtr.getPropertyValue("CrossfadeLength")));
+}
+
+void validateFilterFrequencies(const FilterSpec& spec, double sampleRate)
+{
+    validateFilterFrequencies(spec.response, spec.cutoffFrequency, spec.upperCutoffFrequency, sampleRate);
+}
+
+void validateFilterFrequencies(FilterResponse response, double cutoffFrequency, double upperCutoffFrequency, double sampleRate)
+{
+    const Int maxCutoff = static_cast<Int>(sampleRate / 2) - 1;
+    if (cutoffFrequency < 1 || cutoffFrequency > maxCutoff)
+    {
+        std::stringstream ss;
+        ss << "CutoffFrequency " << cutoffFrequency << " is in invalid range (1 - " << maxCutoff << " Hz)";
+        throw std::invalid_argument(ss.str());
+    }
+
+    if (filter_design::isBandResponse(response))
+    {
+        if (upperCutoffFrequency <= cutoffFrequency || upperCutoffFrequency > maxCutoff)
+        {
+            std::stringstream ss;
+            ss << "UpperCutoffFrequency " << upperCutoffFrequency << " is in invalid range (" << cutoffFrequency + 1 << " - " << maxCutoff << " Hz)";
+            throw std::invalid_argument(ss.str());
+        }
+    }
+}
+
+END_NAMESPACE_EXAMPLE_MODULE
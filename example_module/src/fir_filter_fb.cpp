@@ -0,0 +1,172 @@
+#include <example_module/filter_properties.h>
+#include <example_module/fir_filter_fb.h>
+#include <example_module/property_updates.h>
+#include <opendaq/data_descriptor_ptr.h>
+#include <opendaq/event_packet_params.h>
+#include <opendaq/input_port_factory.h>
+#include <opendaq/signal_factory.h>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+FIRFilterFBImpl::FIRFilterFBImpl(const ContextPtr& context,
+                                 const ComponentPtr& parent,
+                                 const StringPtr& localId,
+                                 const PropertyObjectPtr& /*config*/)
+    : FunctionBlock(CreateType(), context, parent, localId)
+{
+    initComponentStatus();
+    createInputPorts();
+    createSignals();
+    initProperties();
+}
+
+FunctionBlockTypePtr FIRFilterFBImpl::CreateType()
+{
+    return FunctionBlockType("ExampleFIRFilter",
+                             "FIR Filter",
+                             "Linear-phase FIR filter with up to 65536 taps, using FFT convolution for long kernels",
+                             PropertyObject());
+}
+
+void FIRFilterFBImpl::createInputPorts()
+{
+    inputPort = createAndAddInputPort("Input", PacketReadyNotification::Scheduler);
+    reader = StreamReaderFromPort(inputPort, SampleType::Float64, SampleType::UInt64);
+    reader.setOnDataAvailable([this] { calculate(); });
+
+    // Sized once: calculate() reads into it even while the input is rejected
+    inputData.resize(ReadBlockSize);
+}
+
+void FIRFilterFBImpl::createSignals()
+{
+    outputSignal = createAndAddSignal("Filtered");
+    outputDomainSignal = createAndAddSignal("FilteredTime", nullptr, false);
+    outputSignal.setDomainSignal(outputDomainSignal);
+    outputSignal.setName("Filtered");
+}
+
+void FIRFilterFBImpl::initProperties()
+{
+    const auto responseTypeProp = SelectionProperty("ResponseType", List<IString>("Low-pass", "High-pass", "Band-pass", "Band-stop"), 0);
+    objPtr.addProperty(responseTypeProp);
+
+    // High-pass and band-stop filters need an odd tap count
+    const auto tapCountProp = IntPropertyBuilder("TapCount", 101).setMinValue(1).setMaxValue(static_cast<Int>(MaxFirTapCount)).build();
+    objPtr.addProperty(tapCountProp);
+
+    const auto windowProp = SelectionProperty("Window", List<IString>("Rectangular", "Hann", "Hamming", "Blackman"), 2);
+    objPtr.addProperty(windowProp);
+
+    const auto cutoffProp = IntProperty("CutoffFrequency", 5);
+    objPtr.addProperty(cutoffProp);
+
+    const auto upperCutoffProp = IntProperty("UpperCutoffFrequency", 50, EvalValue("$ResponseType > 1"));
+    objPtr.addProperty(upperCutoffProp);
+
+    observeProperties(objPtr, {"ResponseType", "TapCount", "Window", "CutoffFrequency", "UpperCutoffFrequency"}, [this] { propertyChanged(); });
+
+    readProperties();
+}
+
+void FIRFilterFBImpl::readProperties()
+{
+    firSpec.response = static_cast<FilterResponse>(static_cast<Int>(objPtr.getPropertyValue("ResponseType")));
+    firSpec.tapCount = static_cast<SizeT>(static_cast<Int>(objPtr.getPropertyValue("TapCount")));
+    firSpec.window = static_cast<FirWindow>(static_cast<Int>(objPtr.getPropertyValue("Window")));
+    firSpec.cutoffFrequency = static_cast<double>(objPtr.getPropertyValue("CutoffFrequency"));
+    firSpec.upperCutoffFrequency = static_cast<double>(objPtr.getPropertyValue("UpperCutoffFrequency"));
+}
+
+void FIRFilterFBImpl::propertyChanged()
+{
+    auto lock = this->getAcquisitionLock();
+
+    readProperties();
+    if (inputDomainDataDescriptor.assigned())
+        configure();
+}
+
+void FIRFilterFBImpl::configure()
+{
+    try
+    {
+        if (!inputDomainDataDescriptor.assigned() || inputDomainDataDescriptor == NullDataDescriptor())
+            throw std::runtime_error("No domain input");
+
+        if (!inputDataDescriptor.assigned() || inputDataDescriptor == NullDataDescriptor())
+            throw std::runtime_error("No value input");
+
+        validateValueSampleType(inputDataDescriptor.getSampleType());
+        const SizeT domainDelta = validateLinearDomain(inputDomainDataDescriptor);
+        const double sampleRate = getLinearSampleRate(inputDomainDataDescriptor);
+
+        validateFilterFrequencies(firSpec.response, firSpec.cutoffFrequency, firSpec.upperCutoffFrequency, sampleRate);
+        firSpec.sampleRate = sampleRate;
+        filter.setTaps(designFirFilter(firSpec));
+
+        outputDataDescriptor = DataDescriptorBuilderCopy(inputDataDescriptor).setSampleType(SampleType::Float64).setPostScaling(nullptr).setRule(ExplicitDataRule()).build();
+        outputPacketPool.setDescriptor(outputDataDescriptor);
+        outputSignal.setDescriptor(outputDataDescriptor);
+        outputDomainSignal.setDescriptor(inputDomainDataDescriptor);
+
+        domainOffsets.setDelta(domainDelta);
+
+        setComponentStatus(ComponentStatus::Ok);
+        configValid = true;
+    }
+    catch (const std::exception& e)
+    {
+        setComponentStatusWithMessage(ComponentStatus::Error, e.what());
+        outputSignal.setDescriptor(nullptr);
+        configValid = false;
+        throw;
+    }
+}
+
+void FIRFilterFBImpl::calculate()
+{
+    auto lock = this->getAcquisitionLock();
+
+    readUntilEvent(
+        reader,
+        inputData.data(),
+        ReadBlockSize,
+        [this](const ReaderStatusPtr& status, SizeT readAmount)
+        {
+            if (configValid)
+                processData(readAmount, domainOffsets.next(status, readAmount));
+        },
+        [this](const EventPacketPtr& packet) { processEventPacket(packet); });
+}
+
+void FIRFilterFBImpl::processEventPacket(const EventPacketPtr& packet)
+{
+    if (packet.getEventId() == event_packet_id::DATA_DESCRIPTOR_CHANGED)
+    {
+        DataDescriptorPtr dataDesc = packet.getParameters().get(event_packet_param::DATA_DESCRIPTOR);
+        DataDescriptorPtr domainDesc = packet.getParameters().get(event_packet_param::DOMAIN_DATA_DESCRIPTOR);
+        if (dataDesc.assigned())
+            inputDataDescriptor = dataDesc;
+        if (domainDesc.assigned())
+            inputDomainDataDescriptor = domainDesc;
+
+        configure();
+    }
+}
+
+void FIRFilterFBImpl::processData(SizeT readAmount, SizeT packetOffset)
+{
+    if (readAmount == 0)
+        return;
+
+    const auto outputDomainPacket = DataPacket(inputDomainDataDescriptor, readAmount, packetOffset);
+    const auto outputPacket = outputPacketPool.createPacket(outputDomainPacket, readAmount);
+
+    filter.process(inputData.data(), static_cast<double*>(outputPacket.getRawData()), readAmount);
+
+    outputSignal.sendPacket(outputPacket);
+    outputDomainSignal.sendPacket(outputDomainPacket);
+}
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,298 @@
+#include <example_module/generator_fb.h>
+#include <example_module/property_updates.h>
+#include <opendaq/data_descriptor_ptr.h>
+#include <opendaq/signal_factory.h>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+GeneratorFBImpl::GeneratorFBImpl(const ContextPtr& context,
+                                 const ComponentPtr& parent,
+                                 const StringPtr& localId,
+                                 const PropertyObjectPtr& /*config*/)
+    : FunctionBlock(CreateType(), context, parent, localId)
+{
+    initComponentStatus();
+    createSignals();
+    initProperties();
+
+    auto lock = this->getAcquisitionLock();
+    table.build(waveformSpec, sampleType);
+    configure();
+}
+
+GeneratorFBImpl::~GeneratorFBImpl()
+{
+    stop();
+}
+
+FunctionBlockTypePtr GeneratorFBImpl::CreateType()
+{
+    return FunctionBlockType("ExampleGenerator",
+                             "Generator",
+                             "Generates sine, step, chirp, noise or constant test signals on any number of channels",
+                             PropertyObject());
+}
+
+void GeneratorFBImpl::createSignals()
+{
+    outputDomainSignal = createAndAddSignal("GeneratedTime", nullptr, false);
+}
+
+void GeneratorFBImpl::initProperties()
+{
+    const auto waveformProp = SelectionProperty("Waveform", List<IString>("Sine", "Step", "Chirp", "Noise", "Constant"), 0);
+    objPtr.addProperty(waveformProp);
+
+    // Sine and step frequency, start frequency of the chirp
+    const auto frequencyProp = FloatProperty("Frequency", 10.0, EvalValue("$Waveform < 3"));
+    objPtr.addProperty(frequencyProp);
+
+    // Frequency of the generated sine or step; differs from Frequency when no whole number of its periods
+    // ends on a whole sample within the waveform table
+    const auto effectiveFrequencyProp =
+        FloatPropertyBuilder("EffectiveFrequency", 10.0).setReadOnly(true).setVisible(EvalValue("$Waveform < 2")).build();
+    objPtr.addProperty(effectiveFrequencyProp);
+
+    const auto endFrequencyProp = FloatProperty("EndFrequency", 100.0, EvalValue("$Waveform == 2"));
+    objPtr.addProperty(endFrequencyProp);
+
+    const auto sweepTimeProp = FloatProperty("SweepTime", 1.0, EvalValue("$Waveform == 2"));
+    objPtr.addProperty(sweepTimeProp);
+
+    const auto amplitudeProp = FloatProperty("Amplitude", 1.0, EvalValue("$Waveform != 4"));
+    objPtr.addProperty(amplitudeProp);
+
+    const auto offsetProp = FloatProperty("Offset", 0.0);
+    objPtr.addProperty(offsetProp);
+
+    const auto sampleRateProp = IntPropertyBuilder("SampleRate", 1000).setMinValue(1).setMaxValue(MaxSampleRate).build();
+    objPtr.addProperty(sampleRateProp);
+
+    const auto sampleTypeProp = SelectionProperty(
+        "SampleType", List<IString>("Float64", "Float32", "Int8", "Int16", "Int32", "Int64", "UInt8", "UInt16", "UInt32", "UInt64"), 0);
+    objPtr.addProperty(sampleTypeProp);
+
+    const auto packetSizeProp = IntPropertyBuilder("PacketSize", 100).setMinValue(1).setMaxValue(MaxPacketSize).build();
+    objPtr.addProperty(packetSizeProp);
+
+    const auto channelCountProp = IntPropertyBuilder("ChannelCount", 1).setMinValue(1).setMaxValue(MaxChannelCount).build();
+    objPtr.addProperty(channelCountProp);
+
+    // Generates packets as fast as the receivers take them instead of at the sample rate
+    const auto freeRunningProp = BoolProperty("FreeRunning", False);
+    objPtr.addProperty(freeRunningProp);
+
+    const auto activeProp = BoolProperty("Active", True);
+    objPtr.addProperty(activeProp);
+
+    observeProperties(objPtr,
+                      {"Waveform",
+                       "Frequency",
+                       "EndFrequency",
+                       "SweepTime",
+                       "Amplitude",
+                       "Offset",
+                       "SampleRate",
+                       "SampleType",
+                       "PacketSize",
+                       "ChannelCount",
+                       "FreeRunning",
+                       "Active"},
+                      [this] { propertyChanged(); });
+
+    applySettings(readSettings());
+}
+
+GeneratorFBImpl::Settings GeneratorFBImpl::readSettings() const
+{
+    static constexpr SampleType SampleTypes[] = {SampleType::Float64,
+                                                 SampleType::Float32,
+                                                 SampleType::Int8,
+                                                 SampleType::Int16,
+                                                 SampleType::Int32,
+                                                 SampleType::Int64,
+                                                 SampleType::UInt8,
+                                                 SampleType::UInt16,
+                                                 SampleType::UInt32,
+                                                 SampleType::UInt64};
+
+    Settings settings;
+    settings.waveformSpec.waveform = static_cast<Waveform>(static_cast<Int>(objPtr.getPropertyValue("Waveform")));
+    settings.waveformSpec.frequency = objPtr.getPropertyValue("Frequency");
+    settings.waveformSpec.endFrequency = objPtr.getPropertyValue("EndFrequency");
+    settings.waveformSpec.duration = objPtr.getPropertyValue("SweepTime");
+    settings.waveformSpec.amplitude = objPtr.getPropertyValue("Amplitude");
+    settings.waveformSpec.offset = objPtr.getPropertyValue("Offset");
+    settings.waveformSpec.sampleRate = static_cast<double>(static_cast<Int>(objPtr.getPropertyValue("SampleRate")));
+
+    settings.sampleType = SampleTypes[static_cast<Int>(objPtr.getPropertyValue("SampleType"))];
+    settings.packetSize = static_cast<SizeT>(static_cast<Int>(objPtr.getPropertyValue("PacketSize")));
+    settings.channelCount = static_cast<SizeT>(static_cast<Int>(objPtr.getPropertyValue("ChannelCount")));
+    settings.freeRunning = objPtr.getPropertyValue("FreeRunning");
+    settings.active = objPtr.getPropertyValue("Active");
+    return settings;
+}
+
+// The generator thread must be stopped
+void GeneratorFBImpl::applySettings(const Settings& settings)
+{
+    waveformSpec = settings.waveformSpec;
+    sampleType = settings.sampleType;
+    packetSize = settings.packetSize;
+    freeRunning = settings.freeRunning;
+    active = settings.active;
+
+    setChannelCount(settings.channelCount);
+}
+
+// Invalid waveforms are rejected like invalid filter designs. The table is built before the generator is
+// stopped, so a rejected write leaves the running generator, its channels and descriptors unchanged.
+void GeneratorFBImpl::propertyChanged()
+{
+    const auto settings = readSettings();
+    WaveformTable newTable;
+    newTable.build(settings.waveformSpec, settings.sampleType);
+
+    auto lock = this->getAcquisitionLock();
+
+    stop();
+    applySettings(settings);
+    table = std::move(newTable);
+    configure();
+
+    if (!configValid)
+        throw std::invalid_argument(configError);
+}
+
+void GeneratorFBImpl::setChannelCount(SizeT count)
+{
+    while (channels.size() > count)
+    {
+        removeSignal(channels.back()->outputSignal);
+        channels.pop_back();
+    }
+
+    while (channels.size() < count)
+    {
+        auto channel = std::make_unique<Channel>();
+        channel->outputSignal = createAndAddSignal("Generated" + std::to_string(channels.size()));
+        channel->outputSignal.setDomainSignal(outputDomainSignal);
+        channels.push_back(std::move(channel));
+    }
+}
+
+// Rebuilds the descriptors for the current table and restarts the generator thread. The generator thread
+// must be stopped.
+void GeneratorFBImpl::configure()
+{
+    configValid = false;
+    configError.clear();
+
+    try
+    {
+        const auto sampleRate = static_cast<Int>(waveformSpec.sampleRate);
+        outputDomainDataDescriptor = DataDescriptorBuilder()
+                                         .setSampleType(SampleType::Int64)
+                                         .setUnit(Unit("s", -1, "seconds", "time"))
+                                         .setTickResolution(Ratio(1, sampleRate))
+                                         .setRule(LinearDataRule(1, 0))
+                                         .setOrigin("1970-01-01T00:00:00+00:00")
+                                         .setName("Time")
+                                         .build();
+        outputDomainSignal.setDescriptor(outputDomainDataDescriptor);
+
+        objPtr.asPtr<IPropertyObjectProtected>().setProtectedPropertyValue("EffectiveFrequency", table.getFrequency());
+
+        // Nominal range of the waveform; integer sample types saturate outside of their own range
+        const double low = waveformSpec.offset - std::abs(waveformSpec.amplitude);
+        const double high = waveformSpec.offset + std::abs(waveformSpec.amplitude);
+        const auto outputDataDescriptor = DataDescriptorBuilder().setSampleType(sampleType).setValueRange(Range(low, high)).setName("Generated").build();
+
+        for (SizeT i = 0; i < channels.size(); ++i)
+        {
+            auto& channel = *channels[i];
+            channel.phase = i * table.getLength() / (channels.size() * table.getCycles());
+            channel.outputPacketPool.setDescriptor(outputDataDescriptor);
+            channel.outputSignal.setDescriptor(outputDataDescriptor);
+        }
+
+        // The domain starts at the current time
+        const auto now = std::chrono::system_clock::now().time_since_epoch();
+        nextDomainValue = static_cast<Int>(std::chrono::duration<double>(now).count() * waveformSpec.sampleRate);
+
+        setComponentStatus(ComponentStatus::Ok);
+        configValid = true;
+    }
+    catch (const std::exception& e)
+    {
+        configError = e.what();
+        setComponentStatusWithMessage(ComponentStatus::Error, configError);
+        for (const auto& channel : channels)
+            channel->outputSignal.setDescriptor(nullptr);
+        return;
+    }
+
+    if (active)
+        start();
+}
+
+void GeneratorFBImpl::start()
+{
+    stopRequested = false;
+    generatorThread = std::thread([this] { generate(); });
+}
+
+void GeneratorFBImpl::stop()
+{
+    if (!generatorThread.joinable())
+        return;
+
+    {
+        std::scoped_lock lock(generatorMutex);
+        stopRequested = true;
+    }
+    generatorCv.notify_all();
+    generatorThread.join();
+}
+
+// Packet n is sent once the wall clock passes the time of its last sample, measured from the start of
+// the thread. A thread that falls behind sends the missed packets back to back to catch up.
+void GeneratorFBImpl::generate()
+{
+    const auto startTime = Clock::now();
+    SizeT generated = 0;
+
+    std::unique_lock lock(generatorMutex);
+    while (!stopRequested)
+    {
+        if (!freeRunning)
+        {
+            const auto due = startTime + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(
+                                             static_cast<double>(generated + packetSize) / waveformSpec.sampleRate));
+            if (generatorCv.wait_until(lock, due, [this] { return stopRequested; }))
+                break;
+        }
+
+        lock.unlock();
+        sendPackets(packetSize);
+        generated += packetSize;
+        lock.lock();
+    }
+}
+
+void GeneratorFBImpl::sendPackets(SizeT count)
+{
+    const auto domainPacket = DataPacket(outputDomainDataDescriptor, count, nextDomainValue);
+
+    for (auto& channel : channels)
+    {
+        const auto packet = channel->outputPacketPool.createPacket(domainPacket, count);
+        channel->phase = table.fill(packet.getRawData(), count, channel->phase);
+        channel->outputSignal.sendPacket(packet);
+    }
+
+    outputDomainSignal.sendPacket(domainPacket);
+    nextDomainValue += static_cast<Int>(count);
+}
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -1,4 +1,6 @@
+#include <example_module/filter_properties.h>
 #include <example_module/iir_filter_fb.h>
+#include <example_module/property_updates.h>
 #include <opendaq/data_descriptor_ptr.h>
 #include <opendaq/event_packet_params.h>
 #include <opendaq/input_port_factory.h>
@@ -6,15 +8,18 @@
 #include <cmath>
 #include <iostream>
 
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
-
 BEGIN_NAMESPACE_EXAMPLE_MODULE
 
-IIRFilterFBImpl::IIRFilterFBImpl(const ContextPtr& context, const ComponentPtr& parent, const StringPtr& localId)
+IIRFilterFBImpl::IIRFilterFBImpl(const ContextPtr& context,
+                                 const ComponentPtr& parent,
+                                 const StringPtr& localId,
+                                 const PropertyObjectPtr& config)
     : FunctionBlock(CreateType(), context, parent, localId)
+    , trace(localId.toStdString())
 {
+    if (config.assigned() && config.hasProperty("PacketMode"))
+        packetMode = config.getPropertyValue("PacketMode");
+
     initComponentStatus();
     createInputPorts();
     createSignals();
@@ -23,30 +28,36 @@ IIRFilterFBImpl::IIRFilterFBImpl(const ContextPtr& context, const ComponentPtr&
 
 FunctionBlockTypePtr IIRFilterFBImpl::CreateType()
 {
-    return FunctionBlockType("ExampleIIRFilter", "IIR Filter", "Simple first-order IIR filter");
+    auto defaultConfig = PropertyObject();
+    defaultConfig.addProperty(BoolProperty("PacketMode", False));
+
+    return FunctionBlockType("ExampleIIRFilter", "IIR Filter", "IIR filter (Butterworth, Chebyshev I/II, Bessel) of order 1-16 as a cascade of second-order sections", defaultConfig);
 }
 
 void IIRFilterFBImpl::createInputPorts()
 {
     inputPort = createAndAddInputPort("Input", PacketReadyNotification::Scheduler);
-    reader = StreamReaderFromPort(inputPort, SampleType::Float64, SampleType::UInt64);
-    reader.setOnDataAvailable([this] { calculate(); });
-}
 
-void IIRFilterFBImpl::calculateFilterCoefficients(double sampleRate)
-{
-    double wc = std::tan(static_cast<double>(M_PI) * cutoffFreq / sampleRate);
-    double norm = 1.0f / (1.0f + wc);
-    a0 = wc * norm;
-    a1 = a0;
-    b1 = (1.0f - wc) * norm;
+    // In packet mode the input port notifies the function block directly (see onPacketReceived)
+    if (packetMode)
+        return;
+
+    reader = StreamReaderFromPort(inputPort, SampleType::Float64, SampleType::UInt64);
+    reader.setOnDataAvailable(
+        [this]
+        {
+            markIngress(trace, reader);
+            dispatcher.dataAvailable();
+        });
 }
 
 void IIRFilterFBImpl::configure()
 {
+    statistics.recordReconfiguration();
     resetFilterState();
-    inputData.clear();
-    inputDomainData.clear();
+
+    designStage.stop();
+    crossfade.stop();
 
     try
     {
@@ -75,6 +86,18 @@ void IIRFilterFBImpl::configure()
             throw std::runtime_error("Invalid sample type");
         }
 
+        if (packetMode)
+        {
+            // Packets are converted straight from their raw data, which must already hold the values
+            if (inputDataDescriptor.getPostScaling().assigned())
+                throw std::runtime_error("Post scaling is not supported in packet mode");
+            const auto valueRule = inputDataDescriptor.getRule();
+            if (valueRule.assigned() && valueRule.getType() != DataRuleType::Explicit)
+                throw std::runtime_error("Implicit value rules are not supported in packet mode");
+
+            convertKernel = getScalingKernel(inputSampleType);
+        }
+
         // Accept only synchronous (linear implicit) domain signals
         if (inputDomainDataDescriptor.getSampleType() != SampleType::Int64 &&
             inputDomainDataDescriptor.getSampleType() != SampleType::UInt64)
@@ -92,17 +115,20 @@ void IIRFilterFBImpl::configure()
             throw std::runtime_error("Invalid sampleRate: " + std::to_string(sampleRate) + "\n");
         }
 
-        calculateFilterCoefficients(sampleRate);
-        validateCutoffFrequency(cutoffFreq, sampleRate);
+        designStage.start(filter, filterSpec, sampleRate);
 
-        outputSignal.setDescriptor(inputDataDescriptor);
+        // The filter always outputs explicit Float64 samples, whatever the value rule of the input
+        outputDataDescriptor = DataDescriptorBuilderCopy(inputDataDescriptor).setSampleType(SampleType::Float64).setPostScaling(nullptr).setRule(ExplicitDataRule()).build();
+        outputPacketPool.setDescriptor(outputDataDescriptor);
+        outputSignal.setDescriptor(outputDataDescriptor);
         outputDomainSignal.setDescriptor(inputDomainDataDescriptor);
 
-        inputData.resize(sampleRate);
-        inputDomainData.resize(sampleRate);
+        const Int delta = domainRule.getParameters().get("delta");
+        inputReader.setDomainDelta(static_cast<SizeT>(delta));
 
         setComponentStatus(ComponentStatus::Ok);
         configValid = true;
+        updateMemoryUsage();
     }
     catch (const std::exception& e)
     {
@@ -127,26 +153,20 @@ void IIRFilterFBImpl::calculate()
 {
     auto lock = this->getAcquisitionLock();
 
-    while (!reader.getEmpty())
-    {
-        SizeT readAmount = std::min(reader.getAvailableCount(), static_cast<SizeT>(1024));
-        const auto status = reader.readWithDomain(inputData.data(), inputDomainData.data(), &readAmount);
-
-        if (configValid)
-            processData(readAmount, status.getOffset());
-
-        if (status.getReadStatus() == ReadStatus::Event)
-        {
-            const auto eventPacket = status.getEventPacket();
-            if (eventPacket.assigned())
-                processEventPacket(eventPacket);
-            return;
-        }
-    }
+    const auto inputData = ScratchArena::local().acquire(readBlockSize * sizeof(double));
+    inputReader.readBlocks(
+        reader,
+        inputData.get(),
+        configValid,
+        [this](const void* data, SizeT samples, SizeT domainOffset, uint64_t inputPosition)
+        { processData(static_cast<const double*>(data), samples, domainOffset, inputPosition); },
+        [this](const EventPacketPtr& packet) { processEventPacket(packet); });
 }
 
 void IIRFilterFBImpl::processEventPacket(const EventPacketPtr& packet)
 {
+    TraceScope eventSpan(trace, TraceSpan::Event);
+    statistics.recordEvent();
     if (packet.getEventId() == event_packet_id::DATA_DESCRIPTOR_CHANGED)
     {
         DataDescriptorPtr dataDesc = packet.getParameters().get(event_packet_param::DATA_DESCRIPTOR);
@@ -155,30 +175,94 @@ void IIRFilterFBImpl::processEventPacket(const EventPacketPtr& packet)
     }
 }
 
-void IIRFilterFBImpl::processData(SizeT readAmount, SizeT packetOffset)
+void IIRFilterFBImpl::processData(const double* inputData, SizeT readAmount, SizeT packetOffset, uint64_t inputPosition)
 {
     if (readAmount == 0)
         return;
 
-    const auto outputDomainPacket = DataPacket(inputDomainDataDescriptor, readAmount, packetOffset);
-    const auto outputPacket = DataPacketWithDomain(outputDomainPacket, inputDataDescriptor, readAmount);
-    auto outputData = static_cast<double*>(outputPacket.getRawData());
+    designStage.apply(filter, crossfade);
 
-    for (SizeT i = 0; i < readAmount; ++i)
+    const auto outputDomainPacket = DataPacket(inputDomainDataDescriptor, readAmount, packetOffset);
+    DataPacketPtr outputPacket;
     {
-        const double x = inputData[i];
-        const double y = a0 * x + a1 * prevInput + b1 * prevOutput;
-
-        prevInput = x;
-        prevOutput = y;
+        TraceScope computeSpan(trace, TraceSpan::Compute, static_cast<int64_t>(packetOffset), readAmount);
+        outputPacket = outputPacketPool.createPacket(outputDomainPacket, readAmount);
+        auto outputData = static_cast<double*>(outputPacket.getRawData());
 
-        *outputData++ = y;
+        filter.process(inputData, outputData, readAmount);
+        if (crossfade.isActive())
+            crossfade.apply(inputData, outputData, readAmount);
     }
 
+    TraceScope sendSpan(trace, TraceSpan::Send, static_cast<int64_t>(packetOffset), readAmount);
+    sendSpan.setInputPosition(inputPosition);
     outputSignal.sendPacket(outputPacket);
     outputDomainSignal.sendPacket(outputDomainPacket);
 }
 
+void IIRFilterFBImpl::onPacketReceived(const InputPortPtr& /*port*/)
+{
+    markQueuedIngress(trace, inputPort);
+    dispatcher.dataAvailable();
+}
+
+void IIRFilterFBImpl::processQueuedPackets()
+{
+    auto lock = this->getAcquisitionLock();
+
+    inputReader.readPackets(
+        inputPort,
+        configValid,
+        [this](const DataPacketPtr& packet, uint64_t inputPosition) { processDataPacket(packet, inputPosition); },
+        [this](const EventPacketPtr& packet) { processEventPacket(packet); });
+}
+
+// Converts the input packet's raw data into the output packet and filters it in place.
+// The input domain packet is forwarded unchanged.
+void IIRFilterFBImpl::processDataPacket(const DataPacketPtr& packet, uint64_t inputPosition)
+{
+    const auto sampleCount = packet.getSampleCount();
+    if (sampleCount == 0)
+        return;
+
+    designStage.apply(filter, crossfade);
+
+    const auto domainPacket = packet.getDomainPacket();
+    const auto packetOffset = domainPacket.assigned() && domainPacket.getOffset().assigned() ? domainPacket.getOffset().getIntValue() : 0;
+    DataPacketPtr outputPacket;
+    {
+        TraceScope computeSpan(trace, TraceSpan::Compute, packetOffset, sampleCount);
+        outputPacket = outputPacketPool.createPacket(domainPacket, sampleCount);
+        auto outputData = static_cast<double*>(outputPacket.getRawData());
+
+        convertKernel(packet.getRawData(), outputData, sampleCount, 1.0, 0.0);
+        if (crossfade.isActive())
+        {
+            // The outgoing filter needs the input, which is filtered in place; it is copied in blocks
+            // of at most readBlockSize samples
+            const auto inputCopy = ScratchArena::local().acquire(std::min(sampleCount, readBlockSize) * sizeof(double));
+            for (SizeT done = 0; done < sampleCount;)
+            {
+                const SizeT count = std::min(sampleCount - done, readBlockSize);
+                std::copy_n(outputData + done, count, inputCopy.get<double>());
+                filter.process(outputData + done, outputData + done, count);
+                crossfade.apply(inputCopy.get<double>(), outputData + done, count);
+                done += count;
+            }
+        }
+        else
+        {
+            filter.process(outputData, outputData, sampleCount);
+        }
+    }
+
+    TraceScope sendSpan(trace, TraceSpan::Send, packetOffset, sampleCount);
+    sendSpan.setInputPosition(inputPosition);
+    outputSignal.sendPacket(outputPacket);
+    if (domainPacket.assigned())
+        outputDomainSignal.sendPacket(domainPacket);
+}
+
 void IIRFilterFBImpl::createSignals()
 {
     outputSignal = createAndAddSignal("Filtered");
@@ -189,39 +273,105 @@ void IIRFilterFBImpl::createSignals()
 
 void IIRFilterFBImpl::initProperties()
 {
-    const auto cutoffProp = IntProperty("CutoffFrequency", 5);
-    objPtr.addProperty(cutoffProp);
-    objPtr.getOnPropertyValueWrite("CutoffFrequency") += [this](PropertyObjectPtr&, PropertyValueEventArgsPtr&) { propertyChanged(true); };
-    readProperties();
+    addFilterDesignProperties(objPtr, [this] { propertyChanged(); });
+
+    // Number of threads that filter segments of one block concurrently; 1 filters serially
+    const auto parallelismProp = IntPropertyBuilder("Parallelism", 1).setMinValue(1).setMaxValue(64).build();
+    objPtr.addProperty(parallelismProp);
+    objPtr.getOnPropertyValueWrite("Parallelism") += [this](PropertyObjectPtr&, PropertyValueEventArgsPtr&) { parallelismChanged(); };
+
+    addCrossfadeProperty(objPtr);
+
+    addBlockPolicyProperties(objPtr, [this] { blockPolicyChanged(); });
+    addExecutionProperties(objPtr, [this] { dispatcher.setExecutionMode(objPtr, inputPort); });
+    addStatisticsProperty(objPtr, statistics);
+    addTracingProperties(objPtr, [this] { trace.setEnabled(readTracingEnabled(objPtr)); });
+
+    filterSpec = readFilterDesignProperties(objPtr);
+    blockLimits = readBlockPolicyProperties(objPtr);
+    updateReadBlockSize();
+}
+
+// Design changes of a running filter are staged and swapped in between two blocks, keeping the filter
+// state and the output descriptor. Otherwise the function block is configured from scratch. The new spec
+// is validated and designed before the acquisition lock is taken, so designing the filter does not stall
+// the acquisition, and is only published, under the lock, once it is valid. Invalid designs throw and
+// leave the running filter and the published spec unchanged.
+void IIRFilterFBImpl::propertyChanged()
+{
+    const FilterSpec spec = readFilterDesignProperties(objPtr);
+    const SizeT crossfadeLength = readCrossfadeLength(objPtr);
+    auto design = designStage.prepare(spec, crossfadeLength);
+
+    auto lock = this->getAcquisitionLock();
+
+    if (configValid)
+    {
+        designStage.stage(spec, std::move(design), crossfadeLength);
+        filterSpec = spec;
+        return;
+    }
+
+    const FilterSpec previousSpec = filterSpec;
+    filterSpec = spec;
+    if (!inputDomainDataDescriptor.assigned())
+        return;
+
+    try
+    {
+        configure();
+    }
+    catch (...)
+    {
+        filterSpec = previousSpec;
+        throw;
+    }
+}
+
+// The filter state is kept, so the output continues without a glitch
+void IIRFilterFBImpl::parallelismChanged()
+{
+    auto lock = this->getAcquisitionLock();
+
+    const auto threadCount = static_cast<SizeT>(static_cast<Int>(objPtr.getPropertyValue("Parallelism")));
+    if (threadCount > 1)
+        workerPool = std::make_shared<WorkerPool>(threadCount);
+    else
+        workerPool.reset();
+
+    filter.setWorkerPool(workerPool);
+    updateReadBlockSize();
+    updateMemoryUsage();
 }
 
-void IIRFilterFBImpl::propertyChanged(bool configure)
+void IIRFilterFBImpl::blockPolicyChanged()
 {
-    readProperties();
-    if (configure && inputDomainDataDescriptor.assigned())
-        this->configure();
+    auto lock = this->getAcquisitionLock();
+
+    blockLimits = readBlockPolicyProperties(objPtr);
+    updateReadBlockSize();
+    updateMemoryUsage();
 }
 
-void IIRFilterFBImpl::readProperties()
+// Larger read blocks give every thread a full segment, up to the MaxBlockSamples budget. A minimum block
+// size above the preferred size raises it, so that held samples are read in one block.
+void IIRFilterFBImpl::updateReadBlockSize()
 {
-    cutoffFreq = static_cast<double>(objPtr.getPropertyValue("CutoffFrequency"));
+    const SizeT preferred = workerPool ? workerPool->getThreadCount() * filter.getSegmentSize() : SerialReadBlockSize;
+    readBlockSize = std::min(std::max(preferred, blockLimits.minSamples), blockLimits.maxSamples);
+    inputReader.getBlockPolicy().setLimits(blockLimits.minSamples, readBlockSize, blockLimits.maxHoldTime);
 }
 
-void IIRFilterFBImpl::validateCutoffFrequency(double cutoffFreq, const double sampleRate) const
+// The read buffer is leased from the scratch arena of the processing thread, which the function blocks
+// processing on that thread share; packet mode leases it only during a crossfade
+void IIRFilterFBImpl::updateMemoryUsage()
 {
-    const Int maxCutoff = static_cast<Int>(sampleRate / 2) - 1;
-    if (cutoffFreq < 1 || cutoffFreq > maxCutoff)
-    {
-        std::stringstream ss;
-        ss << "CutoffFrequency " << cutoffFreq << " is in invalid range (1 - " << maxCutoff << " Hz)";
-        throw std::invalid_argument(ss.str());
-    }
+    setMemoryUsage(objPtr, readBlockSize * sizeof(double) + filter.getMemoryUsage() + crossfade.getMemoryUsage());
 }
 
 void IIRFilterFBImpl::resetFilterState()
 {
-    prevInput = 0.0;
-    prevOutput = 0.0;
+    filter.reset();
 }
 
 END_NAMESPACE_EXAMPLE_MODULE
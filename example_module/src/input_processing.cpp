@@ -0,0 +1,106 @@
+#include <example_module/block_properties.h>
+#include <example_module/input_processing.h>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+void markIngress(TraceSource& trace, const StreamReaderPtr& reader)
+{
+    if (!trace.isEnabled())
+        return;
+
+    auto lock = trace.lockIngress();
+    trace.markIngress(reader.getAvailableCount());
+}
+
+void markQueuedIngress(TraceSource& trace, const InputPortConfigPtr& inputPort)
+{
+    if (!trace.isEnabled())
+        return;
+
+    auto lock = trace.lockIngress();
+    const auto connection = inputPort.getConnection();
+    if (connection.assigned())
+        trace.markIngress(connection.getPacketCount());
+}
+
+ProcessingDispatcher::ProcessingDispatcher(const ContextPtr& context, std::function<void()> process)
+    : context(context)
+    , process(std::move(process))
+    , flushTarget(std::make_shared<FlushTarget>())
+{
+    flushTarget->process = this->process;
+}
+
+ProcessingDispatcher::~ProcessingDispatcher()
+{
+    // No block can schedule another flush once the worker thread is joined
+    std::atomic_store(&processingThread, std::shared_ptr<ProcessingThread>());
+
+    std::scoped_lock lock(flushTarget->mutex);
+    flushTarget->process = nullptr;
+}
+
+void ProcessingDispatcher::dataAvailable()
+{
+    if (const auto thread = std::atomic_load(&processingThread))
+        thread->notify();
+    else
+        process();
+}
+
+void ProcessingDispatcher::scheduleFlush(DeadlineTimer::Clock::time_point deadline)
+{
+    flushTimer.schedule(deadline);
+}
+
+void ProcessingDispatcher::setExecutionMode(const PropertyObjectPtr& objPtr, const InputPortConfigPtr& inputPort)
+{
+    const auto mode = readExecutionMode(objPtr);
+
+    std::shared_ptr<ProcessingThread> thread;
+    if (mode == ExecutionMode::WorkerThread)
+    {
+        thread = std::make_shared<ProcessingThread>(process);
+        if (!thread->setAffinity(readCpuAffinity(objPtr)))
+            throw std::invalid_argument("CpuAffinity does not name an available CPU");
+    }
+
+    inputPort.setNotificationMethod(getNotificationMethod(mode));
+    std::atomic_store(&processingThread, thread);
+
+    // Input that arrived during the switch
+    if (thread)
+        thread->notify();
+}
+
+// Runs on the timer thread, which is shared by all function blocks and must not process a block itself.
+// A scheduler task that runs after the dispatcher was destroyed does nothing.
+void ProcessingDispatcher::flush()
+{
+    if (const auto thread = std::atomic_load(&processingThread))
+    {
+        thread->notify();
+        return;
+    }
+
+    try
+    {
+        context.getScheduler().scheduleWork(Work(
+            [target = std::weak_ptr<FlushTarget>(flushTarget)]
+            {
+                const auto flushTarget = target.lock();
+                if (!flushTarget)
+                    return;
+
+                std::scoped_lock lock(flushTarget->mutex);
+                if (flushTarget->process)
+                    flushTarget->process();
+            }));
+    }
+    catch (const DaqException&)
+    {
+        // The scheduler no longer accepts work while the instance shuts down
+    }
+}
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,186 @@
+#include <example_module/operator_chain_fb.h>
+#include <example_module/property_updates.h>
+#include <opendaq/data_descriptor_ptr.h>
+#include <opendaq/event_packet_params.h>
+#include <opendaq/input_port_factory.h>
+#include <opendaq/signal_factory.h>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+OperatorChainFBImpl::OperatorChainFBImpl(const ContextPtr& context,
+                                         const ComponentPtr& parent,
+                                         const StringPtr& localId,
+                                         const PropertyObjectPtr& /*config*/)
+    : FunctionBlock(CreateType(), context, parent, localId)
+{
+    initComponentStatus();
+    createInputPorts();
+    createSignals();
+    initProperties();
+}
+
+FunctionBlockTypePtr OperatorChainFBImpl::CreateType()
+{
+    return FunctionBlockType("ExampleOperatorChain",
+                             "Operator Chain",
+                             "Applies a list of per-sample operators (offset, gain, clamp, abs, square, dead band, conversion) in one pass",
+                             PropertyObject());
+}
+
+void OperatorChainFBImpl::createInputPorts()
+{
+    inputPort = createAndAddInputPort("Input", PacketReadyNotification::Scheduler);
+    reader = StreamReaderFromPort(inputPort, SampleType::Float64, SampleType::UInt64);
+    reader.setOnDataAvailable([this] { calculate(); });
+
+    // Holds a read block of the widest sample type, so that it does not depend on a valid configuration
+    inputData.resize(ReadBlockSize * sizeof(double));
+}
+
+void OperatorChainFBImpl::createSignals()
+{
+    outputSignal = createAndAddSignal("Output");
+    outputDomainSignal = createAndAddSignal("OutputTime", nullptr, false);
+    outputSignal.setDomainSignal(outputDomainSignal);
+}
+
+void OperatorChainFBImpl::initProperties()
+{
+    // Applied in order, each written as its name and parameters, e.g. "Offset -2", "Gain 0.5", "Clamp 0 10",
+    // "Abs", "Square", "DeadBand 0.1" or "Convert 1.8 32"
+    const auto operatorsProp = ListProperty("Operators", List<IString>());
+    objPtr.addProperty(operatorsProp);
+
+    // Unit of the output; empty keeps the unit of the input
+    const auto outputUnitProp = StringProperty("OutputUnit", "");
+    objPtr.addProperty(outputUnitProp);
+
+    observeProperties(objPtr, {"Operators", "OutputUnit"}, [this] { propertyChanged(); });
+
+    operators = readOperators();
+    outputUnit = static_cast<std::string>(objPtr.getPropertyValue("OutputUnit"));
+}
+
+// Throws std::invalid_argument for an invalid operator, which rejects the property write
+std::vector<ChainOperator> OperatorChainFBImpl::readOperators() const
+{
+    const ListPtr<IString> list = objPtr.getPropertyValue("Operators");
+
+    std::vector<ChainOperator> result;
+    for (const auto& item : list)
+        result.push_back(parseChainOperator(item.toStdString()));
+    return result;
+}
+
+void OperatorChainFBImpl::propertyChanged()
+{
+    auto parsed = readOperators();
+
+    auto lock = this->getAcquisitionLock();
+
+    operators = std::move(parsed);
+    outputUnit = static_cast<std::string>(objPtr.getPropertyValue("OutputUnit"));
+    if (inputDomainDataDescriptor.assigned())
+        configure();
+}
+
+void OperatorChainFBImpl::configure()
+{
+    try
+    {
+        if (!inputDomainDataDescriptor.assigned() || inputDomainDataDescriptor == NullDataDescriptor())
+            throw std::runtime_error("No domain input");
+
+        if (!inputDataDescriptor.assigned() || inputDataDescriptor == NullDataDescriptor())
+            throw std::runtime_error("No value input");
+
+        if (inputDataDescriptor.getDimensions().getCount() > 0)
+            throw std::runtime_error("Arrays not supported");
+
+        const auto sampleType = inputDataDescriptor.getSampleType();
+        validateValueSampleType(sampleType);
+        const SizeT domainDelta = validateLinearDomain(inputDomainDataDescriptor);
+
+        // Read the input in its native sample type, so that the chain performs the only conversion
+        if (reader.getValueReadType() != sampleType)
+        {
+            reader = StreamReaderFromExisting(reader, sampleType, SampleType::UInt64);
+            reader.setOnDataAvailable([this] { calculate(); });
+        }
+        chain.setOperators(operators, sampleType);
+
+        auto builder = DataDescriptorBuilder().setSampleType(SampleType::Float64);
+        const auto inputRange = inputDataDescriptor.getValueRange();
+        if (inputRange.assigned())
+        {
+            const auto [low, high] = chain.getOutputRange(static_cast<double>(inputRange.getLowValue()), static_cast<double>(inputRange.getHighValue()));
+            builder.setValueRange(Range(low, high));
+        }
+        builder.setUnit(outputUnit.empty() ? inputDataDescriptor.getUnit() : Unit(outputUnit));
+
+        outputDataDescriptor = builder.build();
+        outputPacketPool.setDescriptor(outputDataDescriptor);
+        outputSignal.setDescriptor(outputDataDescriptor);
+        outputDomainSignal.setDescriptor(inputDomainDataDescriptor);
+
+        domainOffsets.setDelta(domainDelta);
+
+        setComponentStatus(ComponentStatus::Ok);
+        configValid = true;
+    }
+    catch (const std::exception& e)
+    {
+        setComponentStatusWithMessage(ComponentStatus::Error, e.what());
+        outputSignal.setDescriptor(nullptr);
+        configValid = false;
+        throw;
+    }
+}
+
+void OperatorChainFBImpl::calculate()
+{
+    auto lock = this->getAcquisitionLock();
+
+    readUntilEvent(
+        reader,
+        inputData.data(),
+        ReadBlockSize,
+        [this](const ReaderStatusPtr& status, SizeT readAmount)
+        {
+            // Samples read while the configuration is invalid are discarded
+            if (configValid)
+                processData(readAmount, domainOffsets.next(status, readAmount));
+        },
+        [this](const EventPacketPtr& packet) { processEventPacket(packet); });
+}
+
+void OperatorChainFBImpl::processEventPacket(const EventPacketPtr& packet)
+{
+    if (packet.getEventId() == event_packet_id::DATA_DESCRIPTOR_CHANGED)
+    {
+        DataDescriptorPtr dataDesc = packet.getParameters().get(event_packet_param::DATA_DESCRIPTOR);
+        DataDescriptorPtr domainDesc = packet.getParameters().get(event_packet_param::DOMAIN_DATA_DESCRIPTOR);
+        if (dataDesc.assigned())
+            inputDataDescriptor = dataDesc;
+        if (domainDesc.assigned())
+            inputDomainDataDescriptor = domainDesc;
+
+        configure();
+    }
+}
+
+void OperatorChainFBImpl::processData(SizeT readAmount, SizeT packetOffset)
+{
+    if (readAmount == 0)
+        return;
+
+    const auto outputDomainPacket = DataPacket(inputDomainDataDescriptor, readAmount, packetOffset);
+    const auto outputPacket = outputPacketPool.createPacket(outputDomainPacket, readAmount);
+
+    chain.process(inputData.data(), static_cast<double*>(outputPacket.getRawData()), readAmount);
+
+    outputSignal.sendPacket(outputPacket);
+    outputDomainSignal.sendPacket(outputDomainPacket);
+}
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,30 @@
+#include <example_module/property_updates.h>
+#include <algorithm>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+void observeProperties(PropertyObjectPtr& objPtr, const std::vector<std::string>& names, const std::function<void()>& onChanged)
+{
+    for (const auto& name : names)
+    {
+        objPtr.getOnPropertyValueWrite(name) += [onChanged](PropertyObjectPtr&, PropertyValueEventArgsPtr& args)
+        {
+            if (!args.getIsUpdating())
+                onChanged();
+        };
+    }
+
+    objPtr.getOnEndUpdate() += [names, onChanged](PropertyObjectPtr&, EndUpdateEventArgsPtr& args)
+    {
+        for (const StringPtr& property : args.getProperties())
+        {
+            if (std::find(names.begin(), names.end(), property.toStdString()) != names.end())
+            {
+                onChanged();
+                return;
+            }
+        }
+    };
+}
+
+END_NAMESPACE_EXAMPLE_MODULE
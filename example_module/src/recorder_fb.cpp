@@ -0,0 +1,277 @@
+#include <example_module/recorder_fb.h>
+#include <example_module/property_updates.h>
+#include <opendaq/data_descriptor_ptr.h>
+#include <opendaq/event_packet_params.h>
+#include <opendaq/input_port_factory.h>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+namespace
+{
+    std::string serializeDescriptor(const DataDescriptorPtr& descriptor)
+    {
+        if (!descriptor.assigned() || descriptor == NullDataDescriptor())
+            return {};
+
+        const auto serializer = JsonSerializer();
+        descriptor.asPtr<ISerializable>().serialize(serializer);
+        return serializer.getOutput().toStdString();
+    }
+}
+
+RecorderFBImpl::RecorderFBImpl(const ContextPtr& context,
+                               const ComponentPtr& parent,
+                               const StringPtr& localId,
+                               const PropertyObjectPtr& /*config*/)
+    : FunctionBlock(CreateType(), context, parent, localId)
+{
+    initComponentStatus();
+    createInputPorts();
+    initProperties();
+}
+
+RecorderFBImpl::~RecorderFBImpl()
+{
+    stopRecording();
+}
+
+FunctionBlockTypePtr RecorderFBImpl::CreateType()
+{
+    return FunctionBlockType("ExampleRecorder",
+                             "Recorder",
+                             "Records raw samples and domain values into a memory-mapped binary file at full rate",
+                             PropertyObject());
+}
+
+void RecorderFBImpl::createInputPorts()
+{
+    // Packets are recorded on the sending thread; writing them is a copy into mapped memory
+    inputPort = createAndAddInputPort("Input", PacketReadyNotification::SameThread);
+}
+
+void RecorderFBImpl::initProperties()
+{
+    const auto filePathProp = StringProperty("FilePath", "recording.daqrec");
+    objPtr.addProperty(filePathProp);
+
+    // Size in MiB of the mapped segments; the file is written one segment at a time
+    const auto segmentSizeProp = IntPropertyBuilder("SegmentSize", 64).setMinValue(1).setMaxValue(MaxSegmentSize).build();
+    objPtr.addProperty(segmentSizeProp);
+
+    // Space in MiB allocated for the recording when it starts; samples beyond it are dropped
+    const auto maxFileSizeProp = IntPropertyBuilder("MaxFileSize", 1024).setMinValue(1).setMaxValue(MaxFileSize).build();
+    objPtr.addProperty(maxFileSizeProp);
+
+    const auto recordingProp = BoolProperty("Recording", False);
+    objPtr.addProperty(recordingProp);
+
+    const auto addCounter = [this](const std::string& name, std::atomic<SizeT>& counter)
+    {
+        objPtr.addProperty(IntPropertyBuilder(name, 0).setReadOnly(true).build());
+        objPtr.getOnPropertyValueRead(name) += [&counter](PropertyObjectPtr&, PropertyValueEventArgsPtr& args)
+        {
+            args.setValue(static_cast<Int>(counter.load(std::memory_order_relaxed)));
+        };
+    };
+
+    // Samples of the current or last recording
+    addCounter("RecordedSamples", recordedSamples);
+    addCounter("DroppedSamples", droppedSamples);
+
+    observeProperties(objPtr, {"Recording"}, [this] { recordingChanged(); });
+}
+
+void RecorderFBImpl::recordingChanged()
+{
+    if (objPtr.getPropertyValue("Recording"))
+        startRecording();
+    else
+        stopRecording();
+}
+
+// Opens the file without the acquisition lock, so packets keep flowing while it is allocated and mapped
+void RecorderFBImpl::startRecording()
+{
+    RecordedDescriptors descriptors;
+    {
+        auto lock = this->getAcquisitionLock();
+        if (writer)
+            return;
+        descriptors = serializeDescriptors();
+    }
+
+    const std::string filePath = objPtr.getPropertyValue("FilePath");
+    const auto segmentSize = static_cast<SizeT>(static_cast<Int>(objPtr.getPropertyValue("SegmentSize"))) << 20;
+    const auto maxFileSize = static_cast<SizeT>(static_cast<Int>(objPtr.getPropertyValue("MaxFileSize"))) << 20;
+
+    auto newWriter = std::make_unique<RecordingWriter>();
+    try
+    {
+        newWriter->open(filePath, descriptors, segmentSize, maxFileSize);
+    }
+    catch (const std::exception& e)
+    {
+        setComponentStatusWithMessage(ComponentStatus::Error, e.what());
+        throw;
+    }
+
+    auto lock = this->getAcquisitionLock();
+
+    // The descriptors may have changed while the file was opened
+    const auto currentDescriptors = serializeDescriptors();
+    if (currentDescriptors.dataDescriptor != descriptors.dataDescriptor || currentDescriptors.domainDescriptor != descriptors.domainDescriptor)
+        newWriter->writeDescriptors(currentDescriptors);
+
+    recordedSamples = 0;
+    droppedSamples = 0;
+    droppedSamplesReported = false;
+    writeErrorReported = false;
+    writer = std::move(newWriter);
+    configure();
+}
+
+void RecorderFBImpl::stopRecording()
+{
+    std::unique_ptr<RecordingWriter> finishedWriter;
+    {
+        auto lock = this->getAcquisitionLock();
+        finishedWriter = std::move(writer);
+    }
+
+    if (finishedWriter)
+        finishedWriter->close();
+}
+
+void RecorderFBImpl::onPacketReceived(const InputPortPtr& /*port*/)
+{
+    auto lock = this->getAcquisitionLock();
+
+    const auto connection = inputPort.getConnection();
+    if (!connection.assigned())
+        return;
+
+    PacketPtr packet = connection.dequeue();
+    while (packet.assigned())
+    {
+        switch (packet.getType())
+        {
+            case PacketType::Event:
+                processEventPacket(packet.asPtr<IEventPacket>());
+                break;
+            case PacketType::Data:
+                if (writer && configValid)
+                    processDataPacket(packet.asPtr<IDataPacket>());
+                break;
+            default:
+                break;
+        }
+
+        packet = connection.dequeue();
+    }
+}
+
+void RecorderFBImpl::processEventPacket(const EventPacketPtr& packet)
+{
+    if (packet.getEventId() == event_packet_id::DATA_DESCRIPTOR_CHANGED)
+    {
+        DataDescriptorPtr dataDesc = packet.getParameters().get(event_packet_param::DATA_DESCRIPTOR);
+        DataDescriptorPtr domainDesc = packet.getParameters().get(event_packet_param::DOMAIN_DATA_DESCRIPTOR);
+        if (dataDesc.assigned())
+            inputDataDescriptor = dataDesc;
+        if (domainDesc.assigned())
+            inputDomainDataDescriptor = domainDesc;
+
+        configure();
+        if (writer && !writer->writeDescriptors(serializeDescriptors()))
+            setComponentStatusWithMessage(ComponentStatus::Warning, "Descriptor change was not recorded");
+    }
+}
+
+void RecorderFBImpl::configure()
+{
+    configValid = false;
+
+    try
+    {
+        if (!inputDataDescriptor.assigned() || inputDataDescriptor == NullDataDescriptor())
+            throw std::runtime_error("No value input");
+
+        // Only explicit values have raw data to record
+        const auto dataRule = inputDataDescriptor.getRule();
+        if (dataRule.assigned() && dataRule.getType() != DataRuleType::Explicit)
+            throw std::runtime_error("Value signal must have an explicit rule");
+
+        valueSampleSize = inputDataDescriptor.getRawSampleSize();
+        domainSampleSize = 0;
+        domainDelta = 0;
+        explicitDomain = false;
+
+        if (inputDomainDataDescriptor.assigned() && inputDomainDataDescriptor != NullDataDescriptor())
+        {
+            const auto domainRule = inputDomainDataDescriptor.getRule();
+            explicitDomain = !domainRule.assigned() || domainRule.getType() == DataRuleType::Explicit;
+            if (explicitDomain)
+                domainSampleSize = inputDomainDataDescriptor.getRawSampleSize();
+            else if (domainRule.getType() == DataRuleType::Linear)
+                domainDelta = domainRule.getParameters().get("delta");
+            else
+                throw std::runtime_error("Domain must have an explicit or linear rule");
+        }
+
+        setComponentStatus(ComponentStatus::Ok);
+        configValid = true;
+    }
+    catch (const std::exception& e)
+    {
+        setComponentStatusWithMessage(ComponentStatus::Error, e.what());
+    }
+}
+
+void RecorderFBImpl::processDataPacket(const DataPacketPtr& packet)
+{
+    const SizeT sampleCount = packet.getSampleCount();
+    if (sampleCount == 0)
+        return;
+
+    const auto domainPacket = packet.getDomainPacket();
+    const void* domainData = nullptr;
+    Int domainOffset = 0;
+    if (domainPacket.assigned())
+    {
+        if (explicitDomain)
+            domainData = domainPacket.getRawData();
+        else if (domainPacket.getOffset().assigned())
+            domainOffset = domainPacket.getOffset().getIntValue();
+    }
+
+    const SizeT written = writer->writeData(packet.getRawData(), valueSampleSize, domainData, domainSampleSize, sampleCount, domainOffset, domainDelta);
+    recordedSamples.fetch_add(written, std::memory_order_relaxed);
+
+    if (written < sampleCount)
+    {
+        droppedSamples.fetch_add(sampleCount - written, std::memory_order_relaxed);
+
+        // A segment that failed to flush or map is not reused, so the drops continue; report the cause
+        const auto error = writer->getError();
+        if (!error.empty())
+        {
+            if (!writeErrorReported)
+            {
+                setComponentStatusWithMessage(ComponentStatus::Error, "Samples were dropped: writing the file failed: " + error);
+                writeErrorReported = true;
+            }
+        }
+        else if (!droppedSamplesReported)
+        {
+            setComponentStatusWithMessage(ComponentStatus::Warning, "Samples were dropped: the disk is too slow or the file is full");
+            droppedSamplesReported = true;
+        }
+    }
+}
+
+RecordedDescriptors RecorderFBImpl::serializeDescriptors() const
+{
+    return {serializeDescriptor(inputDataDescriptor), serializeDescriptor(inputDomainDataDescriptor)};
+}
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,302 @@
+#include <example_module/replay_fb.h>
+#include <example_module/property_updates.h>
+#include <opendaq/data_descriptor_ptr.h>
+#include <opendaq/signal_factory.h>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+namespace
+{
+    DataDescriptorPtr deserializeDescriptor(const std::string& serialized)
+    {
+        if (serialized.empty())
+            return nullptr;
+
+        const auto deserializer = JsonDeserializer();
+        return deserializer.deserialize(String(serialized)).asPtr<IDataDescriptor>();
+    }
+}
+
+ReplayFBImpl::ReplayFBImpl(const ContextPtr& context,
+                           const ComponentPtr& parent,
+                           const StringPtr& localId,
+                           const PropertyObjectPtr& /*config*/)
+    : FunctionBlock(CreateType(), context, parent, localId)
+{
+    initComponentStatus();
+    createSignals();
+    initProperties();
+}
+
+ReplayFBImpl::~ReplayFBImpl()
+{
+    stop();
+}
+
+FunctionBlockTypePtr ReplayFBImpl::CreateType()
+{
+    return FunctionBlockType("ExampleReplay",
+                             "Replay",
+                             "Replays a recording in real time, faster or as fast as possible, without copying the samples",
+                             PropertyObject());
+}
+
+void ReplayFBImpl::createSignals()
+{
+    outputSignal = createAndAddSignal("Replayed");
+    outputDomainSignal = createAndAddSignal("ReplayedTime", nullptr, false);
+    outputSignal.setDomainSignal(outputDomainSignal);
+}
+
+void ReplayFBImpl::initProperties()
+{
+    const auto filePathProp = StringProperty("FilePath", "");
+    objPtr.addProperty(filePathProp);
+
+    // Multiple of real time; 0 replays as fast as the receivers take the packets
+    const auto replaySpeedProp = FloatPropertyBuilder("ReplaySpeed", 1.0).setMinValue(0.0).build();
+    objPtr.addProperty(replaySpeedProp);
+
+    const auto playingProp = BoolProperty("Playing", False);
+    objPtr.addProperty(playingProp);
+
+    objPtr.addProperty(IntPropertyBuilder("ReplayedSamples", 0).setReadOnly(true).build());
+    objPtr.getOnPropertyValueRead("ReplayedSamples") += [this](PropertyObjectPtr&, PropertyValueEventArgsPtr& args)
+    {
+        args.setValue(static_cast<Int>(replayedSamples.load(std::memory_order_relaxed)));
+    };
+
+    // Continues from the first record
+    objPtr.addProperty(FunctionProperty("Rewind", ProcedureInfo()));
+    objPtr.setPropertyValue("Rewind", Procedure([this] { rewind(); }));
+
+    observeProperties(objPtr, {"FilePath"}, [this] { filePathChanged(); });
+    observeProperties(objPtr, {"ReplaySpeed", "Playing"}, [this] { playbackChanged(); });
+}
+
+void ReplayFBImpl::filePathChanged()
+{
+    auto lock = this->getAcquisitionLock();
+
+    stop();
+    openFile();
+    if (recordingReader && objPtr.getPropertyValue("Playing"))
+        start();
+}
+
+void ReplayFBImpl::playbackChanged()
+{
+    auto lock = this->getAcquisitionLock();
+
+    stop();
+    replaySpeed = objPtr.getPropertyValue("ReplaySpeed");
+    if (recordingReader && objPtr.getPropertyValue("Playing"))
+        start();
+}
+
+void ReplayFBImpl::rewind()
+{
+    auto lock = this->getAcquisitionLock();
+
+    stop();
+    if (!recordingReader)
+        return;
+
+    recordingReader->rewind();
+    replayedSamples = 0;
+    applyDescriptors(recordingReader->getDescriptors());
+    if (objPtr.getPropertyValue("Playing"))
+        start();
+}
+
+// Packets of the previous file keep its mapping alive until they are released
+void ReplayFBImpl::openFile()
+{
+    recordingReader.reset();
+    recordDeleter = nullptr;
+    replayedSamples = 0;
+
+    const std::string filePath = objPtr.getPropertyValue("FilePath");
+    if (filePath.empty())
+    {
+        setComponentStatus(ComponentStatus::Ok);
+        return;
+    }
+
+    auto newReader = std::make_shared<RecordingReader>();
+    try
+    {
+        newReader->open(filePath);
+    }
+    catch (const std::exception& e)
+    {
+        setComponentStatusWithMessage(ComponentStatus::Error, e.what());
+        outputSignal.setDescriptor(nullptr);
+        throw;
+    }
+
+    recordingReader = std::move(newReader);
+    recordDeleter = Deleter([keepAlive = recordingReader](void*) {});
+    applyDescriptors(recordingReader->getDescriptors());
+}
+
+void ReplayFBImpl::applyDescriptors(const RecordedDescriptors& descriptors)
+{
+    configValid = false;
+
+    try
+    {
+        dataDescriptor = deserializeDescriptor(descriptors.dataDescriptor);
+        domainDescriptor = deserializeDescriptor(descriptors.domainDescriptor);
+        if (!dataDescriptor.assigned())
+            throw std::runtime_error("The recording has no value descriptor");
+
+        valueSampleSize = dataDescriptor.getRawSampleSize();
+        linearDomain = false;
+        domainDelta = 0;
+        tickSeconds = 0.0;
+
+        if (domainDescriptor.assigned())
+        {
+            const auto domainRule = domainDescriptor.getRule();
+            linearDomain = domainRule.assigned() && domainRule.getType() == DataRuleType::Linear;
+            if (linearDomain)
+                domainDelta = domainRule.getParameters().get("delta");
+
+            // Explicit domains are paced by their first and last value, which must be integer ticks
+            const auto domainType = domainDescriptor.getSampleType();
+            const auto resolution = domainDescriptor.getTickResolution();
+            if (resolution.assigned() && (linearDomain || domainType == SampleType::Int64 || domainType == SampleType::UInt64))
+                tickSeconds = static_cast<double>(resolution.getNumerator()) / static_cast<double>(resolution.getDenominator());
+        }
+
+        outputSignal.setDescriptor(dataDescriptor);
+        outputDomainSignal.setDescriptor(domainDescriptor);
+        setComponentStatus(ComponentStatus::Ok);
+        configValid = true;
+    }
+    catch (const std::exception& e)
+    {
+        setComponentStatusWithMessage(ComponentStatus::Error, e.what());
+        outputSignal.setDescriptor(nullptr);
+    }
+}
+
+void ReplayFBImpl::start()
+{
+    stopRequested = false;
+    replayThread = std::thread([this] { replay(); });
+}
+
+void ReplayFBImpl::stop()
+{
+    if (!replayThread.joinable())
+        return;
+
+    {
+        std::scoped_lock lock(replayMutex);
+        stopRequested = true;
+    }
+    replayCv.notify_all();
+    replayThread.join();
+}
+
+// Record n is sent once the time from the start of the first paced record to the end of record n,
+// divided by the replay speed, has passed since the thread started
+void ReplayFBImpl::replay()
+{
+    const auto startTime = Clock::now();
+    bool paced = false;
+    double firstTime = 0.0;
+
+    RecordView record;
+    std::unique_lock lock(replayMutex);
+    while (!stopRequested)
+    {
+        lock.unlock();
+        bool hasRecord = false;
+        try
+        {
+            hasRecord = recordingReader->next(record);
+            if (!hasRecord)
+                setComponentStatusWithMessage(ComponentStatus::Ok, "End of recording");
+            else if (record.type == RecordType::Descriptor)
+                applyDescriptors(record.descriptors);
+        }
+        catch (const std::exception& e)
+        {
+            setComponentStatusWithMessage(ComponentStatus::Error, e.what());
+        }
+        lock.lock();
+
+        if (!hasRecord)
+            break;
+        if (record.type != RecordType::Data || !configValid || record.valueSize != record.sampleCount * valueSampleSize)
+            continue;
+
+        double recordStart;
+        double recordEnd;
+        if (replaySpeed > 0.0 && getRecordTimes(record, recordStart, recordEnd))
+        {
+            if (!paced)
+            {
+                paced = true;
+                firstTime = recordStart;
+            }
+
+            const auto due = startTime + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>((recordEnd - firstTime) / replaySpeed));
+            if (replayCv.wait_until(lock, due, [this] { return stopRequested; }))
+                break;
+        }
+
+        lock.unlock();
+        sendRecord(record);
+        lock.lock();
+    }
+}
+
+bool ReplayFBImpl::getRecordTimes(const RecordView& record, double& start, double& end) const
+{
+    if (tickSeconds <= 0.0 || record.sampleCount == 0)
+        return false;
+
+    if (linearDomain)
+    {
+        start = static_cast<double>(record.domainOffset) * tickSeconds;
+        end = static_cast<double>(record.domainOffset + static_cast<Int>(record.sampleCount) * domainDelta) * tickSeconds;
+        return true;
+    }
+
+    if (record.domainSize != record.sampleCount * sizeof(int64_t))
+        return false;
+
+    int64_t first;
+    int64_t last;
+    std::memcpy(&first, record.domain, sizeof(first));
+    std::memcpy(&last, record.domain + record.domainSize - sizeof(last), sizeof(last));
+    start = static_cast<double>(first) * tickSeconds;
+    end = static_cast<double>(last) * tickSeconds;
+    return true;
+}
+
+void ReplayFBImpl::sendRecord(const RecordView& record)
+{
+    // The mapping is read-only; receivers only read input packets
+    DataPacketPtr domainPacket;
+    if (linearDomain)
+        domainPacket = DataPacket(domainDescriptor, record.sampleCount, record.domainOffset);
+    else if (record.domain)
+        domainPacket = DataPacketWithExternalMemory(
+            nullptr, domainDescriptor, record.sampleCount, const_cast<uint8_t*>(record.domain), recordDeleter, nullptr, record.domainSize);
+
+    const auto packet = DataPacketWithExternalMemory(
+        domainPacket, dataDescriptor, record.sampleCount, const_cast<uint8_t*>(record.values), recordDeleter, nullptr, record.valueSize);
+
+    outputSignal.sendPacket(packet);
+    if (domainPacket.assigned())
+        outputDomainSignal.sendPacket(domainPacket);
+
+    replayedSamples.fetch_add(record.sampleCount, std::memory_order_relaxed);
+}
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,386 @@
+#include <example_module/filter_properties.h>
+#include <example_module/property_updates.h>
+#include <example_module/scaled_filter_fb.h>
+#include <opendaq/data_descriptor_ptr.h>
+#include <opendaq/event_packet_params.h>
+#include <opendaq/input_port_factory.h>
+#include <opendaq/signal_factory.h>
+#include <algorithm>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+ScaledFilterFBImpl::ScaledFilterFBImpl(const ContextPtr& context,
+                                       const ComponentPtr& parent,
+                                       const StringPtr& localId,
+                                       const PropertyObjectPtr& config)
+    : FunctionBlock(CreateType(), context, parent, localId)
+    , trace(localId.toStdString())
+{
+    if (config.assigned() && config.hasProperty("PacketMode"))
+        packetMode = config.getPropertyValue("PacketMode");
+
+    initComponentStatus();
+    createInputPorts();
+    createSignals();
+    initProperties();
+}
+
+FunctionBlockTypePtr ScaledFilterFBImpl::CreateType()
+{
+    auto defaultConfig = PropertyObject();
+    defaultConfig.addProperty(BoolProperty("PacketMode", False));
+
+    return FunctionBlockType("ExampleScaledIIRFilter",
+                             "Scaled IIR Filter",
+                             "Signal scaling followed by an IIR filter, applied in a single pass over the input",
+                             defaultConfig);
+}
+
+void ScaledFilterFBImpl::createInputPorts()
+{
+    inputPort = createAndAddInputPort("Input", PacketReadyNotification::Scheduler);
+
+    // In packet mode the input port notifies the function block directly (see onPacketReceived)
+    if (packetMode)
+        return;
+
+    reader = StreamReaderFromPort(inputPort, SampleType::Float64, SampleType::UInt64);
+    reader.setOnDataAvailable(
+        [this]
+        {
+            markIngress(trace, reader);
+            dispatcher.dataAvailable();
+        });
+}
+
+void ScaledFilterFBImpl::createSignals()
+{
+    outputSignal = createAndAddSignal("Filtered");
+    outputDomainSignal = createAndAddSignal("FilteredTime", nullptr, false);
+    outputSignal.setDomainSignal(outputDomainSignal);
+}
+
+void ScaledFilterFBImpl::initProperties()
+{
+    // Scaling property writes only publish new parameters and never take the acquisition lock
+    addScalingProperties(objPtr, [this] { scaling.publish(objPtr); });
+    addFilterDesignProperties(objPtr, [this] { filterPropertyChanged(); });
+
+    // Number of threads that filter segments of one block concurrently; 1 filters serially
+    const auto parallelismProp = IntPropertyBuilder("Parallelism", 1).setMinValue(1).setMaxValue(64).build();
+    objPtr.addProperty(parallelismProp);
+    objPtr.getOnPropertyValueWrite("Parallelism") += [this](PropertyObjectPtr&, PropertyValueEventArgsPtr&) { parallelismChanged(); };
+
+    addCrossfadeProperty(objPtr);
+
+    addBlockPolicyProperties(objPtr, [this] { blockPolicyChanged(); });
+    addExecutionProperties(objPtr, [this] { dispatcher.setExecutionMode(objPtr, inputPort); });
+    addStatisticsProperty(objPtr, statistics);
+    addTracingProperties(objPtr, [this] { trace.setEnabled(readTracingEnabled(objPtr)); });
+
+    scaling.publish(objPtr);
+    filterSpec = readFilterDesignProperties(objPtr);
+    blockLimits = readBlockPolicyProperties(objPtr);
+    updateReadBlockSize();
+}
+
+// Design changes of a running filter are staged and swapped in between two blocks, as in ExampleIIRFilter:
+// the spec is validated and designed before the lock is taken and only published once it is valid
+void ScaledFilterFBImpl::filterPropertyChanged()
+{
+    const FilterSpec spec = readFilterDesignProperties(objPtr);
+    const SizeT crossfadeLength = readCrossfadeLength(objPtr);
+    auto design = designStage.prepare(spec, crossfadeLength);
+
+    auto lock = this->getAcquisitionLock();
+
+    if (configValid)
+    {
+        designStage.stage(spec, std::move(design), crossfadeLength);
+        filterSpec = spec;
+        return;
+    }
+
+    const FilterSpec previousSpec = filterSpec;
+    filterSpec = spec;
+    if (!inputDomainDataDescriptor.assigned())
+        return;
+
+    try
+    {
+        configure();
+    }
+    catch (...)
+    {
+        filterSpec = previousSpec;
+        throw;
+    }
+}
+
+void ScaledFilterFBImpl::updateOutputDescriptor(const ScalingParameters& params)
+{
+    outputDataDescriptor = buildScaledOutputDescriptor(params, inputDataDescriptor);
+    outputPacketPool.setDescriptor(outputDataDescriptor);
+
+    outputSignal.setDescriptor(outputDataDescriptor);
+    outputSignal.setName(getScaledOutputName(params, inputPort, "/Filtered"));
+}
+
+// The filter state is kept, so the output continues without a glitch
+void ScaledFilterFBImpl::parallelismChanged()
+{
+    auto lock = this->getAcquisitionLock();
+
+    const auto threadCount = static_cast<SizeT>(static_cast<Int>(objPtr.getPropertyValue("Parallelism")));
+    if (threadCount > 1)
+        workerPool = std::make_shared<WorkerPool>(threadCount);
+    else
+        workerPool.reset();
+
+    filter.setWorkerPool(workerPool);
+    updateReadBlockSize();
+    updateMemoryUsage();
+}
+
+void ScaledFilterFBImpl::blockPolicyChanged()
+{
+    auto lock = this->getAcquisitionLock();
+
+    blockLimits = readBlockPolicyProperties(objPtr);
+    updateReadBlockSize();
+    updateMemoryUsage();
+}
+
+// Larger read blocks give every thread a full segment, up to the MaxBlockSamples budget
+void ScaledFilterFBImpl::updateReadBlockSize()
+{
+    const SizeT preferred = workerPool ? workerPool->getThreadCount() * filter.getSegmentSize() : SerialReadBlockSize;
+    readBlockSize = std::min(std::max(preferred, blockLimits.minSamples), blockLimits.maxSamples);
+    inputReader.getBlockPolicy().setLimits(blockLimits.minSamples, readBlockSize, blockLimits.maxHoldTime);
+}
+
+// The read buffer holds native input samples and is leased from the scratch arena of the processing
+// thread; in packet mode the input packets are scaled directly
+void ScaledFilterFBImpl::updateMemoryUsage()
+{
+    const SizeT readBuffer = packetMode ? 0 : readBlockSize * inputSampleSize;
+    setMemoryUsage(objPtr, readBuffer + filter.getMemoryUsage() + crossfade.getMemoryUsage());
+}
+
+void ScaledFilterFBImpl::processSignalDescriptorChanged(const DataDescriptorPtr& dataDescriptor, const DataDescriptorPtr& domainDescriptor)
+{
+    if (dataDescriptor.assigned())
+        this->inputDataDescriptor = dataDescriptor;
+    if (domainDescriptor.assigned())
+        this->inputDomainDataDescriptor = domainDescriptor;
+
+    configure();
+}
+
+void ScaledFilterFBImpl::configure()
+{
+    statistics.recordReconfiguration();
+    filter.reset();
+
+    designStage.stop();
+    crossfade.stop();
+
+    try
+    {
+        if (!inputDomainDataDescriptor.assigned() || inputDomainDataDescriptor == NullDataDescriptor())
+            throw std::runtime_error("No domain input");
+
+        if (!inputDataDescriptor.assigned() || inputDataDescriptor == NullDataDescriptor())
+            throw std::runtime_error("No value input");
+
+        if (inputDataDescriptor.getDimensions().getCount() > 0)
+            throw std::runtime_error("Arrays not supported");
+
+        inputSampleType = inputDataDescriptor.getSampleType();
+        if (inputSampleType != SampleType::Float64 &&
+            inputSampleType != SampleType::Float32 &&
+            inputSampleType != SampleType::Int8 &&
+            inputSampleType != SampleType::Int16 &&
+            inputSampleType != SampleType::Int32 &&
+            inputSampleType != SampleType::Int64 &&
+            inputSampleType != SampleType::UInt8 &&
+            inputSampleType != SampleType::UInt16 &&
+            inputSampleType != SampleType::UInt32 &&
+            inputSampleType != SampleType::UInt64)
+        {
+            throw std::runtime_error("Invalid sample type");
+        }
+
+        // Read the input in its native sample type, so that the scaling kernel performs the only conversion
+        scalingKernel = getScalingKernel(inputSampleType);
+        inputSampleSize = getSampleSize(inputSampleType);
+        if (packetMode)
+        {
+            // Packets are scaled straight from their raw data, which must already hold the values
+            if (inputDataDescriptor.getPostScaling().assigned())
+                throw std::runtime_error("Post scaling is not supported in packet mode");
+            const auto valueRule = inputDataDescriptor.getRule();
+            if (valueRule.assigned() && valueRule.getType() != DataRuleType::Explicit)
+                throw std::runtime_error("Implicit value rules are not supported in packet mode");
+        }
+        else if (reader.getValueReadType() != inputSampleType)
+        {
+            // Arrivals are marked from the sending thread, which reads the pending samples of the reader
+            auto ingressLock = trace.lockIngress();
+            reader = StreamReaderFromExisting(reader, inputSampleType, SampleType::UInt64);
+            reader.setOnDataAvailable(
+                [this]
+                {
+                    markIngress(trace, reader);
+                    dispatcher.dataAvailable();
+                });
+        }
+
+        // Accept only synchronous (linear implicit) domain signals
+        const SizeT domainDelta = validateLinearDomain(inputDomainDataDescriptor);
+        const double sampleRate = getLinearSampleRate(inputDomainDataDescriptor);
+
+        designStage.start(filter, filterSpec, sampleRate);
+
+        scaling.reset();
+        scaling.apply([this](const ScalingParameters& params) { updateOutputDescriptor(params); });
+        outputDomainSignal.setDescriptor(inputDomainDataDescriptor);
+
+        inputReader.setDomainDelta(domainDelta);
+
+        setComponentStatus(ComponentStatus::Ok);
+        configValid = true;
+        updateMemoryUsage();
+    }
+    catch (const std::exception& e)
+    {
+        setComponentStatusWithMessage(ComponentStatus::Error, e.what());
+        outputSignal.setDescriptor(nullptr);
+        configValid = false;
+        throw;
+    }
+}
+
+void ScaledFilterFBImpl::calculate()
+{
+    auto lock = this->getAcquisitionLock();
+
+    // Sized for the current read type; a descriptor change that changes it ends the call
+    const auto inputData = ScratchArena::local().acquire(readBlockSize * getSampleSize(reader.getValueReadType()));
+    inputReader.readBlocks(
+        reader,
+        inputData.get(),
+        configValid,
+        [this](const void* data, SizeT samples, SizeT domainOffset, uint64_t inputPosition)
+        { processData(data, samples, domainOffset, inputPosition); },
+        [this](const EventPacketPtr& packet) { processEventPacket(packet); });
+}
+
+// Each tile is scaled into the output and filtered in place while it is in L1. With a worker pool the
+// tiles are read blocks, which the pool splits into segments.
+void ScaledFilterFBImpl::scaleAndFilter(const void* inputData, double* outputData, SizeT count, const ScalingParameters& params)
+{
+    const auto input = static_cast<const uint8_t*>(inputData);
+    const SizeT tileSize = workerPool ? readBlockSize : SosFilter::TileSize;
+
+    if (!crossfade.isActive())
+    {
+        for (SizeT done = 0; done < count; done += tileSize)
+        {
+            const SizeT tileCount = std::min(count - done, tileSize);
+            scalingKernel(input + done * inputSampleSize, outputData + done, tileCount, params.scale, params.offset);
+            filter.process(outputData + done, outputData + done, tileCount);
+        }
+        return;
+    }
+
+    // The outgoing filter needs the scaled input, which is filtered in place
+    const auto scaledCopy = ScratchArena::local().acquire(std::min(count, tileSize) * sizeof(double));
+    for (SizeT done = 0; done < count; done += tileSize)
+    {
+        const SizeT tileCount = std::min(count - done, tileSize);
+        scalingKernel(input + done * inputSampleSize, outputData + done, tileCount, params.scale, params.offset);
+        std::copy_n(outputData + done, tileCount, scaledCopy.get<double>());
+        filter.process(outputData + done, outputData + done, tileCount);
+        crossfade.apply(scaledCopy.get<double>(), outputData + done, tileCount);
+    }
+}
+
+void ScaledFilterFBImpl::processData(const void* inputData, SizeT readAmount, SizeT packetOffset, uint64_t inputPosition)
+{
+    if (readAmount == 0)
+        return;
+
+    designStage.apply(filter, crossfade);
+    const auto& params = scaling.apply([this](const ScalingParameters& p) { updateOutputDescriptor(p); });
+
+    const auto outputDomainPacket = DataPacket(inputDomainDataDescriptor, readAmount, packetOffset);
+    DataPacketPtr outputPacket;
+    {
+        TraceScope computeSpan(trace, TraceSpan::Compute, static_cast<int64_t>(packetOffset), readAmount);
+        outputPacket = outputPacketPool.createPacket(outputDomainPacket, readAmount);
+        scaleAndFilter(inputData, static_cast<double*>(outputPacket.getRawData()), readAmount, params);
+    }
+
+    TraceScope sendSpan(trace, TraceSpan::Send, static_cast<int64_t>(packetOffset), readAmount);
+    sendSpan.setInputPosition(inputPosition);
+    outputSignal.sendPacket(outputPacket);
+    outputDomainSignal.sendPacket(outputDomainPacket);
+}
+
+void ScaledFilterFBImpl::onPacketReceived(const InputPortPtr& /*port*/)
+{
+    markQueuedIngress(trace, inputPort);
+    dispatcher.dataAvailable();
+}
+
+void ScaledFilterFBImpl::processQueuedPackets()
+{
+    auto lock = this->getAcquisitionLock();
+
+    inputReader.readPackets(
+        inputPort,
+        configValid,
+        [this](const DataPacketPtr& packet, uint64_t inputPosition) { processDataPacket(packet, inputPosition); },
+        [this](const EventPacketPtr& packet) { processEventPacket(packet); });
+}
+
+// Scales and filters the input packet's raw data into the output packet and forwards its domain packet unchanged
+void ScaledFilterFBImpl::processDataPacket(const DataPacketPtr& packet, uint64_t inputPosition)
+{
+    const auto sampleCount = packet.getSampleCount();
+    if (sampleCount == 0)
+        return;
+
+    designStage.apply(filter, crossfade);
+    const auto& params = scaling.apply([this](const ScalingParameters& p) { updateOutputDescriptor(p); });
+
+    const auto domainPacket = packet.getDomainPacket();
+    const auto packetOffset = domainPacket.assigned() && domainPacket.getOffset().assigned() ? domainPacket.getOffset().getIntValue() : 0;
+    DataPacketPtr outputPacket;
+    {
+        TraceScope computeSpan(trace, TraceSpan::Compute, packetOffset, sampleCount);
+        outputPacket = outputPacketPool.createPacket(domainPacket, sampleCount);
+        scaleAndFilter(packet.getRawData(), static_cast<double*>(outputPacket.getRawData()), sampleCount, params);
+    }
+
+    TraceScope sendSpan(trace, TraceSpan::Send, packetOffset, sampleCount);
+    sendSpan.setInputPosition(inputPosition);
+    outputSignal.sendPacket(outputPacket);
+    if (domainPacket.assigned())
+        outputDomainSignal.sendPacket(domainPacket);
+}
+
+void ScaledFilterFBImpl::processEventPacket(const EventPacketPtr& packet)
+{
+    TraceScope eventSpan(trace, TraceSpan::Event);
+    statistics.recordEvent();
+    if (packet.getEventId() == event_packet_id::DATA_DESCRIPTOR_CHANGED)
+    {
+        DataDescriptorPtr dataDesc = packet.getParameters().get(event_packet_param::DATA_DESCRIPTOR);
+        DataDescriptorPtr domainDesc = packet.getParameters().get(event_packet_param::DOMAIN_DATA_DESCRIPTOR);
+        processSignalDescriptorChanged(dataDesc, domainDesc);
+    }
+}
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,85 @@
+#include <example_module/property_updates.h>
+#include <example_module/scaling_properties.h>
+#include <opendaq/data_descriptor_ptr.h>
+#include <algorithm>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+void addScalingProperties(PropertyObjectPtr& objPtr, const std::function<void()>& onChanged)
+{
+    const auto scaleProp = FloatProperty("Scale", 1.0);
+    objPtr.addProperty(scaleProp);
+
+    const auto offsetProp = FloatProperty("Offset", 0.0);
+    objPtr.addProperty(offsetProp);
+
+    const auto useCustomOutputRangeProp = BoolProperty("UseCustomOutputRange", False);
+    objPtr.addProperty(useCustomOutputRangeProp);
+
+    const auto customHighValueProp = FloatProperty("OutputHighValue", 10.0, EvalValue("$UseCustomOutputRange"));
+    objPtr.addProperty(customHighValueProp);
+
+    const auto customLowValueProp = FloatProperty("OutputLowValue", -10.0, EvalValue("$UseCustomOutputRange"));
+    objPtr.addProperty(customLowValueProp);
+
+    const auto outputNameProp = StringProperty("OutputName", "");
+    objPtr.addProperty(outputNameProp);
+
+    const auto outputUnitProp = StringProperty("OutputUnit", "");
+    objPtr.addProperty(outputUnitProp);
+
+    observeProperties(objPtr,
+                      {"Scale", "Offset", "UseCustomOutputRange", "OutputHighValue", "OutputLowValue", "OutputName", "OutputUnit"},
+                      onChanged);
+}
+
+ScalingParameters readScalingProperties(const PropertyObjectPtr& objPtr)
+{
+    ScalingParameters params;
+    params.scale = objPtr.getPropertyValue("Scale");
+    params.offset = objPtr.getPropertyValue("Offset");
+    params.useCustomOutputRange = objPtr.getPropertyValue("UseCustomOutputRange");
+    params.outputHighValue = objPtr.getPropertyValue("OutputHighValue");
+    params.outputLowValue = objPtr.getPropertyValue("OutputLowValue");
+    params.outputUnit = static_cast<std::string>(objPtr.getPropertyValue("OutputUnit"));
+    params.outputName = static_cast<std::string>(objPtr.getPropertyValue("OutputName"));
+    return params;
+}
+
+bool sameOutputDescriptor(const ScalingParameters& a, const ScalingParameters& b)
+{
+    if (a.useCustomOutputRange != b.useCustomOutputRange || a.outputUnit != b.outputUnit || a.outputName != b.outputName)
+        return false;
+
+    if (a.useCustomOutputRange)
+        return a.outputHighValue == b.outputHighValue && a.outputLowValue == b.outputLowValue;
+    return a.scale == b.scale && a.offset == b.offset;
+}
+
+DataDescriptorPtr buildScaledOutputDescriptor(const ScalingParameters& params, const DataDescriptorPtr& inputDataDescriptor)
+{
+    RangePtr outputRange;
+    if (params.useCustomOutputRange)
+    {
+        outputRange = Range(params.outputLowValue, params.outputHighValue);
+    }
+    else
+    {
+        auto outputHigh = params.scale * static_cast<Float>(inputDataDescriptor.getValueRange().getLowValue()) + params.offset;
+        auto outputLow = params.scale * static_cast<Float>(inputDataDescriptor.getValueRange().getHighValue()) + params.offset;
+        if (outputLow > outputHigh)
+            std::swap(outputLow, outputHigh);
+
+        outputRange = Range(outputLow, outputHigh);
+    }
+
+    const auto unit = params.outputUnit.empty() ? inputDataDescriptor.getUnit() : Unit(params.outputUnit);
+    return DataDescriptorBuilder().setSampleType(SampleType::Float64).setValueRange(outputRange).setUnit(unit).build();
+}
+
+std::string getScaledOutputName(const ScalingParameters& params, const InputPortPtr& inputPort, const std::string& suffix)
+{
+    return params.outputName.empty() ? inputPort.getSignal().getName().toStdString() + suffix : params.outputName;
+}
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,252 @@
+#include <example_module/property_updates.h>
+#include <example_module/statistics_fb.h>
+#include <opendaq/data_descriptor_ptr.h>
+#include <opendaq/event_packet_params.h>
+#include <opendaq/input_port_factory.h>
+#include <opendaq/signal_factory.h>
+#include <cmath>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+StatisticsFBImpl::StatisticsFBImpl(const ContextPtr& context,
+                                   const ComponentPtr& parent,
+                                   const StringPtr& localId,
+                                   const PropertyObjectPtr& /*config*/)
+    : FunctionBlock(CreateType(), context, parent, localId)
+{
+    initComponentStatus();
+    createInputPorts();
+    createSignals();
+    initProperties();
+}
+
+FunctionBlockTypePtr StatisticsFBImpl::CreateType()
+{
+    return FunctionBlockType("ExampleStatistics",
+                             "Statistics",
+                             "Minimum, maximum, mean, RMS and standard deviation over sliding windows",
+                             PropertyObject());
+}
+
+void StatisticsFBImpl::createInputPorts()
+{
+    inputPort = createAndAddInputPort("Input", PacketReadyNotification::Scheduler);
+    reader = StreamReaderFromPort(inputPort, SampleType::Float64, SampleType::UInt64);
+    reader.setOnDataAvailable([this] { calculate(); });
+
+    // Also used while configValid is false, when the read samples are discarded
+    inputData.resize(ReadBlockSize);
+}
+
+void StatisticsFBImpl::createSignals()
+{
+    minSignal = createAndAddSignal("Min");
+    maxSignal = createAndAddSignal("Max");
+    meanSignal = createAndAddSignal("Mean");
+    rmsSignal = createAndAddSignal("RMS");
+    stdDevSignal = createAndAddSignal("StdDev");
+    outputDomainSignal = createAndAddSignal("StatisticsTime", nullptr, false);
+
+    minSignal.setDomainSignal(outputDomainSignal);
+    maxSignal.setDomainSignal(outputDomainSignal);
+    meanSignal.setDomainSignal(outputDomainSignal);
+    rmsSignal.setDomainSignal(outputDomainSignal);
+    stdDevSignal.setDomainSignal(outputDomainSignal);
+}
+
+void StatisticsFBImpl::initProperties()
+{
+    // Length of a window in seconds, rounded to whole samples
+    const auto windowProp = FloatPropertyBuilder("WindowDuration", 1.0).setMinValue(0.0).build();
+    objPtr.addProperty(windowProp);
+
+    // Time between the starts of two windows in seconds; windows overlap if it is shorter than the window
+    const auto hopProp = FloatPropertyBuilder("HopDuration", 1.0).setMinValue(0.0).build();
+    objPtr.addProperty(hopProp);
+
+    observeProperties(objPtr, {"WindowDuration", "HopDuration"}, [this] { propertyChanged(); });
+
+    readProperties();
+}
+
+// Throws std::invalid_argument unless 0 < HopDuration <= WindowDuration, which rejects the property write
+void StatisticsFBImpl::readProperties()
+{
+    const double window = objPtr.getPropertyValue("WindowDuration");
+    const double hop = objPtr.getPropertyValue("HopDuration");
+    if (!(window > 0.0))
+        throw std::invalid_argument("The window duration must be positive");
+    if (!(hop > 0.0) || hop > window)
+        throw std::invalid_argument("The hop duration must be positive and at most the window duration");
+
+    windowDuration = window;
+    hopDuration = hop;
+}
+
+void StatisticsFBImpl::propertyChanged()
+{
+    auto lock = this->getAcquisitionLock();
+
+    readProperties();
+    if (inputDomainDataDescriptor.assigned())
+        configure();
+}
+
+void StatisticsFBImpl::configure()
+{
+    try
+    {
+        if (!inputDomainDataDescriptor.assigned() || inputDomainDataDescriptor == NullDataDescriptor())
+            throw std::runtime_error("No domain input");
+
+        if (!inputDataDescriptor.assigned() || inputDataDescriptor == NullDataDescriptor())
+            throw std::runtime_error("No value input");
+
+        if (inputDataDescriptor.getDimensions().getCount() > 0)
+            throw std::runtime_error("Arrays not supported");
+
+        validateValueSampleType(inputDataDescriptor.getSampleType());
+        const SizeT domainDelta = validateLinearDomain(inputDomainDataDescriptor);
+        const double sampleRate = getLinearSampleRate(inputDomainDataDescriptor);
+
+        // Rounding keeps the hop at most the window
+        const auto windowSize = static_cast<SizeT>(std::max(std::llround(windowDuration * sampleRate), 1LL));
+        const auto hopSize = static_cast<SizeT>(std::max(std::llround(hopDuration * sampleRate), 1LL));
+        statistics.configure(windowSize, hopSize);
+        streamStarted = false;
+
+        const Int delta = static_cast<Int>(domainDelta);
+        const Int start = inputDomainDataDescriptor.getRule().getParameters().get("start");
+        domainOffsets.setDelta(domainDelta);
+
+        const auto buildDescriptor = [this](const std::string& name, const RangePtr& range)
+        {
+            auto builder = DataDescriptorBuilder().setSampleType(SampleType::Float64).setName(name).setUnit(inputDataDescriptor.getUnit());
+            if (range.assigned())
+                builder.setValueRange(range);
+            return builder.build();
+        };
+
+        // The RMS is at most the largest magnitude, the standard deviation at most half the range
+        RangePtr inputRange = inputDataDescriptor.getValueRange();
+        RangePtr rmsRange;
+        RangePtr stdDevRange;
+        if (inputRange.assigned())
+        {
+            const double low = inputRange.getLowValue();
+            const double high = inputRange.getHighValue();
+            rmsRange = Range(0.0, std::max(std::abs(low), std::abs(high)));
+            stdDevRange = Range(0.0, (high - low) / 2.0);
+        }
+
+        minDataDescriptor = buildDescriptor("Min", inputRange);
+        maxDataDescriptor = buildDescriptor("Max", inputRange);
+        meanDataDescriptor = buildDescriptor("Mean", inputRange);
+        rmsDataDescriptor = buildDescriptor("RMS", rmsRange);
+        stdDevDataDescriptor = buildDescriptor("StdDev", stdDevRange);
+        // Same tick resolution, origin and rule start as the input, one hop per window
+        outputDomainDataDescriptor = DataDescriptorBuilderCopy(inputDomainDataDescriptor)
+                                         .setRule(LinearDataRule(static_cast<Int>(hopSize) * delta, start))
+                                         .build();
+
+        minSignal.setDescriptor(minDataDescriptor);
+        maxSignal.setDescriptor(maxDataDescriptor);
+        meanSignal.setDescriptor(meanDataDescriptor);
+        rmsSignal.setDescriptor(rmsDataDescriptor);
+        stdDevSignal.setDescriptor(stdDevDataDescriptor);
+        outputDomainSignal.setDescriptor(outputDomainDataDescriptor);
+
+        setComponentStatus(ComponentStatus::Ok);
+        configValid = true;
+    }
+    catch (const std::exception& e)
+    {
+        setComponentStatusWithMessage(ComponentStatus::Error, e.what());
+        clearDescriptors();
+        configValid = false;
+        throw;
+    }
+}
+
+void StatisticsFBImpl::clearDescriptors()
+{
+    minSignal.setDescriptor(nullptr);
+    maxSignal.setDescriptor(nullptr);
+    meanSignal.setDescriptor(nullptr);
+    rmsSignal.setDescriptor(nullptr);
+    stdDevSignal.setDescriptor(nullptr);
+}
+
+void StatisticsFBImpl::calculate()
+{
+    auto lock = this->getAcquisitionLock();
+
+    readUntilEvent(
+        reader,
+        inputData.data(),
+        ReadBlockSize,
+        [this](const ReaderStatusPtr& status, SizeT readAmount)
+        {
+            if (configValid)
+                processData(readAmount, domainOffsets.next(status, readAmount));
+        },
+        [this](const EventPacketPtr& packet) { processEventPacket(packet); });
+}
+
+void StatisticsFBImpl::processEventPacket(const EventPacketPtr& packet)
+{
+    if (packet.getEventId() == event_packet_id::DATA_DESCRIPTOR_CHANGED)
+    {
+        DataDescriptorPtr dataDesc = packet.getParameters().get(event_packet_param::DATA_DESCRIPTOR);
+        DataDescriptorPtr domainDesc = packet.getParameters().get(event_packet_param::DOMAIN_DATA_DESCRIPTOR);
+        if (dataDesc.assigned())
+            inputDataDescriptor = dataDesc;
+        if (domainDesc.assigned())
+            inputDomainDataDescriptor = domainDesc;
+
+        configure();
+    }
+}
+
+void StatisticsFBImpl::processData(SizeT readAmount, SizeT packetOffset)
+{
+    if (readAmount == 0)
+        return;
+
+    if (!streamStarted)
+    {
+        streamStarted = true;
+        streamStartOffset = packetOffset;
+    }
+
+    windowResults.clear();
+    statistics.process(inputData.data(), readAmount, [this](const WindowResult& result) { windowResults.push_back(result); });
+    if (windowResults.empty())
+        return;
+
+    // The windows of a block are one hop apart, so one linear domain packet covers them
+    const SizeT firstWindowOffset = streamStartOffset + windowResults.front().startIndex * domainOffsets.getDelta();
+    const auto outputDomainPacket = DataPacket(outputDomainDataDescriptor, windowResults.size(), firstWindowOffset);
+
+    sendStatistic(minSignal, minDataDescriptor, outputDomainPacket, &WindowResult::min);
+    sendStatistic(maxSignal, maxDataDescriptor, outputDomainPacket, &WindowResult::max);
+    sendStatistic(meanSignal, meanDataDescriptor, outputDomainPacket, &WindowResult::mean);
+    sendStatistic(rmsSignal, rmsDataDescriptor, outputDomainPacket, &WindowResult::rms);
+    sendStatistic(stdDevSignal, stdDevDataDescriptor, outputDomainPacket, &WindowResult::stdDev);
+    outputDomainSignal.sendPacket(outputDomainPacket);
+}
+
+void StatisticsFBImpl::sendStatistic(const SignalConfigPtr& signal,
+                                     const DataDescriptorPtr& descriptor,
+                                     const DataPacketPtr& domainPacket,
+                                     double WindowResult::*statistic)
+{
+    const auto packet = DataPacketWithDomain(domainPacket, descriptor, windowResults.size());
+    auto* values = static_cast<double*>(packet.getRawData());
+    for (SizeT i = 0; i < windowResults.size(); ++i)
+        values[i] = windowResults[i].*statistic;
+
+    signal.sendPacket(packet);
+}
+
+END_NAMESPACE_EXAMPLE_MODULE
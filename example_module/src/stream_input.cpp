@@ -0,0 +1,45 @@
+#include <example_module/stream_input.h>
+#include <opendaq/data_descriptor_ptr.h>
+#include <string>
+
+BEGIN_NAMESPACE_EXAMPLE_MODULE
+
+void validateValueSampleType(SampleType sampleType)
+{
+    if (sampleType != SampleType::Float64 &&
+        sampleType != SampleType::Float32 &&
+        sampleType != SampleType::Int8 &&
+        sampleType != SampleType::Int16 &&
+        sampleType != SampleType::Int32 &&
+        sampleType != SampleType::Int64 &&
+        sampleType != SampleType::UInt8 &&
+        sampleType != SampleType::UInt16 &&
+        sampleType != SampleType::UInt32 &&
+        sampleType != SampleType::UInt64)
+    {
+        throw std::runtime_error("Invalid sample type");
+    }
+}
+
+SizeT validateLinearDomain(const DataDescriptorPtr& domainDescriptor)
+{
+    if (domainDescriptor.getSampleType() != SampleType::Int64 && domainDescriptor.getSampleType() != SampleType::UInt64)
+        throw std::runtime_error("Incompatible domain data sample type");
+
+    const auto domainRule = domainDescriptor.getRule();
+    if (!domainRule.assigned() || domainRule.getType() != DataRuleType::Linear)
+        throw std::runtime_error("Domain must have linear rule");
+
+    const Int delta = domainRule.getParameters().get("delta");
+    return static_cast<SizeT>(delta);
+}
+
+double getLinearSampleRate(const DataDescriptorPtr& domainDescriptor)
+{
+    const double sampleRate = static_cast<double>(reader::getSampleRate(domainDescriptor));
+    if (sampleRate <= 0.0)
+        throw std::runtime_error("Invalid sampleRate: " + std::to_string(sampleRate));
+    return sampleRate;
+}
+
+END_NAMESPACE_EXAMPLE_MODULE
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <example_module/block_policy.h>
+#include <example_module/deadline_timer.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace daq;
+using namespace daq::modules::example_module;
+using namespace std::chrono_literals;
+
+using BlockPolicyTest = testing::Test;
+using DeadlineTimerTest = testing::Test;
+
+TEST_F(BlockPolicyTest, DefaultReadsEverything)
+{
+    BlockPolicy policy;
+    const auto now = BlockPolicy::Clock::now();
+    ASSERT_EQ(policy.getReadAmount(1, now), 1u);
+    ASSERT_EQ(policy.getReadAmount(100000, now), 100000u);
+    ASSERT_EQ(policy.getReadAmount(0, now), 0u);
+}
+
+TEST_F(BlockPolicyTest, MaximumSplitsBlocks)
+{
+    BlockPolicy policy;
+    policy.setLimits(1, 256, 0ms);
+    ASSERT_EQ(policy.getReadAmount(1000, BlockPolicy::Clock::now()), 256u);
+}
+
+TEST_F(BlockPolicyTest, HoldsPartialBlocksUntilDeadline)
+{
+    BlockPolicy policy;
+    policy.setLimits(100, 1000, 10ms);
+
+    const auto start = BlockPolicy::Clock::now();
+    ASSERT_EQ(policy.getReadAmount(10, start), 0u);
+    ASSERT_EQ(policy.getDeadline(), start + 10ms);
+
+    // The hold time counts from the first held call, not from the latest one
+    ASSERT_EQ(policy.getReadAmount(20, start + 5ms), 0u);
+    ASSERT_EQ(policy.getDeadline(), start + 10ms);
+    ASSERT_EQ(policy.getReadAmount(30, start + 10ms), 30u);
+
+    // A new partial block starts a new hold
+    ASSERT_EQ(policy.getReadAmount(10, start + 11ms), 0u);
+    ASSERT_EQ(policy.getDeadline(), start + 21ms);
+}
+
+TEST_F(BlockPolicyTest, FullBlockEndsHold)
+{
+    BlockPolicy policy;
+    policy.setLimits(100, 1000, 10ms);
+
+    const auto start = BlockPolicy::Clock::now();
+    ASSERT_EQ(policy.getReadAmount(10, start), 0u);
+    ASSERT_EQ(policy.getReadAmount(150, start + 1ms), 150u);
+    ASSERT_EQ(policy.getReadAmount(10, start + 2ms), 0u);
+    ASSERT_EQ(policy.getDeadline(), start + 12ms);
+}
+
+TEST_F(BlockPolicyTest, MinimumIsClampedToMaximum)
+{
+    BlockPolicy policy;
+    policy.setLimits(5000, 1000, 10ms);
+    ASSERT_EQ(policy.getMinSamples(), 1000u);
+    ASSERT_EQ(policy.getReadAmount(1000, BlockPolicy::Clock::now()), 1000u);
+}
+
+TEST_F(DeadlineTimerTest, CallsAtDeadline)
+{
+    std::atomic<int> calls{0};
+    DeadlineTimer timer([&calls] { ++calls; });
+
+    const auto start = DeadlineTimer::Clock::now();
+    timer.schedule(start + 20ms);
+    while (calls == 0 && DeadlineTimer::Clock::now() - start < 5s)
+        std::this_thread::sleep_for(1ms);
+
+    ASSERT_EQ(calls, 1);
+    ASSERT_GE(DeadlineTimer::Clock::now() - start, 20ms);
+}
+
+TEST_F(DeadlineTimerTest, PendingCallIsNotRepeated)
+{
+    std::atomic<int> calls{0};
+    DeadlineTimer timer([&calls] { ++calls; });
+
+    const auto deadline = DeadlineTimer::Clock::now() + 10ms;
+    timer.schedule(deadline);
+    timer.schedule(deadline);
+    timer.schedule(deadline + 1ms);
+    std::this_thread::sleep_for(100ms);
+    ASSERT_EQ(calls, 1);
+
+    // Once called, the timer can be scheduled again
+    timer.schedule(DeadlineTimer::Clock::now());
+    std::this_thread::sleep_for(100ms);
+    ASSERT_EQ(calls, 2);
+}
+
+TEST_F(DeadlineTimerTest, DestroyedTimerIsNotCalled)
+{
+    std::atomic<int> calls{0};
+    {
+        DeadlineTimer timer([&calls] { ++calls; });
+        timer.schedule(DeadlineTimer::Clock::now() + 20ms);
+    }
+    std::this_thread::sleep_for(100ms);
+    ASSERT_EQ(calls, 0);
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include "test_signals.h"
+#include <example_module/filter_design.h>
+#include <example_module/filter_design_cache.h>
+#include <example_module/sos_crossfade.h>
+#include <example_module/sos_filter.h>
+#include <vector>
+
+using namespace daq;
+using namespace daq::modules::example_module;
+using test_signals::createNoise;
+
+using CoefficientSwapTest = testing::Test;
+
+namespace
+{
+    constexpr double SampleRate = 1000.0;
+
+    FilterSpec createSpec(double cutoff, SizeT order = 4)
+    {
+        FilterSpec spec;
+        spec.order = order;
+        spec.sampleRate = SampleRate;
+        spec.cutoffFrequency = cutoff;
+        return spec;
+    }
+}
+
+TEST_F(CoefficientSwapTest, UpdateSectionsKeepsState)
+{
+    const auto sections = designSosFilter(createSpec(20.0));
+    const auto input = createNoise(2000, 1);
+
+    SosFilter reference(sections);
+    std::vector<double> expected(input.size());
+    reference.process(input.data(), expected.data(), input.size());
+
+    // Swapping in the same design midway must not change the output
+    SosFilter swapped(sections);
+    std::vector<double> actual(input.size());
+    swapped.process(input.data(), actual.data(), 1000);
+    swapped.updateSections(sections);
+    swapped.process(input.data() + 1000, actual.data() + 1000, 1000);
+
+    ASSERT_EQ(actual, expected);
+}
+
+TEST_F(CoefficientSwapTest, UpdateSectionsClearsStateOfOtherOrder)
+{
+    SosFilter filter(designSosFilter(createSpec(20.0, 4)));
+    const std::vector<double> ones(500, 1.0);
+    std::vector<double> output(ones.size());
+    filter.process(ones.data(), output.data(), ones.size());
+
+    const auto sections = designSosFilter(createSpec(20.0, 6));
+    filter.updateSections(sections);
+    ASSERT_EQ(filter.getStates().size(), sections.size());
+    for (const auto& state : filter.getStates())
+    {
+        ASSERT_EQ(state.s1, 0.0);
+        ASSERT_EQ(state.s2, 0.0);
+    }
+}
+
+TEST_F(CoefficientSwapTest, CrossfadeBlendsFromOldToNewFilter)
+{
+    const auto oldSections = designSosFilter(createSpec(20.0));
+    const auto newSections = designSosFilter(createSpec(100.0));
+    const auto input = createNoise(3000, 2);
+    const SizeT swapAt = 1000;
+    const SizeT fadeLength = 700;
+
+    // Outputs of the old filter running on, and of the new filter continuing from the old state
+    SosFilter oldFilter(oldSections);
+    std::vector<double> oldOutput(input.size());
+    oldFilter.process(input.data(), oldOutput.data(), input.size());
+
+    SosFilter filter(oldSections);
+    std::vector<double> output(input.size());
+    filter.process(input.data(), output.data(), swapAt);
+
+    SosCrossfade crossfade;
+    crossfade.start(filter.getSections(), filter.getStates(), fadeLength);
+    filter.updateSections(newSections);
+
+    SosFilter newFilter(newSections);
+    newFilter.setStates(filter.getStates());
+    std::vector<double> newOutput(input.size());
+    newFilter.process(input.data() + swapAt, newOutput.data() + swapAt, input.size() - swapAt);
+
+    // Blocks that do not align with the crossfade length
+    for (SizeT position = swapAt; position < input.size(); position += 333)
+    {
+        const SizeT count = std::min<SizeT>(333, input.size() - position);
+        filter.process(input.data() + position, output.data() + position, count);
+        crossfade.apply(input.data() + position, output.data() + position, count);
+    }
+    ASSERT_FALSE(crossfade.isActive());
+
+    for (SizeT i = swapAt; i < input.size(); ++i)
+    {
+        const SizeT faded = i - swapAt + 1;
+        const double weight = faded <= fadeLength ? static_cast<double>(faded) / static_cast<double>(fadeLength + 1) : 1.0;
+        ASSERT_NEAR(output[i], oldOutput[i] + weight * (newOutput[i] - oldOutput[i]), 1e-12) << "at sample " << i;
+    }
+}
+
+TEST_F(CoefficientSwapTest, CacheReturnsSharedDesign)
+{
+    FilterDesignCache cache;
+
+    const auto first = cache.get(createSpec(10.0));
+    const auto second = cache.get(createSpec(20.0));
+    const auto again = cache.get(createSpec(10.0));
+
+    ASSERT_EQ(first, again);
+    ASSERT_NE(first, second);
+    const auto designed = designSosFilter(createSpec(10.0));
+    ASSERT_EQ(first->size(), designed.size());
+    for (SizeT i = 0; i < designed.size(); ++i)
+    {
+        ASSERT_EQ((*first)[i].b0, designed[i].b0);
+        ASSERT_EQ((*first)[i].a1, designed[i].a1);
+        ASSERT_EQ((*first)[i].a2, designed[i].a2);
+    }
+    ASSERT_EQ(cache.getHitCount(), 1u);
+    ASSERT_EQ(cache.getMissCount(), 2u);
+
+    // The sample rate is part of the key
+    auto otherRate = createSpec(10.0);
+    otherRate.sampleRate = 2000.0;
+    ASSERT_NE(cache.get(otherRate), first);
+}
+
+TEST_F(CoefficientSwapTest, CacheEvictsLeastRecentlyUsed)
+{
+    FilterDesignCache cache(2);
+
+    const auto first = cache.get(createSpec(10.0));
+    cache.get(createSpec(20.0));
+    cache.get(createSpec(10.0));
+    cache.get(createSpec(30.0));
+    ASSERT_EQ(cache.getSize(), 2u);
+
+    // 20 Hz was evicted, 10 Hz is still cached
+    ASSERT_EQ(cache.get(createSpec(10.0)), first);
+    const SizeT misses = cache.getMissCount();
+    cache.get(createSpec(20.0));
+    ASSERT_EQ(cache.getMissCount(), misses + 1);
+}
+
+TEST_F(CoefficientSwapTest, CacheRethrowsInvalidDesigns)
+{
+    FilterDesignCache cache;
+    ASSERT_THROW(cache.get(createSpec(SampleRate)), std::invalid_argument);
+    ASSERT_EQ(cache.getSize(), 0u);
+}
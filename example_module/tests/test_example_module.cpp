@@ -1,12 +1,24 @@
 #include <gmock/gmock.h>
+#include <example_module/recording_format.h>
 #include <opendaq/data_descriptor_factory.h>
 #include <opendaq/opendaq.h>
 #include <testutils/testutils.h>
+#include <filesystem>
+#include <fstream>
 #include <thread>
 
 using namespace daq;
 using ExampleModuleTest = testing::Test;
 using ExampleIIRFilterTest = testing::Test;
+using ExampleFilterBankTest = testing::Test;
+using ExampleFIRFilterTest = testing::Test;
+using ExampleDecimatorTest = testing::Test;
+using ExampleGeneratorTest = testing::Test;
+using ExampleRecorderTest = testing::Test;
+using ExampleReplayTest = testing::Test;
+using ExampleScaledIIRFilterTest = testing::Test;
+using ExampleOperatorChainTest = testing::Test;
+using ExampleStatisticsTest = testing::Test;
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -22,7 +34,7 @@ TEST_F(ExampleModuleTest, TestPropCount)
 {
     const auto instance = Instance();
     auto fb = instance.addFunctionBlock("ExampleScalingModule");
-    ASSERT_EQ(fb.getAllProperties().getCount(), 7);
+    ASSERT_EQ(fb.getAllProperties().getCount(), 16);
 }
 
 TEST_F(ExampleModuleTest, TestDataScaling)
@@ -81,99 +93,1854 @@ TEST_F(ExampleModuleTest, TestDataScaling)
         ASSERT_EQ(static_cast<int>(readData[i]), i * 2);
 }
 
+TEST_F(ExampleModuleTest, TestDataScalingInt16)
+{
+    const auto instance = Instance();
+    auto fb = instance.addFunctionBlock("ExampleScalingModule");
+    fb.setPropertyValue("Scale", 0.5);
+    fb.setPropertyValue("Offset", 1.0);
+
+    auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Int16).setValueRange(Range(-32768, 32767)).build();
+    auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Data");
+
+    const auto domainDescriptor = DataDescriptorBuilder()
+                                      .setSampleType(SampleType::Int64)
+                                      .setUnit(Unit("s", -1, "seconds", "time"))
+                                      .setTickResolution(Ratio(1, 1000))
+                                      .setRule(LinearDataRule(1, 0))
+                                      .setOrigin("1970-01-01T01:00:00+00:00")
+                                      .build();
+    auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "DomainData");
+    signal.setDomainSignal(domainSignal);
+
+    fb.getInputPorts()[0].connect(signal);
+    auto streamReader = StreamReader(fb.getSignals()[0], SampleType::Float64, SampleType::Int64);
+
+    auto domainPacket = DataPacket(domainDescriptor, 10, 0);
+    auto packet = DataPacketWithDomain(domainPacket, dataDescriptor, 10);
+    int16_t* data = static_cast<int16_t*>(packet.getRawData());
+    for (auto i = 0; i < 10; i++)
+        data[i] = static_cast<int16_t>(i * 1000 - 5000);
+
+    signal.sendPacket(packet);
+    domainSignal.sendPacket(domainPacket);
+
+    SizeT count = 10;
+    std::vector<double> readData;
+    readData.resize(count);
+
+    auto status = streamReader.read(readData.data(), &count);
+    ASSERT_EQ(status.getReadStatus(), ReadStatus::Event);
+    ASSERT_EQ(count, 0);
+
+    while (count < 10)
+    {
+        using namespace std::chrono_literals;
+        count = streamReader.getAvailableCount();
+        std::this_thread::sleep_for(100ms);
+    }
+
+    status = streamReader.read(readData.data(), &count);
+    ASSERT_EQ(count, 10);
+    ASSERT_EQ(status.getReadStatus(), ReadStatus::Ok);
+
+    for (int i = 0; i < 10; i++)
+        ASSERT_DOUBLE_EQ(readData[i], 0.5 * (i * 1000 - 5000) + 1.0);
+}
+
+TEST_F(ExampleModuleTest, TestDataScalingFloat64Precision)
+{
+    const auto instance = Instance();
+    auto fb = instance.addFunctionBlock("ExampleScalingModule");
+    fb.setPropertyValue("Offset", -1e9);
+
+    auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).setValueRange(Range(0, 2e9)).build();
+    auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Data");
+
+    const auto domainDescriptor = DataDescriptorBuilder()
+                                      .setSampleType(SampleType::Int64)
+                                      .setUnit(Unit("s", -1, "seconds", "time"))
+                                      .setTickResolution(Ratio(1, 1000))
+                                      .setRule(LinearDataRule(1, 0))
+                                      .setOrigin("1970-01-01T01:00:00+00:00")
+                                      .build();
+    auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "DomainData");
+    signal.setDomainSignal(domainSignal);
+
+    fb.getInputPorts()[0].connect(signal);
+    auto streamReader = StreamReader(fb.getSignals()[0], SampleType::Float64, SampleType::Int64);
+
+    // Values that are not representable in Float32
+    auto domainPacket = DataPacket(domainDescriptor, 10, 0);
+    auto packet = DataPacketWithDomain(domainPacket, dataDescriptor, 10);
+    double* data = static_cast<double*>(packet.getRawData());
+    for (auto i = 0; i < 10; i++)
+        data[i] = 1e9 + i * 0.125;
+
+    signal.sendPacket(packet);
+    domainSignal.sendPacket(domainPacket);
+
+    SizeT count = 10;
+    std::vector<double> readData;
+    readData.resize(count);
+
+    auto status = streamReader.read(readData.data(), &count);
+    ASSERT_EQ(status.getReadStatus(), ReadStatus::Event);
+    ASSERT_EQ(count, 0);
+
+    while (count < 10)
+    {
+        using namespace std::chrono_literals;
+        count = streamReader.getAvailableCount();
+        std::this_thread::sleep_for(100ms);
+    }
+
+    status = streamReader.read(readData.data(), &count);
+    ASSERT_EQ(count, 10);
+    ASSERT_EQ(status.getReadStatus(), ReadStatus::Ok);
+
+    for (int i = 0; i < 10; i++)
+        ASSERT_DOUBLE_EQ(readData[i], i * 0.125);
+}
+
+TEST_F(ExampleModuleTest, TestDataScalingPacketMode)
+{
+    const auto instance = Instance();
+    auto config = instance.getAvailableFunctionBlockTypes().get("ExampleScalingModule").createDefaultConfig();
+    config.setPropertyValue("PacketMode", True);
+
+    auto fb = instance.addFunctionBlock("ExampleScalingModule", config);
+    fb.setPropertyValue("Scale", 2);
+
+    auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float32).setValueRange(Range(-10, 10)).build();
+    auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Data");
+
+    const auto domainDescriptor = DataDescriptorBuilder()
+                                      .setSampleType(SampleType::Int64)
+                                      .setUnit(Unit("s", -1, "seconds", "time"))
+                                      .setTickResolution(Ratio(1, 1000))
+                                      .setRule(LinearDataRule(1, 0))
+                                      .setOrigin("1970-01-01T01:00:00+00:00")
+                                      .build();
+    auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "DomainData");
+    signal.setDomainSignal(domainSignal);
+
+    fb.getInputPorts()[0].connect(signal);
+    auto streamReader = StreamReader(fb.getSignals()[0], SampleType::Float32, SampleType::Int64);
+
+    auto domainPacket = DataPacket(domainDescriptor, 10, 50);
+    auto packet = DataPacketWithDomain(domainPacket, dataDescriptor, 10);
+    float* data = static_cast<float*>(packet.getRawData());
+    for (auto i = 0; i < 10; i++)
+        data[i] = static_cast<float>(i);
+
+    signal.sendPacket(packet);
+    domainSignal.sendPacket(domainPacket);
+
+    SizeT count = 10;
+    std::vector<float> readData;
+    readData.resize(count);
+    std::vector<int64_t> readDomain;
+    readDomain.resize(count);
+
+    auto status = streamReader.read(readData.data(), &count);
+    ASSERT_EQ(status.getReadStatus(), ReadStatus::Event);
+    ASSERT_EQ(count, 0);
+
+    while (count < 10)
+    {
+        using namespace std::chrono_literals;
+        count = streamReader.getAvailableCount();
+        std::this_thread::sleep_for(100ms);
+    }
+
+    status = streamReader.readWithDomain(readData.data(), readDomain.data(), &count);
+    ASSERT_EQ(count, 10);
+    ASSERT_EQ(status.getReadStatus(), ReadStatus::Ok);
+
+    for (int i = 0; i < 10; i++)
+    {
+        ASSERT_EQ(static_cast<int>(readData[i]), i * 2);
+        ASSERT_EQ(readDomain[i], 50 + i);
+    }
+}
+
+// Property writes while streaming are picked up by the next block, together with the new output range
+TEST_F(ExampleModuleTest, TestScaleChangeWhileStreaming)
+{
+    const auto instance = Instance();
+    auto fb = instance.addFunctionBlock("ExampleScalingModule");
+    fb.setPropertyValue("Scale", 2);
+
+    auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).setValueRange(Range(-10, 10)).build();
+    auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Data");
+
+    const auto domainDescriptor = DataDescriptorBuilder()
+                                      .setSampleType(SampleType::Int64)
+                                      .setUnit(Unit("s", -1, "seconds", "time"))
+                                      .setTickResolution(Ratio(1, 1000))
+                                      .setRule(LinearDataRule(1, 0))
+                                      .setOrigin("1970-01-01T01:00:00+00:00")
+                                      .build();
+    auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "DomainData");
+    signal.setDomainSignal(domainSignal);
+
+    fb.getInputPorts()[0].connect(signal);
+    auto streamReader = StreamReader(fb.getSignals()[0], SampleType::Float64, SampleType::Int64);
+
+    const auto sendBlock = [&](Int offset)
+    {
+        auto domainPacket = DataPacket(domainDescriptor, 10, offset);
+        auto packet = DataPacketWithDomain(domainPacket, dataDescriptor, 10);
+        double* data = static_cast<double*>(packet.getRawData());
+        for (auto i = 0; i < 10; i++)
+            data[i] = static_cast<double>(i);
+
+        signal.sendPacket(packet);
+        domainSignal.sendPacket(domainPacket);
+    };
+
+    // Reads 10 samples, passing over descriptor changes
+    const auto readBlock = [&]()
+    {
+        std::vector<double> readData(10);
+        SizeT read = 0;
+        for (int retries = 0; read < 10 && retries < 50; ++retries)
+        {
+            using namespace std::chrono_literals;
+            SizeT count = 10 - read;
+            streamReader.read(readData.data() + read, &count);
+            read += count;
+            if (read < 10)
+                std::this_thread::sleep_for(100ms);
+        }
+        return readData;
+    };
+
+    sendBlock(0);
+    auto readData = readBlock();
+    for (int i = 0; i < 10; i++)
+        ASSERT_DOUBLE_EQ(readData[i], 2.0 * i);
+
+    fb.setPropertyValue("Scale", 3);
+    sendBlock(10);
+    readData = readBlock();
+    for (int i = 0; i < 10; i++)
+        ASSERT_DOUBLE_EQ(readData[i], 3.0 * i);
+
+    const auto range = fb.getSignals()[0].getDescriptor().getValueRange();
+    ASSERT_DOUBLE_EQ(static_cast<double>(range.getLowValue()), -30.0);
+    ASSERT_DOUBLE_EQ(static_cast<double>(range.getHighValue()), 30.0);
+}
+
+TEST_F(ExampleModuleTest, TestMaxBlockSamplesSplitsBlocks)
+{
+    const auto instance = Instance();
+    auto fb = instance.addFunctionBlock("ExampleScalingModule");
+    fb.setPropertyValue("Scale", 2);
+    fb.setPropertyValue("MaxBlockSamples", 4);
+
+    auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Int32).setValueRange(Range(-10, 10)).build();
+    auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Data");
+
+    const auto domainDescriptor = DataDescriptorBuilder()
+                                      .setSampleType(SampleType::Int64)
+                                      .setUnit(Unit("s", -1, "seconds", "time"))
+                                      .setTickResolution(Ratio(1, 1000000))
+                                      .setRule(LinearDataRule(1, 0))
+                                      .setOrigin("1970-01-01T01:00:00+00:00")
+                                      .build();
+    auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "DomainData");
+    signal.setDomainSignal(domainSignal);
+
+    fb.getInputPorts()[0].connect(signal);
+    auto streamReader = StreamReader(fb.getSignals()[0], SampleType::Float64, SampleType::Int64);
+
+    auto domainPacket = DataPacket(domainDescriptor, 10, 0);
+    auto packet = DataPacketWithDomain(domainPacket, dataDescriptor, 10);
+    int32_t* data = static_cast<int32_t*>(packet.getRawData());
+    for (auto i = 0; i < 10; i++)
+        data[i] = i;
+
+    signal.sendPacket(packet);
+    domainSignal.sendPacket(domainPacket);
+
+    // The read buffer follows the block size, not the 1 MHz sample rate
+    std::vector<double> readData(10);
+    SizeT read = 0;
+    for (int retries = 0; read < 10 && retries < 50; ++retries)
+    {
+        using namespace std::chrono_literals;
+        SizeT count = 10 - read;
+        streamReader.read(readData.data() + read, &count);
+        read += count;
+        if (read < 10)
+            std::this_thread::sleep_for(100ms);
+    }
+
+    ASSERT_EQ(read, 10u);
+    for (int i = 0; i < 10; i++)
+        ASSERT_DOUBLE_EQ(readData[i], 2.0 * i);
+    ASSERT_EQ(static_cast<Int>(fb.getPropertyValue("MemoryUsage")), 4 * static_cast<Int>(sizeof(int32_t)));
+
+    const PropertyObjectPtr statistics = fb.getPropertyValue("Statistics");
+    ASSERT_EQ(static_cast<Int>(statistics.getPropertyValue("SamplesIn")), 10);
+    ASSERT_EQ(static_cast<Int>(statistics.getPropertyValue("SamplesOut")), 10);
+    ASSERT_EQ(static_cast<Int>(statistics.getPropertyValue("Blocks")), 3);
+    ASSERT_EQ(static_cast<Int>(statistics.getPropertyValue("PacketsOut")), 3);
+    ASSERT_GE(static_cast<Int>(statistics.getPropertyValue("Events")), 1);
+    ASSERT_GE(static_cast<Int>(statistics.getPropertyValue("Reconfigurations")), 1);
+    ASSERT_GE(static_cast<Int>(statistics.getPropertyValue("MaxBacklog")), 10);
+
+    const ListPtr<IInteger> histogram = statistics.getPropertyValue("ProcessingTimeHistogram");
+    Int histogramBlocks = 0;
+    for (const Int count : histogram)
+        histogramBlocks += count;
+    ASSERT_EQ(histogramBlocks, 3);
+
+    const ProcedurePtr reset = statistics.getPropertyValue("Reset");
+    reset();
+    ASSERT_EQ(static_cast<Int>(statistics.getPropertyValue("SamplesIn")), 0);
+    ASSERT_EQ(static_cast<Int>(statistics.getPropertyValue("Blocks")), 0);
+}
+
+TEST_F(ExampleModuleTest, TestExecutionModes)
+{
+    for (const Int mode : {0, 1, 2})
+    {
+        const auto instance = Instance();
+        auto fb = instance.addFunctionBlock("ExampleScalingModule");
+        fb.setPropertyValue("Scale", 2);
+        fb.setPropertyValue("ExecutionMode", mode);
+
+        auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).setValueRange(Range(-10, 10)).build();
+        auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Data");
+
+        const auto domainDescriptor = DataDescriptorBuilder()
+                                          .setSampleType(SampleType::Int64)
+                                          .setUnit(Unit("s", -1, "seconds", "time"))
+                                          .setTickResolution(Ratio(1, 1000))
+                                          .setRule(LinearDataRule(1, 0))
+                                          .setOrigin("1970-01-01T01:00:00+00:00")
+                                          .build();
+        auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "DomainData");
+        signal.setDomainSignal(domainSignal);
+
+        fb.getInputPorts()[0].connect(signal);
+        auto streamReader = StreamReader(fb.getSignals()[0], SampleType::Float64, SampleType::Int64);
+
+        auto domainPacket = DataPacket(domainDescriptor, 10, 0);
+        auto packet = DataPacketWithDomain(domainPacket, dataDescriptor, 10);
+        double* data = static_cast<double*>(packet.getRawData());
+        for (auto i = 0; i < 10; i++)
+            data[i] = static_cast<double>(i);
+
+        signal.sendPacket(packet);
+        domainSignal.sendPacket(domainPacket);
+
+        std::vector<double> readData(10);
+        SizeT read = 0;
+        for (int retries = 0; read < 10 && retries < 50; ++retries)
+        {
+            using namespace std::chrono_literals;
+            SizeT count = 10 - read;
+            streamReader.read(readData.data() + read, &count);
+            read += count;
+
+            // Same-thread processing is done when sendPacket returns
+            if (mode == 1 && retries == 1)
+                ASSERT_EQ(read, 10u);
+            if (read < 10 && retries > 0)
+                std::this_thread::sleep_for(100ms);
+        }
+
+        ASSERT_EQ(read, 10u);
+        for (int i = 0; i < 10; i++)
+            ASSERT_DOUBLE_EQ(readData[i], 2.0 * i);
+    }
+}
+
+TEST_F(ExampleModuleTest, TestHeldBlockIsFlushedAfterHoldTime)
+{
+    const auto instance = Instance();
+    auto fb = instance.addFunctionBlock("ExampleScalingModule");
+    fb.setPropertyValue("Scale", 2);
+    fb.setPropertyValue("MinBlockSamples", 1000);
+    fb.setPropertyValue("MaxHoldTime", 50.0);
+
+    auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).setValueRange(Range(-10, 10)).build();
+    auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Data");
+
+    const auto domainDescriptor = DataDescriptorBuilder()
+                                      .setSampleType(SampleType::Int64)
+                                      .setUnit(Unit("s", -1, "seconds", "time"))
+                                      .setTickResolution(Ratio(1, 1000))
+                                      .setRule(LinearDataRule(1, 0))
+                                      .setOrigin("1970-01-01T01:00:00+00:00")
+                                      .build();
+    auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "DomainData");
+    signal.setDomainSignal(domainSignal);
+
+    fb.getInputPorts()[0].connect(signal);
+    auto streamReader = StreamReader(fb.getSignals()[0], SampleType::Float64, SampleType::Int64);
+
+    // Far fewer samples than the minimum block; no more samples follow
+    auto domainPacket = DataPacket(domainDescriptor, 10, 0);
+    auto packet = DataPacketWithDomain(domainPacket, dataDescriptor, 10);
+    double* data = static_cast<double*>(packet.getRawData());
+    for (auto i = 0; i < 10; i++)
+        data[i] = static_cast<double>(i);
+
+    signal.sendPacket(packet);
+    domainSignal.sendPacket(domainPacket);
+
+    std::vector<double> readData(10);
+    SizeT read = 0;
+    for (int retries = 0; read < 10 && retries < 50; ++retries)
+    {
+        using namespace std::chrono_literals;
+        SizeT count = 10 - read;
+        streamReader.read(readData.data() + read, &count);
+        read += count;
+        if (read < 10)
+            std::this_thread::sleep_for(100ms);
+    }
+
+    ASSERT_EQ(read, 10u);
+    for (int i = 0; i < 10; i++)
+        ASSERT_DOUBLE_EQ(readData[i], 2.0 * i);
+}
+
+TEST_F(ExampleModuleTest, TestTracing)
+{
+    const auto instance = Instance();
+    auto fb = instance.addFunctionBlock("ExampleScalingModule");
+    fb.setPropertyValue("Tracing", true);
+
+    auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).setValueRange(Range(-10, 10)).build();
+    auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Data");
+
+    const auto domainDescriptor = DataDescriptorBuilder()
+                                      .setSampleType(SampleType::Int64)
+                                      .setUnit(Unit("s", -1, "seconds", "time"))
+                                      .setTickResolution(Ratio(1, 1000))
+                                      .setRule(LinearDataRule(1, 0))
+                                      .setOrigin("1970-01-01T01:00:00+00:00")
+                                      .build();
+    auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "DomainData");
+    signal.setDomainSignal(domainSignal);
+
+    fb.getInputPorts()[0].connect(signal);
+    auto streamReader = StreamReader(fb.getSignals()[0], SampleType::Float64, SampleType::Int64);
+
+    auto domainPacket = DataPacket(domainDescriptor, 10, 1000);
+    auto packet = DataPacketWithDomain(domainPacket, dataDescriptor, 10);
+    double* data = static_cast<double*>(packet.getRawData());
+    for (auto i = 0; i < 10; i++)
+        data[i] = static_cast<double>(i);
+
+    signal.sendPacket(packet);
+    domainSignal.sendPacket(domainPacket);
+
+    std::vector<double> readData(10);
+    SizeT read = 0;
+    for (int retries = 0; read < 10 && retries < 50; ++retries)
+    {
+        using namespace std::chrono_literals;
+        SizeT count = 10 - read;
+        streamReader.read(readData.data() + read, &count);
+        read += count;
+        if (read < 10)
+            std::this_thread::sleep_for(100ms);
+    }
+    ASSERT_EQ(read, 10u);
+
+    const FunctionPtr dumpTrace = fb.getPropertyValue("DumpTrace");
+    const std::string trace = static_cast<StringPtr>(dumpTrace()).toStdString();
+    ASSERT_NE(trace.find(R"("name":"read")"), std::string::npos);
+    ASSERT_NE(trace.find(R"("name":"compute")"), std::string::npos);
+    ASSERT_NE(trace.find(R"("name":"send")"), std::string::npos);
+    ASSERT_NE(trace.find(R"("name":"event")"), std::string::npos);
+    ASSERT_NE(trace.find(R"("offset":1000,"samples":10,"latency_us":)"), std::string::npos);
+}
+
 // Test 1: Adding function block
 TEST_F(ExampleIIRFilterTest, CanAddFilter)
 {
     const auto instance = Instance();
-    ASSERT_TRUE(instance.addFunctionBlock("ExampleIIRFilter").assigned());
+    ASSERT_TRUE(instance.addFunctionBlock("ExampleIIRFilter").assigned());
+}
+
+// Test 2: Response of filter to step values 0 then 1
+TEST_F(ExampleIIRFilterTest, StepResponse)
+{
+    const auto instance = Instance();
+    const auto fb = instance.addFunctionBlock("ExampleIIRFilter");
+    fb.setPropertyValue("CutoffFrequency", 5);
+
+    const SizeT sampleCount = 200;
+
+    const auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).setValueRange(Range(0.0, 1.0)).build();
+
+    const auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "StepInput");
+
+    const auto domainDescriptor = DataDescriptorBuilder()
+                                      .setSampleType(SampleType::UInt64)
+                                      .setTickResolution(Ratio(1, 1000))
+                                      .setRule(LinearDataRule(1, 0))
+                                      .setOrigin("1970-01-01T01:00:00+00:00")
+                                      .build();
+
+    auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "Domain");
+    signal.setDomainSignal(domainSignal);
+
+    fb.getInputPorts()[0].connect(signal);
+
+    auto reader = StreamReader(fb.getSignals()[0], SampleType::Float64, SampleType::UInt64);
+
+    // Preparing data – 50 zero, 150 one
+    SizeT count = sampleCount;
+    auto domainPacket = DataPacket(domainDescriptor, count, 0);
+    auto dataPacket = DataPacketWithDomain(domainPacket, dataDescriptor, count);
+
+    double* raw = static_cast<double*>(dataPacket.getRawData());
+    for (auto i = 0; i < sampleCount; ++i)
+        raw[i] = i < 50 ? 0.0 : 1.0;
+
+    signal.sendPacket(dataPacket);
+    domainSignal.sendPacket(domainPacket);
+    std::vector<double> dummyReadData;
+    dummyReadData.resize(count);
+
+    auto status = reader.read(dummyReadData.data(), &count);
+    ASSERT_EQ(status.getReadStatus(), ReadStatus::Event);
+
+    int retries = 20;
+    SizeT availableCount = 0;
+    while (availableCount < sampleCount && retries-- > 0)
+    {
+        using namespace std::chrono_literals;
+        availableCount = reader.getAvailableCount();
+        std::this_thread::sleep_for(100ms);
+    }
+    ASSERT_GT(availableCount, 0);
+
+    std::vector<double> output(sampleCount);
+    std::vector<uint64_t> domain(sampleCount);
+    SizeT read = sampleCount;
+    status = reader.readWithDomain(output.data(), domain.data(), &read);
+
+    ASSERT_EQ(status.getReadStatus(), ReadStatus::Ok);
+    ASSERT_EQ(read, sampleCount);
+    ASSERT_NEAR(output.back(), 1.0, 0.05);
+
+    for (SizeT i = 51; i < read; ++i)
+        ASSERT_GE(output[i], output[i - 1]) << "Output is not monotonically increasing: y[" << i - 1 << "]=" << output[i - 1] << ", y[" << i
+                                            << "]=" << output[i];
+}
+
+// Test 3: Testing attenuation of high frequencies
+TEST_F(ExampleIIRFilterTest, AttenuatesHighFrequencies)
+{
+    const auto instance = Instance();
+    const auto fb = instance.addFunctionBlock("ExampleIIRFilter");
+    fb.setPropertyValue("CutoffFrequency", 5);
+
+    const SizeT sampleCount = 200;
+    const double samplingRate = 1000.0;
+    const double signalFrequency = 100.0;
+
+    const auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).setValueRange(Range(-10.0, 10.0)).build();
+
+    const auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "HighFreqInput");
+
+    const auto domainDescriptor = DataDescriptorBuilder()
+                                      .setSampleType(SampleType::UInt64)
+                                      .setTickResolution(Ratio(1, static_cast<Int>(samplingRate)))
+                                      .setRule(LinearDataRule(1, 0))
+                                      .setOrigin("1970-01-01T01:00:00+00:00")
+                                      .build();
+
+    auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "Domain");
+    signal.setDomainSignal(domainSignal);
+
+    fb.getInputPorts()[0].connect(signal);
+
+    auto reader = StreamReader(fb.getSignals()[0], SampleType::Float64, SampleType::UInt64);
+
+    auto domainPacket = DataPacket(domainDescriptor, sampleCount, 0);
+    auto dataPacket = DataPacketWithDomain(domainPacket, dataDescriptor, sampleCount);
+    double* raw = static_cast<double*>(dataPacket.getRawData());
+    const int amplitude = 10;
+    double inputEnergy = 0;
+
+    for (SizeT i = 0; i < sampleCount; ++i)
+    {
+        double timeInSeconds = static_cast<double>(i) / samplingRate;
+        double inputSample = amplitude * std::sin(2 * M_PI * signalFrequency * timeInSeconds);
+        raw[i] = inputSample;
+        inputEnergy += inputSample * inputSample;
+    }
+
+    signal.sendPacket(dataPacket);
+    domainSignal.sendPacket(domainPacket);
+
+    std::vector<double> dummyReadData(sampleCount);
+    SizeT dummyCount = sampleCount;
+    auto status = reader.read(dummyReadData.data(), &dummyCount);
+    ASSERT_EQ(status.getReadStatus(), ReadStatus::Event);
+
+    int retries = 20;
+    SizeT availableCount = 0;
+    while (availableCount < sampleCount && retries-- > 0)
+    {
+        using namespace std::chrono_literals;
+        availableCount = reader.getAvailableCount();
+        std::this_thread::sleep_for(100ms);
+    }
+    ASSERT_GT(availableCount, 0);
+
+    std::vector<double> output(sampleCount);
+    std::vector<uint64_t> domain(sampleCount);
+    SizeT read = sampleCount;
+    status = reader.readWithDomain(output.data(), domain.data(), &read);
+
+    ASSERT_EQ(status.getReadStatus(), ReadStatus::Ok);
+    ASSERT_EQ(read, sampleCount);
+
+    double outputEnergy = 0;
+    for (SizeT i = 0; i < read; ++i)
+        outputEnergy += output[i] * output[i];
+
+    const SizeT maxExpectedTotalOutputEnergy = 28;
+    ASSERT_LT(outputEnergy, maxExpectedTotalOutputEnergy);
+    ASSERT_LT(outputEnergy, inputEnergy * 0.1);
+}
+
+// Test 4: Testing attenuation of low frequencies
+TEST_F(ExampleIIRFilterTest, PassesLowFrequencies)
+{
+    const auto instance = Instance();
+    const auto fb = instance.addFunctionBlock("ExampleIIRFilter");
+    fb.setPropertyValue("CutoffFrequency", 50);
+
+    const SizeT sampleCount = 100;
+    const double samplingRate = 1000.0;
+    const double signalFrequency = 0.1;
+
+    const auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).setValueRange(Range(-10.0, 10.0)).build();
+
+    const auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "LowFreqInput");
+
+    const auto domainDescriptor = DataDescriptorBuilder()
+                                      .setSampleType(SampleType::UInt64)
+                                      .setTickResolution(Ratio(1, static_cast<Int>(samplingRate)))
+                                      .setRule(LinearDataRule(1, 0))
+                                      .setOrigin("1970-01-01T01:00:00+00:00")
+                                      .build();
+
+    auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "Domain");
+    signal.setDomainSignal(domainSignal);
+
+    fb.getInputPorts()[0].connect(signal);
+
+    auto reader = StreamReader(fb.getSignals()[0], SampleType::Float64, SampleType::UInt64);
+
+    auto domainPacket = DataPacket(domainDescriptor, sampleCount, 0);
+    auto dataPacket = DataPacketWithDomain(domainPacket, dataDescriptor, sampleCount);
+    double* raw = static_cast<double*>(dataPacket.getRawData());
+    const int amplitude = 10;
+    double inputEnergy = 0;
+
+    for (SizeT i = 0; i < sampleCount; ++i)
+    {
+        double timeInSeconds = static_cast<double>(i) / samplingRate;
+        double inputSample = amplitude * std::sin(2 * M_PI * signalFrequency * timeInSeconds);
+        raw[i] = inputSample;
+        inputEnergy += inputSample * inputSample;
+    }
+
+    signal.sendPacket(dataPacket);
+    domainSignal.sendPacket(domainPacket);
+
+    std::vector<double> dummyReadData(sampleCount);
+    SizeT dummyCount = sampleCount;
+    auto status = reader.read(dummyReadData.data(), &dummyCount);
+    ASSERT_EQ(status.getReadStatus(), ReadStatus::Event);
+
+    int retries = 20;
+    SizeT availableCount = 0;
+    while (availableCount < sampleCount && retries-- > 0)
+    {
+        using namespace std::chrono_literals;
+        availableCount = reader.getAvailableCount();
+        std::this_thread::sleep_for(100ms);
+    }
+    ASSERT_GT(availableCount, 0);
+
+    std::vector<double> output(sampleCount);
+    std::vector<uint64_t> domain(sampleCount);
+    SizeT read = sampleCount;
+    status = reader.readWithDomain(output.data(), domain.data(), &read);
+
+    ASSERT_EQ(status.getReadStatus(), ReadStatus::Ok);
+    ASSERT_EQ(read, sampleCount);
+
+    double outputEnergy = 0;
+    for (SizeT i = 0; i < read; ++i)
+        outputEnergy += output[i] * output[i];
+
+    ASSERT_GT(outputEnergy, inputEnergy * 0.9);
+}
+
+// Test 5: Testing valid range of cutoff frequency
+TEST_F(ExampleIIRFilterTest, CutoffFrequencyInValidRange)
+{
+    const auto instance = Instance();
+    const auto fb = instance.addFunctionBlock("ExampleIIRFilter");
+
+    const double sampleRate = 1000.0;
+    const auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).setValueRange(Range(0.0, 1.0)).build();
+
+    const auto domainDescriptor = DataDescriptorBuilder()
+                                      .setSampleType(SampleType::UInt64)
+                                      .setTickResolution(Ratio(1, static_cast<Int>(sampleRate)))
+                                      .setRule(LinearDataRule(1, 0))
+                                      .build();
+
+    const auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Input");
+    const auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "Domain");
+
+    signal.setDomainSignal(domainSignal);
+    fb.getInputPorts()[0].connect(signal);
+
+    const Int defaultCutoff = fb.getPropertyValue("CutoffFrequency");
+
+    ASSERT_GT(defaultCutoff, 0);
+    const Int maxAllowed = static_cast<Int>(sampleRate / 2) - 1;
+    ASSERT_LT(defaultCutoff, maxAllowed);
+
+    const std::vector<Int> validValues = {1, 10, 100, 400, maxAllowed};
+    for (const auto& val : validValues)
+    {
+        fb.setPropertyValue("CutoffFrequency", val);
+        const Int readBack = fb.getPropertyValue("CutoffFrequency");
+        ASSERT_EQ(readBack, val) << "The set value was not stored correctly:: " << val;
+    }
+}
+
+// Test 6: Testing invalid values for cutoff frequency
+TEST_F(ExampleIIRFilterTest, InvalidCutoffFrequencyThrows)
+{
+    const auto instance = Instance();
+    const auto fb = instance.addFunctionBlock("ExampleIIRFilter");
+
+    // Konfiguracija za sampleRate
+    const double sampleRate = 1000.0;
+    const auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).setValueRange(Range(0.0, 1.0)).build();
+
+    const auto domainDescriptor = DataDescriptorBuilder()
+                                      .setSampleType(SampleType::UInt64)
+                                      .setTickResolution(Ratio(1, static_cast<Int>(sampleRate)))
+                                      .setRule(LinearDataRule(1, 0))
+                                      .build();
+
+    const auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Input");
+    const auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "Domain");
+    signal.setDomainSignal(domainSignal);
+    fb.getInputPorts()[0].connect(signal);
+
+    const Int nyquistLimit = static_cast<Int>(sampleRate / 2);
+    const Int maxValid = nyquistLimit - 1;
+
+    EXPECT_THROW(fb.setPropertyValue("CutoffFrequency", -1), daq::GeneralErrorException);
+    EXPECT_THROW(fb.setPropertyValue("CutoffFrequency", 0), daq::GeneralErrorException);
+    EXPECT_THROW(fb.setPropertyValue("CutoffFrequency", nyquistLimit), daq::GeneralErrorException);
+
+    EXPECT_NO_THROW(fb.setPropertyValue("CutoffFrequency", 1));
+    EXPECT_NO_THROW(fb.setPropertyValue("CutoffFrequency", maxValid));
+}
+
+// Test 7: Output domain follows the input domain across several read blocks
+TEST_F(ExampleIIRFilterTest, OutputDomainFollowsInputDomain)
+{
+    const auto instance = Instance();
+    const auto fb = instance.addFunctionBlock("ExampleIIRFilter");
+
+    const SizeT sampleCount = 3000;
+    const SizeT packetOffset = 100;
+
+    const auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).setValueRange(Range(0.0, 1.0)).build();
+    const auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Input");
+
+    const auto domainDescriptor = DataDescriptorBuilder()
+                                      .setSampleType(SampleType::UInt64)
+                                      .setTickResolution(Ratio(1, 1000))
+                                      .setRule(LinearDataRule(1, 0))
+                                      .setOrigin("1970-01-01T01:00:00+00:00")
+                                      .build();
+
+    auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "Domain");
+    signal.setDomainSignal(domainSignal);
+
+    fb.getInputPorts()[0].connect(signal);
+
+    auto reader = StreamReader(fb.getSignals()[0], SampleType::Float64, SampleType::UInt64);
+
+    auto domainPacket = DataPacket(domainDescriptor, sampleCount, packetOffset);
+    auto dataPacket = DataPacketWithDomain(domainPacket, dataDescriptor, sampleCount);
+    double* raw = static_cast<double*>(dataPacket.getRawData());
+    for (SizeT i = 0; i < sampleCount; ++i)
+        raw[i] = 1.0;
+
+    signal.sendPacket(dataPacket);
+    domainSignal.sendPacket(domainPacket);
+
+    std::vector<double> dummyReadData(sampleCount);
+    SizeT dummyCount = sampleCount;
+    auto status = reader.read(dummyReadData.data(), &dummyCount);
+    ASSERT_EQ(status.getReadStatus(), ReadStatus::Event);
+
+    int retries = 20;
+    SizeT availableCount = 0;
+    while (availableCount < sampleCount && retries-- > 0)
+    {
+        using namespace std::chrono_literals;
+        availableCount = reader.getAvailableCount();
+        std::this_thread::sleep_for(100ms);
+    }
+    ASSERT_EQ(availableCount, sampleCount);
+
+    std::vector<double> output(sampleCount);
+    std::vector<uint64_t> domain(sampleCount);
+    SizeT read = sampleCount;
+    status = reader.readWithDomain(output.data(), domain.data(), &read);
+
+    ASSERT_EQ(status.getReadStatus(), ReadStatus::Ok);
+    ASSERT_EQ(read, sampleCount);
+
+    for (SizeT i = 0; i < read; ++i)
+        ASSERT_EQ(domain[i], packetOffset + i);
+}
+
+// Test 8: Packet mode produces the same output as the reader path
+TEST_F(ExampleIIRFilterTest, PacketModeMatchesReaderMode)
+{
+    const auto instance = Instance();
+
+    auto config = instance.getAvailableFunctionBlockTypes().get("ExampleIIRFilter").createDefaultConfig();
+    config.setPropertyValue("PacketMode", True);
+    const auto packetFb = instance.addFunctionBlock("ExampleIIRFilter", config);
+    const auto readerFb = instance.addFunctionBlock("ExampleIIRFilter");
+
+    const SizeT sampleCount = 500;
+
+    const auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Int16).setValueRange(Range(-1000, 1000)).build();
+    const auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Input");
+
+    const auto domainDescriptor = DataDescriptorBuilder()
+                                      .setSampleType(SampleType::UInt64)
+                                      .setTickResolution(Ratio(1, 1000))
+                                      .setRule(LinearDataRule(1, 0))
+                                      .setOrigin("1970-01-01T01:00:00+00:00")
+                                      .build();
+
+    auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "Domain");
+    signal.setDomainSignal(domainSignal);
+
+    packetFb.getInputPorts()[0].connect(signal);
+    readerFb.getInputPorts()[0].connect(signal);
+
+    auto packetReader = StreamReader(packetFb.getSignals()[0], SampleType::Float64, SampleType::UInt64);
+    auto readerReader = StreamReader(readerFb.getSignals()[0], SampleType::Float64, SampleType::UInt64);
+
+    auto domainPacket = DataPacket(domainDescriptor, sampleCount, 0);
+    auto dataPacket = DataPacketWithDomain(domainPacket, dataDescriptor, sampleCount);
+    int16_t* raw = static_cast<int16_t*>(dataPacket.getRawData());
+    for (SizeT i = 0; i < sampleCount; ++i)
+        raw[i] = static_cast<int16_t>(i % 50 < 25 ? 1000 : -1000);
+
+    signal.sendPacket(dataPacket);
+    domainSignal.sendPacket(domainPacket);
+
+    for (auto* reader : {&packetReader, &readerReader})
+    {
+        std::vector<double> dummyReadData(sampleCount);
+        SizeT dummyCount = sampleCount;
+        auto status = reader->read(dummyReadData.data(), &dummyCount);
+        ASSERT_EQ(status.getReadStatus(), ReadStatus::Event);
+
+        int retries = 20;
+        SizeT availableCount = 0;
+        while (availableCount < sampleCount && retries-- > 0)
+        {
+            using namespace std::chrono_literals;
+            availableCount = reader->getAvailableCount();
+            std::this_thread::sleep_for(100ms);
+        }
+        ASSERT_EQ(availableCount, sampleCount);
+    }
+
+    std::vector<double> packetOutput(sampleCount);
+    std::vector<uint64_t> packetDomain(sampleCount);
+    SizeT packetRead = sampleCount;
+    packetReader.readWithDomain(packetOutput.data(), packetDomain.data(), &packetRead);
+
+    std::vector<double> readerOutput(sampleCount);
+    std::vector<uint64_t> readerDomain(sampleCount);
+    SizeT readerRead = sampleCount;
+    readerReader.readWithDomain(readerOutput.data(), readerDomain.data(), &readerRead);
+
+    ASSERT_EQ(packetRead, sampleCount);
+    ASSERT_EQ(readerRead, sampleCount);
+    ASSERT_EQ(packetOutput, readerOutput);
+    ASSERT_EQ(packetDomain, readerDomain);
+}
+
+// Test 9: Higher-order band-stop removes a tone inside the band and passes one outside of it
+TEST_F(ExampleIIRFilterTest, BandStopRemovesTone)
+{
+    const auto instance = Instance();
+    const auto fb = instance.addFunctionBlock("ExampleIIRFilter");
+    fb.setPropertyValue("FilterType", 1);
+    fb.setPropertyValue("ResponseType", 3);
+    fb.setPropertyValue("Order", 6);
+    fb.setPropertyValue("CutoffFrequency", 80);
+    fb.setPropertyValue("UpperCutoffFrequency", 120);
+
+    const SizeT sampleCount = 2000;
+    const double samplingRate = 1000.0;
+
+    const auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).setValueRange(Range(-10.0, 10.0)).build();
+    const auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Input");
+
+    const auto domainDescriptor = DataDescriptorBuilder()
+                                      .setSampleType(SampleType::UInt64)
+                                      .setTickResolution(Ratio(1, static_cast<Int>(samplingRate)))
+                                      .setRule(LinearDataRule(1, 0))
+                                      .setOrigin("1970-01-01T01:00:00+00:00")
+                                      .build();
+
+    auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "Domain");
+    signal.setDomainSignal(domainSignal);
+
+    fb.getInputPorts()[0].connect(signal);
+
+    auto reader = StreamReader(fb.getSignals()[0], SampleType::Float64, SampleType::UInt64);
+
+    // 100 Hz lies in the stop band, 10 Hz in the pass band
+    auto domainPacket = DataPacket(domainDescriptor, sampleCount, 0);
+    auto dataPacket = DataPacketWithDomain(domainPacket, dataDescriptor, sampleCount);
+    double* raw = static_cast<double*>(dataPacket.getRawData());
+    for (SizeT i = 0; i < sampleCount; ++i)
+    {
+        const double t = static_cast<double>(i) / samplingRate;
+        raw[i] = std::sin(2 * M_PI * 100.0 * t) + std::sin(2 * M_PI * 10.0 * t);
+    }
+
+    signal.sendPacket(dataPacket);
+    domainSignal.sendPacket(domainPacket);
+
+    std::vector<double> dummyReadData(sampleCount);
+    SizeT dummyCount = sampleCount;
+    auto status = reader.read(dummyReadData.data(), &dummyCount);
+    ASSERT_EQ(status.getReadStatus(), ReadStatus::Event);
+
+    int retries = 20;
+    SizeT availableCount = 0;
+    while (availableCount < sampleCount && retries-- > 0)
+    {
+        using namespace std::chrono_literals;
+        availableCount = reader.getAvailableCount();
+        std::this_thread::sleep_for(100ms);
+    }
+    ASSERT_EQ(availableCount, sampleCount);
+
+    std::vector<double> output(sampleCount);
+    SizeT read = sampleCount;
+    status = reader.read(output.data(), &read);
+    ASSERT_EQ(read, sampleCount);
+
+    // After the transient has decayed only the 10 Hz tone remains: RMS of 1/sqrt(2), within the 1 dB ripple
+    double energy = 0;
+    for (SizeT i = sampleCount / 2; i < sampleCount; ++i)
+        energy += output[i] * output[i];
+    const double rms = std::sqrt(energy / static_cast<double>(sampleCount / 2));
+
+    ASSERT_GT(rms, 0.6);
+    ASSERT_LT(rms, 0.75);
+}
+
+// Test 10: Band responses require an upper cutoff above the cutoff frequency
+TEST_F(ExampleIIRFilterTest, InvalidUpperCutoffFrequencyThrows)
+{
+    const auto instance = Instance();
+    const auto fb = instance.addFunctionBlock("ExampleIIRFilter");
+
+    const auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).setValueRange(Range(0.0, 1.0)).build();
+    const auto domainDescriptor = DataDescriptorBuilder()
+                                      .setSampleType(SampleType::UInt64)
+                                      .setTickResolution(Ratio(1, 1000))
+                                      .setRule(LinearDataRule(1, 0))
+                                      .build();
+
+    const auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Input");
+    const auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "Domain");
+    signal.setDomainSignal(domainSignal);
+    fb.getInputPorts()[0].connect(signal);
+
+    fb.setPropertyValue("CutoffFrequency", 100);
+    fb.setPropertyValue("UpperCutoffFrequency", 50);
+
+    // Low-pass ignores the upper cutoff, band-pass validates it
+    EXPECT_THROW(fb.setPropertyValue("ResponseType", 2), daq::GeneralErrorException);
+    EXPECT_NO_THROW(fb.setPropertyValue("UpperCutoffFrequency", 200));
+    EXPECT_THROW(fb.setPropertyValue("UpperCutoffFrequency", 500), daq::GeneralErrorException);
+}
+
+// Test 11: Filtering segments of a block on several threads matches the serial filter
+TEST_F(ExampleIIRFilterTest, ParallelismMatchesSerialFilter)
+{
+    const auto instance = Instance();
+    const auto parallelFb = instance.addFunctionBlock("ExampleIIRFilter");
+    const auto serialFb = instance.addFunctionBlock("ExampleIIRFilter");
+
+    for (const auto& fb : {parallelFb, serialFb})
+    {
+        fb.setPropertyValue("FilterType", 1);
+        fb.setPropertyValue("Order", 8);
+        fb.setPropertyValue("CutoffFrequency", 20000);
+    }
+    parallelFb.setPropertyValue("Parallelism", 4);
+
+    // Several segments per read block
+    const SizeT sampleCount = 100000;
+
+    const auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).build();
+    const auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Input");
+
+    const auto domainDescriptor = DataDescriptorBuilder()
+                                      .setSampleType(SampleType::UInt64)
+                                      .setTickResolution(Ratio(1, 10000000))
+                                      .setRule(LinearDataRule(1, 0))
+                                      .build();
+
+    auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "Domain");
+    signal.setDomainSignal(domainSignal);
+
+    parallelFb.getInputPorts()[0].connect(signal);
+    serialFb.getInputPorts()[0].connect(signal);
+
+    auto parallelReader = StreamReader(parallelFb.getSignals()[0], SampleType::Float64, SampleType::UInt64);
+    auto serialReader = StreamReader(serialFb.getSignals()[0], SampleType::Float64, SampleType::UInt64);
+
+    auto domainPacket = DataPacket(domainDescriptor, sampleCount, 0);
+    auto dataPacket = DataPacketWithDomain(domainPacket, dataDescriptor, sampleCount);
+    double* raw = static_cast<double*>(dataPacket.getRawData());
+    for (SizeT i = 0; i < sampleCount; ++i)
+        raw[i] = (i * 7919) % 1000 < 500 ? 1.0 : -1.0;
+
+    signal.sendPacket(dataPacket);
+    domainSignal.sendPacket(domainPacket);
+
+    for (auto* reader : {&parallelReader, &serialReader})
+    {
+        std::vector<double> dummyReadData(sampleCount);
+        SizeT dummyCount = sampleCount;
+        auto status = reader->read(dummyReadData.data(), &dummyCount);
+        ASSERT_EQ(status.getReadStatus(), ReadStatus::Event);
+
+        int retries = 20;
+        SizeT availableCount = 0;
+        while (availableCount < sampleCount && retries-- > 0)
+        {
+            using namespace std::chrono_literals;
+            availableCount = reader->getAvailableCount();
+            std::this_thread::sleep_for(100ms);
+        }
+        ASSERT_EQ(availableCount, sampleCount);
+    }
+
+    std::vector<double> parallelOutput(sampleCount);
+    SizeT parallelRead = sampleCount;
+    parallelReader.read(parallelOutput.data(), &parallelRead);
+
+    std::vector<double> serialOutput(sampleCount);
+    SizeT serialRead = sampleCount;
+    serialReader.read(serialOutput.data(), &serialRead);
+
+    ASSERT_EQ(parallelRead, sampleCount);
+    ASSERT_EQ(serialRead, sampleCount);
+    for (SizeT i = 0; i < sampleCount; ++i)
+        ASSERT_NEAR(parallelOutput[i], serialOutput[i], 1e-8) << "at sample " << i;
+}
+
+// Test 12: Changing the design of a running filter keeps its state and output descriptor
+TEST_F(ExampleIIRFilterTest, CutoffChangeKeepsState)
+{
+    const auto instance = Instance();
+    const auto fb = instance.addFunctionBlock("ExampleIIRFilter");
+
+    const SizeT packetSize = 2000;
+
+    const auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).build();
+    const auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Input");
+
+    const auto domainDescriptor = DataDescriptorBuilder()
+                                      .setSampleType(SampleType::UInt64)
+                                      .setTickResolution(Ratio(1, 1000))
+                                      .setRule(LinearDataRule(1, 0))
+                                      .build();
+
+    auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "Domain");
+    signal.setDomainSignal(domainSignal);
+
+    fb.getInputPorts()[0].connect(signal);
+    auto reader = StreamReader(fb.getSignals()[0], SampleType::Float64, SampleType::UInt64);
+
+    const auto sendStep = [&](SizeT offset)
+    {
+        auto domainPacket = DataPacket(domainDescriptor, packetSize, offset);
+        auto dataPacket = DataPacketWithDomain(domainPacket, dataDescriptor, packetSize);
+        double* raw = static_cast<double*>(dataPacket.getRawData());
+        for (SizeT i = 0; i < packetSize; ++i)
+            raw[i] = 1.0;
+
+        signal.sendPacket(dataPacket);
+        domainSignal.sendPacket(domainPacket);
+    };
+
+    const auto waitForSamples = [&]()
+    {
+        int retries = 20;
+        SizeT availableCount = 0;
+        while (availableCount < packetSize && retries-- > 0)
+        {
+            using namespace std::chrono_literals;
+            availableCount = reader.getAvailableCount();
+            std::this_thread::sleep_for(100ms);
+        }
+        return availableCount;
+    };
+
+    sendStep(0);
+
+    std::vector<double> output(packetSize);
+    SizeT count = packetSize;
+    auto status = reader.read(output.data(), &count);
+    ASSERT_EQ(status.getReadStatus(), ReadStatus::Event);
+
+    ASSERT_EQ(waitForSamples(), packetSize);
+    count = packetSize;
+    reader.read(output.data(), &count);
+    ASSERT_NEAR(output.back(), 1.0, 1e-6);
+
+    fb.setPropertyValue("CutoffFrequency", 10);
+    sendStep(packetSize);
+
+    // No descriptor change, and the settled output does not restart from zero
+    ASSERT_EQ(waitForSamples(), packetSize);
+    count = packetSize;
+    status = reader.read(output.data(), &count);
+    ASSERT_EQ(status.getReadStatus(), ReadStatus::Ok);
+    ASSERT_EQ(count, packetSize);
+
+    for (SizeT i = 0; i < packetSize; ++i)
+        ASSERT_NEAR(output[i], 1.0, 0.05) << "at sample " << i;
+}
+
+TEST_F(ExampleFilterBankTest, ConnectingAddsInputPort)
+{
+    const auto instance = Instance();
+    const auto fb = instance.addFunctionBlock("ExampleFilterBank");
+    ASSERT_EQ(fb.getInputPorts().getCount(), 1u);
+
+    const auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).build();
+    const auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Input");
+
+    fb.getInputPorts()[0].connect(signal);
+    ASSERT_EQ(fb.getInputPorts().getCount(), 2u);
+    ASSERT_EQ(fb.getSignals().getCount(), 2u);
+
+    fb.getInputPorts()[0].disconnect();
+    ASSERT_EQ(fb.getInputPorts().getCount(), 1u);
+    ASSERT_EQ(fb.getSignals().getCount(), 1u);
+}
+
+// Every channel of the bank produces the same output as a separate IIR filter block
+TEST_F(ExampleFilterBankTest, ChannelsMatchIIRFilter)
+{
+    const auto instance = Instance();
+    const auto bank = instance.addFunctionBlock("ExampleFilterBank");
+    const auto iir = instance.addFunctionBlock("ExampleIIRFilter");
+    for (const auto& fb : {bank, iir})
+    {
+        fb.setPropertyValue("FilterType", 0);
+        fb.setPropertyValue("Order", 4);
+        fb.setPropertyValue("CutoffFrequency", 50);
+    }
+
+    const SizeT channelCount = 3;
+    const SizeT sampleCount = 3000;
+
+    const auto domainDescriptor = DataDescriptorBuilder()
+                                      .setSampleType(SampleType::UInt64)
+                                      .setTickResolution(Ratio(1, 1000))
+                                      .setRule(LinearDataRule(1, 0))
+                                      .setOrigin("1970-01-01T01:00:00+00:00")
+                                      .build();
+    const auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).setValueRange(Range(-10.0, 10.0)).build();
+
+    std::vector<SignalConfigPtr> signals;
+    std::vector<SignalConfigPtr> domainSignals;
+    std::vector<StreamReaderPtr> readers;
+    for (SizeT channel = 0; channel < channelCount; ++channel)
+    {
+        const auto name = std::to_string(channel);
+        signals.push_back(SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Input" + name));
+        domainSignals.push_back(SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "Domain" + name));
+        signals.back().setDomainSignal(domainSignals.back());
+
+        bank.getInputPorts()[channel].connect(signals.back());
+        readers.push_back(StreamReader(bank.getSignals()[channel], SampleType::Float64, SampleType::UInt64));
+    }
+    ASSERT_EQ(bank.getInputPorts().getCount(), channelCount + 1);
+
+    // The reference filter processes the last channel
+    iir.getInputPorts()[0].connect(signals.back());
+    const auto iirReader = StreamReader(iir.getSignals()[0], SampleType::Float64, SampleType::UInt64);
+
+    for (SizeT channel = 0; channel < channelCount; ++channel)
+    {
+        auto domainPacket = DataPacket(domainDescriptor, sampleCount, 0);
+        auto dataPacket = DataPacketWithDomain(domainPacket, dataDescriptor, sampleCount);
+        double* raw = static_cast<double*>(dataPacket.getRawData());
+        for (SizeT i = 0; i < sampleCount; ++i)
+            raw[i] = std::sin(2 * M_PI * static_cast<double>((channel + 1) * 30 * i) / 1000.0);
+
+        signals[channel].sendPacket(dataPacket);
+        domainSignals[channel].sendPacket(domainPacket);
+    }
+
+    std::vector<std::vector<double>> outputs(channelCount + 1, std::vector<double>(sampleCount));
+    for (SizeT r = 0; r <= channelCount; ++r)
+    {
+        auto reader = r < channelCount ? readers[r] : iirReader;
+
+        std::vector<double> dummyReadData(sampleCount);
+        SizeT dummyCount = sampleCount;
+        auto status = reader.read(dummyReadData.data(), &dummyCount);
+        ASSERT_EQ(status.getReadStatus(), ReadStatus::Event);
+
+        int retries = 20;
+        SizeT availableCount = 0;
+        while (availableCount < sampleCount && retries-- > 0)
+        {
+            using namespace std::chrono_literals;
+            availableCount = reader.getAvailableCount();
+            std::this_thread::sleep_for(100ms);
+        }
+        ASSERT_EQ(availableCount, sampleCount);
+
+        SizeT read = sampleCount;
+        reader.read(outputs[r].data(), &read);
+        ASSERT_EQ(read, sampleCount);
+    }
+
+    ASSERT_EQ(outputs[channelCount - 1], outputs[channelCount]);
+
+    // Channels are filtered independently: the 30 Hz channel passes, the 90 Hz channel is attenuated
+    double passEnergy = 0;
+    double stopEnergy = 0;
+    for (SizeT i = sampleCount / 2; i < sampleCount; ++i)
+    {
+        passEnergy += outputs[0][i] * outputs[0][i];
+        stopEnergy += outputs[2][i] * outputs[2][i];
+    }
+    ASSERT_GT(passEnergy, 10 * stopEnergy);
+}
+
+TEST_F(ExampleFIRFilterTest, CanAddFilter)
+{
+    const auto instance = Instance();
+    ASSERT_TRUE(instance.addFunctionBlock("ExampleFIRFilter").assigned());
+}
+
+// A long kernel (FFT convolution) outputs its symmetric taps as the impulse response
+TEST_F(ExampleFIRFilterTest, ImpulseResponseIsLinearPhase)
+{
+    const auto instance = Instance();
+    const auto fb = instance.addFunctionBlock("ExampleFIRFilter");
+    fb.setPropertyValue("TapCount", 1001);
+    fb.setPropertyValue("CutoffFrequency", 50);
+
+    const SizeT packetSize = 1500;
+    const SizeT sampleCount = 3 * packetSize;
+
+    const auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).build();
+    const auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Input");
+
+    const auto domainDescriptor = DataDescriptorBuilder()
+                                      .setSampleType(SampleType::UInt64)
+                                      .setTickResolution(Ratio(1, 1000))
+                                      .setRule(LinearDataRule(1, 0))
+                                      .build();
+
+    auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "Domain");
+    signal.setDomainSignal(domainSignal);
+
+    fb.getInputPorts()[0].connect(signal);
+    auto reader = StreamReader(fb.getSignals()[0], SampleType::Float64, SampleType::UInt64);
+
+    // Sent in packets that do not align with the filter's block size
+    for (SizeT packet = 0; packet < 3; ++packet)
+    {
+        auto domainPacket = DataPacket(domainDescriptor, packetSize, packet * packetSize);
+        auto dataPacket = DataPacketWithDomain(domainPacket, dataDescriptor, packetSize);
+        double* raw = static_cast<double*>(dataPacket.getRawData());
+        for (SizeT i = 0; i < packetSize; ++i)
+            raw[i] = (packet == 0 && i == 0) ? 1.0 : 0.0;
+
+        signal.sendPacket(dataPacket);
+        domainSignal.sendPacket(domainPacket);
+    }
+
+    std::vector<double> dummyReadData(sampleCount);
+    SizeT dummyCount = sampleCount;
+    auto status = reader.read(dummyReadData.data(), &dummyCount);
+    ASSERT_EQ(status.getReadStatus(), ReadStatus::Event);
+
+    int retries = 20;
+    SizeT availableCount = 0;
+    while (availableCount < sampleCount && retries-- > 0)
+    {
+        using namespace std::chrono_literals;
+        availableCount = reader.getAvailableCount();
+        std::this_thread::sleep_for(100ms);
+    }
+    ASSERT_EQ(availableCount, sampleCount);
+
+    std::vector<double> output(sampleCount);
+    SizeT read = sampleCount;
+    reader.read(output.data(), &read);
+    ASSERT_EQ(read, sampleCount);
+
+    // Unity gain at DC, symmetric around the center tap, and nothing after the last tap
+    double sum = 0.0;
+    for (SizeT i = 0; i < 1001; ++i)
+    {
+        sum += output[i];
+        ASSERT_NEAR(output[i], output[1000 - i], 1e-12) << "at tap " << i;
+    }
+    ASSERT_NEAR(sum, 1.0, 1e-9);
+
+    for (SizeT i = 1001; i < sampleCount; ++i)
+        ASSERT_NEAR(output[i], 0.0, 1e-12) << "at sample " << i;
+}
+
+TEST_F(ExampleFIRFilterTest, HighPassRequiresOddTapCount)
+{
+    const auto instance = Instance();
+    const auto fb = instance.addFunctionBlock("ExampleFIRFilter");
+
+    const auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).build();
+    const auto domainDescriptor = DataDescriptorBuilder()
+                                      .setSampleType(SampleType::UInt64)
+                                      .setTickResolution(Ratio(1, 1000))
+                                      .setRule(LinearDataRule(1, 0))
+                                      .build();
+
+    const auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Input");
+    const auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "Domain");
+    signal.setDomainSignal(domainSignal);
+    fb.getInputPorts()[0].connect(signal);
+
+    fb.setPropertyValue("TapCount", 100);
+    EXPECT_THROW(fb.setPropertyValue("ResponseType", 1), daq::GeneralErrorException);
+    EXPECT_NO_THROW(fb.setPropertyValue("TapCount", 101));
+}
+
+TEST_F(ExampleDecimatorTest, CanAddDecimator)
+{
+    const auto instance = Instance();
+    ASSERT_TRUE(instance.addFunctionBlock("ExampleDecimator").assigned());
+}
+
+// The output domain keeps the input's offsets at every factor-th sample and scales the rule's delta
+TEST_F(ExampleDecimatorTest, OutputDomainIsScaled)
+{
+    const auto instance = Instance();
+    const auto fb = instance.addFunctionBlock("ExampleDecimator");
+    fb.setPropertyValue("DecimationFactor", 4);
+
+    const SizeT sampleCount = 1000;
+    const SizeT outputCount = sampleCount / 4;
+    const SizeT startOffset = 5000;
+
+    const auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).build();
+    const auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Input");
+
+    const auto domainDescriptor = DataDescriptorBuilder()
+                                      .setSampleType(SampleType::UInt64)
+                                      .setTickResolution(Ratio(1, 1000))
+                                      .setRule(LinearDataRule(1, 0))
+                                      .build();
+
+    auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "Domain");
+    signal.setDomainSignal(domainSignal);
+
+    fb.getInputPorts()[0].connect(signal);
+    auto reader = StreamReader(fb.getSignals()[0], SampleType::Float64, SampleType::UInt64);
+
+    // Packets that split the groups of four samples
+    SizeT offset = startOffset;
+    for (const SizeT packetSize : {SizeT(7), SizeT(333), SizeT(660)})
+    {
+        auto domainPacket = DataPacket(domainDescriptor, packetSize, offset);
+        auto dataPacket = DataPacketWithDomain(domainPacket, dataDescriptor, packetSize);
+        double* raw = static_cast<double*>(dataPacket.getRawData());
+        for (SizeT i = 0; i < packetSize; ++i)
+            raw[i] = 1.0;
+
+        signal.sendPacket(dataPacket);
+        domainSignal.sendPacket(domainPacket);
+        offset += packetSize;
+    }
+
+    std::vector<double> dummyReadData(outputCount);
+    SizeT dummyCount = outputCount;
+    auto status = reader.read(dummyReadData.data(), &dummyCount);
+    ASSERT_EQ(status.getReadStatus(), ReadStatus::Event);
+
+    int retries = 20;
+    SizeT availableCount = 0;
+    while (availableCount < outputCount && retries-- > 0)
+    {
+        using namespace std::chrono_literals;
+        availableCount = reader.getAvailableCount();
+        std::this_thread::sleep_for(100ms);
+    }
+    ASSERT_EQ(availableCount, outputCount);
+
+    const auto outputDomainRule = fb.getSignals()[0].getDomainSignal().getDescriptor().getRule();
+    ASSERT_EQ(static_cast<Int>(outputDomainRule.getParameters().get("delta")), 4);
+
+    std::vector<double> output(outputCount);
+    std::vector<uint64_t> domain(outputCount);
+    SizeT read = outputCount;
+    status = reader.readWithDomain(output.data(), domain.data(), &read);
+    ASSERT_EQ(read, outputCount);
+
+    for (SizeT i = 0; i < read; ++i)
+        ASSERT_EQ(domain[i], startOffset + 4 * i) << "at output " << i;
+
+    // Unity gain at DC once the anti-alias filter has settled
+    for (SizeT i = 16; i < read; ++i)
+        ASSERT_NEAR(output[i], 1.0, 1e-2) << "at output " << i;
+}
+
+// Within a batch update only the final state is validated and configured, once
+TEST_F(ExampleFIRFilterTest, BatchUpdateConfiguresFinalState)
+{
+    const auto instance = Instance();
+    const auto fb = instance.addFunctionBlock("ExampleFIRFilter");
+
+    const auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).build();
+    const auto domainDescriptor = DataDescriptorBuilder()
+                                      .setSampleType(SampleType::UInt64)
+                                      .setTickResolution(Ratio(1, 1000))
+                                      .setRule(LinearDataRule(1, 0))
+                                      .build();
+
+    const auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Input");
+    const auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "Domain");
+    signal.setDomainSignal(domainSignal);
+    fb.getInputPorts()[0].connect(signal);
+
+    // A high-pass filter with an even tap count is invalid on its own, but not at the end of the batch
+    fb.beginUpdate();
+    fb.setPropertyValue("TapCount", 100);
+    fb.setPropertyValue("ResponseType", 1);
+    fb.setPropertyValue("TapCount", 201);
+    fb.setPropertyValue("CutoffFrequency", 100);
+    EXPECT_NO_THROW(fb.endUpdate());
+
+    ASSERT_EQ(static_cast<Int>(fb.getPropertyValue("TapCount")), 201);
+    ASSERT_TRUE(fb.getSignals()[0].getDescriptor().assigned());
+}
+
+TEST_F(ExampleGeneratorTest, CanAddGenerator)
+{
+    const auto instance = Instance();
+    ASSERT_TRUE(instance.addFunctionBlock("ExampleGenerator").assigned());
+}
+
+TEST_F(ExampleGeneratorTest, ChannelCountAddsSignals)
+{
+    const auto instance = Instance();
+    const auto fb = instance.addFunctionBlock("ExampleGenerator");
+    ASSERT_EQ(fb.getSignals().getCount(), 1u);
+
+    fb.setPropertyValue("ChannelCount", 4);
+    ASSERT_EQ(fb.getSignals().getCount(), 4u);
+
+    fb.setPropertyValue("ChannelCount", 2);
+    ASSERT_EQ(fb.getSignals().getCount(), 2u);
+}
+
+// Channels share the domain and are offset by a fraction of the period
+TEST_F(ExampleGeneratorTest, GeneratesSine)
+{
+    const auto instance = Instance();
+    const auto fb = instance.addFunctionBlock("ExampleGenerator");
+
+    fb.beginUpdate();
+    fb.setPropertyValue("Active", False);
+    fb.setPropertyValue("SampleRate", 10000);
+    fb.setPropertyValue("Frequency", 100.0);
+    fb.setPropertyValue("PacketSize", 100);
+    fb.setPropertyValue("ChannelCount", 2);
+    fb.endUpdate();
+
+    const SizeT sampleCount = 1000;
+    std::vector<StreamReaderPtr> readers;
+    for (const auto& signal : fb.getSignals())
+        readers.push_back(StreamReader(signal, SampleType::Float64, SampleType::Int64));
+
+    fb.setPropertyValue("Active", True);
+
+    for (SizeT channel = 0; channel < readers.size(); ++channel)
+    {
+        auto& reader = readers[channel];
+
+        std::vector<double> dummyReadData(sampleCount);
+        SizeT dummyCount = sampleCount;
+        auto status = reader.read(dummyReadData.data(), &dummyCount);
+        ASSERT_EQ(status.getReadStatus(), ReadStatus::Event);
+
+        int retries = 50;
+        while (reader.getAvailableCount() < sampleCount && retries-- > 0)
+        {
+            using namespace std::chrono_literals;
+            std::this_thread::sleep_for(100ms);
+        }
+        ASSERT_GE(reader.getAvailableCount(), sampleCount);
+
+        std::vector<double> output(sampleCount);
+        std::vector<Int> domain(sampleCount);
+        SizeT read = sampleCount;
+        reader.readWithDomain(output.data(), domain.data(), &read);
+        ASSERT_EQ(read, sampleCount);
+
+        for (SizeT i = 0; i < read; ++i)
+        {
+            const double expected = std::sin(2.0 * M_PI * static_cast<double>(i + channel * 50) / 100.0);
+            ASSERT_NEAR(output[i], expected, 1e-9) << "channel " << channel << " at sample " << i;
+            if (i > 0)
+                ASSERT_EQ(domain[i], domain[i - 1] + 1);
+        }
+    }
+}
+
+TEST_F(ExampleGeneratorTest, GeneratesIntegerSamples)
+{
+    const auto instance = Instance();
+    const auto fb = instance.addFunctionBlock("ExampleGenerator");
+
+    fb.beginUpdate();
+    fb.setPropertyValue("Active", False);
+    fb.setPropertyValue("Waveform", 4);
+    fb.setPropertyValue("Offset", 1000.0);
+    fb.setPropertyValue("SampleType", 3);
+    fb.endUpdate();
+
+    auto reader = StreamReader(fb.getSignals()[0], SampleType::Int16, SampleType::Int64);
+    fb.setPropertyValue("Active", True);
+
+    std::vector<int16_t> output(100);
+    SizeT count = output.size();
+    auto status = reader.read(output.data(), &count);
+    ASSERT_EQ(status.getReadStatus(), ReadStatus::Event);
+    ASSERT_EQ(fb.getSignals()[0].getDescriptor().getSampleType(), SampleType::Int16);
+
+    int retries = 50;
+    while (reader.getAvailableCount() < output.size() && retries-- > 0)
+    {
+        using namespace std::chrono_literals;
+        std::this_thread::sleep_for(100ms);
+    }
+
+    count = output.size();
+    reader.read(output.data(), &count);
+    fb.setPropertyValue("Active", False);
+
+    ASSERT_EQ(count, output.size());
+    for (const auto value : output)
+        ASSERT_EQ(value, 1000);
+}
+
+TEST_F(ExampleGeneratorTest, InvalidFrequencyThrows)
+{
+    const auto instance = Instance();
+    const auto fb = instance.addFunctionBlock("ExampleGenerator");
+
+    // Above half the default sample rate of 1000 Hz
+    EXPECT_THROW(fb.setPropertyValue("Frequency", 600.0), daq::GeneralErrorException);
+    ASSERT_FALSE(fb.getSignals()[0].getDescriptor().assigned());
+
+    EXPECT_NO_THROW(fb.setPropertyValue("Frequency", 100.0));
+    ASSERT_TRUE(fb.getSignals()[0].getDescriptor().assigned());
+}
+
+// 300 Hz at the default 1000 Hz spans 3 periods in a 10 sample table instead of rounding to 333.3 Hz
+TEST_F(ExampleGeneratorTest, PublishesEffectiveFrequency)
+{
+    const auto instance = Instance();
+    const auto fb = instance.addFunctionBlock("ExampleGenerator");
+
+    fb.setPropertyValue("Frequency", 300.0);
+    ASSERT_DOUBLE_EQ(fb.getPropertyValue("EffectiveFrequency"), 300.0);
+
+    fb.setPropertyValue("Frequency", 7.5);
+    ASSERT_DOUBLE_EQ(fb.getPropertyValue("EffectiveFrequency"), 7.5);
+}
+
+TEST_F(ExampleRecorderTest, CanAddRecorder)
+{
+    const auto instance = Instance();
+    ASSERT_TRUE(instance.addFunctionBlock("ExampleRecorder").assigned());
+}
+
+// The file holds the descriptors in its header and the raw samples with their domain offsets
+TEST_F(ExampleRecorderTest, RecordsRawSamples)
+{
+    using namespace daq::modules::example_module;
+
+    const auto instance = Instance();
+    const auto fb = instance.addFunctionBlock("ExampleRecorder");
+    const auto path = (std::filesystem::temp_directory_path() / "test_example_recorder.daqrec").string();
+
+    const auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Int32).build();
+    const auto domainDescriptor = DataDescriptorBuilder()
+                                      .setSampleType(SampleType::Int64)
+                                      .setTickResolution(Ratio(1, 1000))
+                                      .setRule(LinearDataRule(1, 0))
+                                      .build();
+
+    const auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Input");
+    const auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "Domain");
+    signal.setDomainSignal(domainSignal);
+    fb.getInputPorts()[0].connect(signal);
+
+    fb.setPropertyValue("FilePath", path);
+    fb.setPropertyValue("SegmentSize", 1);
+    fb.setPropertyValue("MaxFileSize", 8);
+    fb.setPropertyValue("Recording", True);
+
+    const SizeT packetSize = 100;
+    for (SizeT packetIndex = 0; packetIndex < 5; ++packetIndex)
+    {
+        const auto domainPacket = DataPacket(domainDescriptor, packetSize, static_cast<Int>(packetIndex * packetSize));
+        const auto dataPacket = DataPacketWithDomain(domainPacket, dataDescriptor, packetSize);
+        auto* raw = static_cast<int32_t*>(dataPacket.getRawData());
+        for (SizeT i = 0; i < packetSize; ++i)
+            raw[i] = static_cast<int32_t>(packetIndex * packetSize + i);
+
+        signal.sendPacket(dataPacket);
+        domainSignal.sendPacket(domainPacket);
+    }
+
+    fb.setPropertyValue("Recording", False);
+    ASSERT_EQ(static_cast<Int>(fb.getPropertyValue("RecordedSamples")), 500);
+    ASSERT_EQ(static_cast<Int>(fb.getPropertyValue("DroppedSamples")), 0);
+
+    std::ifstream stream(path, std::ios::binary);
+    const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    stream.close();
+
+    RecordingFileHeader header;
+    ASSERT_GE(bytes.size(), sizeof(header));
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    ASSERT_EQ(header.complete, 1u);
+    ASSERT_EQ(header.recordCount, 5u);
+    ASSERT_EQ(bytes.size(), header.headerSize + header.dataSize);
+
+    const auto descriptors = decodeDescriptors(bytes.data() + sizeof(header), header.descriptorSize);
+    ASSERT_FALSE(descriptors.dataDescriptor.empty());
+    ASSERT_FALSE(descriptors.domainDescriptor.empty());
+
+    SizeT position = header.headerSize;
+    for (SizeT packetIndex = 0; packetIndex < 5; ++packetIndex)
+    {
+        RecordHeader record;
+        std::memcpy(&record, bytes.data() + position, sizeof(record));
+        ASSERT_EQ(record.type, RecordType::Data);
+        ASSERT_EQ(record.sampleCount, packetSize);
+        ASSERT_EQ(record.domainOffset, static_cast<Int>(packetIndex * packetSize));
+        ASSERT_EQ(record.valueSize, packetSize * sizeof(int32_t));
+        ASSERT_EQ(record.size, record.valueSize);
+
+        const auto* values = reinterpret_cast<const int32_t*>(bytes.data() + position + sizeof(record));
+        for (SizeT i = 0; i < packetSize; ++i)
+            ASSERT_EQ(values[i], static_cast<int32_t>(packetIndex * packetSize + i));
+
+        position += sizeof(record) + alignRecordSize(record.size);
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_F(ExampleReplayTest, CanAddReplay)
+{
+    const auto instance = Instance();
+    ASSERT_TRUE(instance.addFunctionBlock("ExampleReplay").assigned());
 }
 
-// Test 2: Response of filter to step values 0 then 1
-TEST_F(ExampleIIRFilterTest, StepResponse)
+TEST_F(ExampleReplayTest, InvalidFileThrows)
 {
     const auto instance = Instance();
-    const auto fb = instance.addFunctionBlock("ExampleIIRFilter");
-    fb.setPropertyValue("CutoffFrequency", 5);
-
-    const SizeT sampleCount = 200;
-
-    const auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).setValueRange(Range(0.0, 1.0)).build();
+    const auto fb = instance.addFunctionBlock("ExampleReplay");
+    const auto path = (std::filesystem::temp_directory_path() / "test_example_replay_missing.daqrec").string();
+    EXPECT_THROW(fb.setPropertyValue("FilePath", path), daq::GeneralErrorException);
+}
 
-    const auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "StepInput");
+// A recording of the recorder function block replays with its descriptors, values and domain
+TEST_F(ExampleReplayTest, ReplaysRecording)
+{
+    const auto instance = Instance();
+    const auto recorder = instance.addFunctionBlock("ExampleRecorder");
+    const auto path = (std::filesystem::temp_directory_path() / "test_example_replay.daqrec").string();
 
+    const auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float32).setValueRange(Range(-10, 10)).build();
     const auto domainDescriptor = DataDescriptorBuilder()
-                                      .setSampleType(SampleType::UInt64)
+                                      .setSampleType(SampleType::Int64)
+                                      .setUnit(Unit("s", -1, "seconds", "time"))
                                       .setTickResolution(Ratio(1, 1000))
                                       .setRule(LinearDataRule(1, 0))
-                                      .setOrigin("1970-01-01T01:00:00+00:00")
+                                      .setOrigin("1970-01-01T00:00:00+00:00")
                                       .build();
 
-    auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "Domain");
+    const auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Input");
+    const auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "Domain");
     signal.setDomainSignal(domainSignal);
+    recorder.getInputPorts()[0].connect(signal);
 
-    fb.getInputPorts()[0].connect(signal);
-
-    auto reader = StreamReader(fb.getSignals()[0], SampleType::Float64, SampleType::UInt64);
+    recorder.setPropertyValue("FilePath", path);
+    recorder.setPropertyValue("SegmentSize", 1);
+    recorder.setPropertyValue("MaxFileSize", 8);
+    recorder.setPropertyValue("Recording", True);
 
-    // Preparing data – 50 zero, 150 one
-    SizeT count = sampleCount;
-    auto domainPacket = DataPacket(domainDescriptor, count, 0);
-    auto dataPacket = DataPacketWithDomain(domainPacket, dataDescriptor, count);
+    const SizeT packetSize = 100;
+    const SizeT packetCount = 10;
+    const Int startOffset = 7000;
+    for (SizeT packetIndex = 0; packetIndex < packetCount; ++packetIndex)
+    {
+        const auto domainPacket = DataPacket(domainDescriptor, packetSize, startOffset + static_cast<Int>(packetIndex * packetSize));
+        const auto dataPacket = DataPacketWithDomain(domainPacket, dataDescriptor, packetSize);
+        auto* raw = static_cast<float*>(dataPacket.getRawData());
+        for (SizeT i = 0; i < packetSize; ++i)
+            raw[i] = static_cast<float>(packetIndex * packetSize + i) / 100.0f;
+
+        signal.sendPacket(dataPacket);
+        domainSignal.sendPacket(domainPacket);
+    }
+    recorder.setPropertyValue("Recording", False);
 
-    double* raw = static_cast<double*>(dataPacket.getRawData());
-    for (auto i = 0; i < sampleCount; ++i)
-        raw[i] = i < 50 ? 0.0 : 1.0;
+    const auto replay = instance.addFunctionBlock("ExampleReplay");
+    replay.setPropertyValue("FilePath", path);
+    replay.setPropertyValue("ReplaySpeed", 0.0);
+    ASSERT_EQ(replay.getSignals()[0].getDescriptor().getSampleType(), SampleType::Float32);
+    ASSERT_EQ(replay.getSignals()[0].getDomainSignal().getDescriptor().getRule().getType(), DataRuleType::Linear);
 
-    signal.sendPacket(dataPacket);
-    domainSignal.sendPacket(domainPacket);
-    std::vector<double> dummyReadData;
-    dummyReadData.resize(count);
+    const SizeT sampleCount = packetSize * packetCount;
+    auto reader = StreamReader(replay.getSignals()[0], SampleType::Float32, SampleType::Int64);
+    replay.setPropertyValue("Playing", True);
 
-    auto status = reader.read(dummyReadData.data(), &count);
+    std::vector<float> dummyReadData(sampleCount);
+    SizeT dummyCount = sampleCount;
+    auto status = reader.read(dummyReadData.data(), &dummyCount);
     ASSERT_EQ(status.getReadStatus(), ReadStatus::Event);
 
-    int retries = 20;
-    SizeT availableCount = 0;
-    while (availableCount < sampleCount && retries-- > 0)
+    int retries = 50;
+    while (reader.getAvailableCount() < sampleCount && retries-- > 0)
     {
         using namespace std::chrono_literals;
-        availableCount = reader.getAvailableCount();
         std::this_thread::sleep_for(100ms);
     }
-    ASSERT_GT(availableCount, 0);
+    ASSERT_EQ(reader.getAvailableCount(), sampleCount);
+    ASSERT_EQ(static_cast<Int>(replay.getPropertyValue("ReplayedSamples")), static_cast<Int>(sampleCount));
 
-    std::vector<double> output(sampleCount);
-    std::vector<uint64_t> domain(sampleCount);
+    std::vector<float> output(sampleCount);
+    std::vector<Int> domain(sampleCount);
     SizeT read = sampleCount;
-    status = reader.readWithDomain(output.data(), domain.data(), &read);
-
-    ASSERT_EQ(status.getReadStatus(), ReadStatus::Ok);
+    reader.readWithDomain(output.data(), domain.data(), &read);
     ASSERT_EQ(read, sampleCount);
-    ASSERT_NEAR(output.back(), 1.0, 0.05);
 
-    for (SizeT i = 51; i < read; ++i)
-        ASSERT_GE(output[i], output[i - 1]) << "Output is not monotonically increasing: y[" << i - 1 << "]=" << output[i - 1] << ", y[" << i
-                                            << "]=" << output[i];
+    for (SizeT i = 0; i < sampleCount; ++i)
+    {
+        ASSERT_EQ(output[i], static_cast<float>(i) / 100.0f) << "at sample " << i;
+        ASSERT_EQ(domain[i], startOffset + static_cast<Int>(i)) << "at sample " << i;
+    }
+
+    // Packets still held by the reader keep the file mapped
+    replay.setPropertyValue("Playing", False);
+    replay.setPropertyValue("FilePath", "");
+    std::error_code error;
+    std::filesystem::remove(path, error);
 }
 
-// Test 3: Testing attenuation of high frequencies
-TEST_F(ExampleIIRFilterTest, AttenuatesHighFrequencies)
+TEST_F(ExampleScaledIIRFilterTest, CanAddFilter)
 {
     const auto instance = Instance();
-    const auto fb = instance.addFunctionBlock("ExampleIIRFilter");
-    fb.setPropertyValue("CutoffFrequency", 5);
+    ASSERT_TRUE(instance.addFunctionBlock("ExampleScaledIIRFilter").assigned());
+}
 
-    const SizeT sampleCount = 200;
-    const double samplingRate = 1000.0;
-    const double signalFrequency = 100.0;
+TEST_F(ExampleScaledIIRFilterTest, HasPropertiesOfScalingAndIIRFilter)
+{
+    const auto instance = Instance();
+    const auto fused = instance.addFunctionBlock("ExampleScaledIIRFilter");
 
-    const auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).setValueRange(Range(-10.0, 10.0)).build();
+    for (const auto& id : {"ExampleScalingModule", "ExampleIIRFilter"})
+    {
+        const auto fb = instance.addFunctionBlock(id);
+        for (const auto& property : fb.getAllProperties())
+            ASSERT_TRUE(fused.hasProperty(property.getName())) << id << ": " << property.getName();
+    }
+}
 
-    const auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "HighFreqInput");
+// The fused function block in both modes produces exactly the output of the scaling function block
+// connected to the IIR filter
+TEST_F(ExampleScaledIIRFilterTest, MatchesScalingAndIIRChain)
+{
+    const auto instance = Instance();
+
+    const auto scaling = instance.addFunctionBlock("ExampleScalingModule");
+    const auto iir = instance.addFunctionBlock("ExampleIIRFilter");
+    const auto readerFused = instance.addFunctionBlock("ExampleScaledIIRFilter");
+    auto config = instance.getAvailableFunctionBlockTypes().get("ExampleScaledIIRFilter").createDefaultConfig();
+    config.setPropertyValue("PacketMode", True);
+    const auto packetFused = instance.addFunctionBlock("ExampleScaledIIRFilter", config);
+
+    for (const auto& fb : {scaling, readerFused, packetFused})
+    {
+        fb.setPropertyValue("Scale", 0.25);
+        fb.setPropertyValue("Offset", 3.0);
+    }
+    for (const auto& fb : {iir, readerFused, packetFused})
+    {
+        fb.setPropertyValue("FilterType", 1);
+        fb.setPropertyValue("Order", 6);
+        fb.setPropertyValue("CutoffFrequency", 40);
+    }
+
+    const SizeT sampleCount = 3000;
+
+    const auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Int16).setValueRange(Range(-1000, 1000)).build();
+    const auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Input");
 
     const auto domainDescriptor = DataDescriptorBuilder()
                                       .setSampleType(SampleType::UInt64)
-                                      .setTickResolution(Ratio(1, static_cast<Int>(samplingRate)))
+                                      .setTickResolution(Ratio(1, 1000))
                                       .setRule(LinearDataRule(1, 0))
                                       .setOrigin("1970-01-01T01:00:00+00:00")
                                       .build();
@@ -181,101 +1948,106 @@ TEST_F(ExampleIIRFilterTest, AttenuatesHighFrequencies)
     auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "Domain");
     signal.setDomainSignal(domainSignal);
 
-    fb.getInputPorts()[0].connect(signal);
+    scaling.getInputPorts()[0].connect(signal);
+    iir.getInputPorts()[0].connect(scaling.getSignals()[0]);
+    readerFused.getInputPorts()[0].connect(signal);
+    packetFused.getInputPorts()[0].connect(signal);
 
-    auto reader = StreamReader(fb.getSignals()[0], SampleType::Float64, SampleType::UInt64);
+    std::vector<StreamReaderPtr> readers;
+    for (const auto& fb : {iir, readerFused, packetFused})
+        readers.push_back(StreamReader(fb.getSignals()[0], SampleType::Float64, SampleType::UInt64));
 
     auto domainPacket = DataPacket(domainDescriptor, sampleCount, 0);
     auto dataPacket = DataPacketWithDomain(domainPacket, dataDescriptor, sampleCount);
-    double* raw = static_cast<double*>(dataPacket.getRawData());
-    const int amplitude = 10;
-    double inputEnergy = 0;
-
+    int16_t* raw = static_cast<int16_t*>(dataPacket.getRawData());
     for (SizeT i = 0; i < sampleCount; ++i)
-    {
-        double timeInSeconds = static_cast<double>(i) / samplingRate;
-        double inputSample = amplitude * std::sin(2 * M_PI * signalFrequency * timeInSeconds);
-        raw[i] = inputSample;
-        inputEnergy += inputSample * inputSample;
-    }
+        raw[i] = static_cast<int16_t>(i % 50 < 25 ? 1000 : -1000);
 
     signal.sendPacket(dataPacket);
     domainSignal.sendPacket(domainPacket);
 
-    std::vector<double> dummyReadData(sampleCount);
-    SizeT dummyCount = sampleCount;
-    auto status = reader.read(dummyReadData.data(), &dummyCount);
-    ASSERT_EQ(status.getReadStatus(), ReadStatus::Event);
-
-    int retries = 20;
-    SizeT availableCount = 0;
-    while (availableCount < sampleCount && retries-- > 0)
+    std::vector<std::vector<double>> outputs(readers.size(), std::vector<double>(sampleCount));
+    std::vector<std::vector<uint64_t>> domains(readers.size(), std::vector<uint64_t>(sampleCount));
+    for (SizeT r = 0; r < readers.size(); ++r)
     {
-        using namespace std::chrono_literals;
-        availableCount = reader.getAvailableCount();
-        std::this_thread::sleep_for(100ms);
+        auto& reader = readers[r];
+
+        std::vector<double> dummyReadData(sampleCount);
+        SizeT dummyCount = sampleCount;
+        auto status = reader.read(dummyReadData.data(), &dummyCount);
+        ASSERT_EQ(status.getReadStatus(), ReadStatus::Event);
+
+        int retries = 20;
+        SizeT availableCount = 0;
+        while (availableCount < sampleCount && retries-- > 0)
+        {
+            using namespace std::chrono_literals;
+            availableCount = reader.getAvailableCount();
+            std::this_thread::sleep_for(100ms);
+        }
+        ASSERT_EQ(availableCount, sampleCount);
+
+        SizeT read = sampleCount;
+        reader.readWithDomain(outputs[r].data(), domains[r].data(), &read);
+        ASSERT_EQ(read, sampleCount);
     }
-    ASSERT_GT(availableCount, 0);
-
-    std::vector<double> output(sampleCount);
-    std::vector<uint64_t> domain(sampleCount);
-    SizeT read = sampleCount;
-    status = reader.readWithDomain(output.data(), domain.data(), &read);
 
-    ASSERT_EQ(status.getReadStatus(), ReadStatus::Ok);
-    ASSERT_EQ(read, sampleCount);
+    ASSERT_EQ(outputs[1], outputs[0]);
+    ASSERT_EQ(outputs[2], outputs[0]);
+    ASSERT_EQ(domains[1], domains[0]);
+    ASSERT_EQ(domains[2], domains[0]);
 
-    double outputEnergy = 0;
-    for (SizeT i = 0; i < read; ++i)
-        outputEnergy += output[i] * output[i];
+    const auto range = readerFused.getSignals()[0].getDescriptor().getValueRange();
+    ASSERT_DOUBLE_EQ(static_cast<double>(range.getLowValue()), -247.0);
+    ASSERT_DOUBLE_EQ(static_cast<double>(range.getHighValue()), 253.0);
+}
 
-    const SizeT maxExpectedTotalOutputEnergy = 28;
-    ASSERT_LT(outputEnergy, maxExpectedTotalOutputEnergy);
-    ASSERT_LT(outputEnergy, inputEnergy * 0.1);
+TEST_F(ExampleOperatorChainTest, CanAddOperatorChain)
+{
+    const auto instance = Instance();
+    ASSERT_TRUE(instance.addFunctionBlock("ExampleOperatorChain").assigned());
 }
 
-// Test 4: Testing attenuation of low frequencies
-TEST_F(ExampleIIRFilterTest, PassesLowFrequencies)
+TEST_F(ExampleOperatorChainTest, InvalidOperatorThrows)
 {
     const auto instance = Instance();
-    const auto fb = instance.addFunctionBlock("ExampleIIRFilter");
-    fb.setPropertyValue("CutoffFrequency", 50);
+    const auto fb = instance.addFunctionBlock("ExampleOperatorChain");
 
-    const SizeT sampleCount = 100;
-    const double samplingRate = 1000.0;
-    const double signalFrequency = 0.1;
+    EXPECT_THROW(fb.setPropertyValue("Operators", List<IString>("Gain")), daq::GeneralErrorException);
+    EXPECT_THROW(fb.setPropertyValue("Operators", List<IString>("Offset 1", "Clamp 1 0")), daq::GeneralErrorException);
+    EXPECT_NO_THROW(fb.setPropertyValue("Operators", List<IString>("Offset 1", "Clamp 0 1")));
+}
 
-    const auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).setValueRange(Range(-10.0, 10.0)).build();
+// A chain without a specialized kernel applies its operators in order to the native input samples
+TEST_F(ExampleOperatorChainTest, AppliesOperators)
+{
+    const auto instance = Instance();
+    const auto fb = instance.addFunctionBlock("ExampleOperatorChain");
+    fb.setPropertyValue("Operators", List<IString>("Offset -100", "DeadBand 20", "Abs", "Gain 0.5", "Clamp 0 200"));
 
-    const auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "LowFreqInput");
+    const SizeT sampleCount = 1000;
+
+    const auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Int16).setValueRange(Range(-1000, 1000)).build();
+    const auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Input");
 
     const auto domainDescriptor = DataDescriptorBuilder()
                                       .setSampleType(SampleType::UInt64)
-                                      .setTickResolution(Ratio(1, static_cast<Int>(samplingRate)))
+                                      .setTickResolution(Ratio(1, 1000))
                                       .setRule(LinearDataRule(1, 0))
                                       .setOrigin("1970-01-01T01:00:00+00:00")
                                       .build();
 
     auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "Domain");
     signal.setDomainSignal(domainSignal);
-
     fb.getInputPorts()[0].connect(signal);
 
     auto reader = StreamReader(fb.getSignals()[0], SampleType::Float64, SampleType::UInt64);
 
     auto domainPacket = DataPacket(domainDescriptor, sampleCount, 0);
     auto dataPacket = DataPacketWithDomain(domainPacket, dataDescriptor, sampleCount);
-    double* raw = static_cast<double*>(dataPacket.getRawData());
-    const int amplitude = 10;
-    double inputEnergy = 0;
-
+    int16_t* raw = static_cast<int16_t*>(dataPacket.getRawData());
     for (SizeT i = 0; i < sampleCount; ++i)
-    {
-        double timeInSeconds = static_cast<double>(i) / samplingRate;
-        double inputSample = amplitude * std::sin(2 * M_PI * signalFrequency * timeInSeconds);
-        raw[i] = inputSample;
-        inputEnergy += inputSample * inputSample;
-    }
+        raw[i] = static_cast<int16_t>(static_cast<Int>(i) - 500);
 
     signal.sendPacket(dataPacket);
     domainSignal.sendPacket(domainPacket);
@@ -293,87 +2065,114 @@ TEST_F(ExampleIIRFilterTest, PassesLowFrequencies)
         availableCount = reader.getAvailableCount();
         std::this_thread::sleep_for(100ms);
     }
-    ASSERT_GT(availableCount, 0);
+    ASSERT_EQ(availableCount, sampleCount);
 
     std::vector<double> output(sampleCount);
-    std::vector<uint64_t> domain(sampleCount);
     SizeT read = sampleCount;
-    status = reader.readWithDomain(output.data(), domain.data(), &read);
-
-    ASSERT_EQ(status.getReadStatus(), ReadStatus::Ok);
+    reader.read(output.data(), &read);
     ASSERT_EQ(read, sampleCount);
 
-    double outputEnergy = 0;
-    for (SizeT i = 0; i < read; ++i)
-        outputEnergy += output[i] * output[i];
+    for (SizeT i = 0; i < sampleCount; ++i)
+    {
+        const double x = static_cast<double>(i) - 600.0;
+        const double expected = std::abs(x) < 20.0 ? 0.0 : std::min(std::abs(x) * 0.5, 200.0);
+        ASSERT_EQ(output[i], expected) << i;
+    }
 
-    ASSERT_GT(outputEnergy, inputEnergy * 0.9);
+    // [-1000, 1000] is shifted to [-1100, 900], folded to [0, 1100] by Abs, halved and clamped
+    const auto range = fb.getSignals()[0].getDescriptor().getValueRange();
+    ASSERT_DOUBLE_EQ(static_cast<double>(range.getLowValue()), 0.0);
+    ASSERT_DOUBLE_EQ(static_cast<double>(range.getHighValue()), 200.0);
 }
 
-// Test 5: Testing valid range of cutoff frequency
-TEST_F(ExampleIIRFilterTest, CutoffFrequencyInValidRange)
+TEST_F(ExampleStatisticsTest, CanAddStatistics)
 {
     const auto instance = Instance();
-    const auto fb = instance.addFunctionBlock("ExampleIIRFilter");
-
-    const double sampleRate = 1000.0;
-    const auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).setValueRange(Range(0.0, 1.0)).build();
-
-    const auto domainDescriptor = DataDescriptorBuilder()
-                                      .setSampleType(SampleType::UInt64)
-                                      .setTickResolution(Ratio(1, static_cast<Int>(sampleRate)))
-                                      .setRule(LinearDataRule(1, 0))
-                                      .build();
-
-    const auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Input");
-    const auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "Domain");
-
-    signal.setDomainSignal(domainSignal);
-    fb.getInputPorts()[0].connect(signal);
-
-    const Int defaultCutoff = fb.getPropertyValue("CutoffFrequency");
+    ASSERT_TRUE(instance.addFunctionBlock("ExampleStatistics").assigned());
+}
 
-    ASSERT_GT(defaultCutoff, 0);
-    const Int maxAllowed = static_cast<Int>(sampleRate / 2) - 1;
-    ASSERT_LT(defaultCutoff, maxAllowed);
+TEST_F(ExampleStatisticsTest, InvalidHopThrows)
+{
+    const auto instance = Instance();
+    const auto fb = instance.addFunctionBlock("ExampleStatistics");
 
-    const std::vector<Int> validValues = {1, 10, 100, 400, maxAllowed};
-    for (const auto& val : validValues)
-    {
-        fb.setPropertyValue("CutoffFrequency", val);
-        const Int readBack = fb.getPropertyValue("CutoffFrequency");
-        ASSERT_EQ(readBack, val) << "The set value was not stored correctly:: " << val;
-    }
+    EXPECT_THROW(fb.setPropertyValue("HopDuration", 2.0), daq::GeneralErrorException);
+    EXPECT_NO_THROW(fb.setPropertyValue("WindowDuration", 4.0));
+    EXPECT_THROW(fb.setPropertyValue("WindowDuration", 0.0), daq::GeneralErrorException);
+    EXPECT_NO_THROW(fb.setPropertyValue("WindowDuration", 2.0));
+    EXPECT_NO_THROW(fb.setPropertyValue("HopDuration", 0.25));
 }
 
-// Test 6: Testing invalid values for cutoff frequency
-TEST_F(ExampleIIRFilterTest, InvalidCutoffFrequencyThrows)
+// Overlapping windows of a ramp; each window mean is stamped with the domain value of its first sample
+TEST_F(ExampleStatisticsTest, ComputesWindowStatistics)
 {
     const auto instance = Instance();
-    const auto fb = instance.addFunctionBlock("ExampleIIRFilter");
+    const auto fb = instance.addFunctionBlock("ExampleStatistics");
+    fb.setPropertyValue("WindowDuration", 1.0);
+    fb.setPropertyValue("HopDuration", 0.5);
 
-    // Konfiguracija za sampleRate
-    const double sampleRate = 1000.0;
-    const auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).setValueRange(Range(0.0, 1.0)).build();
+    const SizeT sampleCount = 3000;
+    const SizeT startOffset = 1000;
+    const SizeT windowCount = 5;
+
+    const auto dataDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).setValueRange(Range(0, 5000)).build();
+    const auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Input");
 
     const auto domainDescriptor = DataDescriptorBuilder()
                                       .setSampleType(SampleType::UInt64)
-                                      .setTickResolution(Ratio(1, static_cast<Int>(sampleRate)))
+                                      .setTickResolution(Ratio(1, 1000))
                                       .setRule(LinearDataRule(1, 0))
+                                      .setOrigin("1970-01-01T01:00:00+00:00")
                                       .build();
 
-    const auto signal = SignalWithDescriptor(instance.getContext(), dataDescriptor, nullptr, "Input");
-    const auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "Domain");
+    auto domainSignal = SignalWithDescriptor(instance.getContext(), domainDescriptor, nullptr, "Domain");
     signal.setDomainSignal(domainSignal);
     fb.getInputPorts()[0].connect(signal);
 
-    const Int nyquistLimit = static_cast<Int>(sampleRate / 2);
-    const Int maxValid = nyquistLimit - 1;
+    // Min, Max, Mean, RMS, StdDev
+    const auto meanSignal = fb.getSignals()[2];
+    auto reader = StreamReader(meanSignal, SampleType::Float64, SampleType::UInt64);
 
-    EXPECT_THROW(fb.setPropertyValue("CutoffFrequency", -1), daq::GeneralErrorException);
-    EXPECT_THROW(fb.setPropertyValue("CutoffFrequency", 0), daq::GeneralErrorException);
-    EXPECT_THROW(fb.setPropertyValue("CutoffFrequency", nyquistLimit), daq::GeneralErrorException);
+    auto domainPacket = DataPacket(domainDescriptor, sampleCount, startOffset);
+    auto dataPacket = DataPacketWithDomain(domainPacket, dataDescriptor, sampleCount);
+    double* raw = static_cast<double*>(dataPacket.getRawData());
+    for (SizeT i = 0; i < sampleCount; ++i)
+        raw[i] = static_cast<double>(i);
 
-    EXPECT_NO_THROW(fb.setPropertyValue("CutoffFrequency", 1));
-    EXPECT_NO_THROW(fb.setPropertyValue("CutoffFrequency", maxValid));
+    signal.sendPacket(dataPacket);
+    domainSignal.sendPacket(domainPacket);
+
+    std::vector<double> dummyReadData(windowCount);
+    SizeT dummyCount = windowCount;
+    auto status = reader.read(dummyReadData.data(), &dummyCount);
+    ASSERT_EQ(status.getReadStatus(), ReadStatus::Event);
+
+    int retries = 20;
+    SizeT availableCount = 0;
+    while (availableCount < windowCount && retries-- > 0)
+    {
+        using namespace std::chrono_literals;
+        availableCount = reader.getAvailableCount();
+        std::this_thread::sleep_for(100ms);
+    }
+    ASSERT_EQ(availableCount, windowCount);
+
+    const auto outputDomainRule = meanSignal.getDomainSignal().getDescriptor().getRule();
+    ASSERT_EQ(static_cast<Int>(outputDomainRule.getParameters().get("delta")), 500);
+
+    std::vector<double> output(windowCount);
+    std::vector<uint64_t> domain(windowCount);
+    SizeT read = windowCount;
+    reader.readWithDomain(output.data(), domain.data(), &read);
+    ASSERT_EQ(read, windowCount);
+
+    for (SizeT i = 0; i < windowCount; ++i)
+    {
+        ASSERT_EQ(domain[i], startOffset + 500 * i) << "at window " << i;
+        ASSERT_NEAR(output[i], static_cast<double>(500 * i) + 499.5, 1e-9) << "at window " << i;
+    }
+
+    // The standard deviation of a window is at most half the input range
+    const auto stdDevRange = fb.getSignals()[4].getDescriptor().getValueRange();
+    ASSERT_DOUBLE_EQ(static_cast<double>(stdDevRange.getHighValue()), 2500.0);
 }
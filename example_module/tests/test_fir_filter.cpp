@@ -0,0 +1,218 @@
+#include <gtest/gtest.h>
+#include "test_signals.h"
+#include <example_module/fft.h>
+#include <example_module/fir_design.h>
+#include <example_module/fir_filter.h>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+using namespace daq;
+using namespace daq::modules::example_module;
+using test_signals::createNoise;
+
+using FirFilterTest = testing::Test;
+
+namespace
+{
+    constexpr double SampleRate = 1000.0;
+
+    // Reference convolution with zero history
+    std::vector<double> convolve(const std::vector<double>& taps, const std::vector<double>& input)
+    {
+        std::vector<double> output(input.size(), 0.0);
+        for (SizeT n = 0; n < input.size(); ++n)
+        {
+            for (SizeT k = 0; k < taps.size() && k <= n; ++k)
+                output[n] += taps[k] * input[n - k];
+        }
+        return output;
+    }
+
+    FirSpec createSpec(FilterResponse response, SizeT tapCount)
+    {
+        FirSpec spec;
+        spec.response = response;
+        spec.tapCount = tapCount;
+        spec.sampleRate = SampleRate;
+        spec.cutoffFrequency = 100.0;
+        spec.upperCutoffFrequency = 200.0;
+        return spec;
+    }
+}
+
+TEST_F(FirFilterTest, FftMatchesDft)
+{
+    for (const SizeT size : {SizeT(4), SizeT(8), SizeT(64), SizeT(1024)})
+    {
+        const auto input = createNoise(size, 1);
+        const auto plan = FftPlan::get(size);
+
+        std::vector<double> re(plan->getBinCount());
+        std::vector<double> im(plan->getBinCount());
+        plan->forward(input.data(), re.data(), im.data());
+
+        for (SizeT k = 0; k < plan->getBinCount(); ++k)
+        {
+            std::complex<double> expected = 0.0;
+            for (SizeT n = 0; n < size; ++n)
+                expected += input[n] * std::polar(1.0, -2.0 * M_PI * static_cast<double>(k * n) / static_cast<double>(size));
+
+            ASSERT_NEAR(re[k], expected.real(), 1e-9) << "size " << size << ", bin " << k;
+            ASSERT_NEAR(im[k], expected.imag(), 1e-9) << "size " << size << ", bin " << k;
+        }
+
+        std::vector<double> output(size);
+        plan->inverse(re.data(), im.data(), output.data());
+        for (SizeT n = 0; n < size; ++n)
+            ASSERT_NEAR(output[n], input[n], 1e-12) << "size " << size << ", sample " << n;
+    }
+}
+
+TEST_F(FirFilterTest, FftStageKernelsMatchScalar)
+{
+    const SizeT size = 4096;
+    const auto input = createNoise(size, 6);
+
+    const FftPlan scalar(size, SimdLevel::Scalar);
+    std::vector<double> expectedRe(scalar.getBinCount());
+    std::vector<double> expectedIm(scalar.getBinCount());
+    scalar.forward(input.data(), expectedRe.data(), expectedIm.data());
+
+    for (const auto level : {SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512})
+    {
+        if (level > getSimdLevel())
+            continue;
+
+        const FftPlan plan(size, level);
+        std::vector<double> re(plan.getBinCount());
+        std::vector<double> im(plan.getBinCount());
+        plan.forward(input.data(), re.data(), im.data());
+        ASSERT_EQ(re, expectedRe) << simdLevelName(level);
+        ASSERT_EQ(im, expectedIm) << simdLevelName(level);
+    }
+}
+
+TEST_F(FirFilterTest, PlansAreShared)
+{
+    const auto first = FftPlan::get(256);
+    const auto second = FftPlan::get(256);
+    ASSERT_EQ(first.get(), second.get());
+    ASSERT_NE(first.get(), FftPlan::get(512).get());
+}
+
+class FirMethodTest : public testing::TestWithParam<SizeT>
+{
+};
+
+// Both methods match the reference convolution, for blocks that do not align with the internal block sizes
+TEST_P(FirMethodTest, MatchesConvolution)
+{
+    const SizeT tapCount = GetParam();
+    const auto taps = createNoise(tapCount, 2);
+    const auto input = createNoise(5000, 3);
+    const auto expected = convolve(taps, input);
+
+    for (const auto method : {FirMethod::Direct, FirMethod::Fft})
+    {
+        FirFilter filter;
+        filter.setTaps(taps, method);
+
+        std::vector<double> actual = input;
+        SizeT position = 0;
+        for (const SizeT blockSize : {SizeT(1), SizeT(13), SizeT(1024), SizeT(1500), SizeT(2462)})
+        {
+            filter.process(actual.data() + position, actual.data() + position, blockSize);
+            position += blockSize;
+        }
+        ASSERT_EQ(position, input.size());
+
+        for (SizeT i = 0; i < input.size(); ++i)
+            ASSERT_NEAR(actual[i], expected[i], 1e-9) << (method == FirMethod::Direct ? "direct" : "FFT") << " at sample " << i;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(TapCounts, FirMethodTest, testing::Values(SizeT(1), SizeT(2), SizeT(7), SizeT(64), SizeT(65), SizeT(1000), SizeT(4097)));
+
+TEST_F(FirFilterTest, DirectKernelsMatchScalar)
+{
+    const auto taps = createNoise(37, 4);
+    const auto input = createNoise(3000, 5);
+
+    DirectFirFilter scalar;
+    scalar.setSimdLevel(SimdLevel::Scalar);
+    scalar.setTaps(taps);
+    std::vector<double> expected(input.size());
+    scalar.process(input.data(), expected.data(), input.size());
+
+    for (const auto level : {SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512})
+    {
+        if (level > getSimdLevel())
+            continue;
+
+        DirectFirFilter filter;
+        filter.setSimdLevel(level);
+        filter.setTaps(taps);
+        std::vector<double> actual(input.size());
+        filter.process(input.data(), actual.data(), input.size());
+        ASSERT_EQ(actual, expected) << simdLevelName(level);
+    }
+}
+
+TEST_F(FirFilterTest, MethodFollowsTapCount)
+{
+    FirFilter filter;
+    filter.setTaps(std::vector<double>(FirFilter::DirectMaxTaps, 0.1));
+    ASSERT_EQ(filter.getMethod(), FirMethod::Direct);
+
+    filter.setTaps(std::vector<double>(FirFilter::DirectMaxTaps + 1, 0.1));
+    ASSERT_EQ(filter.getMethod(), FirMethod::Fft);
+}
+
+TEST_F(FirFilterTest, DesignIsLinearPhase)
+{
+    for (const auto response : {FilterResponse::LowPass, FilterResponse::HighPass, FilterResponse::BandPass, FilterResponse::BandStop})
+    {
+        const auto taps = designFirFilter(createSpec(response, 201));
+        for (SizeT n = 0; n < taps.size(); ++n)
+            ASSERT_DOUBLE_EQ(taps[n], taps[taps.size() - 1 - n]);
+    }
+}
+
+TEST_F(FirFilterTest, DesignHasExpectedGains)
+{
+    const double pass = 1e-2;
+    const double stop = 1e-2;
+    const auto gain = [](const std::vector<double>& taps, double frequency) { return fir_design::gainAt(taps, frequency / SampleRate); };
+
+    const auto lowPass = designFirFilter(createSpec(FilterResponse::LowPass, 201));
+    EXPECT_NEAR(gain(lowPass, 0.0), 1.0, pass);
+    EXPECT_NEAR(gain(lowPass, 50.0), 1.0, pass);
+    EXPECT_LT(gain(lowPass, 150.0), stop);
+
+    const auto highPass = designFirFilter(createSpec(FilterResponse::HighPass, 201));
+    EXPECT_LT(gain(highPass, 50.0), stop);
+    EXPECT_NEAR(gain(highPass, 300.0), 1.0, pass);
+
+    const auto bandPass = designFirFilter(createSpec(FilterResponse::BandPass, 201));
+    EXPECT_NEAR(gain(bandPass, 150.0), 1.0, pass);
+    EXPECT_LT(gain(bandPass, 50.0), stop);
+    EXPECT_LT(gain(bandPass, 300.0), stop);
+
+    const auto bandStop = designFirFilter(createSpec(FilterResponse::BandStop, 201));
+    EXPECT_LT(gain(bandStop, 150.0), stop);
+    EXPECT_NEAR(gain(bandStop, 50.0), 1.0, pass);
+    EXPECT_NEAR(gain(bandStop, 300.0), 1.0, pass);
+}
+
+TEST_F(FirFilterTest, InvalidSpecificationThrows)
+{
+    ASSERT_THROW(designFirFilter(createSpec(FilterResponse::LowPass, 0)), std::invalid_argument);
+    ASSERT_THROW(designFirFilter(createSpec(FilterResponse::LowPass, MaxFirTapCount + 1)), std::invalid_argument);
+    ASSERT_THROW(designFirFilter(createSpec(FilterResponse::HighPass, 100)), std::invalid_argument);
+    ASSERT_NO_THROW(designFirFilter(createSpec(FilterResponse::LowPass, 100)));
+
+    auto spec = createSpec(FilterResponse::BandPass, 101);
+    spec.upperCutoffFrequency = spec.cutoffFrequency;
+    ASSERT_THROW(designFirFilter(spec), std::invalid_argument);
+}
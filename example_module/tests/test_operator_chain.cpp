@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include <example_module/operator_chain.h>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace daq;
+using namespace daq::modules::example_module;
+
+class OperatorChainKernelsTest : public testing::TestWithParam<SampleType>
+{
+};
+
+using OperatorChainTest = testing::Test;
+
+namespace
+{
+    template <SampleType InputType>
+    void fillInput(std::vector<uint8_t>& buffer, SizeT count)
+    {
+        using InputT = typename SampleTypeToType<InputType>::Type;
+
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<int> dist(0, 100);
+        buffer.resize(count * sizeof(InputT));
+        auto* data = reinterpret_cast<InputT*>(buffer.data());
+        for (SizeT i = 0; i < count; ++i)
+            data[i] = static_cast<InputT>(dist(gen));
+    }
+
+    std::vector<ChainOperator> parseOperators(const std::vector<std::string>& texts)
+    {
+        std::vector<ChainOperator> operators;
+        for (const auto& text : texts)
+            operators.push_back(parseChainOperator(text));
+        return operators;
+    }
+
+    double applyReference(double x, const std::vector<ChainOperator>& operators)
+    {
+        for (const auto& op : operators)
+        {
+            switch (op.type)
+            {
+                case ChainOperatorType::Offset:
+                    x = x + op.a;
+                    break;
+                case ChainOperatorType::Gain:
+                    x = x * op.a;
+                    break;
+                case ChainOperatorType::Clamp:
+                    x = x < op.a ? op.a : (x > op.b ? op.b : x);
+                    break;
+                case ChainOperatorType::Abs:
+                    x = std::fabs(x);
+                    break;
+                case ChainOperatorType::Square:
+                    x = x * x;
+                    break;
+                case ChainOperatorType::DeadBand:
+                    x = std::fabs(x) < op.a ? 0.0 : x;
+                    break;
+                case ChainOperatorType::Convert:
+                    x = x * op.a + op.b;
+                    break;
+            }
+        }
+        return x;
+    }
+}
+
+TEST_P(OperatorChainKernelsTest, KernelsMatchInterpreterAndReference)
+{
+    const auto sampleType = GetParam();
+    const SizeT count = 1337;
+
+    std::vector<uint8_t> input;
+    SAMPLE_TYPE_DISPATCH(sampleType, fillInput, input, count)
+
+    std::vector<double> values(count);
+    const auto convert = getOperatorChainKernel(sampleType, {});
+    convert(input.data(), values.data(), count, nullptr);
+
+    const std::vector<std::vector<std::string>> chains = {{},
+                                                          {"Gain 0.5"},
+                                                          {"Gain 0.25", "Offset -10", "Clamp -5 5"},
+                                                          {"Offset -50", "Square"},
+                                                          {"Offset -50", "Gain 1.5", "DeadBand 10", "Abs", "Clamp 0 60"},
+                                                          {"Convert 1.8 32", "Square", "Gain 0.001"}};
+
+    for (const auto& texts : chains)
+    {
+        OperatorChain chain;
+        chain.setOperators(parseOperators(texts), sampleType);
+
+        std::vector<double> processed(count);
+        std::vector<double> interpreted(count);
+        chain.process(input.data(), processed.data(), count);
+        chain.interpret(input.data(), interpreted.data(), count);
+
+        ASSERT_EQ(std::memcmp(processed.data(), interpreted.data(), count * sizeof(double)), 0) << texts.size() << " operators";
+        for (SizeT i = 0; i < count; ++i)
+            ASSERT_EQ(processed[i], applyReference(values[i], chain.getOperators())) << texts.size() << " operators, sample " << i;
+    }
+}
+
+TEST_F(OperatorChainTest, ParsesOperators)
+{
+    const auto clamp = parseChainOperator("Clamp -1.5 2");
+    ASSERT_EQ(clamp.type, ChainOperatorType::Clamp);
+    ASSERT_EQ(clamp.a, -1.5);
+    ASSERT_EQ(clamp.b, 2.0);
+
+    const auto gain = parseChainOperator("  Gain   3 ");
+    ASSERT_EQ(gain.type, ChainOperatorType::Gain);
+    ASSERT_EQ(gain.a, 3.0);
+
+    ASSERT_EQ(parseChainOperator("Abs").type, ChainOperatorType::Abs);
+    ASSERT_EQ(parseChainOperator("Convert 1.8 32").b, 32.0);
+}
+
+TEST_F(OperatorChainTest, RejectsInvalidOperators)
+{
+    for (const auto& text : {"", "Scale 2", "Gain", "Gain x", "Gain 2 3", "Abs 1", "Clamp 1", "Clamp 2 1", "DeadBand -1", "Offset inf"})
+        ASSERT_THROW(parseChainOperator(text), std::invalid_argument) << text;
+}
+
+TEST_F(OperatorChainTest, CommonSequencesAreSpecialized)
+{
+    OperatorChain chain;
+    chain.setOperators(parseOperators({"Gain 2", "Offset 1"}), SampleType::Int16);
+    ASSERT_TRUE(chain.isSpecialized());
+
+    chain.setOperators(parseOperators({}), SampleType::UInt64);
+    ASSERT_TRUE(chain.isSpecialized());
+
+    chain.setOperators(parseOperators({"Offset 1", "Gain 2", "DeadBand 1", "Abs", "Clamp 0 1"}), SampleType::Float32);
+    ASSERT_FALSE(chain.isSpecialized());
+}
+
+TEST_F(OperatorChainTest, OutputRangeFollowsOperators)
+{
+    OperatorChain chain;
+    chain.setOperators(parseOperators({"Gain -2", "Offset 1"}), SampleType::Float64);
+    ASSERT_EQ(chain.getOutputRange(-1.0, 3.0), std::make_pair(-5.0, 3.0));
+
+    chain.setOperators(parseOperators({"Offset -1", "Square"}), SampleType::Float64);
+    ASSERT_EQ(chain.getOutputRange(-2.0, 3.0), std::make_pair(0.0, 9.0));
+
+    chain.setOperators(parseOperators({"Abs", "DeadBand 2", "Clamp 0 5"}), SampleType::Float64);
+    ASSERT_EQ(chain.getOutputRange(1.0, 10.0), std::make_pair(0.0, 5.0));
+}
+
+INSTANTIATE_TEST_SUITE_P(SampleTypes,
+                         OperatorChainKernelsTest,
+                         testing::Values(SampleType::Int8,
+                                         SampleType::Int16,
+                                         SampleType::Int32,
+                                         SampleType::Int64,
+                                         SampleType::UInt8,
+                                         SampleType::UInt16,
+                                         SampleType::UInt32,
+                                         SampleType::UInt64,
+                                         SampleType::Float32,
+                                         SampleType::Float64));
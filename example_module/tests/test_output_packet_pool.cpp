@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <example_module/output_packet_pool.h>
+#include <opendaq/data_descriptor_factory.h>
+#include <opendaq/opendaq.h>
+
+using namespace daq;
+using namespace daq::modules::example_module;
+
+using OutputPacketPoolTest = testing::Test;
+
+namespace
+{
+    DataDescriptorPtr createValueDescriptor(SampleType sampleType = SampleType::Float64)
+    {
+        return DataDescriptorBuilder().setSampleType(sampleType).setValueRange(Range(-10, 10)).build();
+    }
+
+    DataDescriptorPtr createDomainDescriptor()
+    {
+        return DataDescriptorBuilder()
+            .setSampleType(SampleType::Int64)
+            .setUnit(Unit("s", -1, "seconds", "time"))
+            .setTickResolution(Ratio(1, 1000))
+            .setRule(LinearDataRule(1, 0))
+            .setOrigin("1970-01-01T00:00:00+00:00")
+            .build();
+    }
+}
+
+TEST_F(OutputPacketPoolTest, NoAllocationsAfterWarmUp)
+{
+    OutputPacketPool pool;
+    pool.setDescriptor(createValueDescriptor());
+    const auto domainDescriptor = createDomainDescriptor();
+
+    // Warm-up: the first block allocates its buffer
+    {
+        const auto packet = pool.createPacket(DataPacket(domainDescriptor, 1024, 0), 1024);
+        ASSERT_EQ(packet.getSampleCount(), 1024u);
+    }
+    const auto allocationsAfterWarmUp = pool.getAllocationCount();
+    ASSERT_EQ(allocationsAfterWarmUp, 1u);
+
+    for (SizeT i = 1; i < 1000; ++i)
+    {
+        const auto packet = pool.createPacket(DataPacket(domainDescriptor, 1024, i * 1024), 1024);
+        auto data = static_cast<double*>(packet.getRawData());
+        data[0] = 1.0;
+        data[1023] = 2.0;
+    }
+
+    ASSERT_EQ(pool.getAllocationCount(), allocationsAfterWarmUp);
+    ASSERT_EQ(pool.getFreeBufferCount(), 1u);
+}
+
+TEST_F(OutputPacketPoolTest, HeldPacketsGetSeparateBuffers)
+{
+    OutputPacketPool pool;
+    pool.setDescriptor(createValueDescriptor());
+    const auto domainDescriptor = createDomainDescriptor();
+
+    auto first = pool.createPacket(DataPacket(domainDescriptor, 16, 0), 16);
+    auto second = pool.createPacket(DataPacket(domainDescriptor, 16, 16), 16);
+    ASSERT_NE(first.getRawData(), second.getRawData());
+    ASSERT_EQ(pool.getAllocationCount(), 2u);
+
+    // Releasing one packet makes its buffer available again
+    void* const firstData = first.getRawData();
+    first.release();
+    const auto third = pool.createPacket(DataPacket(domainDescriptor, 16, 32), 16);
+    ASSERT_EQ(third.getRawData(), firstData);
+    ASSERT_EQ(pool.getAllocationCount(), 2u);
+}
+
+TEST_F(OutputPacketPoolTest, BuffersAreKeyedBySampleCount)
+{
+    OutputPacketPool pool;
+    pool.setDescriptor(createValueDescriptor());
+    const auto domainDescriptor = createDomainDescriptor();
+
+    for (SizeT i = 0; i < 10; ++i)
+    {
+        pool.createPacket(DataPacket(domainDescriptor, 100, 0), 100);
+        pool.createPacket(DataPacket(domainDescriptor, 200, 0), 200);
+    }
+
+    ASSERT_EQ(pool.getAllocationCount(), 2u);
+    ASSERT_EQ(pool.getFreeBufferCount(), 2u);
+}
+
+TEST_F(OutputPacketPoolTest, DescriptorChangeDropsBuffers)
+{
+    OutputPacketPool pool;
+    pool.setDescriptor(createValueDescriptor());
+    const auto domainDescriptor = createDomainDescriptor();
+
+    auto heldPacket = pool.createPacket(DataPacket(domainDescriptor, 64, 0), 64);
+    pool.createPacket(DataPacket(domainDescriptor, 64, 64), 64);
+    ASSERT_EQ(pool.getFreeBufferCount(), 1u);
+
+    pool.setDescriptor(createValueDescriptor(SampleType::Float32));
+    ASSERT_EQ(pool.getFreeBufferCount(), 0u);
+
+    // Buffers of the previous descriptor are freed rather than recycled
+    heldPacket.release();
+    ASSERT_EQ(pool.getFreeBufferCount(), 0u);
+
+    const auto packet = pool.createPacket(DataPacket(domainDescriptor, 64, 128), 64);
+    ASSERT_EQ(packet.getDataDescriptor().getSampleType(), SampleType::Float32);
+    ASSERT_EQ(pool.getAllocationCount(), 3u);
+}
+
+TEST_F(OutputPacketPoolTest, PacketsOutlivePool)
+{
+    DataPacketPtr packet;
+    {
+        OutputPacketPool pool;
+        pool.setDescriptor(createValueDescriptor());
+        packet = pool.createPacket(DataPacket(createDomainDescriptor(), 32, 0), 32);
+    }
+
+    auto data = static_cast<double*>(packet.getRawData());
+    for (SizeT i = 0; i < 32; ++i)
+        data[i] = static_cast<double>(i);
+    ASSERT_EQ(data[31], 31.0);
+}
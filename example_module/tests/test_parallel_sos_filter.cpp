@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include "test_signals.h"
+#include <example_module/filter_design.h>
+#include <example_module/parallel_sos_filter.h>
+#include <example_module/worker_pool.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <tuple>
+#include <vector>
+
+using namespace daq;
+using namespace daq::modules::example_module;
+using test_signals::createNoise;
+
+using ParallelSosFilterTest = testing::Test;
+
+namespace
+{
+    constexpr double SampleRate = 10e6;
+
+    double maxAbs(const std::vector<double>& values)
+    {
+        double result = 0.0;
+        for (const double value : values)
+            result = std::max(result, std::abs(value));
+        return result;
+    }
+}
+
+TEST_F(ParallelSosFilterTest, WorkerPoolRunsEveryTaskOnce)
+{
+    WorkerPool pool(4);
+    for (const SizeT taskCount : {SizeT(1), SizeT(3), SizeT(4), SizeT(100)})
+    {
+        for (int job = 0; job < 50; ++job)
+        {
+            std::vector<std::atomic<int>> counts(taskCount);
+            pool.run(taskCount, [&counts](SizeT task) { ++counts[task]; });
+
+            for (SizeT task = 0; task < taskCount; ++task)
+                ASSERT_EQ(counts[task], 1) << "task " << task << " of " << taskCount;
+        }
+    }
+}
+
+using ParallelFilterParams = std::tuple<FilterFamily, FilterResponse, SizeT, double>;
+
+class ParallelSosFilterDesignTest : public testing::TestWithParam<ParallelFilterParams>
+{
+};
+
+// The output and the state carried to the next block match the serial filter within the documented tolerance
+TEST_P(ParallelSosFilterDesignTest, MatchesSerialFilter)
+{
+    const auto [family, response, order, cutoff] = GetParam();
+
+    FilterSpec spec;
+    spec.family = family;
+    spec.response = response;
+    spec.order = order;
+    spec.sampleRate = SampleRate;
+    spec.cutoffFrequency = cutoff;
+    spec.upperCutoffFrequency = cutoff * 2.0;
+    const auto sections = designSosFilter(spec);
+
+    SosFilter serial(sections);
+    ParallelSosFilter parallel;
+    parallel.setSections(sections);
+    parallel.setWorkerPool(std::make_shared<WorkerPool>(4));
+    parallel.setSegmentSize(1000);
+
+    const auto input = createNoise(60000, 3);
+    std::vector<double> expected(input.size());
+    serial.process(input.data(), expected.data(), input.size());
+
+    // Blocks below, at and above the segment size, with a partial first segment
+    std::vector<double> actual(input.size());
+    SizeT position = 0;
+    for (const SizeT blockSize : {SizeT(700), SizeT(1000), SizeT(1001), SizeT(8299), SizeT(20000), SizeT(29000)})
+    {
+        parallel.process(input.data() + position, actual.data() + position, blockSize);
+        position += blockSize;
+    }
+    ASSERT_EQ(position, input.size());
+
+    const double tolerance = 1e-8 * maxAbs(expected);
+    for (SizeT i = 0; i < input.size(); ++i)
+        ASSERT_NEAR(actual[i], expected[i], tolerance) << "at sample " << i;
+}
+
+INSTANTIATE_TEST_SUITE_P(Designs,
+                         ParallelSosFilterDesignTest,
+                         testing::Values(std::make_tuple(FilterFamily::Butterworth, FilterResponse::LowPass, SizeT(1), 100e3),
+                                         std::make_tuple(FilterFamily::Butterworth, FilterResponse::LowPass, SizeT(16), 10e3),
+                                         std::make_tuple(FilterFamily::ChebyshevI, FilterResponse::LowPass, SizeT(16), 10e3),
+                                         std::make_tuple(FilterFamily::ChebyshevII, FilterResponse::HighPass, SizeT(8), 10e3),
+                                         std::make_tuple(FilterFamily::Bessel, FilterResponse::LowPass, SizeT(8), 10e3),
+                                         std::make_tuple(FilterFamily::ChebyshevI, FilterResponse::BandPass, SizeT(8), 100e3),
+                                         std::make_tuple(FilterFamily::Butterworth, FilterResponse::BandStop, SizeT(6), 1e6)));
+
+TEST_F(ParallelSosFilterTest, SmallBlocksMatchSerialFilterExactly)
+{
+    FilterSpec spec;
+    spec.order = 6;
+    spec.sampleRate = SampleRate;
+    spec.cutoffFrequency = 50e3;
+    const auto sections = designSosFilter(spec);
+
+    SosFilter serial(sections);
+    ParallelSosFilter parallel;
+    parallel.setSections(sections);
+    parallel.setWorkerPool(std::make_shared<WorkerPool>(4));
+    parallel.setSegmentSize(4096);
+
+    const auto input = createNoise(4096, 5);
+    std::vector<double> expected(input.size());
+    std::vector<double> actual(input.size());
+    serial.process(input.data(), expected.data(), input.size());
+    parallel.process(input.data(), actual.data(), input.size());
+
+    ASSERT_EQ(actual, expected);
+}
+
+TEST_F(ParallelSosFilterTest, ProcessesInPlace)
+{
+    FilterSpec spec;
+    spec.order = 4;
+    spec.sampleRate = SampleRate;
+    spec.cutoffFrequency = 20e3;
+    const auto sections = designSosFilter(spec);
+
+    ParallelSosFilter outOfPlace;
+    ParallelSosFilter inPlace;
+    for (auto* filter : {&outOfPlace, &inPlace})
+    {
+        filter->setSections(sections);
+        filter->setWorkerPool(std::make_shared<WorkerPool>(3));
+        filter->setSegmentSize(512);
+    }
+
+    const auto input = createNoise(10000, 9);
+    std::vector<double> expected(input.size());
+    outOfPlace.process(input.data(), expected.data(), input.size());
+
+    auto actual = input;
+    inPlace.process(actual.data(), actual.data(), actual.size());
+
+    ASSERT_EQ(actual, expected);
+}
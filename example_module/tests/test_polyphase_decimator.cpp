@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include "test_signals.h"
+#include <example_module/fir_design.h>
+#include <example_module/polyphase_decimator.h>
+#include <cmath>
+#include <vector>
+
+using namespace daq;
+using namespace daq::modules::example_module;
+using test_signals::createNoise;
+
+using PolyphaseDecimatorTest = testing::Test;
+
+namespace
+{
+    constexpr double SampleRate = 1000.0;
+
+    // Reference: full-rate convolution with zero history, keeping every factor-th output
+    std::vector<double> filterThenDrop(const std::vector<double>& taps, const std::vector<double>& input, SizeT factor)
+    {
+        std::vector<double> output;
+        for (SizeT n = 0; n < input.size(); n += factor)
+        {
+            double acc = 0.0;
+            for (SizeT k = 0; k < taps.size() && k <= n; ++k)
+                acc += taps[k] * input[n - k];
+            output.push_back(acc);
+        }
+        return output;
+    }
+}
+
+TEST_F(PolyphaseDecimatorTest, MatchesFilterThenDrop)
+{
+    const auto input = createNoise(10000, 3);
+
+    for (const SizeT factor : {SizeT(1), SizeT(2), SizeT(3), SizeT(10), SizeT(64)})
+    {
+        const auto taps = designDecimationFilter(factor, 16, SampleRate);
+        const auto expected = filterThenDrop(taps, input, factor);
+
+        PolyphaseDecimator decimator;
+        decimator.setFilter(taps, factor);
+
+        // Blocks that split the output groups at every position
+        std::vector<double> output(expected.size() + 1);
+        SizeT position = 0;
+        SizeT produced = 0;
+        for (SizeT blockSize = 1; position < input.size(); blockSize = blockSize * 3 % 2048 + 1)
+        {
+            const SizeT count = std::min(blockSize, input.size() - position);
+            const SizeT outputCount = decimator.getOutputCount(count);
+            ASSERT_EQ(decimator.process(input.data() + position, count, output.data() + produced), outputCount);
+            position += count;
+            produced += outputCount;
+        }
+
+        ASSERT_EQ(produced, expected.size()) << "factor " << factor;
+        for (SizeT m = 0; m < expected.size(); ++m)
+            ASSERT_NEAR(output[m], expected[m], 1e-12) << "factor " << factor << ", output " << m;
+    }
+}
+
+TEST_F(PolyphaseDecimatorTest, OutputsAlignWithEveryFactorthSample)
+{
+    PolyphaseDecimator decimator;
+    decimator.setFilter({1.0}, 4);
+
+    // A single tap keeps samples 0, 4, 8, ...
+    std::vector<double> input(10);
+    for (SizeT n = 0; n < input.size(); ++n)
+        input[n] = static_cast<double>(n);
+
+    ASSERT_EQ(decimator.getSamplesUntilNextOutput(), 1u);
+
+    std::vector<double> output(3);
+    ASSERT_EQ(decimator.process(input.data(), 6, output.data()), 2u);
+    ASSERT_EQ(decimator.getSamplesUntilNextOutput(), 3u);
+    ASSERT_EQ(decimator.process(input.data() + 6, 4, output.data() + 2), 1u);
+    ASSERT_EQ(decimator.getSamplesUntilNextOutput(), 3u);
+
+    ASSERT_EQ(output, (std::vector<double>{0.0, 4.0, 8.0}));
+}
+
+TEST_F(PolyphaseDecimatorTest, SimdLevelsAreBitExact)
+{
+    const auto input = createNoise(5000, 5);
+    const auto taps = designDecimationFilter(5, 24, SampleRate);
+
+    PolyphaseDecimator reference;
+    reference.setSimdLevel(SimdLevel::Scalar);
+    reference.setFilter(taps, 5);
+    std::vector<double> expected(reference.getOutputCount(input.size()));
+    reference.process(input.data(), input.size(), expected.data());
+
+    for (const auto level : {SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512})
+    {
+        if (level > getSimdLevel())
+            continue;
+
+        PolyphaseDecimator decimator;
+        decimator.setSimdLevel(level);
+        decimator.setFilter(taps, 5);
+        std::vector<double> output(expected.size());
+        decimator.process(input.data(), input.size(), output.data());
+        ASSERT_EQ(output, expected) << simdLevelName(level);
+    }
+}
+
+TEST_F(PolyphaseDecimatorTest, AntiAliasFilterRejectsAliasedBand)
+{
+    for (const SizeT factor : {SizeT(2), SizeT(10), SizeT(100)})
+    {
+        const auto taps = designDecimationFilter(factor, 16, SampleRate);
+        ASSERT_EQ(taps.size(), factor * 16);
+
+        const double outputRate = SampleRate / static_cast<double>(factor);
+        EXPECT_NEAR(fir_design::gainAt(taps, 0.0), 1.0, 1e-2) << "factor " << factor;
+
+        // Everything that folds back into the passband is attenuated by at least 40 dB
+        for (double frequency = 0.6 * outputRate; frequency < SampleRate / 2.0; frequency += outputRate / 8.0)
+            EXPECT_LT(fir_design::gainAt(taps, frequency / SampleRate), 0.01) << "factor " << factor << ", frequency " << frequency;
+    }
+}
+
+TEST_F(PolyphaseDecimatorTest, ResetClearsHistory)
+{
+    PolyphaseDecimator decimator;
+    decimator.setFilter(designDecimationFilter(3, 8, SampleRate), 3);
+
+    const auto input = createNoise(100, 9);
+    std::vector<double> first(decimator.getOutputCount(input.size()));
+    decimator.process(input.data(), input.size(), first.data());
+
+    decimator.reset();
+    std::vector<double> second(decimator.getOutputCount(input.size()));
+    decimator.process(input.data(), input.size(), second.data());
+
+    ASSERT_EQ(first, second);
+}
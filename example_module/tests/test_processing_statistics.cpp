@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <example_module/processing_statistics.h>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+using namespace daq;
+using namespace daq::modules::example_module;
+using namespace std::chrono_literals;
+
+using ProcessingStatisticsTest = testing::Test;
+
+TEST_F(ProcessingStatisticsTest, CountsBlocks)
+{
+    ProcessingStatistics statistics;
+    statistics.recordBlock(100, 100, 0, 1, 2us);
+    statistics.recordBlock(50, 25, 1, 1, 3us);
+    statistics.recordEvent();
+    statistics.recordReconfiguration();
+
+    const auto counters = statistics.getCounters();
+    ASSERT_EQ(counters.samplesIn, 150u);
+    ASSERT_EQ(counters.samplesOut, 125u);
+    ASSERT_EQ(counters.packetsIn, 1u);
+    ASSERT_EQ(counters.packetsOut, 2u);
+    ASSERT_EQ(counters.blocks, 2u);
+    ASSERT_EQ(counters.busyTimeNs, 5000u);
+    ASSERT_EQ(counters.events, 1u);
+    ASSERT_EQ(counters.reconfigurations, 1u);
+}
+
+TEST_F(ProcessingStatisticsTest, HistogramBucketsArePowersOfTwo)
+{
+    ASSERT_EQ(ProcessingStatistics::getHistogramBucket(0), 0u);
+    ASSERT_EQ(ProcessingStatistics::getHistogramBucket(1), 0u);
+    ASSERT_EQ(ProcessingStatistics::getHistogramBucket(2), 1u);
+    ASSERT_EQ(ProcessingStatistics::getHistogramBucket(3), 1u);
+    ASSERT_EQ(ProcessingStatistics::getHistogramBucket(1024), 10u);
+    ASSERT_EQ(ProcessingStatistics::getHistogramBucket(2047), 10u);
+    ASSERT_EQ(ProcessingStatistics::getHistogramBucket(uint64_t{1} << 40), ProcessingStatistics::HistogramBucketCount - 1);
+
+    ProcessingStatistics statistics;
+    statistics.recordBlock(1, 1, 0, 1, 1500ns);
+    statistics.recordBlock(1, 1, 0, 1, 1800ns);
+    statistics.recordBlock(1, 1, 0, 1, 5s);
+
+    const auto histogram = statistics.getCounters().processingTimeHistogram;
+    ASSERT_EQ(histogram[10], 2u);
+    ASSERT_EQ(histogram[ProcessingStatistics::HistogramBucketCount - 1], 1u);
+    ASSERT_EQ(std::accumulate(histogram.begin(), histogram.end(), uint64_t{0}), 3u);
+}
+
+TEST_F(ProcessingStatisticsTest, BacklogKeepsMaximum)
+{
+    ProcessingStatistics statistics;
+    statistics.recordBacklog(10);
+    statistics.recordBacklog(1000);
+    statistics.recordBacklog(20);
+    ASSERT_EQ(statistics.getCounters().maxBacklog, 1000u);
+}
+
+TEST_F(ProcessingStatisticsTest, ResetStartsFromZero)
+{
+    ProcessingStatistics statistics;
+    statistics.recordBlock(100, 100, 0, 1, 2us);
+    statistics.recordBacklog(100);
+    statistics.reset();
+
+    auto counters = statistics.getCounters();
+    ASSERT_EQ(counters.samplesIn, 0u);
+    ASSERT_EQ(counters.blocks, 0u);
+    ASSERT_EQ(counters.maxBacklog, 0u);
+    ASSERT_EQ(std::accumulate(counters.processingTimeHistogram.begin(), counters.processingTimeHistogram.end(), uint64_t{0}), 0u);
+
+    statistics.recordBlock(10, 10, 0, 1, 2us);
+    counters = statistics.getCounters();
+    ASSERT_EQ(counters.samplesIn, 10u);
+    ASSERT_EQ(counters.blocks, 1u);
+}
+
+TEST_F(ProcessingStatisticsTest, ReconfigurationsFromSeveralThreads)
+{
+    ProcessingStatistics statistics;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back(
+            [&statistics]
+            {
+                for (int i = 0; i < 10000; ++i)
+                    statistics.recordReconfiguration();
+            });
+    for (auto& thread : threads)
+        thread.join();
+
+    ASSERT_EQ(statistics.getCounters().reconfigurations, 40000u);
+}
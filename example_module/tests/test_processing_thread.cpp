@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <example_module/processing_thread.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace daq;
+using namespace daq::modules::example_module;
+using namespace std::chrono_literals;
+
+using ProcessingThreadTest = testing::Test;
+
+namespace
+{
+    template <typename Predicate>
+    bool waitFor(Predicate predicate)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        while (!predicate())
+        {
+            if (std::chrono::steady_clock::now() - start > 5s)
+                return false;
+            std::this_thread::sleep_for(1ms);
+        }
+        return true;
+    }
+}
+
+TEST_F(ProcessingThreadTest, ProcessesOnItsOwnThread)
+{
+    std::atomic<int> calls{0};
+    std::thread::id processingThreadId;
+    ProcessingThread thread(
+        [&]
+        {
+            processingThreadId = std::this_thread::get_id();
+            ++calls;
+        });
+
+    ASSERT_EQ(calls, 0);
+    thread.notify();
+    ASSERT_TRUE(waitFor([&] { return calls == 1; }));
+    ASSERT_NE(processingThreadId, std::this_thread::get_id());
+}
+
+TEST_F(ProcessingThreadTest, NotificationsDuringProcessingAreCoalesced)
+{
+    std::atomic<int> calls{0};
+    std::atomic<bool> release{false};
+    ProcessingThread thread(
+        [&]
+        {
+            ++calls;
+            while (!release)
+                std::this_thread::yield();
+        });
+
+    thread.notify();
+    ASSERT_TRUE(waitFor([&] { return calls == 1; }));
+    for (int i = 0; i < 10; ++i)
+        thread.notify();
+    release = true;
+
+    ASSERT_TRUE(waitFor([&] { return calls == 2; }));
+    std::this_thread::sleep_for(50ms);
+    ASSERT_EQ(calls, 2);
+}
+
+TEST_F(ProcessingThreadTest, ExceptionsDoNotStopTheThread)
+{
+    std::atomic<int> calls{0};
+    ProcessingThread thread(
+        [&]
+        {
+            ++calls;
+            throw std::runtime_error("Invalid configuration");
+        });
+
+    thread.notify();
+    ASSERT_TRUE(waitFor([&] { return calls == 1; }));
+    thread.notify();
+    ASSERT_TRUE(waitFor([&] { return calls == 2; }));
+}
+
+TEST_F(ProcessingThreadTest, ZeroAffinityIsAlwaysAccepted)
+{
+    ProcessingThread thread([] {});
+    ASSERT_TRUE(thread.setAffinity(0));
+}
+
+#if defined(__linux__)
+TEST_F(ProcessingThreadTest, AffinityPinsThread)
+{
+    cpu_set_t allowed;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+    int cpu = 0;
+    while (cpu < 64 && !CPU_ISSET(cpu, &allowed))
+        ++cpu;
+    if (cpu == 64)
+        GTEST_SKIP() << "No CPU below 64 available";
+
+    std::atomic<int> processedOn{-1};
+    ProcessingThread thread([&] { processedOn = sched_getcpu(); });
+    ASSERT_TRUE(thread.setAffinity(uint64_t{1} << cpu));
+
+    thread.notify();
+    ASSERT_TRUE(waitFor([&] { return processedOn != -1; }));
+    ASSERT_EQ(processedOn, cpu);
+}
+#endif
@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+#include <example_module/recording_reader.h>
+#include <example_module/recording_writer.h>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <vector>
+
+using namespace daq;
+using namespace daq::modules::example_module;
+
+using RecordingReaderTest = testing::Test;
+
+namespace
+{
+    std::string getTestPath(const std::string& name)
+    {
+        return (std::filesystem::temp_directory_path() / ("test_recording_reader_" + name + ".daqrec")).string();
+    }
+
+    std::vector<double> createValues(SizeT count)
+    {
+        std::vector<double> values(count);
+        std::iota(values.begin(), values.end(), 0.0);
+        return values;
+    }
+}
+
+TEST_F(RecordingReaderTest, ReadsWrittenRecordsInPlace)
+{
+    const auto path = getTestPath("roundtrip");
+    const SizeT sampleCount = RecordingWriter::MinSegmentSize / sizeof(double) + 1000;
+    const auto values = createValues(sampleCount);
+    {
+        RecordingWriter writer;
+        writer.open(path, {"data", "domain"}, RecordingWriter::MinSegmentSize, 1 << 20);
+        ASSERT_EQ(writer.writeData(values.data(), sizeof(double), nullptr, 0, sampleCount, 40, 2), sampleCount);
+    }
+
+    RecordingReader reader;
+    reader.open(path);
+    ASSERT_EQ(reader.getHeader().complete, 1u);
+    ASSERT_EQ(reader.getDescriptors().dataDescriptor, "data");
+    ASSERT_EQ(reader.getDescriptors().domainDescriptor, "domain");
+
+    std::vector<double> read;
+    Int expectedOffset = 40;
+    RecordView record;
+    while (reader.next(record))
+    {
+        ASSERT_EQ(record.type, RecordType::Data);
+        ASSERT_EQ(record.domainOffset, expectedOffset);
+        ASSERT_EQ(record.valueSize, record.sampleCount * sizeof(double));
+        ASSERT_EQ(record.domain, nullptr);
+
+        const auto* samples = reinterpret_cast<const double*>(record.values);
+        read.insert(read.end(), samples, samples + record.sampleCount);
+        expectedOffset += static_cast<Int>(record.sampleCount) * 2;
+    }
+    ASSERT_EQ(read, values);
+
+    // Rewinding starts over at the first record
+    reader.rewind();
+    ASSERT_TRUE(reader.next(record));
+    ASSERT_EQ(record.domainOffset, 40);
+
+    reader.close();
+    std::filesystem::remove(path);
+}
+
+TEST_F(RecordingReaderTest, ReadsDescriptorRecordsAndDomainValues)
+{
+    const auto path = getTestPath("descriptor");
+    const std::vector<int32_t> values = {1, 2, 3};
+    const std::vector<int64_t> domain = {100, 150, 400};
+    {
+        RecordingWriter writer;
+        writer.open(path, {"a", "b"}, RecordingWriter::MinSegmentSize, 1 << 20);
+        writer.writeDescriptors({"c", "d"});
+        writer.writeData(values.data(), sizeof(int32_t), domain.data(), sizeof(int64_t), 3, 0, 0);
+    }
+
+    RecordingReader reader;
+    reader.open(path);
+
+    RecordView record;
+    ASSERT_TRUE(reader.next(record));
+    ASSERT_EQ(record.type, RecordType::Descriptor);
+    ASSERT_EQ(record.descriptors.dataDescriptor, "c");
+    ASSERT_EQ(record.descriptors.domainDescriptor, "d");
+
+    ASSERT_TRUE(reader.next(record));
+    ASSERT_EQ(record.type, RecordType::Data);
+    ASSERT_EQ(std::memcmp(record.values, values.data(), 3 * sizeof(int32_t)), 0);
+    ASSERT_EQ(record.domainSize, 3 * sizeof(int64_t));
+    ASSERT_EQ(std::memcmp(record.domain, domain.data(), 3 * sizeof(int64_t)), 0);
+
+    ASSERT_FALSE(reader.next(record));
+
+    reader.close();
+    std::filesystem::remove(path);
+}
+
+// A recording that was not closed keeps its preallocated size and an incomplete header
+TEST_F(RecordingReaderTest, ReadsUnclosedRecordings)
+{
+    const auto path = getTestPath("unclosed");
+    const auto values = createValues(100);
+    {
+        RecordingWriter writer;
+        writer.open(path, {}, RecordingWriter::MinSegmentSize, 1 << 20);
+        writer.writeData(values.data(), sizeof(double), nullptr, 0, 100, 0, 1);
+    }
+
+    {
+        std::fstream stream(path, std::ios::binary | std::ios::in | std::ios::out);
+        RecordingFileHeader header;
+        stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+        header.complete = 0;
+        header.dataSize = 0;
+        stream.seekp(0);
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        stream.seekp(0, std::ios::end);
+        const std::vector<char> zeros(3 * RecordingWriter::MinSegmentSize);
+        stream.write(zeros.data(), static_cast<std::streamsize>(zeros.size()));
+    }
+
+    RecordingReader reader;
+    reader.open(path);
+    ASSERT_EQ(reader.getHeader().complete, 0u);
+
+    SizeT records = 0;
+    RecordView record;
+    while (reader.next(record))
+    {
+        ASSERT_EQ(record.sampleCount, 100u);
+        ++records;
+    }
+    ASSERT_EQ(records, 1u);
+
+    reader.close();
+    std::filesystem::remove(path);
+}
+
+TEST_F(RecordingReaderTest, RejectsOtherFiles)
+{
+    const auto path = getTestPath("other");
+    {
+        std::ofstream stream(path, std::ios::binary);
+        const std::vector<char> text(1000, 'x');
+        stream.write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+
+    RecordingReader reader;
+    ASSERT_THROW(reader.open(path), std::runtime_error);
+    ASSERT_THROW(reader.open(getTestPath("missing")), std::runtime_error);
+
+    std::filesystem::remove(path);
+}
+
+// A header size below the size of the header itself must not wrap the descriptor size check, and unknown
+// record types are not read as data
+TEST_F(RecordingReaderTest, RejectsCorruptHeadersAndRecords)
+{
+    const auto path = getTestPath("corrupt");
+    const auto values = createValues(100);
+    {
+        RecordingWriter writer;
+        writer.open(path, {"data", "domain"}, RecordingWriter::MinSegmentSize, 1 << 20);
+        writer.writeData(values.data(), sizeof(double), nullptr, 0, 100, 0, 1);
+    }
+
+    RecordingFileHeader header;
+    {
+        std::ifstream stream(path, std::ios::binary);
+        stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+    }
+
+    const auto writeAt = [&path](std::streamoff offset, const void* data, SizeT size)
+    {
+        std::fstream stream(path, std::ios::binary | std::ios::in | std::ios::out);
+        stream.seekp(offset);
+        stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    };
+
+    RecordingFileHeader truncated = header;
+    truncated.headerSize = 16;
+    writeAt(0, &truncated, sizeof(truncated));
+
+    RecordingReader reader;
+    ASSERT_THROW(reader.open(path), std::runtime_error);
+
+    writeAt(0, &header, sizeof(header));
+    RecordHeader recordHeader;
+    {
+        std::ifstream stream(path, std::ios::binary);
+        stream.seekg(header.headerSize);
+        stream.read(reinterpret_cast<char*>(&recordHeader), sizeof(recordHeader));
+    }
+    recordHeader.type = static_cast<RecordType>(7);
+    writeAt(header.headerSize, &recordHeader, sizeof(recordHeader));
+
+    reader.open(path);
+    RecordView record;
+    ASSERT_THROW(reader.next(record), std::runtime_error);
+
+    reader.close();
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,236 @@
+#include <gtest/gtest.h>
+#include <example_module/recording_writer.h>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+using namespace daq;
+using namespace daq::modules::example_module;
+
+using RecordingWriterTest = testing::Test;
+
+namespace
+{
+    struct ParsedRecord
+    {
+        RecordHeader header;
+        std::vector<uint8_t> payload;
+    };
+
+    struct ParsedFile
+    {
+        RecordingFileHeader header;
+        RecordedDescriptors descriptors;
+        std::vector<ParsedRecord> records;
+        SizeT fileSize = 0;
+    };
+
+    std::string getTestPath(const std::string& name)
+    {
+        return (std::filesystem::temp_directory_path() / ("test_recording_writer_" + name + ".daqrec")).string();
+    }
+
+    ParsedFile parseFile(const std::string& path)
+    {
+        std::ifstream stream(path, std::ios::binary);
+        const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+        ParsedFile file;
+        file.fileSize = bytes.size();
+        std::memcpy(&file.header, bytes.data(), sizeof(file.header));
+        file.descriptors = decodeDescriptors(bytes.data() + sizeof(file.header), file.header.descriptorSize);
+
+        for (SizeT segment = file.header.headerSize; segment < bytes.size(); segment += file.header.segmentSize)
+        {
+            const SizeT segmentEnd = std::min<SizeT>(segment + file.header.segmentSize, bytes.size());
+            for (SizeT position = segment; segmentEnd - position >= sizeof(RecordHeader);)
+            {
+                ParsedRecord record;
+                std::memcpy(&record.header, bytes.data() + position, sizeof(RecordHeader));
+                if (record.header.type == RecordType::End)
+                    break;
+
+                const auto* payload = bytes.data() + position + sizeof(RecordHeader);
+                record.payload.assign(payload, payload + record.header.size);
+                file.records.push_back(std::move(record));
+                position += sizeof(RecordHeader) + alignRecordSize(record.header.size);
+            }
+        }
+        return file;
+    }
+
+    std::vector<double> createValues(SizeT count)
+    {
+        std::vector<double> values(count);
+        std::iota(values.begin(), values.end(), 0.0);
+        return values;
+    }
+}
+
+TEST_F(RecordingWriterTest, WritesHeaderAndDataRecords)
+{
+    const auto path = getTestPath("header");
+    const auto values = createValues(1000);
+    {
+        RecordingWriter writer;
+        writer.open(path, {"{\"data\":1}", "{\"domain\":2}"}, RecordingWriter::MinSegmentSize, 1 << 20);
+        ASSERT_EQ(writer.writeData(values.data(), sizeof(double), nullptr, 0, 600, 5000, 2), 600u);
+        ASSERT_EQ(writer.writeData(values.data() + 600, sizeof(double), nullptr, 0, 400, 6200, 2), 400u);
+        writer.close();
+        ASSERT_EQ(writer.getRecordCount(), 2u);
+    }
+
+    const auto file = parseFile(path);
+    ASSERT_EQ(std::memcmp(file.header.magic, RecordingMagic, sizeof(RecordingMagic)), 0);
+    ASSERT_EQ(file.header.version, RecordingVersion);
+    ASSERT_EQ(file.header.complete, 1u);
+    ASSERT_EQ(file.header.recordCount, 2u);
+    ASSERT_EQ(file.header.droppedSamples, 0u);
+    ASSERT_EQ(file.fileSize, file.header.headerSize + file.header.dataSize);
+    ASSERT_EQ(file.descriptors.dataDescriptor, "{\"data\":1}");
+    ASSERT_EQ(file.descriptors.domainDescriptor, "{\"domain\":2}");
+
+    ASSERT_EQ(file.records.size(), 2u);
+    ASSERT_EQ(file.records[0].header.type, RecordType::Data);
+    ASSERT_EQ(file.records[0].header.sampleCount, 600u);
+    ASSERT_EQ(file.records[0].header.domainOffset, 5000);
+    ASSERT_EQ(file.records[1].header.domainOffset, 6200);
+    ASSERT_EQ(std::memcmp(file.records[1].payload.data(), values.data() + 600, 400 * sizeof(double)), 0);
+
+    std::filesystem::remove(path);
+}
+
+TEST_F(RecordingWriterTest, SplitsBlocksAcrossSegments)
+{
+    const auto path = getTestPath("split");
+    // Fills the first segment and continues in the second, which is mapped in advance
+    const SizeT sampleCount = RecordingWriter::MinSegmentSize / sizeof(double) + 1000;
+    const auto values = createValues(sampleCount);
+    {
+        RecordingWriter writer;
+        writer.open(path, {}, RecordingWriter::MinSegmentSize, 16 << 20);
+        ASSERT_EQ(writer.writeData(values.data(), sizeof(double), nullptr, 0, sampleCount, 100, 3), sampleCount);
+    }
+
+    const auto file = parseFile(path);
+    ASSERT_EQ(file.records.size(), 2u);
+
+    std::vector<double> read;
+    Int expectedOffset = 100;
+    for (const auto& record : file.records)
+    {
+        ASSERT_EQ(record.header.domainOffset, expectedOffset);
+        const auto* samples = reinterpret_cast<const double*>(record.payload.data());
+        read.insert(read.end(), samples, samples + record.header.sampleCount);
+        expectedOffset += static_cast<Int>(record.header.sampleCount) * 3;
+    }
+    ASSERT_EQ(read, values);
+
+    std::filesystem::remove(path);
+}
+
+TEST_F(RecordingWriterTest, StoresExplicitDomainValues)
+{
+    const auto path = getTestPath("domain");
+    const std::vector<float> values = {1.0f, 2.0f, 3.0f};
+    const std::vector<int64_t> domain = {10, 25, 70};
+    {
+        RecordingWriter writer;
+        writer.open(path, {}, RecordingWriter::MinSegmentSize, 1 << 20);
+        ASSERT_EQ(writer.writeData(values.data(), sizeof(float), domain.data(), sizeof(int64_t), 3, 0, 0), 3u);
+    }
+
+    const auto file = parseFile(path);
+    ASSERT_EQ(file.records.size(), 1u);
+    const auto& record = file.records[0];
+    ASSERT_EQ(record.header.valueSize, 3 * sizeof(float));
+    ASSERT_EQ(record.header.size, 3 * sizeof(float) + 3 * sizeof(int64_t));
+    ASSERT_EQ(std::memcmp(record.payload.data(), values.data(), record.header.valueSize), 0);
+    ASSERT_EQ(std::memcmp(record.payload.data() + record.header.valueSize, domain.data(), 3 * sizeof(int64_t)), 0);
+
+    std::filesystem::remove(path);
+}
+
+TEST_F(RecordingWriterTest, DescriptorRecordsFollowData)
+{
+    const auto path = getTestPath("descriptor");
+    const auto values = createValues(10);
+    {
+        RecordingWriter writer;
+        writer.open(path, {"a", "b"}, RecordingWriter::MinSegmentSize, 1 << 20);
+        writer.writeData(values.data(), sizeof(double), nullptr, 0, 10, 0, 1);
+        ASSERT_TRUE(writer.writeDescriptors({"c", "d"}));
+        writer.writeData(values.data(), sizeof(double), nullptr, 0, 10, 10, 1);
+    }
+
+    const auto file = parseFile(path);
+    ASSERT_EQ(file.records.size(), 3u);
+    ASSERT_EQ(file.records[1].header.type, RecordType::Descriptor);
+    const auto descriptors = decodeDescriptors(file.records[1].payload.data(), file.records[1].payload.size());
+    ASSERT_EQ(descriptors.dataDescriptor, "c");
+    ASSERT_EQ(descriptors.domainDescriptor, "d");
+
+    std::filesystem::remove(path);
+}
+
+TEST_F(RecordingWriterTest, DropsSamplesWhenFileIsFull)
+{
+    const auto path = getTestPath("full");
+    const SizeT sampleCount = 100000;
+    const auto values = createValues(sampleCount);
+    SizeT written;
+    {
+        RecordingWriter writer;
+        writer.open(path, {}, RecordingWriter::MinSegmentSize, RecordingWriter::MinSegmentSize);
+        written = writer.writeData(values.data(), sizeof(double), nullptr, 0, sampleCount, 0, 1);
+        ASSERT_LT(written, RecordingWriter::MinSegmentSize / sizeof(double));
+        ASSERT_EQ(writer.getDroppedSamples(), sampleCount - written);
+
+        // Later writes are dropped as a whole
+        ASSERT_EQ(writer.writeData(values.data(), sizeof(double), nullptr, 0, 10, 0, 1), 0u);
+        ASSERT_EQ(writer.getDroppedSamples(), sampleCount - written + 10);
+    }
+
+    const auto file = parseFile(path);
+    ASSERT_EQ(file.header.droppedSamples, sampleCount - written + 10);
+    ASSERT_EQ(file.header.segmentSize, file.header.dataSize);
+
+    std::filesystem::remove(path);
+}
+
+// Many small blocks through a stream of segments; every sample is either written in order or counted
+TEST_F(RecordingWriterTest, SustainedWritesKeepOrder)
+{
+    const auto path = getTestPath("sustained");
+    const SizeT blockSize = 1000;
+    const SizeT blockCount = 2000;
+    const auto values = createValues(blockSize);
+    SizeT written = 0;
+    {
+        RecordingWriter writer;
+        writer.open(path, {}, RecordingWriter::MinSegmentSize, 64 << 20);
+        for (SizeT block = 0; block < blockCount; ++block)
+            written += writer.writeData(values.data(), sizeof(double), nullptr, 0, blockSize, static_cast<Int>(block * blockSize), 1);
+        ASSERT_EQ(written + writer.getDroppedSamples(), blockSize * blockCount);
+        ASSERT_TRUE(writer.getError().empty());
+    }
+
+    const auto file = parseFile(path);
+    SizeT read = 0;
+    Int lastOffset = -1;
+    for (const auto& record : file.records)
+    {
+        ASSERT_GT(record.header.domainOffset, lastOffset);
+        const auto* samples = reinterpret_cast<const double*>(record.payload.data());
+        const auto first = static_cast<SizeT>(record.header.domainOffset) % blockSize;
+        for (SizeT i = 0; i < record.header.sampleCount; ++i)
+            ASSERT_EQ(samples[i], static_cast<double>(first + i));
+        lastOffset = record.header.domainOffset;
+        read += record.header.sampleCount;
+    }
+    ASSERT_EQ(read, written);
+
+    std::filesystem::remove(path);
+}
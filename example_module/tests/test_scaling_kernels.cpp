@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <example_module/scaling_kernels.h>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace daq;
+using namespace daq::modules::example_module;
+
+class ScalingKernelsTest : public testing::TestWithParam<SampleType>
+{
+};
+
+using ScalingKernelDispatchTest = testing::Test;
+
+namespace
+{
+    // Random bit patterns, so that extreme values and sign bits of every width are covered
+    template <SampleType InputType>
+    void fillRandomInput(std::vector<uint8_t>& buffer, SizeT count)
+    {
+        using InputT = typename SampleTypeToType<InputType>::Type;
+
+        std::mt19937_64 gen(1234);
+        buffer.resize(count * sizeof(InputT));
+        auto* data = reinterpret_cast<InputT*>(buffer.data());
+        for (SizeT i = 0; i < count; ++i)
+        {
+            const uint64_t bits = gen();
+            std::memcpy(&data[i], &bits, sizeof(InputT));
+            if constexpr (std::is_floating_point_v<InputT>)
+            {
+                if (!std::isfinite(data[i]))
+                    data[i] = static_cast<InputT>(i);
+            }
+        }
+    }
+}
+
+TEST_P(ScalingKernelsTest, SimdMatchesScalarBitForBit)
+{
+    const auto sampleType = GetParam();
+    const SizeT maxCount = 1037;
+
+    std::vector<uint8_t> input;
+    SAMPLE_TYPE_DISPATCH(sampleType, fillRandomInput, input, maxCount)
+
+    const auto scalar = getScalingKernel(sampleType, SimdLevel::Scalar);
+    for (const auto level : {SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512})
+    {
+        if (level > getSimdLevel())
+            continue;
+
+        const auto kernel = getScalingKernel(sampleType, level);
+        for (const SizeT count : {SizeT(0), SizeT(1), SizeT(7), SizeT(16), SizeT(33), maxCount})
+        {
+            std::vector<Float> expected(count);
+            std::vector<Float> actual(count);
+            scalar(input.data(), expected.data(), count, 0.37, -12.25);
+            kernel(input.data(), actual.data(), count, 0.37, -12.25);
+
+            ASSERT_EQ(std::memcmp(expected.data(), actual.data(), count * sizeof(Float)), 0)
+                << simdLevelName(level) << " differs from the scalar kernel for " << count << " samples";
+        }
+    }
+}
+
+TEST_F(ScalingKernelDispatchTest, DetectedLevelIsSelectedByDefault)
+{
+    ASSERT_EQ(getScalingKernel(SampleType::Float64), getScalingKernel(SampleType::Float64, getSimdLevel()));
+}
+
+INSTANTIATE_TEST_SUITE_P(SampleTypes,
+                         ScalingKernelsTest,
+                         testing::Values(SampleType::Int8,
+                                         SampleType::Int16,
+                                         SampleType::Int32,
+                                         SampleType::Int64,
+                                         SampleType::UInt8,
+                                         SampleType::UInt16,
+                                         SampleType::UInt32,
+                                         SampleType::UInt64,
+                                         SampleType::Float32,
+                                         SampleType::Float64));
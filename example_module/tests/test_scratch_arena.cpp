@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <example_module/scratch_arena.h>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+using namespace daq;
+using namespace daq::modules::example_module;
+
+using ScratchArenaTest = testing::Test;
+
+TEST_F(ScratchArenaTest, LeasesAreAligned)
+{
+    ScratchArena arena;
+    const auto first = arena.acquire(3);
+    const auto second = arena.acquire(100);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(first.get()) % ScratchArena::Alignment, 0u);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(second.get()) % ScratchArena::Alignment, 0u);
+}
+
+TEST_F(ScratchArenaTest, NestedLeasesDoNotOverlap)
+{
+    ScratchArena arena;
+    const auto outer = arena.acquire(1000 * sizeof(double));
+    std::fill_n(outer.get<double>(), 1000, 1.0);
+    {
+        const auto inner = arena.acquire(1000 * sizeof(double));
+        std::fill_n(inner.get<double>(), 1000, 2.0);
+    }
+
+    for (SizeT i = 0; i < 1000; ++i)
+        ASSERT_EQ(outer.get<double>()[i], 1.0);
+}
+
+TEST_F(ScratchArenaTest, ReleasedMemoryIsReused)
+{
+    ScratchArena arena;
+    void* data;
+    {
+        const auto lease = arena.acquire(4096);
+        data = lease.get();
+    }
+    const SizeT reserved = arena.getReservedBytes();
+
+    for (int i = 0; i < 100; ++i)
+    {
+        const auto lease = arena.acquire(4096);
+        ASSERT_EQ(lease.get(), data);
+    }
+    ASSERT_EQ(arena.getReservedBytes(), reserved);
+}
+
+TEST_F(ScratchArenaTest, GrowingKeepsOutstandingLeases)
+{
+    ScratchArena arena;
+    const auto small = arena.acquire(64);
+    std::memset(small.get(), 0x5a, 64);
+
+    // Does not fit the first chunk and gets a chunk of its own
+    const auto large = arena.acquire(4 * ScratchArena::MinChunkSize);
+    std::memset(large.get(), 0, 4 * ScratchArena::MinChunkSize);
+
+    for (SizeT i = 0; i < 64; ++i)
+        ASSERT_EQ(small.get<uint8_t>()[i], 0x5a);
+    ASSERT_GE(arena.getReservedBytes(), 5 * ScratchArena::MinChunkSize);
+}
+
+TEST_F(ScratchArenaTest, ThreadsHaveSeparateArenas)
+{
+    ScratchArena* mainArena = &ScratchArena::local();
+    ScratchArena* otherArena = nullptr;
+    std::thread([&otherArena] { otherArena = &ScratchArena::local(); }).join();
+    ASSERT_NE(mainArena, otherArena);
+}
+
+TEST_F(ScratchArenaTest, TotalTracksAllArenas)
+{
+    const SizeT before = ScratchArena::getTotalReservedBytes();
+    {
+        ScratchArena arena;
+        { const auto lease = arena.acquire(ScratchArena::MinChunkSize); }
+        ASSERT_EQ(ScratchArena::getTotalReservedBytes(), before + arena.getReservedBytes());
+    }
+    ASSERT_EQ(ScratchArena::getTotalReservedBytes(), before);
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include <example_module/common.h>
+#include <random>
+#include <vector>
+
+namespace test_signals
+{
+    // Uniform white noise in [-1, 1); the same seed gives the same samples
+    inline std::vector<double> createNoise(daq::SizeT count, unsigned seed)
+    {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        std::vector<double> values(count);
+        for (auto& value : values)
+            value = dist(gen);
+        return values;
+    }
+}
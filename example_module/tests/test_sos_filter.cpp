@@ -0,0 +1,225 @@
+#include <gtest/gtest.h>
+#include <example_module/filter_design.h>
+#include <example_module/sos_filter.h>
+#include <cmath>
+#include <complex>
+#include <random>
+#include <tuple>
+#include <vector>
+
+using namespace daq;
+using namespace daq::modules::example_module;
+
+using SosFilterTest = testing::Test;
+
+namespace
+{
+    constexpr double SampleRate = 1000.0;
+
+    double magnitudeAt(const std::vector<BiquadCoefficients>& sections, double frequency)
+    {
+        const std::complex<double> z1 = std::polar(1.0, -2.0 * M_PI * frequency / SampleRate);
+        const std::complex<double> z2 = z1 * z1;
+
+        std::complex<double> response = 1.0;
+        for (const auto& s : sections)
+            response *= (s.b0 + s.b1 * z1 + s.b2 * z2) / (1.0 + s.a1 * z1 + s.a2 * z2);
+        return std::abs(response);
+    }
+
+    bool isStable(const std::vector<BiquadCoefficients>& sections)
+    {
+        // Stability triangle of a second-order section
+        for (const auto& s : sections)
+        {
+            if (!(std::abs(s.a2) < 1.0 && std::abs(s.a1) < 1.0 + s.a2))
+                return false;
+        }
+        return true;
+    }
+
+    FilterSpec createSpec(FilterFamily family, FilterResponse response, SizeT order)
+    {
+        FilterSpec spec;
+        spec.family = family;
+        spec.response = response;
+        spec.order = order;
+        spec.sampleRate = SampleRate;
+        spec.cutoffFrequency = 100.0;
+        spec.upperCutoffFrequency = 200.0;
+        spec.passbandRipple = 1.0;
+        spec.stopbandAttenuation = 40.0;
+        return spec;
+    }
+}
+
+using FilterDesignParams = std::tuple<FilterFamily, FilterResponse, SizeT>;
+
+class FilterDesignTest : public testing::TestWithParam<FilterDesignParams>
+{
+};
+
+// Checks the band edges and the pass/stop band gains defined by each family
+TEST_P(FilterDesignTest, ResponseMatchesSpecification)
+{
+    const auto [family, response, order] = GetParam();
+    const auto spec = createSpec(family, response, order);
+    const auto sections = designSosFilter(spec);
+
+    const SizeT poleCount = (response == FilterResponse::BandPass || response == FilterResponse::BandStop) ? 2 * order : order;
+    ASSERT_EQ(sections.size(), (poleCount + 1) / 2);
+    ASSERT_TRUE(isStable(sections));
+
+    const double rippleGain = std::pow(10.0, -spec.passbandRipple / 20.0);
+    const double stopGain = std::pow(10.0, -spec.stopbandAttenuation / 20.0);
+
+    double edgeGain = 1.0 / std::sqrt(2.0);
+    if (family == FilterFamily::ChebyshevI)
+        edgeGain = rippleGain;
+    else if (family == FilterFamily::ChebyshevII)
+        edgeGain = stopGain;
+
+    // Chebyshev I filters of even order start at the bottom of the ripple
+    const double passGain = (family == FilterFamily::ChebyshevI && order % 2 == 0) ? rippleGain : 1.0;
+    const double tolerance = 1e-6;
+
+    switch (response)
+    {
+        case FilterResponse::LowPass:
+            EXPECT_NEAR(magnitudeAt(sections, 0.0), passGain, tolerance);
+            EXPECT_NEAR(magnitudeAt(sections, spec.cutoffFrequency), edgeGain, tolerance);
+            break;
+        case FilterResponse::HighPass:
+            EXPECT_NEAR(magnitudeAt(sections, SampleRate / 2.0), passGain, tolerance);
+            EXPECT_NEAR(magnitudeAt(sections, spec.cutoffFrequency), edgeGain, tolerance);
+            break;
+        case FilterResponse::BandPass:
+            EXPECT_NEAR(magnitudeAt(sections, spec.cutoffFrequency), edgeGain, tolerance);
+            EXPECT_NEAR(magnitudeAt(sections, spec.upperCutoffFrequency), edgeGain, tolerance);
+            EXPECT_LT(magnitudeAt(sections, 1.0), edgeGain);
+            EXPECT_LT(magnitudeAt(sections, 499.0), edgeGain);
+            break;
+        case FilterResponse::BandStop:
+            EXPECT_NEAR(magnitudeAt(sections, 0.0), passGain, tolerance);
+            EXPECT_NEAR(magnitudeAt(sections, SampleRate / 2.0), passGain, tolerance);
+            EXPECT_NEAR(magnitudeAt(sections, spec.cutoffFrequency), edgeGain, tolerance);
+            EXPECT_NEAR(magnitudeAt(sections, spec.upperCutoffFrequency), edgeGain, tolerance);
+            break;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Designs,
+                         FilterDesignTest,
+                         testing::Combine(testing::Values(FilterFamily::Butterworth,
+                                                          FilterFamily::ChebyshevI,
+                                                          FilterFamily::ChebyshevII,
+                                                          FilterFamily::Bessel),
+                                          testing::Values(FilterResponse::LowPass,
+                                                          FilterResponse::HighPass,
+                                                          FilterResponse::BandPass,
+                                                          FilterResponse::BandStop),
+                                          testing::Values(SizeT(1), SizeT(2), SizeT(5), SizeT(8), SizeT(16))));
+
+TEST_F(SosFilterTest, ButterworthIsMaximallyFlat)
+{
+    const auto sections = designSosFilter(createSpec(FilterFamily::Butterworth, FilterResponse::LowPass, 8));
+
+    // |H|^2 = 1 / (1 + (w / wc)^(2n)) in the prewarped frequency
+    for (const double frequency : {10.0, 50.0, 150.0, 300.0})
+    {
+        const double ratio = std::tan(M_PI * frequency / SampleRate) / std::tan(M_PI * 100.0 / SampleRate);
+        EXPECT_NEAR(magnitudeAt(sections, frequency), 1.0 / std::sqrt(1.0 + std::pow(ratio, 16.0)), 1e-9);
+    }
+}
+
+TEST_F(SosFilterTest, FirstOrderMatchesDirectRecurrence)
+{
+    const double cutoff = 5.0;
+    auto spec = createSpec(FilterFamily::Butterworth, FilterResponse::LowPass, 1);
+    spec.cutoffFrequency = cutoff;
+    SosFilter filter(designSosFilter(spec));
+
+    const double wc = std::tan(M_PI * cutoff / SampleRate);
+    const double a0 = wc / (1.0 + wc);
+    const double b1 = (1.0 - wc) / (1.0 + wc);
+
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> input(3000);
+    for (auto& value : input)
+        value = dist(gen);
+
+    std::vector<double> output(input.size());
+    filter.process(input.data(), output.data(), input.size());
+
+    double prevInput = 0.0;
+    double prevOutput = 0.0;
+    for (SizeT i = 0; i < input.size(); ++i)
+    {
+        const double y = a0 * input[i] + a0 * prevInput + b1 * prevOutput;
+        prevInput = input[i];
+        prevOutput = y;
+        ASSERT_NEAR(output[i], y, 1e-12) << "at sample " << i;
+    }
+}
+
+TEST_F(SosFilterTest, BlockSplitDoesNotChangeOutput)
+{
+    const auto sections = designSosFilter(createSpec(FilterFamily::ChebyshevI, FilterResponse::BandPass, 6));
+    SosFilter whole(sections);
+    SosFilter split(sections);
+
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> input(5000);
+    for (auto& value : input)
+        value = dist(gen);
+
+    std::vector<double> expected(input.size());
+    whole.process(input.data(), expected.data(), input.size());
+
+    // Filtering in place, in blocks that do not align with the tile size
+    std::vector<double> actual = input;
+    SizeT position = 0;
+    for (const SizeT blockSize : {SizeT(1), SizeT(7), SizeT(511), SizeT(513), SizeT(1024), SizeT(2944)})
+    {
+        split.process(actual.data() + position, actual.data() + position, blockSize);
+        position += blockSize;
+    }
+    ASSERT_EQ(position, input.size());
+
+    for (SizeT i = 0; i < input.size(); ++i)
+        ASSERT_EQ(actual[i], expected[i]) << "at sample " << i;
+}
+
+TEST_F(SosFilterTest, ResetClearsState)
+{
+    SosFilter filter(designSosFilter(createSpec(FilterFamily::Bessel, FilterResponse::LowPass, 4)));
+
+    std::vector<double> ones(100, 1.0);
+    std::vector<double> first(ones.size());
+    std::vector<double> second(ones.size());
+
+    filter.process(ones.data(), first.data(), ones.size());
+    filter.reset();
+    filter.process(ones.data(), second.data(), ones.size());
+
+    ASSERT_EQ(first, second);
+}
+
+TEST_F(SosFilterTest, InvalidSpecificationThrows)
+{
+    auto spec = createSpec(FilterFamily::Butterworth, FilterResponse::LowPass, 0);
+    ASSERT_THROW(designSosFilter(spec), std::invalid_argument);
+
+    spec.order = MaxFilterOrder + 1;
+    ASSERT_THROW(designSosFilter(spec), std::invalid_argument);
+
+    spec.order = 4;
+    spec.cutoffFrequency = SampleRate / 2.0;
+    ASSERT_THROW(designSosFilter(spec), std::invalid_argument);
+
+    spec = createSpec(FilterFamily::Butterworth, FilterResponse::BandStop, 4);
+    spec.upperCutoffFrequency = spec.cutoffFrequency;
+    ASSERT_THROW(designSosFilter(spec), std::invalid_argument);
+}
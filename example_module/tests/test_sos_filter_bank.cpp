@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <example_module/filter_design.h>
+#include <example_module/sos_filter.h>
+#include <example_module/sos_filter_bank.h>
+#include <random>
+#include <vector>
+
+using namespace daq;
+using namespace daq::modules::example_module;
+
+class SosFilterBankTest : public testing::TestWithParam<SimdLevel>
+{
+};
+
+namespace
+{
+    // Every channel gets its own sample rate, so the coefficients differ per lane
+    std::vector<std::vector<BiquadCoefficients>> designChannels(SizeT channelCount)
+    {
+        std::vector<std::vector<BiquadCoefficients>> channels;
+        for (SizeT channel = 0; channel < channelCount; ++channel)
+        {
+            FilterSpec spec;
+            spec.family = FilterFamily::ChebyshevI;
+            spec.response = FilterResponse::BandPass;
+            spec.order = 3;
+            spec.sampleRate = 1000.0 + 100.0 * static_cast<double>(channel);
+            spec.cutoffFrequency = 50.0;
+            spec.upperCutoffFrequency = 150.0;
+            channels.push_back(designSosFilter(spec));
+        }
+        return channels;
+    }
+}
+
+TEST_P(SosFilterBankTest, MatchesSingleChannelFiltersBitForBit)
+{
+    const auto level = GetParam();
+    if (level > getSimdLevel())
+        GTEST_SKIP() << simdLevelName(level) << " is not supported by this CPU";
+
+    for (const SizeT channelCount : {SizeT(1), SizeT(3), SizeT(8), SizeT(13)})
+    {
+        const auto designs = designChannels(channelCount);
+
+        SosFilterBank bank;
+        bank.setSimdLevel(level);
+        bank.setChannels(designs);
+        ASSERT_EQ(bank.getChannelCount(), channelCount);
+        ASSERT_EQ(bank.getStride() % SosFilterBank::ChannelAlignment, 0u);
+
+        std::vector<SosFilter> references;
+        for (const auto& sections : designs)
+            references.emplace_back(sections);
+
+        std::mt19937 gen(5);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        const SizeT stride = bank.getStride();
+
+        // Several blocks, not aligned with the tile size, so that the state carries over
+        for (const SizeT count : {SizeT(1), SizeT(300), SizeT(1000)})
+        {
+            std::vector<std::vector<double>> channelData(channelCount, std::vector<double>(count));
+            std::vector<double> interleaved(count * stride, 0.0);
+            for (SizeT channel = 0; channel < channelCount; ++channel)
+            {
+                for (SizeT i = 0; i < count; ++i)
+                {
+                    channelData[channel][i] = dist(gen);
+                    interleaved[i * stride + channel] = channelData[channel][i];
+                }
+            }
+
+            bank.process(interleaved.data(), count);
+
+            for (SizeT channel = 0; channel < channelCount; ++channel)
+            {
+                references[channel].process(channelData[channel].data(), channelData[channel].data(), count);
+                for (SizeT i = 0; i < count; ++i)
+                    ASSERT_EQ(interleaved[i * stride + channel], channelData[channel][i])
+                        << simdLevelName(level) << ", channel " << channel << " of " << channelCount << ", sample " << i;
+            }
+        }
+    }
+}
+
+TEST_P(SosFilterBankTest, ChannelStateCarriesOver)
+{
+    const auto level = GetParam();
+    if (level > getSimdLevel())
+        GTEST_SKIP() << simdLevelName(level) << " is not supported by this CPU";
+
+    const auto designs = designChannels(2);
+    SosFilterBank bank;
+    bank.setSimdLevel(level);
+    bank.setChannels(designs);
+
+    std::vector<double> interleaved(100 * bank.getStride(), 1.0);
+    bank.process(interleaved.data(), 100);
+
+    // Rebuilding with the second channel only keeps its state when it is restored explicitly
+    const auto state = bank.getChannelState(1);
+    SosFilterBank rebuilt;
+    rebuilt.setSimdLevel(level);
+    rebuilt.setChannels({designs[1]});
+    rebuilt.setChannelState(0, state);
+
+    SosFilter reference(designs[1]);
+    std::vector<double> ones(100, 1.0);
+    reference.process(ones.data(), ones.data(), 100);
+
+    std::vector<double> next(rebuilt.getStride(), 0.5);
+    rebuilt.process(next.data(), 1);
+    double expected = 0.5;
+    reference.process(&expected, &expected, 1);
+
+    ASSERT_EQ(next[0], expected);
+}
+
+INSTANTIATE_TEST_SUITE_P(SimdLevels,
+                         SosFilterBankTest,
+                         testing::Values(SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512),
+                         [](const testing::TestParamInfo<SimdLevel>& info) { return std::string(simdLevelName(info.param)); });
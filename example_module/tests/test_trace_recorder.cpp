@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+#include <example_module/trace_recorder.h>
+#include <atomic>
+#include <thread>
+
+using namespace daq;
+using namespace daq::modules::example_module;
+using namespace std::chrono_literals;
+
+using TraceRecorderTest = testing::Test;
+
+namespace
+{
+    TraceEvent createEvent(int64_t index)
+    {
+        TraceEvent event;
+        event.span = TraceSpan::Compute;
+        event.startNs = index;
+        event.durationNs = index;
+        event.offset = index;
+        event.samples = index;
+        return event;
+    }
+}
+
+TEST_F(TraceRecorderTest, RingKeepsMostRecentEvents)
+{
+    auto ring = std::make_unique<TraceRing>();
+    const auto count = static_cast<int64_t>(TraceRing::Capacity + 10);
+    for (int64_t i = 0; i < count; ++i)
+        ring->push(createEvent(i));
+
+    std::vector<TraceEvent> events;
+    ring->collect(events);
+    ASSERT_EQ(events.size(), TraceRing::Capacity);
+    ASSERT_EQ(events.front().offset, 10);
+    ASSERT_EQ(events.back().offset, count - 1);
+}
+
+TEST_F(TraceRecorderTest, ClearHidesRecordedEvents)
+{
+    auto ring = std::make_unique<TraceRing>();
+    ring->push(createEvent(1));
+    ring->clear();
+    ring->push(createEvent(2));
+
+    std::vector<TraceEvent> events;
+    ring->collect(events);
+    ASSERT_EQ(events.size(), 1u);
+    ASSERT_EQ(events[0].offset, 2);
+}
+
+// Every collected event must be one that was pushed as a whole, never a mix of two
+TEST_F(TraceRecorderTest, CollectWhileRecording)
+{
+    auto ring = std::make_unique<TraceRing>();
+    std::atomic<bool> running{true};
+    std::thread writer(
+        [&]
+        {
+            for (int64_t i = 0; running; ++i)
+                ring->push(createEvent(i));
+        });
+
+    for (int i = 0; i < 100; ++i)
+    {
+        std::vector<TraceEvent> events;
+        ring->collect(events);
+        for (const auto& event : events)
+        {
+            ASSERT_EQ(event.durationNs, event.startNs);
+            ASSERT_EQ(event.offset, event.startNs);
+            ASSERT_EQ(event.samples, event.startNs);
+        }
+    }
+
+    running = false;
+    writer.join();
+}
+
+TEST_F(TraceRecorderTest, LatencyFromIngressMarks)
+{
+    TraceSource source("Latency");
+    const auto t0 = TraceSource::Clock::now();
+
+    {
+        auto lock = source.lockIngress();
+        source.markIngress(100, t0);
+    }
+    source.consumeInput(60);
+    {
+        auto lock = source.lockIngress();
+        source.markIngress(90, t0 + 2ms);
+    }
+
+    // Positions 0..99 arrived at t0, 100..149 at t0 + 2 ms
+    ASSERT_EQ(source.takeLatency(0, t0 + 5ms), std::chrono::nanoseconds(5ms).count());
+    ASSERT_EQ(source.takeLatency(99, t0 + 5ms), std::chrono::nanoseconds(5ms).count());
+    ASSERT_EQ(source.takeLatency(120, t0 + 5ms), std::chrono::nanoseconds(3ms).count());
+    ASSERT_EQ(source.takeLatency(150, t0 + 5ms), -1);
+}
+
+// An arrival behind an event packet does not show in the pending count yet
+TEST_F(TraceRecorderTest, ArrivalWithoutPendingInputMarksNextSample)
+{
+    TraceSource source("Event");
+    const auto t0 = TraceSource::Clock::now();
+
+    {
+        auto lock = source.lockIngress();
+        source.markIngress(0, t0);
+        source.markIngress(0, t0 + 1ms);
+    }
+
+    ASSERT_EQ(source.takeLatency(0, t0 + 5ms), std::chrono::nanoseconds(5ms).count());
+}
+
+TEST_F(TraceRecorderTest, DisabledSourceRecordsNothing)
+{
+    auto& registry = TraceRegistry::instance();
+    registry.clear();
+
+    TraceSource source("Disabled");
+    {
+        TraceScope scope(source, TraceSpan::Compute, 0, 10);
+    }
+
+    ASSERT_TRUE(registry.collect().empty());
+}
+
+TEST_F(TraceRecorderTest, ChromeTraceContainsSpans)
+{
+    auto& registry = TraceRegistry::instance();
+    registry.clear();
+
+    TraceSource source("Scaler \"1\"");
+    source.setEnabled(true);
+    {
+        auto lock = source.lockIngress();
+        source.markIngress(10);
+    }
+    {
+        TraceScope scope(source, TraceSpan::Compute, 42, 10);
+    }
+    {
+        TraceScope scope(source, TraceSpan::Send, 42, 10);
+        scope.setInputPosition(0);
+    }
+
+    const auto events = registry.collect();
+    ASSERT_EQ(events.size(), 2u);
+    ASSERT_EQ(events[0].span, TraceSpan::Compute);
+    ASSERT_EQ(events[0].latencyNs, -1);
+    ASSERT_EQ(events[1].span, TraceSpan::Send);
+    ASSERT_GE(events[1].latencyNs, 0);
+
+    const auto json = registry.dumpChromeTrace();
+    ASSERT_EQ(json.rfind(R"({"displayTimeUnit":"ns","traceEvents":[)", 0), 0u);
+    ASSERT_NE(json.find(R"("name":"compute","cat":"Scaler \"1\"","ph":"X")"), std::string::npos);
+    ASSERT_NE(json.find(R"("offset":42,"samples":10)"), std::string::npos);
+    ASSERT_NE(json.find(R"("latency_us":)"), std::string::npos);
+    ASSERT_NE(json.find(R"("name":"thread_name","ph":"M")"), std::string::npos);
+}
+
+TEST_F(TraceRecorderTest, DestroyedSourceLeavesTrace)
+{
+    auto& registry = TraceRegistry::instance();
+    registry.clear();
+
+    {
+        TraceSource source("Removed");
+        source.setEnabled(true);
+        TraceScope scope(source, TraceSpan::Compute, 0, 10);
+    }
+
+    TraceSource source("Kept");
+    source.setEnabled(true);
+    {
+        TraceScope scope(source, TraceSpan::Compute, 0, 10);
+    }
+
+    ASSERT_EQ(registry.collect().size(), 2u);
+
+    const auto json = registry.dumpChromeTrace();
+    ASSERT_EQ(json.find("Removed"), std::string::npos);
+    ASSERT_NE(json.find(R"("cat":"Kept")"), std::string::npos);
+}
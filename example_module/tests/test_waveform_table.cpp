@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <example_module/waveform_table.h>
+#include <cmath>
+#include <vector>
+
+using namespace daq;
+using namespace daq::modules::example_module;
+
+using WaveformTableTest = testing::Test;
+
+TEST_F(WaveformTableTest, SineKeepsFrequencyOverWholePeriods)
+{
+    WaveformSpec spec;
+    spec.sampleRate = 1000.0;
+    spec.frequency = 300.0;
+
+    WaveformTable table;
+    table.build(spec, SampleType::Float64);
+    ASSERT_EQ(table.getLength(), 10u);
+    ASSERT_EQ(table.getCycles(), 3u);
+    ASSERT_DOUBLE_EQ(table.getFrequency(), 300.0);
+
+    std::vector<double> output(25);
+    table.fill(output.data(), output.size(), 0);
+    for (SizeT i = 0; i < output.size(); ++i)
+        ASSERT_NEAR(output[i], std::sin(2.0 * M_PI * 300.0 * static_cast<double>(i) / 1000.0), 1e-12);
+
+    spec.frequency = 3.0;
+    table.build(spec, SampleType::Float64);
+    ASSERT_EQ(table.getLength(), 1000u);
+    ASSERT_DOUBLE_EQ(table.getFrequency(), 3.0);
+
+    spec.sampleRate = 48000.0;
+    spec.frequency = 440.25;
+    table.build(spec, SampleType::Float64);
+    ASSERT_EQ(table.getLength(), 64000u);
+    ASSERT_EQ(table.getCycles(), 587u);
+    ASSERT_DOUBLE_EQ(table.getFrequency(), 440.25);
+}
+
+TEST_F(WaveformTableTest, FrequencyWithoutExactPeriodIsClose)
+{
+    WaveformSpec spec;
+    spec.sampleRate = 1000.0;
+    spec.frequency = 1000.0 / M_PI;
+
+    WaveformTable table;
+    table.build(spec, SampleType::Float64);
+    ASSERT_LE(table.getLength(), WaveformTable::MaxLength);
+    ASSERT_NEAR(table.getFrequency(), spec.frequency, spec.frequency * 1e-9);
+}
+
+TEST_F(WaveformTableTest, FillWrapsAroundThePeriod)
+{
+    WaveformSpec spec;
+    spec.sampleRate = 1000.0;
+    spec.frequency = 100.0;
+    spec.amplitude = 2.0;
+    spec.offset = 1.0;
+
+    WaveformTable table;
+    table.build(spec, SampleType::Float64);
+
+    std::vector<double> output(25);
+    const SizeT phase = table.fill(output.data(), output.size(), 3);
+    ASSERT_EQ(phase, 8u);
+    for (SizeT i = 0; i < output.size(); ++i)
+        ASSERT_NEAR(output[i], 1.0 + 2.0 * std::sin(2.0 * M_PI * 100.0 * static_cast<double>(i + 3) / 1000.0), 1e-12);
+}
+
+TEST_F(WaveformTableTest, StepAlternatesEveryHalfPeriod)
+{
+    WaveformSpec spec;
+    spec.waveform = Waveform::Step;
+    spec.sampleRate = 100.0;
+    spec.frequency = 10.0;
+    spec.amplitude = 5.0;
+
+    WaveformTable table;
+    table.build(spec, SampleType::Int16);
+
+    std::vector<int16_t> output(20);
+    table.fill(output.data(), output.size(), 0);
+    for (SizeT i = 0; i < output.size(); ++i)
+        ASSERT_EQ(output[i], i % 10 < 5 ? 0 : 5);
+}
+
+TEST_F(WaveformTableTest, ChirpSweepsFrequency)
+{
+    WaveformSpec spec;
+    spec.waveform = Waveform::Chirp;
+    spec.sampleRate = 10000.0;
+    spec.frequency = 10.0;
+    spec.endFrequency = 1000.0;
+    spec.duration = 1.0;
+
+    WaveformTable table;
+    table.build(spec, SampleType::Float64);
+    ASSERT_EQ(table.getLength(), 10000u);
+
+    // Zero crossings per 100 samples grow from 0.2 to 20
+    std::vector<double> output(table.getLength());
+    table.fill(output.data(), output.size(), 0);
+    const auto crossings = [&output](SizeT begin, SizeT end)
+    {
+        SizeT count = 0;
+        for (SizeT i = begin + 1; i < end; ++i)
+            count += (output[i - 1] < 0.0) != (output[i] < 0.0);
+        return count;
+    };
+    ASSERT_LT(crossings(0, 1000), crossings(9000, 10000));
+}
+
+TEST_F(WaveformTableTest, IntegerSamplesSaturate)
+{
+    WaveformSpec spec;
+    spec.waveform = Waveform::Noise;
+    spec.amplitude = 1000.0;
+
+    WaveformTable table;
+    table.build(spec, SampleType::Int8);
+    ASSERT_EQ(table.getLength(), WaveformTable::NoiseLength);
+
+    std::vector<int8_t> output(1000);
+    table.fill(output.data(), output.size(), 0);
+    SizeT saturated = 0;
+    for (const int8_t value : output)
+        saturated += value == 127 || value == -128;
+    ASSERT_GT(saturated, 800u);
+}
+
+TEST_F(WaveformTableTest, ConstantFillsAnyCount)
+{
+    WaveformSpec spec;
+    spec.waveform = Waveform::Constant;
+    spec.offset = 42.0;
+
+    WaveformTable table;
+    table.build(spec, SampleType::UInt32);
+
+    std::vector<uint32_t> output(1000, 0);
+    table.fill(output.data(), output.size(), 0);
+    for (const uint32_t value : output)
+        ASSERT_EQ(value, 42u);
+}
+
+TEST_F(WaveformTableTest, InvalidFrequencyThrows)
+{
+    WaveformSpec spec;
+    spec.sampleRate = 1000.0;
+
+    spec.frequency = 600.0;
+    WaveformTable table;
+    ASSERT_THROW(table.build(spec, SampleType::Float64), std::invalid_argument);
+
+    spec.sampleRate = 1e8;
+    spec.frequency = 1.0;
+    ASSERT_THROW(table.build(spec, SampleType::Float64), std::invalid_argument);
+}
@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+#include <example_module/window_statistics.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace daq;
+using namespace daq::modules::example_module;
+
+using WindowStatisticsTest = testing::Test;
+
+namespace
+{
+    std::vector<double> makeSignal(SizeT count, double offset, double amplitude, unsigned seed = 42)
+    {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<double> dist(-amplitude, amplitude);
+        std::vector<double> signal(count);
+        for (auto& x : signal)
+            x = offset + dist(gen);
+        return signal;
+    }
+
+    std::vector<WindowResult> collect(WindowStatistics& statistics, const std::vector<double>& signal, SizeT blockSize)
+    {
+        std::vector<WindowResult> results;
+        for (SizeT i = 0; i < signal.size(); i += blockSize)
+        {
+            const SizeT n = std::min(blockSize, signal.size() - i);
+            statistics.process(signal.data() + i, n, [&](const WindowResult& result) { results.push_back(result); });
+        }
+        return results;
+    }
+
+    bool sameBits(const WindowResult& a, const WindowResult& b)
+    {
+        return a.startIndex == b.startIndex && a.min == b.min && a.max == b.max && a.mean == b.mean && a.rms == b.rms &&
+               a.stdDev == b.stdDev;
+    }
+}
+
+TEST_F(WindowStatisticsTest, SimdLevelsMatchScalar)
+{
+    const auto signal = makeSignal(10007, 3.0, 2.0);
+
+    for (const SizeT count : {SizeT(0), SizeT(1), SizeT(3), SizeT(4), SizeT(13), SizeT(1000), SizeT(10007)})
+    {
+        const auto expected = MomentsKernel(SimdLevel::Scalar)(signal.data(), count);
+
+        for (const auto level : {SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512})
+        {
+            if (level > getSimdLevel())
+                continue;
+
+            const auto actual = MomentsKernel(level)(signal.data(), count);
+            EXPECT_EQ(actual.count, expected.count) << simdLevelName(level);
+            EXPECT_EQ(actual.min, expected.min) << simdLevelName(level) << " count " << count;
+            EXPECT_EQ(actual.max, expected.max) << simdLevelName(level) << " count " << count;
+            EXPECT_EQ(actual.mean, expected.mean) << simdLevelName(level) << " count " << count;
+            EXPECT_EQ(actual.m2, expected.m2) << simdLevelName(level) << " count " << count;
+        }
+    }
+}
+
+TEST_F(WindowStatisticsTest, MatchesReference)
+{
+    const SizeT window = 5000;
+    const auto signal = makeSignal(window, 0.5, 1.0);
+
+    WindowStatistics statistics;
+    statistics.configure(window, window);
+    const auto results = collect(statistics, signal, signal.size());
+    ASSERT_EQ(results.size(), 1u);
+
+    long double sum = 0.0L;
+    long double sumSquares = 0.0L;
+    double min = signal[0];
+    double max = signal[0];
+    for (const double x : signal)
+    {
+        sum += x;
+        sumSquares += static_cast<long double>(x) * x;
+        min = std::min(min, x);
+        max = std::max(max, x);
+    }
+    const long double mean = sum / window;
+    const long double variance = sumSquares / window - mean * mean;
+
+    EXPECT_EQ(results[0].startIndex, 0u);
+    EXPECT_EQ(results[0].min, min);
+    EXPECT_EQ(results[0].max, max);
+    EXPECT_NEAR(results[0].mean, static_cast<double>(mean), 1e-12);
+    EXPECT_NEAR(results[0].rms, std::sqrt(static_cast<double>(sumSquares / window)), 1e-12);
+    EXPECT_NEAR(results[0].stdDev, std::sqrt(static_cast<double>(variance)), 1e-12);
+}
+
+TEST_F(WindowStatisticsTest, StableWithLargeOffset)
+{
+    // The variance of the noise is 1e-6 / 3; the sum of squares of the samples is about 1e18 per sample
+    const SizeT window = 100000;
+    const auto signal = makeSignal(window, 1e9, 1e-3);
+
+    WindowStatistics statistics;
+    statistics.configure(window, window);
+    const auto results = collect(statistics, signal, 4096);
+    ASSERT_EQ(results.size(), 1u);
+
+    long double sum = 0.0L;
+    for (const double x : signal)
+        sum += x;
+    const long double mean = sum / window;
+    long double m2 = 0.0L;
+    for (const double x : signal)
+        m2 += (x - mean) * (x - mean);
+    const double stdDev = std::sqrt(static_cast<double>(m2 / window));
+
+    EXPECT_NEAR(results[0].mean, static_cast<double>(mean), 1e-6);
+    EXPECT_NEAR(results[0].stdDev, stdDev, stdDev * 1e-4);
+}
+
+TEST_F(WindowStatisticsTest, EmitsOverlappingWindows)
+{
+    const auto signal = makeSignal(10000, 0.0, 1.0);
+
+    WindowStatistics statistics;
+    statistics.configure(1000, 300);
+    const auto results = collect(statistics, signal, 777);
+
+    // Windows start at multiples of the hop and end within the signal
+    ASSERT_EQ(results.size(), (10000 - 1000) / 300 + 1);
+    for (SizeT i = 0; i < results.size(); ++i)
+    {
+        EXPECT_EQ(results[i].startIndex, i * 300);
+
+        const auto first = signal.begin() + static_cast<std::ptrdiff_t>(results[i].startIndex);
+        EXPECT_EQ(results[i].min, *std::min_element(first, first + 1000));
+        EXPECT_EQ(results[i].max, *std::max_element(first, first + 1000));
+    }
+}
+
+TEST_F(WindowStatisticsTest, BlockSizeDoesNotChangeResults)
+{
+    const auto signal = makeSignal(20000, 2.0, 1.0);
+
+    WindowStatistics whole;
+    whole.configure(3000, 1000);
+    const auto expected = collect(whole, signal, signal.size());
+
+    for (const SizeT blockSize : {SizeT(1), SizeT(7), SizeT(1000), SizeT(4099)})
+    {
+        WindowStatistics split;
+        split.configure(3000, 1000);
+        const auto actual = collect(split, signal, blockSize);
+
+        ASSERT_EQ(actual.size(), expected.size()) << blockSize;
+        for (SizeT i = 0; i < expected.size(); ++i)
+            EXPECT_TRUE(sameBits(actual[i], expected[i])) << "block size " << blockSize << " window " << i;
+    }
+}
+
+TEST_F(WindowStatisticsTest, ResetDiscardsPartialWindow)
+{
+    const auto signal = makeSignal(1500, 0.0, 1.0);
+
+    WindowStatistics statistics;
+    statistics.configure(1000, 1000);
+    EXPECT_TRUE(collect(statistics, std::vector<double>(signal.begin(), signal.begin() + 500), 500).empty());
+
+    statistics.reset();
+    const auto results = collect(statistics, std::vector<double>(signal.begin() + 500, signal.end()), 1000);
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].startIndex, 0u);
+    EXPECT_EQ(results[0].min, *std::min_element(signal.begin() + 500, signal.end()));
+}
+
+TEST_F(WindowStatisticsTest, InvalidConfigurationThrows)
+{
+    WindowStatistics statistics;
+    EXPECT_THROW(statistics.configure(0, 0), std::invalid_argument);
+    EXPECT_THROW(statistics.configure(100, 0), std::invalid_argument);
+    EXPECT_THROW(statistics.configure(100, 101), std::invalid_argument);
+    EXPECT_THROW(statistics.configure(1000003, 1000), std::invalid_argument);
+    EXPECT_NO_THROW(statistics.configure(1000000, 1000));
+}